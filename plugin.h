@@ -25,6 +25,7 @@
 // ---- changed: 17May2020, 18May2020, 19May2020, 20May2020, 24May2020, 31May2020, 06Jun2020
 // ----          08Jun2020, 16Aug2021, 03Sep2023, 30Nov2023, 04Dec2023, 22Dec2023, 06Jan2024
 // ----          19Jan2024, 21Jan2024, 08Feb2024, 15Feb2024, 10Aug2024, 19Sep2024, 07Nov2024
+// ----          16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -33,6 +34,7 @@
 #define ST_PLUGIN_H__
 
 #include <string.h>
+#include <stdlib.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -72,6 +74,35 @@ typedef void *st_sampleplayer_handle_t;
 
 typedef void *st_ui_handle_t;
 
+// Per-voice block description (see process_replace_voices())
+typedef struct st_plugin_voice_block_s {
+   st_plugin_voice_t *voice;
+   float              freq_hz;      // see prepare_block()
+   float              note;         // see prepare_block()
+   float              vol;          // see prepare_block()
+   float              pan;          // see prepare_block()
+   int                b_mono_in;    // see process_replace()
+   const float       *samples_in;   // see process_replace()
+   float             *samples_out;  // see process_replace()
+} st_plugin_voice_block_t;
+
+// Host memory allocator (see st_plugin_info_t::allocator)
+struct st_plugin_allocator_s;
+typedef struct st_plugin_allocator_s st_plugin_allocator_t;
+struct st_plugin_allocator_s {
+   // Allocate 'size' bytes at an address aligned to (at least) 'align' bytes (power of two)
+   //  - returns NULL when out of memory
+   //  - memory is not necessarily zero-initialized
+   void *(ST_PLUGIN_API *mem_alloc) (st_plugin_allocator_t *_allocator, size_t _size, size_t _align);
+
+   // Free memory previously returned by mem_alloc()
+   void (ST_PLUGIN_API *mem_free) (st_plugin_allocator_t *_allocator, void *_ptr);
+
+   void *user_data;  // host-specific
+
+   void *_future[8 - 3];
+};
+
 
 // plugin api version
 //  (note) 'voiceIdx' param added to voice_new() in v2
@@ -90,6 +121,26 @@ typedef void *st_ui_handle_t;
 // flags: plugin supports voicebus cross modulation
 #define ST_PLUGIN_FLAG_XMOD             (1u << 3)
 
+// flags: plugin implements process_replace_planar() (non-interleaved l/r buffers)
+#define ST_PLUGIN_FLAG_PLANAR           (1u << 4)
+
+// flags: plugin processes a summed 'send' bus once per block (shared instance state, see process_shared())
+//         (e.g. reverbs, global effects)
+#define ST_PLUGIN_FLAG_SHARED_BUS       (1u << 5)
+
+// Minimum alignment (bytes) of the process_replace_planar() buffer addresses
+#define ST_PLUGIN_PLANAR_ALIGN  (16u)
+
+// Alignment (bytes) of shared / voice instances allocated via st_plugin_allocator_t (see Dstplugin_alloc())
+#define ST_PLUGIN_ALLOC_ALIGN  (64u)
+
+// Voice tail states (see query_tail_state())
+#define ST_PLUGIN_TAIL_ACTIVE  (0u)
+#define ST_PLUGIN_TAIL_SILENT  (1u)
+
+// Peak level below which a block of samples is considered silent (~-120dB)
+#define ST_PLUGIN_SILENCE_THRESHOLD  (0.000001f)
+
 // Maximum number of layers / voice buses
 #define ST_PLUGIN_MAX_LAYERS  (32u)
 
@@ -611,7 +662,110 @@ struct st_plugin_info_s {
                                      const unsigned int  _srcNumElements
                                      );
 
-   void *_future[64 - 49];
+   // Prepare and process multiple voices of the same shared instance ('batched' block processing)
+   //  - fxn pointer can be NULL (host falls back to per-voice prepare_block() + process_replace() calls)
+   //  - equivalent to calling
+   //       prepare_block(voice, numFrames, freq_hz, note, vol, pan)
+   //       process_replace(voice, b_mono_in, samples_in, samples_out, numFrames)
+   //     for each of the 'numVoices' elements in 'blocks' (in any order)
+   //  - allows plugins to evaluate shared parameters only once per block, and to process voices in SIMD lanes
+   //  - all voices share the same 'shared' instance and block size ('numFrames' is always > 0)
+   //  - not used for the initial prepare_block() call after note on (numFrames=0)
+   //  - set_mod_value() and voice bus updates (voice_bus_buffers, voice_bus_read_offset) must be done by the host before this call
+   //  - the output buffer of a voice must not overlap the input / output buffers of other voices in the same call
+   //     (in-place processing of the same voice is allowed, though)
+   void (ST_PLUGIN_API *process_replace_voices) (st_plugin_voice_block_t *_blocks,
+                                                 unsigned int             _numVoices,
+                                                 unsigned int             _numFrames
+                                                 );
+
+   // Process non-interleaved ('planar') stereo data
+   //  - fxn pointer can be NULL (plugin does not set ST_PLUGIN_FLAG_PLANAR)
+   //  - same as process_replace() but with separate left / right channel buffers
+   //  - all buffer addresses are aligned to (at least) ST_PLUGIN_PLANAR_ALIGN bytes
+   //  - when 'samplesInL'=='samplesOutL' and 'samplesInR'=='samplesOutR', process in place
+   //  - when 'bMonoIn' is set, 'samplesInL' and 'samplesInR' may point to the same buffer
+   void (ST_PLUGIN_API *process_replace_planar) (st_plugin_voice_t  *_voice,
+                                                 int                 _bMonoIn,
+                                                 const float        *_samplesInL,
+                                                 const float        *_samplesInR,
+                                                 float              *_samplesOutL,
+                                                 float              *_samplesOutR,
+                                                 unsigned int        _numFrames
+                                                 );
+
+   // Query voice tail state
+   //  - fxn pointer can be NULL (voice is always considered active)
+   //  - called by the host after process_replace() (or process_replace_voices() / process_replace_planar())
+   //  - returns ST_PLUGIN_TAIL_SILENT when the last block's output was silent (peak < ST_PLUGIN_SILENCE_THRESHOLD)
+   //     and will stay silent for as long as the input stays silent
+   //     - FX plugins must account for all internal state (delay lines, reverb tanks, filters, ..)
+   //     - oscillator plugins (ST_PLUGIN_FLAG_OSC) stay silent until the next note_on() (e.g. amp envelope ended)
+   //  - while a voice is silent and its input block is silent, the host may skip set_mod_value(), prepare_block()
+   //     and process_replace() and output silence instead
+   //     - the host resumes processing when the input becomes non-silent (or after note_on())
+   unsigned int (ST_PLUGIN_API *query_tail_state) (st_plugin_voice_t *_voice);
+
+   // Process and accumulate ('samplesOut += process(samplesIn) * gain')
+   //  - fxn pointer can be NULL (host calls process_replace() and mixes the output itself)
+   //  - same as process_replace() but adds the (scaled) output to 'samplesOut' instead of overwriting it
+   //     (e.g. last plugin in a layer's FX chain renders directly into the voice / layer mix buffer)
+   //  - 'samplesIn' and 'samplesOut' must not overlap
+   void (ST_PLUGIN_API *process_add) (st_plugin_voice_t  *_voice,
+                                      int                 _bMonoIn,
+                                      const float        *_samplesIn,
+                                      float              *_samplesOut,
+                                      unsigned int        _numFrames,
+                                      float               _gain
+                                      );
+
+   // Host memory allocator
+   //  - NULL by default (plugin uses malloc() / free())
+   //  - may be set by the host after st_plugin_init() and before the first shared_new() call
+   //     (e.g. to keep shared / voice instances in a contiguous, pre-faulted arena)
+   //  - must not be changed until all shared / voice instances have been deleted
+   //  - plugins allocate and free their shared / voice instances via Dstplugin_alloc() / Dstplugin_free()
+   //  - plugins may also allocate per-voice buffers (e.g. delay lines sized for the current sample rate)
+   //     in set_sample_rate() and free them in voice_delete()
+   st_plugin_allocator_t *allocator;
+
+   // Reset voice instance to its initial state (as returned by voice_new()) without reallocating it
+   //  - fxn pointer can be NULL (host calls voice_delete() + voice_new() instead)
+   //  - e.g. called when the host steals / recycles a voice
+   //  - 'voiceIdx' is the value that was passed to voice_new()
+   //  - host-managed base fields (shared, voice_bus_buffers, layer_idx, voice_idx, ..) are not modified
+   //  - host must call set_sample_rate(), set_bpm() and note_on() afterwards (like after voice_new())
+   void (ST_PLUGIN_API *voice_reset) (st_plugin_voice_t *_voice, unsigned int _voiceIdx);
+
+   // Process summed voice bus (interleaved stereo, once per block and shared instance)
+   //  - fxn pointer can be NULL (plugin does not set ST_PLUGIN_FLAG_SHARED_BUS)
+   //  - hosts that support the bus sum the input of all voices routed to the shared instance,
+   //     call process_shared() instead of the voices' prepare_block() + process_replace(),
+   //     and mix the output into the layer / main output
+   //     - per-voice modulation does not apply, the plugin uses its (smoothed) shared parameters
+   //     - voices are still created and receive set_sample_rate() (which updates the shared state)
+   //  - hosts that do not support the bus call process_replace() for each voice
+   //     (plugins should step the shared state in one voice only, e.g. voice_new() index 0, and pass the other voices through)
+   //  - 'samplesIn' and 'samplesOut' may overlap (in-place processing)
+   void (ST_PLUGIN_API *process_shared) (st_plugin_shared_t *_shared,
+                                         int                 _bMonoIn,
+                                         const float        *_samplesIn,
+                                         float              *_samplesOut,
+                                         unsigned int        _numFrames
+                                         );
+
+   // Declare maximum block size (number of sample frames per prepare_block() / process_*() call)
+   //  - fxn pointer can be NULL (plugin does not preallocate block-sized buffers)
+   //  - called by the host after shared_new() and before the voices' set_sample_rate() calls,
+   //     and whenever the host's block size limit changes (while no voices are being processed)
+   //  - not called from the audio thread: plugins may (re-)allocate scratch buffers / tables here
+   //     (e.g. store the size in the shared instance and size per-voice buffers in set_sample_rate())
+   //  - hosts that do not call it may render blocks of any size
+   void (ST_PLUGIN_API *set_max_block_size) (st_plugin_shared_t *_shared,
+                                             unsigned int        _maxFrames
+                                             );
+
+   void *_future[64 - 57];
 };
 
 
@@ -802,6 +956,54 @@ typedef union stplugin_us16_u {
    unsigned short u;
 } stplugin_us16_t;
 
+// Tail / silence tracker (see query_tail_state())
+typedef struct stplugin_tail_s {
+   unsigned int num_silent_frames;  // consecutive frames with silent input and silent (internal / wet) output
+   unsigned int num_tail_frames;    // min. number of silent frames before the tail has ended (e.g. delay line size)
+} stplugin_tail_t;
+
+// Update peak level 'p' with sample 'a'
+#define Dstplugin_peak(p,a) ( (p) = (Dstplugin_abs(a) > (p)) ? Dstplugin_abs(a) : (p) )
+
+// Update peak level 'p' with 'n' samples from buffer 'b'
+#define Dstplugin_peak_buf(p,b,n) do { unsigned int peakIdx_; for(peakIdx_ = 0u; peakIdx_ < (n); peakIdx_++) { Dstplugin_peak(p, (b)[peakIdx_]); } } while(0)
+
+// Reset tail tracker (e.g. in note_on())
+#define Dstplugin_tail_reset(t) (t).num_silent_frames = 0u
+
+// Update tail tracker after processing 'n' frames ('pi'=input peak, 'po'=internal / wet output peak)
+#define Dstplugin_tail_update(t,pi,po,n)                                                               \
+   do {                                                                                                \
+      if( ((pi) < ST_PLUGIN_SILENCE_THRESHOLD) && ((po) < ST_PLUGIN_SILENCE_THRESHOLD) )              \
+      {                                                                                                \
+         if((t).num_silent_frames < 0x7FFFFFFFu)                                                       \
+            (t).num_silent_frames += (n);                                                              \
+      }                                                                                                \
+      else                                                                                             \
+         (t).num_silent_frames = 0u;                                                                   \
+   } while(0)
+
+// Query tail state (ST_PLUGIN_TAIL_xxx)
+#define Dstplugin_tail_state(t) ( (((t).num_silent_frames > 0u) && ((t).num_silent_frames >= (t).num_tail_frames)) ? ST_PLUGIN_TAIL_SILENT : ST_PLUGIN_TAIL_ACTIVE )
+
+// Clear all voice instance fields that follow the 'base' field (see voice_reset())
+#define Dstplugin_voice_clear(v) memset((void*)(&(v)->base + 1), 0, sizeof(*(v)) - sizeof((v)->base))
+
+// Clear voice instance fields from 'base' up to (excluding) field 'e' (e.g. to skip large delay lines)
+#define Dstplugin_voice_clear_to(v,e) memset((void*)(&(v)->base + 1), 0, (size_t)((const char*)&(v)->e - (const char*)(&(v)->base + 1)))
+
+// Clear voice instance fields from field 'f' up to the end of the struct
+#define Dstplugin_voice_clear_from(v,f) memset((void*)&(v)->f, 0, sizeof(*(v)) - (size_t)((const char*)&(v)->f - (const char*)(v)))
+
+// Allocate shared / voice instance memory via host allocator (or malloc() when info->allocator is NULL)
+#define Dstplugin_alloc(i,sz) ( (NULL != (i)->allocator) ? (i)->allocator->mem_alloc((i)->allocator, (sz), ST_PLUGIN_ALLOC_ALIGN) : malloc(sz) )
+
+// Free shared / voice instance memory allocated via Dstplugin_alloc()
+#define Dstplugin_free(i,p) do { if(NULL != (i)->allocator) { (i)->allocator->mem_free((i)->allocator, (void*)(p)); } else { free((void*)(p)); } } while(0)
+
+// Store ('bAdd'=0, see process_replace()) or accumulate ('bAdd'=1, see process_add()) output sample 'a' in 'd'
+#define Dstplugin_out(bAdd,d,a,g) do { if(bAdd) { (d) += (a) * (g); } else { (d) = (a); } } while(0)
+
 
 #ifdef __cplusplus
 }
@@ -1015,7 +1015,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   aon_fm_v1_lofi_shared_t *ret = (aon_fm_v1_lofi_shared_t *)malloc(sizeof(aon_fm_v1_lofi_shared_t));
+   aon_fm_v1_lofi_shared_t *ret = (aon_fm_v1_lofi_shared_t *)Dstplugin_alloc(_info, sizeof(aon_fm_v1_lofi_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -1026,11 +1026,11 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
-   aon_fm_v1_lofi_voice_t *voice = (aon_fm_v1_lofi_voice_t *)malloc(sizeof(aon_fm_v1_lofi_voice_t));
+   aon_fm_v1_lofi_voice_t *voice = (aon_fm_v1_lofi_voice_t *)Dstplugin_alloc(_info, sizeof(aon_fm_v1_lofi_voice_t));
    if(NULL != voice)
    {
       memset((void*)voice, 0, sizeof(*voice));
@@ -1041,10 +1041,18 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &voice->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(aon_fm_v1_lofi_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+   voice->tmp5_zlp_pos = 0;
+   voice->tmp10_zlp_pos = 0;
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
    ST_PLUGIN_VOICE_CAST(aon_fm_v1_lofi_voice_t);
 
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -1112,6 +1120,7 @@ st_plugin_info_t *aon_fm_v1_lofi_init(void) {
       ret->base.shared_delete                       = &loc_shared_delete;
       ret->base.voice_new                           = &loc_voice_new;
       ret->base.voice_delete                        = &loc_voice_delete;
+      ret->base.voice_reset                         = &loc_voice_reset;
       ret->base.get_param_name                      = &loc_get_param_name;
       ret->base.get_param_group_name                = &loc_get_param_group_name;
       ret->base.get_param_group_idx                 = &loc_get_param_group_idx;
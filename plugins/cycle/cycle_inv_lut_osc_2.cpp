@@ -617,7 +617,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   inv_lut_osc_2_shared_t *ret = (inv_lut_osc_2_shared_t *)malloc(sizeof(inv_lut_osc_2_shared_t));
+   inv_lut_osc_2_shared_t *ret = (inv_lut_osc_2_shared_t *)Dstplugin_alloc(_info, sizeof(inv_lut_osc_2_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -628,11 +628,11 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
-   inv_lut_osc_2_voice_t *voice = (inv_lut_osc_2_voice_t *)malloc(sizeof(inv_lut_osc_2_voice_t));
+   inv_lut_osc_2_voice_t *voice = (inv_lut_osc_2_voice_t *)Dstplugin_alloc(_info, sizeof(inv_lut_osc_2_voice_t));
    if(NULL != voice)
    {
       memset((void*)voice, 0, sizeof(*voice));
@@ -641,10 +641,16 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &voice->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(inv_lut_osc_2_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
    ST_PLUGIN_VOICE_CAST(inv_lut_osc_2_voice_t);
 
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -712,6 +718,7 @@ st_plugin_info_t *inv_lut_osc_2_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
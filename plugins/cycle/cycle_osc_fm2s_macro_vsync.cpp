@@ -1421,7 +1421,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   osc_fm2s_macro_vsync_shared_t *ret = (osc_fm2s_macro_vsync_shared_t *)malloc(sizeof(osc_fm2s_macro_vsync_shared_t));
+   osc_fm2s_macro_vsync_shared_t *ret = (osc_fm2s_macro_vsync_shared_t *)Dstplugin_alloc(_info, sizeof(osc_fm2s_macro_vsync_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -1432,11 +1432,11 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
-   osc_fm2s_macro_vsync_voice_t *voice = (osc_fm2s_macro_vsync_voice_t *)malloc(sizeof(osc_fm2s_macro_vsync_voice_t));
+   osc_fm2s_macro_vsync_voice_t *voice = (osc_fm2s_macro_vsync_voice_t *)Dstplugin_alloc(_info, sizeof(osc_fm2s_macro_vsync_voice_t));
    if(NULL != voice)
    {
       memset((void*)voice, 0, sizeof(*voice));
@@ -1450,10 +1450,21 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &voice->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(osc_fm2s_macro_vsync_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+   voice->tmp6_lfsr_state = 17545;
+   voice->tmp10_lfsr_state = 52447;
+   voice->tmp14_lfsr_state = 4945;
+   voice->tmp18_lfsr_state = 44615;
+   voice->tmp70_lfsr_state = 10552;
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
    ST_PLUGIN_VOICE_CAST(osc_fm2s_macro_vsync_voice_t);
 
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -1521,6 +1532,7 @@ st_plugin_info_t *osc_fm2s_macro_vsync_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -1190,7 +1190,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   osc_fm3s_tanh_shared_t *ret = (osc_fm3s_tanh_shared_t *)malloc(sizeof(osc_fm3s_tanh_shared_t));
+   osc_fm3s_tanh_shared_t *ret = (osc_fm3s_tanh_shared_t *)Dstplugin_alloc(_info, sizeof(osc_fm3s_tanh_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -1201,11 +1201,11 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
-   osc_fm3s_tanh_voice_t *voice = (osc_fm3s_tanh_voice_t *)malloc(sizeof(osc_fm3s_tanh_voice_t));
+   osc_fm3s_tanh_voice_t *voice = (osc_fm3s_tanh_voice_t *)Dstplugin_alloc(_info, sizeof(osc_fm3s_tanh_voice_t));
    if(NULL != voice)
    {
       memset((void*)voice, 0, sizeof(*voice));
@@ -1217,10 +1217,18 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &voice->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(osc_fm3s_tanh_voice_t);
+   Dstplugin_voice_clear(voice);
+   voice->tmp2_lfsr_state = 17545 * (_voiceIdx + 1u);
+   voice->tmp5_lfsr_state = 56505 * (_voiceIdx + 1u);
+   voice->tmp7_lfsr_state = 61706 * (_voiceIdx + 1u);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
    ST_PLUGIN_VOICE_CAST(osc_fm3s_tanh_voice_t);
 
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
    }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -1292,6 +1300,7 @@ st_plugin_info_t *osc_fm3s_tanh_init(void) {
       ret->base.shared_delete                       = &loc_shared_delete;
       ret->base.voice_new                           = &loc_voice_new;
       ret->base.voice_delete                        = &loc_voice_delete;
+      ret->base.voice_reset                         = &loc_voice_reset;
 #ifndef CYCLE_SKIP_UI
       ret->base.get_param_name                      = &loc_get_param_name;
       ret->base.get_param_group_name                = &loc_get_param_group_name;
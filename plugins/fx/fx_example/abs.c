@@ -8,7 +8,7 @@
 // ---- info   : abs
 // ----
 // ---- created: 09Jun2020
-// ---- changed: 21Jan2024
+// ---- changed: 21Jan2024, 16Oct2026
 // ----
 // ----
 // ----
@@ -195,12 +195,14 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    }
 }
 
-static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
-                                              int                 _bMonoIn,
-                                              const float        *_samplesIn,
-                                              float              *_samplesOut, 
-                                              unsigned int        _numFrames
-                                              ) {
+static inline void loc_process(st_plugin_voice_t  *_voice,
+                               int                 _bMonoIn,
+                               const float        *_samplesIn,
+                               float              *_samplesOut,
+                               unsigned int        _numFrames,
+                               const int           _bAdd,
+                               const float         _gain
+                               ) {
    // Ring modulate at (modulated) note frequency
    ST_PLUGIN_VOICE_CAST(abs_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(abs_shared_t);
@@ -229,8 +231,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          outL = outL + (outL*absL.f - outL) * voice->mod_blend_cur;
 
          outL = l + (outL - l) * voice->mod_drywet_cur;
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outL;
+         Dstplugin_out(_bAdd, _samplesOut[k],      outL, _gain);
+         Dstplugin_out(_bAdd, _samplesOut[k + 1u], outL, _gain);
 
          // Next frame
          k += 2u;
@@ -273,8 +275,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
          outL = l + (outL - l) * voice->mod_drywet_cur;
          outR = r + (outR - r) * voice->mod_drywet_cur;
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outR;
+         Dstplugin_out(_bAdd, _samplesOut[k],      outL, _gain);
+         Dstplugin_out(_bAdd, _samplesOut[k + 1u], outR, _gain);
 
          // Next frame
          k += 2u;
@@ -288,8 +290,27 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
 }
 
+static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
+                                              int                 _bMonoIn,
+                                              const float        *_samplesIn,
+                                              float              *_samplesOut,
+                                              unsigned int        _numFrames
+                                              ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 0/*bAdd*/, 1.0f/*gain*/);
+}
+
+static void ST_PLUGIN_API loc_process_add(st_plugin_voice_t  *_voice,
+                                          int                 _bMonoIn,
+                                          const float        *_samplesIn,
+                                          float              *_samplesOut,
+                                          unsigned int        _numFrames,
+                                          float               _gain
+                                          ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 1/*bAdd*/, _gain);
+}
+
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   abs_shared_t *ret = (abs_shared_t *)malloc(sizeof(abs_shared_t));
+   abs_shared_t *ret = (abs_shared_t *)Dstplugin_alloc(_info, sizeof(abs_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -300,12 +321,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   abs_voice_t *ret = (abs_voice_t *)malloc(sizeof(abs_voice_t));
+   abs_voice_t *ret = (abs_voice_t *)Dstplugin_alloc(_info, sizeof(abs_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -314,8 +335,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(abs_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -345,6 +372,7 @@ st_plugin_info_t *abs_init(void) {
       ret->base.shared_delete      = &loc_shared_delete;
       ret->base.voice_new          = &loc_voice_new;
       ret->base.voice_delete       = &loc_voice_delete;
+      ret->base.voice_reset        = &loc_voice_reset;
       ret->base.get_param_name     = &loc_get_param_name;
       ret->base.get_param_reset    = &loc_get_param_reset;
       ret->base.get_param_value    = &loc_get_param_value;
@@ -354,6 +382,7 @@ st_plugin_info_t *abs_init(void) {
       ret->base.set_mod_value      = &loc_set_mod_value;
       ret->base.prepare_block      = &loc_prepare_block;
       ret->base.process_replace    = &loc_process_replace;
+      ret->base.process_add        = &loc_process_add;
       ret->base.plugin_exit        = &loc_plugin_exit;
    }
 
@@ -8,7 +8,7 @@
 // ---- info   : amplifier
 // ----
 // ---- created: 21May2020
-// ---- changed: 24May2020, 08Jun2020, 21Jan2024
+// ---- changed: 24May2020, 08Jun2020, 21Jan2024, 16Oct2026
 // ----
 // ----
 // ----
@@ -32,6 +32,9 @@ static float loc_param_resets[NUM_PARAMS] = {
    0.5f,  // DRIVE
 };
 
+// process_replace_planar(): number of frames per ramp chunk
+#define PLANAR_CHUNK_SIZE  (64u)
+
 #define MOD_DRYWET  0
 #define MOD_DRIVE   1
 #define NUM_MODS    2
@@ -157,12 +160,14 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    }
 }
 
-static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
-                                              int                 _bMonoIn,
-                                              const float        *_samplesIn,
-                                              float              *_samplesOut, 
-                                              unsigned int        _numFrames
-                                              ) {
+static inline void loc_process(st_plugin_voice_t  *_voice,
+                               int                 _bMonoIn,
+                               const float        *_samplesIn,
+                               float              *_samplesOut,
+                               unsigned int        _numFrames,
+                               const int           _bAdd,
+                               const float         _gain
+                               ) {
    // Ring modulate at (modulated) note frequency
    ST_PLUGIN_VOICE_CAST(amp_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(amp_shared_t);
@@ -177,8 +182,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          float l = _samplesIn[k];
          float outL = l * voice->mod_drive_cur;
          outL = l + (outL - l) * voice->mod_drywet_cur;
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outL;
+         Dstplugin_out(_bAdd, _samplesOut[k],      outL, _gain);
+         Dstplugin_out(_bAdd, _samplesOut[k + 1u], outL, _gain);
 
          // Next frame
          k += 2u;
@@ -197,8 +202,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          float outR = r * voice->mod_drive_cur;
          outL = l + (outL - l) * voice->mod_drywet_cur;
          outR = r + (outR - r) * voice->mod_drywet_cur;
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outR;
+         Dstplugin_out(_bAdd, _samplesOut[k],      outL, _gain);
+         Dstplugin_out(_bAdd, _samplesOut[k + 1u], outR, _gain);
 
          // Next frame
          k += 2u;
@@ -209,8 +214,85 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
 }
 
+static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
+                                              int                 _bMonoIn,
+                                              const float        *_samplesIn,
+                                              float              *_samplesOut,
+                                              unsigned int        _numFrames
+                                              ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 0/*bAdd*/, 1.0f/*gain*/);
+}
+
+static void ST_PLUGIN_API loc_process_add(st_plugin_voice_t  *_voice,
+                                          int                 _bMonoIn,
+                                          const float        *_samplesIn,
+                                          float              *_samplesOut,
+                                          unsigned int        _numFrames,
+                                          float               _gain
+                                          ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 1/*bAdd*/, _gain);
+}
+
+static void ST_PLUGIN_API loc_process_replace_planar(st_plugin_voice_t  *_voice,
+                                                     int                 _bMonoIn,
+                                                     const float        *_samplesInL,
+                                                     const float        *_samplesInR,
+                                                     float              *_samplesOutL,
+                                                     float              *_samplesOutR,
+                                                     unsigned int        _numFrames
+                                                     ) {
+   ST_PLUGIN_VOICE_CAST(amp_voice_t);
+
+   // (note) the parameter ramps are unrolled into small arrays first so the per-channel loops
+   //         can be vectorized (same results as process_replace())
+   float drive [PLANAR_CHUNK_SIZE];
+   float drywet[PLANAR_CHUNK_SIZE];
+
+   unsigned int frameOff = 0u;
+   while(frameOff < _numFrames)
+   {
+      unsigned int numChunkFrames = Dstplugin_min(_numFrames - frameOff, PLANAR_CHUNK_SIZE);
+
+      for(unsigned int i = 0u; i < numChunkFrames; i++)
+      {
+         drive [i] = voice->mod_drive_cur;
+         drywet[i] = voice->mod_drywet_cur;
+         voice->mod_drywet_cur += voice->mod_drywet_inc;
+         voice->mod_drive_cur  += voice->mod_drive_inc;
+      }
+
+      const float *inL  = _samplesInL  + frameOff;
+      const float *inR  = _samplesInR  + frameOff;
+      float       *outL = _samplesOutL + frameOff;
+      float       *outR = _samplesOutR + frameOff;
+
+      for(unsigned int i = 0u; i < numChunkFrames; i++)
+      {
+         float l = inL[i];
+         outL[i] = l + (l * drive[i] - l) * drywet[i];
+      }
+
+      if(_bMonoIn)
+      {
+         // Mono input, stereo output
+         for(unsigned int i = 0u; i < numChunkFrames; i++)
+            outR[i] = outL[i];
+      }
+      else
+      {
+         for(unsigned int i = 0u; i < numChunkFrames; i++)
+         {
+            float r = inR[i];
+            outR[i] = r + (r * drive[i] - r) * drywet[i];
+         }
+      }
+
+      frameOff += numChunkFrames;
+   }
+}
+
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   amp_shared_t *ret = (amp_shared_t *)malloc(sizeof(amp_shared_t));
+   amp_shared_t *ret = (amp_shared_t *)Dstplugin_alloc(_info, sizeof(amp_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -221,12 +303,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   amp_voice_t *ret = (amp_voice_t *)malloc(sizeof(amp_voice_t));
+   amp_voice_t *ret = (amp_voice_t *)Dstplugin_alloc(_info, sizeof(amp_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -235,8 +317,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(amp_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -257,7 +345,7 @@ st_plugin_info_t *amp_init(void) {
       ret->base.author      = "bsp";
       ret->base.name        = "amp";
       ret->base.short_name  = "amp";
-      ret->base.flags       = ST_PLUGIN_FLAG_FX;
+      ret->base.flags       = ST_PLUGIN_FLAG_FX | ST_PLUGIN_FLAG_PLANAR;
       ret->base.category    = ST_PLUGIN_CAT_AMP;
       ret->base.num_params  = NUM_PARAMS;
       ret->base.num_mods    = NUM_MODS;
@@ -266,6 +354,7 @@ st_plugin_info_t *amp_init(void) {
       ret->base.shared_delete      = &loc_shared_delete;
       ret->base.voice_new          = &loc_voice_new;
       ret->base.voice_delete       = &loc_voice_delete;
+      ret->base.voice_reset        = &loc_voice_reset;
       ret->base.get_param_name     = &loc_get_param_name;
       ret->base.get_param_reset    = &loc_get_param_reset;
       ret->base.get_param_value    = &loc_get_param_value;
@@ -275,6 +364,8 @@ st_plugin_info_t *amp_init(void) {
       ret->base.set_mod_value      = &loc_set_mod_value;
       ret->base.prepare_block      = &loc_prepare_block;
       ret->base.process_replace    = &loc_process_replace;
+      ret->base.process_add        = &loc_process_add;
+      ret->base.process_replace_planar = &loc_process_replace_planar;
       ret->base.plugin_exit        = &loc_plugin_exit;
    }
 
@@ -4,7 +4,7 @@
 // ---- info   : biquad filter
 // ----
 // ---- created: 21May2020
-// ---- changed: 25May2020
+// ---- changed: 25May2020, 17Oct2026
 // ----
 // ----
 // ----
@@ -30,33 +30,134 @@
 #include <stdlib.h>
 #include <math.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define ST_BIQUAD_CASCADE_SSE2  1
+#include <emmintrin.h>
+#endif
+
 #include "../../../plugin.h"
 
 #include "biquad.h"
 
 
-void StBiquadCoeff::calcParams(int          _type,
-                               float        _dbGain,
-                               float        _freq,   // 0..1
-                               float        _res     // 0..1
-                               ) {
-#define Q _res
-#define Fc _freq
+// shared (read-only) coefficient design tables, built once when the plugin library is loaded.
+//  - tan(PI*Fc) is evaluated as sin(w)/cos(w) from a linearly interpolated quarter-wave sine table.
+//     the interpolation error of sin() (and cos()) is relative to the function value (<= h^2/8), i.e. K is
+//     accurate over the whole frequency range, including the region close to Nyquist where tan() is steep
+//  - pow(10, dB/20) is evaluated as 2^n * 2^f (integer octaves + interpolated fractional octave table),
+//     sqrt(2*V) is read at dB/2
+//  (note) the filter frequency is normalized (0..1 => 0..Nyquist) so the tables do not depend on the sample rate
+#define ST_BIQUAD_SIN_TBL_SIZE   (2048u)   // number of intervals in 0..PI/2
+#define ST_BIQUAD_EXP2_TBL_SIZE  (1024u)   // number of intervals in 2^(0..1)
+#define ST_BIQUAD_GAIN_MAXDB     (96.0f)   // pow() fallback above this gain
+
+static double loc_sin_tbl [ST_BIQUAD_SIN_TBL_SIZE  + 2u];
+static double loc_exp2_tbl[ST_BIQUAD_EXP2_TBL_SIZE + 2u];
+
+static struct loc_biquad_tables_init_s {
+   loc_biquad_tables_init_s(void) {
+      for(unsigned int i = 0u; i <= ST_BIQUAD_SIN_TBL_SIZE; i++)
+         loc_sin_tbl[i] = sin( (ST_PLUGIN_PI * 0.5 * i) / ST_BIQUAD_SIN_TBL_SIZE );
+      loc_sin_tbl[ST_BIQUAD_SIN_TBL_SIZE + 1u] = loc_sin_tbl[ST_BIQUAD_SIN_TBL_SIZE];
+
+      for(unsigned int i = 0u; i <= ST_BIQUAD_EXP2_TBL_SIZE; i++)
+         loc_exp2_tbl[i] = pow(2.0, double(i) / ST_BIQUAD_EXP2_TBL_SIZE);
+      loc_exp2_tbl[ST_BIQUAD_EXP2_TBL_SIZE + 1u] = loc_exp2_tbl[ST_BIQUAD_EXP2_TBL_SIZE];
+   }
+} loc_biquad_tables_init;
+
+static inline double loc_sin_tbl_lookup(float _x) {
+   // _x: 0..ST_BIQUAD_SIN_TBL_SIZE
+   unsigned int i = (unsigned int)_x;
+   double f = double(_x - float(i));
+   return loc_sin_tbl[i] + (loc_sin_tbl[i + 1u] - loc_sin_tbl[i]) * f;
+}
 
+static inline double loc_gain_tbl_lookup(float _absDb) {
+   // 10^(dB/20) = 2^(dB*log2(10)/20)
+   double oct = _absDb * (3.321928094887362 / 20.0);
+   unsigned int n = (unsigned int)oct;
+   double x = (oct - double(n)) * ST_BIQUAD_EXP2_TBL_SIZE;
+   unsigned int i = (unsigned int)x;
+   double f = x - double(i);
+   return (loc_exp2_tbl[i] + (loc_exp2_tbl[i + 1u] - loc_exp2_tbl[i]) * f) * double(1u << n);
+}
+
+static inline float loc_clamp_freq(float _freq) {
    // (note) sound dies after a short while with fmax=1.0
    _freq = Dstplugin_min(0.9999f, Dstplugin_max(_freq, 0.001f));
-   _freq *= 0.5f;
+   return _freq * 0.5f;
+}
 
+static inline float loc_clamp_res(float _res) {
    // (note) sound becomes very quiet with res < 0.5
    _res += 0.5f;
    if(_res < 0.5f)
       _res = 0.5f;
    else if(_res > 1.5f)
       _res = 1.5f;
+   return _res;
+}
+
+void StBiquadCoeff::calcParams(int          _type,
+                               float        _dbGain,
+                               float        _freq,   // 0..1
+                               float        _res     // 0..1
+                               ) {
+#ifdef ST_BIQUAD_COEFF_EXACT
+   calcParamsExact(_type, _dbGain, _freq, _res);
+#else
+   float Fc = loc_clamp_freq(_freq);
+   float Q  = loc_clamp_res(_res);
+
+   // tan(PI*Fc) = sin(PI*Fc) / sin(PI/2 - PI*Fc)
+   float x = Fc * float(2u * ST_BIQUAD_SIN_TBL_SIZE);
+   double K = loc_sin_tbl_lookup(x) / loc_sin_tbl_lookup(float(ST_BIQUAD_SIN_TBL_SIZE) - x);
+
+   double V      = 1.0;  // PEQ, LSH, HSH
+   double sqrt2V = 1.0;
+   float absDb = fabsf(_dbGain);
+   if(_type < StBiquad::PEQ)
+   {
+      // gain not used
+   }
+   else if(absDb < ST_BIQUAD_GAIN_MAXDB)
+   {
+      V      = loc_gain_tbl_lookup(absDb);
+      sqrt2V = loc_gain_tbl_lookup(absDb * 0.5f) * sqrt(2.0);
+   }
+   else
+   {
+      V      = pow(10, absDb / 20.0);
+      sqrt2V = sqrt(2*V);
+   }
+
+   calcParamsKV(_type, (_dbGain >= 0), K, V, sqrt2V, Q);
+#endif // ST_BIQUAD_COEFF_EXACT
+}
+
+void StBiquadCoeff::calcParamsExact(int          _type,
+                                    float        _dbGain,
+                                    float        _freq,   // 0..1
+                                    float        _res     // 0..1
+                                    ) {
+   float Fc = loc_clamp_freq(_freq);
+   float Q  = loc_clamp_res(_res);
 
-   double norm;
    double V = pow(10, fabs(_dbGain) / 20.0);  // PEQ, LSH, HSH
    double K = tan(ST_PLUGIN_PI * Fc);
+
+   calcParamsKV(_type, (_dbGain >= 0), K, V, sqrt(2*V), Q);
+}
+
+void StBiquadCoeff::calcParamsKV(int    _type,
+                                 bool   _bBoost,
+                                 double K,
+                                 double V,
+                                 double _sqrt2V,
+                                 double Q
+                                 ) {
+   double norm;
    switch(_type)
    {
       case StBiquad::LPF:
@@ -96,7 +197,7 @@ void StBiquadCoeff::calcParams(int          _type,
          break;
             
       case StBiquad::PEQ:
-         if(_dbGain >= 0)
+         if(_bBoost)
          {
             // boost
             norm = 1 / (1 + 1/Q * K + K * K);
@@ -119,52 +220,265 @@ void StBiquadCoeff::calcParams(int          _type,
          break;
 
       case StBiquad::LSH:
-         if(_dbGain >= 0)
+         if(_bBoost)
          {
             // boost
-            norm = 1 / (1 + sqrt(2) * K + K * K);
-            a0 = (1 + sqrt(2*V) * K + V * K * K) * norm;
+            norm = 1 / (1 + sqrt(2.0) * K + K * K);
+            a0 = (1 + _sqrt2V * K + V * K * K) * norm;
             a1 = 2 * (V * K * K - 1) * norm;
-            a2 = (1 - sqrt(2*V) * K + V * K * K) * norm;
+            a2 = (1 - _sqrt2V * K + V * K * K) * norm;
             b1 = 2 * (K * K - 1) * norm;
-            b2 = (1 - sqrt(2) * K + K * K) * norm;
+            b2 = (1 - sqrt(2.0) * K + K * K) * norm;
          }
          else
          {
             // cut
-            norm = 1 / (1 + sqrt(2*V) * K + V * K * K);
-            a0 = (1 + sqrt(2) * K + K * K) * norm;
+            norm = 1 / (1 + _sqrt2V * K + V * K * K);
+            a0 = (1 + sqrt(2.0) * K + K * K) * norm;
             a1 = 2 * (K * K - 1) * norm;
-            a2 = (1 - sqrt(2) * K + K * K) * norm;
+            a2 = (1 - sqrt(2.0) * K + K * K) * norm;
             b1 = 2 * (V * K * K - 1) * norm;
-            b2 = (1 - sqrt(2*V) * K + V * K * K) * norm;
+            b2 = (1 - _sqrt2V * K + V * K * K) * norm;
          }
          break;
 
       case StBiquad::HSH:
-         if(_dbGain >= 0)
+         if(_bBoost)
          {
             // boost
-            norm = 1 / (1 + sqrt(2) * K + K * K);
-            a0 = (V + sqrt(2*V) * K + K * K) * norm;
+            norm = 1 / (1 + sqrt(2.0) * K + K * K);
+            a0 = (V + _sqrt2V * K + K * K) * norm;
             a1 = 2 * (K * K - V) * norm;
-            a2 = (V - sqrt(2*V) * K + K * K) * norm;
+            a2 = (V - _sqrt2V * K + K * K) * norm;
             b1 = 2 * (K * K - 1) * norm;
-            b2 = (1 - sqrt(2) * K + K * K) * norm;
+            b2 = (1 - sqrt(2.0) * K + K * K) * norm;
          }
          else
          {
             // cut
-            norm = 1 / (V + sqrt(2*V) * K + K * K);
-            a0 = (1 + sqrt(2) * K + K * K) * norm;
+            norm = 1 / (V + _sqrt2V * K + K * K);
+            a0 = (1 + sqrt(2.0) * K + K * K) * norm;
             a1 = 2 * (K * K - 1) * norm;
-            a2 = (1 - sqrt(2) * K + K * K) * norm;
+            a2 = (1 - sqrt(2.0) * K + K * K) * norm;
             b1 = 2 * (K * K - V) * norm;
-            b2 = (V - sqrt(2*V) * K + K * K) * norm;
+            b2 = (V - _sqrt2V * K + K * K) * norm;
          }
          break;
    }
-#undef Q
-#undef Fc
+}
+
+
+void StBiquadCascade::reset(void) {
+   next[0].reset();
+   next[1].reset();
+
+   for(unsigned int j = 0u; j < 2u; j++)
+   {
+      for(unsigned int c = 0u; c < 5u; c++)
+      {
+         cur [c][j] = StBiquadCascadeSample(0);
+         step[c][j] = StBiquadCascadeSample(0);
+      }
+      cur[0][j] = StBiquadCascadeSample(1);  // a0
+
+      for(unsigned int p = 0u; p < ST_BIQUAD_CASCADE_MAX_POLES; p++)
+      {
+         z1[p][j] = StBiquadCascadeSample(0);
+         z2[p][j] = StBiquadCascadeSample(0);
+      }
+   }
+}
+
+void StBiquadCascade::shuffleCoeff(void) {
+   for(unsigned int j = 0u; j < 2u; j++)
+   {
+      cur[0][j] = StBiquadCascadeSample(next[j].a0);
+      cur[1][j] = StBiquadCascadeSample(next[j].a1);
+      cur[2][j] = StBiquadCascadeSample(next[j].a2);
+      cur[3][j] = StBiquadCascadeSample(next[j].b1);
+      cur[4][j] = StBiquadCascadeSample(next[j].b2);
+   }
+}
+
+void StBiquadCascade::calcStep(unsigned int _blkSz) {
+   for(unsigned int j = 0u; j < 2u; j++)
+   {
+      step[0][j] = (StBiquadCascadeSample(next[j].a0) - cur[0][j]) / _blkSz;
+      step[1][j] = (StBiquadCascadeSample(next[j].a1) - cur[1][j]) / _blkSz;
+      step[2][j] = (StBiquadCascadeSample(next[j].a2) - cur[2][j]) / _blkSz;
+      step[3][j] = (StBiquadCascadeSample(next[j].b1) - cur[3][j]) / _blkSz;
+      step[4][j] = (StBiquadCascadeSample(next[j].b2) - cur[4][j]) / _blkSz;
+   }
+}
+
+#ifdef ST_BIQUAD_CASCADE_SSE2
+// L/R lane pair operations (double: __m128d, float: lower half of __m128)
+template <typename T> struct StBiquadLanes;
+
+template <> struct StBiquadLanes<double> {
+   typedef __m128d vec_t;
+   static inline vec_t load   (const double *_s)       { return _mm_loadu_pd(_s); }
+   static inline void  store  (double *_d, vec_t _v)   { _mm_storeu_pd(_d, _v); }
+   static inline vec_t add    (vec_t _a, vec_t _b)     { return _mm_add_pd(_a, _b); }
+   static inline vec_t sub    (vec_t _a, vec_t _b)     { return _mm_sub_pd(_a, _b); }
+   static inline vec_t mul    (vec_t _a, vec_t _b)     { return _mm_mul_pd(_a, _b); }
+   static inline vec_t fromPS (__m128 _v)              { return _mm_cvtps_pd(_v); }
+   static inline __m128 toPS  (vec_t _v)               { return _mm_cvtpd_ps(_v); }
+};
+
+template <> struct StBiquadLanes<float> {
+   typedef __m128 vec_t;
+   static inline vec_t load   (const float *_s)        { return _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)_s); }
+   static inline void  store  (float *_d, vec_t _v)    { _mm_storel_pi((__m64*)_d, _v); }
+   static inline vec_t add    (vec_t _a, vec_t _b)     { return _mm_add_ps(_a, _b); }
+   static inline vec_t sub    (vec_t _a, vec_t _b)     { return _mm_sub_ps(_a, _b); }
+   static inline vec_t mul    (vec_t _a, vec_t _b)     { return _mm_mul_ps(_a, _b); }
+   static inline vec_t fromPS (__m128 _v)              { return _v; }
+   static inline __m128 toPS  (vec_t _v)               { return _v; }
+};
+
+template <unsigned int NP>
+static void loc_process_stereo(StBiquadCascade *_c,
+                               const float     *_samplesIn,
+                               float           *_samplesOut,
+                               unsigned int     _numFrames,
+                               float           &_driveCur,
+                               const float      _driveInc,
+                               float           &_dryWetCur,
+                               const float      _dryWetInc
+                               ) {
+   typedef StBiquadLanes<StBiquadCascadeSample> L;
+   typedef L::vec_t vec_t;
+
+   vec_t a0 = L::load(_c->cur[0]);  vec_t sa0 = L::load(_c->step[0]);
+   vec_t a1 = L::load(_c->cur[1]);  vec_t sa1 = L::load(_c->step[1]);
+   vec_t a2 = L::load(_c->cur[2]);  vec_t sa2 = L::load(_c->step[2]);
+   vec_t b1 = L::load(_c->cur[3]);  vec_t sb1 = L::load(_c->step[3]);
+   vec_t b2 = L::load(_c->cur[4]);  vec_t sb2 = L::load(_c->step[4]);
+
+   vec_t z1[NP];
+   vec_t z2[NP];
+   for(unsigned int p = 0u; p < NP; p++)
+   {
+      z1[p] = L::load(_c->z1[p]);
+      z2[p] = L::load(_c->z2[p]);
+   }
+
+   const __m128 denorm = _mm_set1_ps(10.0f);  // see Dstplugin_fix_denorm_32()
+   float driveCur  = _driveCur;
+   float dryWetCur = _dryWetCur;
+   unsigned int k = 0u;
+
+   for(unsigned int i = 0u; i < _numFrames; i++)
+   {
+      __m128 in = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(_samplesIn + k));
+      __m128 x32 = _mm_mul_ps(in, _mm_set1_ps(driveCur));
+
+      for(unsigned int p = 0u; p < NP; p++)
+      {
+         vec_t x = L::fromPS(x32);
+         vec_t out = L::add(L::mul(x, a0), z1[p]);
+         z1[p] = L::sub(L::add(L::mul(x, a1), z2[p]), L::mul(b1, out));
+         z2[p] = L::sub(L::mul(x, a2), L::mul(b2, out));
+         x32 = _mm_sub_ps(_mm_add_ps(L::toPS(out), denorm), denorm);
+      }
+
+      a0 = L::add(a0, sa0);
+      a1 = L::add(a1, sa1);
+      a2 = L::add(a2, sa2);
+      b1 = L::add(b1, sb1);
+      b2 = L::add(b2, sb2);
+
+      __m128 out = _mm_add_ps(in, _mm_mul_ps(_mm_sub_ps(x32, in), _mm_set1_ps(dryWetCur)));
+      _mm_storel_pi((__m64*)(_samplesOut + k), out);
+
+      // Next frame
+      k += 2u;
+      driveCur  += _driveInc;
+      dryWetCur += _dryWetInc;
+   }
+
+   L::store(_c->cur[0], a0);
+   L::store(_c->cur[1], a1);
+   L::store(_c->cur[2], a2);
+   L::store(_c->cur[3], b1);
+   L::store(_c->cur[4], b2);
+
+   for(unsigned int p = 0u; p < NP; p++)
+   {
+      L::store(_c->z1[p], z1[p]);
+      L::store(_c->z2[p], z2[p]);
+   }
+
+   _driveCur  = driveCur;
+   _dryWetCur = dryWetCur;
+}
+#else
+template <unsigned int NP>
+static void loc_process_stereo(StBiquadCascade *_c,
+                               const float     *_samplesIn,
+                               float           *_samplesOut,
+                               unsigned int     _numFrames,
+                               float           &_driveCur,
+                               const float      _driveInc,
+                               float           &_dryWetCur,
+                               const float      _dryWetInc
+                               ) {
+   typedef StBiquadCascadeSample T;
+
+   float driveCur  = _driveCur;
+   float dryWetCur = _dryWetCur;
+   unsigned int k = 0u;
+
+   for(unsigned int i = 0u; i < _numFrames; i++)
+   {
+      for(unsigned int j = 0u; j < 2u; j++)
+      {
+         float in = _samplesIn[k + j];
+         float x32 = in * driveCur;
 
+         for(unsigned int p = 0u; p < NP; p++)
+         {
+            T x = T(x32);
+            T out = x * _c->cur[0][j] + _c->z1[p][j];
+            _c->z1[p][j] = x * _c->cur[1][j] + _c->z2[p][j] - _c->cur[3][j] * out;
+            _c->z2[p][j] = x * _c->cur[2][j] - _c->cur[4][j] * out;
+            x32 = float(out);
+            x32 = Dstplugin_fix_denorm_32(x32);
+         }
+
+         for(unsigned int c = 0u; c < 5u; c++)
+            _c->cur[c][j] += _c->step[c][j];
+
+         _samplesOut[k + j] = in + (x32 - in) * dryWetCur;
+      }
+
+      // Next frame
+      k += 2u;
+      driveCur  += _driveInc;
+      dryWetCur += _dryWetInc;
+   }
+
+   _driveCur  = driveCur;
+   _dryWetCur = dryWetCur;
+}
+#endif // ST_BIQUAD_CASCADE_SSE2
+
+void StBiquadCascade::processStereo(unsigned int  _numPoles,
+                                    const float  *_samplesIn,
+                                    float        *_samplesOut,
+                                    unsigned int  _numFrames,
+                                    float        &_driveCur,
+                                    const float   _driveInc,
+                                    float        &_dryWetCur,
+                                    const float   _dryWetInc
+                                    ) {
+   switch(_numPoles)
+   {
+      default:
+      case 1u: loc_process_stereo<1u>(this, _samplesIn, _samplesOut, _numFrames, _driveCur, _driveInc, _dryWetCur, _dryWetInc); break;
+      case 2u: loc_process_stereo<2u>(this, _samplesIn, _samplesOut, _numFrames, _driveCur, _driveInc, _dryWetCur, _dryWetInc); break;
+      case 3u: loc_process_stereo<3u>(this, _samplesIn, _samplesOut, _numFrames, _driveCur, _driveInc, _dryWetCur, _dryWetInc); break;
+      case 4u: loc_process_stereo<4u>(this, _samplesIn, _samplesOut, _numFrames, _driveCur, _driveInc, _dryWetCur, _dryWetInc); break;
+   }
 }
@@ -4,7 +4,7 @@
 // ---- info   : biquad filter
 // ----
 // ---- created: 21May2020
-// ---- changed: 25May2020
+// ---- changed: 25May2020, 17Oct2026
 // ----
 // ----
 // ----
@@ -30,6 +30,18 @@
 #ifndef __ST_BIQUAD_H__
 #define __ST_BIQUAD_H__
 
+// (note) define ST_BIQUAD_CASCADE_32 (e.g. CPPFLAGS+=-DST_BIQUAD_CASCADE_32) to build StBiquadCascade with
+//         single precision filter state / coefficient ramps (default: double precision, same as StBiquad)
+// (note) single precision is ~25% faster but the coefficients of very low cutoff frequencies / high resonances
+//         are not accurately representable (the cascade's gain / resonance deviates from the double precision build)
+#ifdef ST_BIQUAD_CASCADE_32
+typedef float  StBiquadCascadeSample;
+#else
+typedef double StBiquadCascadeSample;
+#endif
+
+#define ST_BIQUAD_CASCADE_MAX_POLES  (4u)
+
 
 struct StBiquadCoeff {
 
@@ -40,12 +52,30 @@ struct StBiquadCoeff {
       a1 = a2 = b1 = b2 = 0.0;
    }
 
+   // table-driven coefficient design (shared tan / gain tables, see biquad.cpp)
+   //  (note) max. coefficient error vs. calcParamsExact() is < 2e-7 (relative to the largest coefficient magnitude)
+   //  (note) define ST_BIQUAD_COEFF_EXACT to make calcParams() use the closed form
    void calcParams (int          _type,
                     float        _dbGain,
                     float        _freq,   // 0..1
                     float        _res     // 0..1
                     );
 
+   // closed form (tan(), pow(), sqrt())
+   void calcParamsExact (int          _type,
+                         float        _dbGain,
+                         float        _freq,   // 0..1
+                         float        _res     // 0..1
+                         );
+
+   void calcParamsKV (int    _type,
+                      bool   _bBoost,
+                      double K,        // tan(PI*Fc)
+                      double V,        // 10^(|dbGain|/20)
+                      double _sqrt2V,  // sqrt(2*V)
+                      double Q
+                      );
+
    void lerp (const StBiquadCoeff &a, const StBiquadCoeff &b, const float t) {
       a0 = a.a0 + (b.a0 - a.a0) * t;
       a1 = a.a1 + (b.a1 - a.a1) * t;
@@ -136,5 +166,69 @@ struct StBiquad {
 
 };
 
+// Stereo cascade of 1..ST_BIQUAD_CASCADE_MAX_POLES identical biquad sections (e.g. 4 poles = 48dB/oct LPF)
+//  - all poles of a channel share the same coefficients, i.e. calcParams() runs once per channel and block
+//     (or just once when the left and right channel frequencies are equal)
+//  - coefficients are linearly interpolated over the block (same as StBiquad)
+//  - left / right channels are processed in two SIMD lanes (SSE2, scalar fallback on other architectures)
+struct StBiquadCascade {
+
+   // lane 0 = left channel, lane 1 = right channel
+   StBiquadCascadeSample cur [5][2];  // a0, a1, a2, b1, b2
+   StBiquadCascadeSample step[5][2];
+   StBiquadCascadeSample z1[ST_BIQUAD_CASCADE_MAX_POLES][2];
+   StBiquadCascadeSample z2[ST_BIQUAD_CASCADE_MAX_POLES][2];
+
+   StBiquadCoeff next[2];  // target coefficients (end of block)
+
+   void reset (void);
+
+   void shuffleCoeff (void);
+   void calcStep (unsigned int _blkSz);
+
+   inline void calcParams (unsigned int _blkSz,
+                           int          _type,
+                           float        _dbGain,
+                           float        _freqL,  // 0..1
+                           float        _freqR,  // 0..1
+                           float        _res     // 0..1
+                           ) {
+      shuffleCoeff();
+
+      next[0].calcParams(_type, _dbGain, _freqL, _res);
+
+      if(_freqR == _freqL)
+         next[1] = next[0];
+      else
+         next[1].calcParams(_type, _dbGain, _freqR, _res);
+
+      calcStep(_blkSz);
+   }
+
+   // Use precalculated target coefficients (e.g. mixed filter types, or coefficients of another voice)
+   inline void setParams (unsigned int         _blkSz,
+                          const StBiquadCoeff &_nextL,
+                          const StBiquadCoeff &_nextR
+                          ) {
+      shuffleCoeff();
+      next[0] = _nextL;
+      next[1] = _nextR;
+      calcStep(_blkSz);
+   }
+
+   // Filter interleaved stereo sample frames through '_numPoles' sections ('_samplesOut' may be the same as '_samplesIn')
+   //   out = in + (cascade(in * drive) - in) * dryWet
+   //  - 'drive' and 'dryWet' are interpolated per sample frame (cur += inc), the final values are written back
+   void processStereo (unsigned int  _numPoles,
+                       const float  *_samplesIn,
+                       float        *_samplesOut,
+                       unsigned int  _numFrames,
+                       float        &_driveCur,
+                       const float   _driveInc,
+                       float        &_dryWetCur,
+                       const float   _dryWetInc
+                       );
+};
+
 
 #endif // __ST_BIQUAD_H__
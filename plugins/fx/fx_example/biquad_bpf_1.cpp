@@ -8,7 +8,7 @@
 // ---- info   : a biquad band pass filter that supports per-sample-frame parameter interpolation
 // ----
 // ---- created: 21May2020
-// ---- changed: 24May2020, 31May2020, 08Jun2020, 21Jan2024
+// ---- changed: 24May2020, 31May2020, 08Jun2020, 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -66,14 +66,13 @@ typedef struct biquad_bpf_1_shared_s {
 
 typedef struct biquad_bpf_1_voice_s {
    st_plugin_voice_t base;
-   float    sample_rate;
-   float    mods[NUM_MODS];
-   float    mod_drywet_cur;
-   float    mod_drywet_inc;
-   float    mod_drive_cur;
-   float    mod_drive_inc;
-   StBiquad bpf_1_l;
-   StBiquad bpf_1_r;
+   float           sample_rate;
+   float           mods[NUM_MODS];
+   float           mod_drywet_cur;
+   float           mod_drywet_inc;
+   float           mod_drive_cur;
+   float           mod_drive_inc;
+   StBiquadCascade bpf;
 } biquad_bpf_1_voice_t;
 
 
@@ -133,8 +132,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
    {
       memset((void*)voice->mods, 0, sizeof(voice->mods));
 
-      voice->bpf_1_l.reset();
-      voice->bpf_1_r.reset();
+      voice->bpf.reset();
    }
 }
 
@@ -198,19 +196,13 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
       _numFrames = 1u;
    }
 
-   voice->bpf_1_l.calcParams(_numFrames,
-                             StBiquad::BPF,
-                             0.0f/*gainDB*/,
-                             modFreqL,
-                             modQ
-                             );
-
-   voice->bpf_1_r.calcParams(_numFrames,
-                             StBiquad::BPF,
-                             0.0f/*gainDB*/,
-                             modFreqR,
-                             modQ
-                             );
+   voice->bpf.calcParams(_numFrames,
+                         StBiquad::BPF,
+                         0.0f/*gainDB*/,
+                         modFreqL,
+                         modFreqR,
+                         modQ
+                         );
 }
 
 static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
@@ -223,30 +215,20 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
    ST_PLUGIN_VOICE_CAST(biquad_bpf_1_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(biquad_bpf_1_shared_t);
 
-   unsigned int k = 0u;
-
    // Stereo input, stereo output
-   for(unsigned int i = 0u; i < _numFrames; i++)
-   {
-      float l = _samplesIn[k];
-      float r = _samplesIn[k + 1u];
-      float outL = voice->bpf_1_l.filter(l * voice->mod_drive_cur);
-      float outR = voice->bpf_1_r.filter(r * voice->mod_drive_cur);
-      outL = l + (outL - l) * voice->mod_drywet_cur;
-      outR = r + (outR - r) * voice->mod_drywet_cur;
-      _samplesOut[k]      = outL;
-      _samplesOut[k + 1u] = outR;
-
-      // Next frame
-      k += 2u;
-      voice->mod_drywet_cur += voice->mod_drywet_inc;
-      voice->mod_drive_cur  += voice->mod_drive_inc;
-   }
-
+   voice->bpf.processStereo(1u/*numPoles*/,
+                            _samplesIn,
+                            _samplesOut,
+                            _numFrames,
+                            voice->mod_drive_cur,
+                            voice->mod_drive_inc,
+                            voice->mod_drywet_cur,
+                            voice->mod_drywet_inc
+                            );
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   biquad_bpf_1_shared_t *ret = (biquad_bpf_1_shared_t *)malloc(sizeof(biquad_bpf_1_shared_t));
+   biquad_bpf_1_shared_t *ret = (biquad_bpf_1_shared_t *)Dstplugin_alloc(_info, sizeof(biquad_bpf_1_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -257,12 +239,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   biquad_bpf_1_voice_t *ret = (biquad_bpf_1_voice_t *)malloc(sizeof(biquad_bpf_1_voice_t));
+   biquad_bpf_1_voice_t *ret = (biquad_bpf_1_voice_t *)Dstplugin_alloc(_info, sizeof(biquad_bpf_1_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -271,8 +253,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(biquad_bpf_1_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -303,6 +291,7 @@ st_plugin_info_t *biquad_bpf_1_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
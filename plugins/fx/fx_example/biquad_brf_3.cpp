@@ -8,7 +8,7 @@
 // ---- info   : a biquad band reject filter that supports per-sample-frame parameter interpolation
 // ----
 // ---- created: 21May2020
-// ---- changed: 24May2020, 31May2020, 08Jun2020, 21Jan2024
+// ---- changed: 24May2020, 31May2020, 08Jun2020, 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -68,14 +68,13 @@ typedef struct biquad_brf_3_shared_s {
 
 typedef struct biquad_brf_3_voice_s {
    st_plugin_voice_t base;
-   float    sample_rate;
-   float    mods[NUM_MODS];
-   float    mod_drywet_cur;
-   float    mod_drywet_inc;
-   float    mod_drive_cur;
-   float    mod_drive_inc;
-   StBiquad brf_l[NUM_POLES];
-   StBiquad brf_r[NUM_POLES];
+   float           sample_rate;
+   float           mods[NUM_MODS];
+   float           mod_drywet_cur;
+   float           mod_drywet_inc;
+   float           mod_drive_cur;
+   float           mod_drive_inc;
+   StBiquadCascade brf;
 } biquad_brf_3_voice_t;
 
 
@@ -135,11 +134,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
    {
       memset((void*)voice->mods, 0, sizeof(voice->mods));
 
-      for(unsigned int i = 0u; i < NUM_POLES; i++)
-      {
-         voice->brf_l[i].reset();
-         voice->brf_r[i].reset();
-      }
+      voice->brf.reset();
    }
 }
 
@@ -203,22 +198,13 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
       _numFrames = 1u;
    }
 
-   for(unsigned int i = 0u; i < NUM_POLES; i++)
-   {
-      voice->brf_l[i].calcParams(_numFrames,
-                                 StBiquad::BRF,
-                                 0.0f/*gainDB*/,
-                                 modFreqL,
-                                 modQ
-                                 );
-
-      voice->brf_r[i].calcParams(_numFrames,
-                                 StBiquad::BRF,
-                                 0.0f/*gainDB*/,
-                                 modFreqR,
-                                 modQ
-                                 );
-   }
+   voice->brf.calcParams(_numFrames,
+                         StBiquad::BRF,
+                         0.0f/*gainDB*/,
+                         modFreqL,
+                         modFreqR,
+                         modQ
+                         );
 
 }
 
@@ -232,35 +218,20 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
    ST_PLUGIN_VOICE_CAST(biquad_brf_3_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(biquad_brf_3_shared_t);
 
-   unsigned int k = 0u;
-
    // Stereo input, stereo output
-   for(unsigned int i = 0u; i < _numFrames; i++)
-   {
-      float l = _samplesIn[k];
-      float r = _samplesIn[k + 1u];
-      float outL = l * voice->mod_drive_cur;
-      float outR = r * voice->mod_drive_cur;
-      for(unsigned int i = 0u; i < NUM_POLES; i++)
-      {
-         outL = voice->brf_l[i].filter(outL);
-         outR = voice->brf_r[i].filter(outR);
-      }
-      outL = l + (outL - l) * voice->mod_drywet_cur;
-      outR = r + (outR - r) * voice->mod_drywet_cur;
-      _samplesOut[k]      = outL;
-      _samplesOut[k + 1u] = outR;
-
-      // Next frame
-      k += 2u;
-      voice->mod_drywet_cur += voice->mod_drywet_inc;
-      voice->mod_drive_cur  += voice->mod_drive_inc;
-   }
-
+   voice->brf.processStereo(NUM_POLES,
+                            _samplesIn,
+                            _samplesOut,
+                            _numFrames,
+                            voice->mod_drive_cur,
+                            voice->mod_drive_inc,
+                            voice->mod_drywet_cur,
+                            voice->mod_drywet_inc
+                            );
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   biquad_brf_3_shared_t *ret = (biquad_brf_3_shared_t *)malloc(sizeof(biquad_brf_3_shared_t));
+   biquad_brf_3_shared_t *ret = (biquad_brf_3_shared_t *)Dstplugin_alloc(_info, sizeof(biquad_brf_3_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -271,12 +242,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   biquad_brf_3_voice_t *ret = (biquad_brf_3_voice_t *)malloc(sizeof(biquad_brf_3_voice_t));
+   biquad_brf_3_voice_t *ret = (biquad_brf_3_voice_t *)Dstplugin_alloc(_info, sizeof(biquad_brf_3_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -285,8 +256,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(biquad_brf_3_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -317,6 +294,7 @@ st_plugin_info_t *biquad_brf_3_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -8,7 +8,7 @@
 // ---- info   : a biquad low shelf filter that supports per-sample-frame parameter interpolation
 // ----
 // ---- created: 21May2020
-// ---- changed: 24May2020, 08Jun2020, 21Jan2024
+// ---- changed: 24May2020, 08Jun2020, 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -71,14 +71,13 @@ typedef struct biquad_hsh_4_shared_s {
 
 typedef struct biquad_hsh_4_voice_s {
    st_plugin_voice_t base;
-   float    sample_rate;
-   float    mods[NUM_MODS];
-   float    mod_drywet_cur;
-   float    mod_drywet_inc;
-   float    mod_drive_cur;
-   float    mod_drive_inc;
-   StBiquad hsh_l[NUM_POLES];
-   StBiquad hsh_r[NUM_POLES];
+   float           sample_rate;
+   float           mods[NUM_MODS];
+   float           mod_drywet_cur;
+   float           mod_drywet_inc;
+   float           mod_drive_cur;
+   float           mod_drive_inc;
+   StBiquadCascade hsh;
 } biquad_hsh_4_voice_t;
 
 
@@ -138,11 +137,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
    {
       memset((void*)voice->mods, 0, sizeof(voice->mods));
 
-      for(unsigned int i = 0u; i < NUM_POLES; i++)
-      {
-         voice->hsh_l[i].reset();
-         voice->hsh_r[i].reset();
-      }
+      voice->hsh.reset();
    }
 }
 
@@ -214,22 +209,13 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    }
 
    
-   for(unsigned int i = 0u; i < NUM_POLES; i++)
-   {
-      voice->hsh_l[i].calcParams(_numFrames,
-                                 StBiquad::HSH,
-                                 modGain,
-                                 modFreqL,
-                                 0.0f/*q*/
-                                 );
-
-      voice->hsh_r[i].calcParams(_numFrames,
-                                 StBiquad::HSH,
-                                 modGain,
-                                 modFreqR,
-                                 0.0f/*q*/
-                                 );
-   }
+   voice->hsh.calcParams(_numFrames,
+                         StBiquad::HSH,
+                         modGain,
+                         modFreqL,
+                         modFreqR,
+                         0.0f/*q*/
+                         );
 }
 
 static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
@@ -242,35 +228,20 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
    ST_PLUGIN_VOICE_CAST(biquad_hsh_4_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(biquad_hsh_4_shared_t);
 
-   unsigned int k = 0u;
-
    // Stereo input, stereo output
-   for(unsigned int i = 0u; i < _numFrames; i++)
-   {
-      float l = _samplesIn[k];
-      float r = _samplesIn[k + 1u];
-      float outL = l * voice->mod_drive_cur;
-      float outR = r * voice->mod_drive_cur;
-      for(unsigned int i = 0u; i < NUM_POLES; i++)
-      {
-         outL = voice->hsh_l[i].filter(outL);
-         outR = voice->hsh_l[i].filter(outR);
-      }
-      outL = l + (outL - l) * voice->mod_drywet_cur;
-      outR = r + (outR - r) * voice->mod_drywet_cur;
-      _samplesOut[k]      = outL;
-      _samplesOut[k + 1u] = outR;
-
-      // Next frame
-      k += 2u;
-      voice->mod_drywet_cur += voice->mod_drywet_inc;
-      voice->mod_drive_cur  += voice->mod_drive_inc;
-   }
-
+   voice->hsh.processStereo(NUM_POLES,
+                            _samplesIn,
+                            _samplesOut,
+                            _numFrames,
+                            voice->mod_drive_cur,
+                            voice->mod_drive_inc,
+                            voice->mod_drywet_cur,
+                            voice->mod_drywet_inc
+                            );
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   biquad_hsh_4_shared_t *ret = (biquad_hsh_4_shared_t *)malloc(sizeof(biquad_hsh_4_shared_t));
+   biquad_hsh_4_shared_t *ret = (biquad_hsh_4_shared_t *)Dstplugin_alloc(_info, sizeof(biquad_hsh_4_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -281,12 +252,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   biquad_hsh_4_voice_t *ret = (biquad_hsh_4_voice_t *)malloc(sizeof(biquad_hsh_4_voice_t));
+   biquad_hsh_4_voice_t *ret = (biquad_hsh_4_voice_t *)Dstplugin_alloc(_info, sizeof(biquad_hsh_4_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -295,8 +266,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(biquad_hsh_4_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -327,6 +304,7 @@ st_plugin_info_t *biquad_hsh_4_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
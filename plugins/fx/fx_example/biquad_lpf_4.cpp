@@ -8,7 +8,7 @@
 // ---- info   : a biquad low pass filter that supports per-sample-frame parameter interpolation
 // ----
 // ---- created: 21May2020
-// ---- changed: 24May2020, 31May2020, 08Jun2020, 21Jan2024
+// ---- changed: 24May2020, 31May2020, 08Jun2020, 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -68,14 +68,13 @@ typedef struct biquad_lpf_4_shared_s {
 
 typedef struct biquad_lpf_4_voice_s {
    st_plugin_voice_t base;
-   float    sample_rate;
-   float    mods[NUM_MODS];
-   float    mod_drywet_cur;
-   float    mod_drywet_inc;
-   float    mod_drive_cur;
-   float    mod_drive_inc;
-   StBiquad lpf_l[NUM_POLES];
-   StBiquad lpf_r[NUM_POLES];
+   float           sample_rate;
+   float           mods[NUM_MODS];
+   float           mod_drywet_cur;
+   float           mod_drywet_inc;
+   float           mod_drive_cur;
+   float           mod_drive_inc;
+   StBiquadCascade lpf;
 } biquad_lpf_4_voice_t;
 
 
@@ -135,11 +134,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
    {
       memset((void*)voice->mods, 0, sizeof(voice->mods));
 
-      for(unsigned int i = 0u; i < NUM_POLES; i++)
-      {
-         voice->lpf_l[i].reset();
-         voice->lpf_r[i].reset();
-      }
+      voice->lpf.reset();
    }
 }
 
@@ -153,26 +148,23 @@ static void ST_PLUGIN_API loc_set_mod_value(st_plugin_voice_t *_voice,
    voice->mods[_modIdx] = _value;
 }
 
-static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
-                                            unsigned int       _numFrames,
-                                            float              _freqHz,
-                                            float              _note,
-                                            float              _vol,
-                                            float              _pan
-                                            ) {
-   ST_PLUGIN_VOICE_CAST(biquad_lpf_4_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(biquad_lpf_4_shared_t);
-   (void)_freqHz;
-   (void)_note;
-   (void)_vol;
-   (void)_pan;
+static float loc_calc_drive(const biquad_lpf_4_shared_t *shared) {
+   // (note) not modulated, i.e. the same for all voices
+   float modDrive = ((shared->params[PARAM_DRIVE] - 0.5f) * 2.0f);
+   return powf(10.0f, modDrive * 2.0f);
+}
+
+static void loc_prepare_voice(biquad_lpf_4_voice_t        *voice,
+                              const biquad_lpf_4_shared_t *shared,
+                              unsigned int                 _numFrames,
+                              float                        modDrive,
+                              const biquad_lpf_4_voice_t  *_coeffVoice
+                              ) {
+   // '_coeffVoice' is an (already prepared) voice whose target coefficients may be reused (or NULL)
 
    float modDryWet = shared->params[PARAM_DRYWET]   + voice->mods[MOD_DRYWET];
    modDryWet = Dstplugin_clamp(modDryWet, 0.0f, 1.0f);
 
-   float modDrive = ((shared->params[PARAM_DRIVE] - 0.5f) * 2.0f);
-   modDrive = powf(10.0f, modDrive * 2.0f);
-
    float modFreq = shared->params[PARAM_FREQ] + voice->mods[MOD_FREQ];
    float modPan  = ((shared->params[PARAM_PAN] - 0.5f) * 2.0f) + voice->mods[MOD_PAN];
    float modFreqL = Dstplugin_clamp(modFreq - modPan, 0.0f, 1.0f);
@@ -203,23 +195,41 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
       _numFrames = 1u;
    }
 
-   for(unsigned int i = 0u; i < NUM_POLES; i++)
+   if(NULL != _coeffVoice                                &&
+      _coeffVoice->mods[MOD_FREQ] == voice->mods[MOD_FREQ] &&
+      _coeffVoice->mods[MOD_Q]    == voice->mods[MOD_Q]    &&
+      _coeffVoice->mods[MOD_PAN]  == voice->mods[MOD_PAN]
+      )
    {
-      voice->lpf_l[i].calcParams(_numFrames,
-                                 StBiquad::LPF,
-                                 0.0f/*gainDB*/,
-                                 modFreqL,
-                                 modQ
-                                 );
-
-      voice->lpf_r[i].calcParams(_numFrames,
-                                 StBiquad::LPF,
-                                 0.0f/*gainDB*/,
-                                 modFreqR,
-                                 modQ
-                                 );
+      // Same target frequency / resonance as previous voice (e.g. unmodulated) => skip calcParams()
+      voice->lpf.setParams(_numFrames, _coeffVoice->lpf.next[0], _coeffVoice->lpf.next[1]);
+      return;
    }
 
+   voice->lpf.calcParams(_numFrames,
+                         StBiquad::LPF,
+                         0.0f/*gainDB*/,
+                         modFreqL,
+                         modFreqR,
+                         modQ
+                         );
+}
+
+static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
+                                            unsigned int       _numFrames,
+                                            float              _freqHz,
+                                            float              _note,
+                                            float              _vol,
+                                            float              _pan
+                                            ) {
+   ST_PLUGIN_VOICE_CAST(biquad_lpf_4_voice_t);
+   ST_PLUGIN_VOICE_SHARED_CAST(biquad_lpf_4_shared_t);
+   (void)_freqHz;
+   (void)_note;
+   (void)_vol;
+   (void)_pan;
+
+   loc_prepare_voice(voice, shared, _numFrames, loc_calc_drive(shared), NULL/*coeffVoice*/);
 }
 
 static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
@@ -232,35 +242,46 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
    ST_PLUGIN_VOICE_CAST(biquad_lpf_4_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(biquad_lpf_4_shared_t);
 
-   unsigned int k = 0u;
-
    // Stereo input, stereo output
-   for(unsigned int i = 0u; i < _numFrames; i++)
+   voice->lpf.processStereo(NUM_POLES,
+                            _samplesIn,
+                            _samplesOut,
+                            _numFrames,
+                            voice->mod_drive_cur,
+                            voice->mod_drive_inc,
+                            voice->mod_drywet_cur,
+                            voice->mod_drywet_inc
+                            );
+}
+
+static void ST_PLUGIN_API loc_process_replace_voices(st_plugin_voice_block_t *_blocks,
+                                                     unsigned int             _numVoices,
+                                                     unsigned int             _numFrames
+                                                     ) {
+   if(0u == _numVoices)
+      return;
+
+   // Shared params are evaluated once per batch
+   biquad_lpf_4_shared_t *shared = (biquad_lpf_4_shared_t*)_blocks[0].voice->shared;
+   float modDrive = loc_calc_drive(shared);
+
+   const biquad_lpf_4_voice_t *coeffVoice = NULL;
+   for(unsigned int voiceIdx = 0u; voiceIdx < _numVoices; voiceIdx++)
    {
-      float l = _samplesIn[k];
-      float r = _samplesIn[k + 1u];
-      float outL = l * voice->mod_drive_cur;
-      float outR = r * voice->mod_drive_cur;
-      for(unsigned int i = 0u; i < NUM_POLES; i++)
-      {
-         outL = voice->lpf_l[i].filter(outL);
-         outR = voice->lpf_r[i].filter(outR);
-      }
-      outL = l + (outL - l) * voice->mod_drywet_cur;
-      outR = r + (outR - r) * voice->mod_drywet_cur;
-      _samplesOut[k]      = outL;
-      _samplesOut[k + 1u] = outR;
-
-      // Next frame
-      k += 2u;
-      voice->mod_drywet_cur += voice->mod_drywet_inc;
-      voice->mod_drive_cur  += voice->mod_drive_inc;
+      biquad_lpf_4_voice_t *voice = (biquad_lpf_4_voice_t*)_blocks[voiceIdx].voice;
+      loc_prepare_voice(voice, shared, _numFrames, modDrive, coeffVoice);
+      coeffVoice = voice;
    }
 
+   for(unsigned int voiceIdx = 0u; voiceIdx < _numVoices; voiceIdx++)
+   {
+      const st_plugin_voice_block_t *block = &_blocks[voiceIdx];
+      loc_process_replace(block->voice, block->b_mono_in, block->samples_in, block->samples_out, _numFrames);
+   }
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   biquad_lpf_4_shared_t *ret = (biquad_lpf_4_shared_t *)malloc(sizeof(biquad_lpf_4_shared_t));
+   biquad_lpf_4_shared_t *ret = (biquad_lpf_4_shared_t *)Dstplugin_alloc(_info, sizeof(biquad_lpf_4_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -271,12 +292,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   biquad_lpf_4_voice_t *ret = (biquad_lpf_4_voice_t *)malloc(sizeof(biquad_lpf_4_voice_t));
+   biquad_lpf_4_voice_t *ret = (biquad_lpf_4_voice_t *)Dstplugin_alloc(_info, sizeof(biquad_lpf_4_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -285,8 +306,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(biquad_lpf_4_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -317,6 +344,7 @@ st_plugin_info_t *biquad_lpf_4_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -327,6 +355,7 @@ st_plugin_info_t *biquad_lpf_4_init(void) {
       ret->base.set_mod_value    = &loc_set_mod_value;
       ret->base.prepare_block    = &loc_prepare_block;
       ret->base.process_replace  = &loc_process_replace;
+      ret->base.process_replace_voices = &loc_process_replace_voices;
       ret->base.plugin_exit      = &loc_plugin_exit;
    }
 
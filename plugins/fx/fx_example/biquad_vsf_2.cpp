@@ -8,7 +8,7 @@
 // ---- info   : a biquad variable shape (sweepable multimode) filter that supports per-sample-frame parameter interpolation
 // ----
 // ---- created: 31May2020
-// ---- changed: 08Jun2020, 21Jan2024
+// ---- changed: 08Jun2020, 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -68,15 +68,14 @@ typedef struct biquad_vsf_2_shared_s {
 
 typedef struct biquad_vsf_2_voice_s {
    st_plugin_voice_t base;
-   float         sample_rate;
-   float         mods[NUM_MODS];
-   float         mod_drywet_cur;
-   float         mod_drywet_inc;
-   StBiquadCoeff coeff_lpf;
-   StBiquadCoeff coeff_bpf;
-   StBiquadCoeff coeff_hpf;
-   StBiquad      flt_l[NUM_POLES];
-   StBiquad      flt_r[NUM_POLES];
+   float           sample_rate;
+   float           mods[NUM_MODS];
+   float           mod_drywet_cur;
+   float           mod_drywet_inc;
+   StBiquadCoeff   coeff_lpf;
+   StBiquadCoeff   coeff_bpf;
+   StBiquadCoeff   coeff_hpf;
+   StBiquadCascade flt;
 
    void calcFltCoeff(StBiquadCoeff &d, float _shape, float _freq, float _q) {
 
@@ -166,11 +165,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
    {
       memset((void*)voice->mods, 0, sizeof(voice->mods));
 
-      for(unsigned int i = 0u; i < NUM_POLES; i++)
-      {
-         voice->flt_l[i].reset();
-         voice->flt_r[i].reset();
-      }
+      voice->flt.reset();
    }
 }
 
@@ -221,16 +216,6 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
       // lerp
       float recBlockSize = (1.0f / _numFrames);
       voice->mod_drywet_inc = (modDryWet - voice->mod_drywet_cur) * recBlockSize;
-
-      for(unsigned int i = 0u; i < NUM_POLES; i++)
-      {
-         voice->flt_l[i].shuffleCoeff();
-         voice->flt_r[i].shuffleCoeff();
-         voice->calcFltCoeff(voice->flt_l[i].next, modShape, modFreqL, modQ);
-         voice->calcFltCoeff(voice->flt_r[i].next, modShape, modFreqR, modQ);
-         voice->flt_l[i].calcStep(_numFrames);
-         voice->flt_r[i].calcStep(_numFrames);
-      }
    }
    else
    {
@@ -238,13 +223,19 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
       voice->mod_drywet_cur = modDryWet;
       voice->mod_drywet_inc = 0.0f;
 
-      for(unsigned int i = 0u; i < NUM_POLES; i++)
-      {
-         voice->calcFltCoeff(voice->flt_l[i].next, modShape, modFreqL, modQ);
-         voice->calcFltCoeff(voice->flt_r[i].next, modShape, modFreqR, modQ);
-      }
+      _numFrames = 1u;
    }
 
+   // (note) all poles share the same coefficients
+   StBiquadCoeff coeffL;
+   StBiquadCoeff coeffR;
+   voice->calcFltCoeff(coeffL, modShape, modFreqL, modQ);
+   if(modFreqR == modFreqL)
+      coeffR = coeffL;
+   else
+      voice->calcFltCoeff(coeffR, modShape, modFreqR, modQ);
+
+   voice->flt.setParams(_numFrames, coeffL, coeffR);
 }
 
 static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
@@ -257,34 +248,21 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
    ST_PLUGIN_VOICE_CAST(biquad_vsf_2_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(biquad_vsf_2_shared_t);
 
-   unsigned int k = 0u;
-
    // Stereo input, stereo output
-   for(unsigned int i = 0u; i < _numFrames; i++)
-   {
-      float l = _samplesIn[k];
-      float r = _samplesIn[k + 1u];
-      float outL = l;
-      float outR = r;
-      for(unsigned int i = 0u; i < NUM_POLES; i++)
-      {
-         outL = voice->flt_l[i].filter(outL);
-         outR = voice->flt_r[i].filter(outR);
-      }
-      outL = l + (outL - l) * voice->mod_drywet_cur;
-      outR = r + (outR - r) * voice->mod_drywet_cur;
-      _samplesOut[k]      = outL;
-      _samplesOut[k + 1u] = outR;
-
-      // Next frame
-      k += 2u;
-      voice->mod_drywet_cur += voice->mod_drywet_inc;
-   }
-
+   float drive = 1.0f;  // (note) no drive param
+   voice->flt.processStereo(NUM_POLES,
+                            _samplesIn,
+                            _samplesOut,
+                            _numFrames,
+                            drive,
+                            0.0f/*driveInc*/,
+                            voice->mod_drywet_cur,
+                            voice->mod_drywet_inc
+                            );
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   biquad_vsf_2_shared_t *ret = (biquad_vsf_2_shared_t *)malloc(sizeof(biquad_vsf_2_shared_t));
+   biquad_vsf_2_shared_t *ret = (biquad_vsf_2_shared_t *)Dstplugin_alloc(_info, sizeof(biquad_vsf_2_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -295,12 +273,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   biquad_vsf_2_voice_t *ret = (biquad_vsf_2_voice_t *)malloc(sizeof(biquad_vsf_2_voice_t));
+   biquad_vsf_2_voice_t *ret = (biquad_vsf_2_voice_t *)Dstplugin_alloc(_info, sizeof(biquad_vsf_2_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -309,8 +287,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(biquad_vsf_2_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -341,6 +325,7 @@ st_plugin_info_t *biquad_vsf_2_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -8,7 +8,7 @@
 // ---- info   : a bit crusher that supports per-sample-frame parameter interpolation
 // ----
 // ---- created: 20May2020
-// ---- changed: 21May2020, 24May2020, 25May2020, 31May2020, 08Jun2020, 21Jan2024, 19Sep2024
+// ---- changed: 21May2020, 24May2020, 25May2020, 31May2020, 08Jun2020, 21Jan2024, 19Sep2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -16,6 +16,11 @@
 #include <stdlib.h>
 #include <math.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define BITCRUSHER_SSE2  1
+#include <emmintrin.h>
+#endif
+
 #include "../../../plugin.h"
 
 #define PARAM_DRYWET    0
@@ -167,16 +172,47 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    voice->amp_bias = powf(10.0f, (ampBias - 0.5f) * 4.0f);
 }
 
+#ifdef BITCRUSHER_SSE2
+// Per-frame ramp values of 2 stereo frames (same float accumulation as the scalar loop)
+static inline __m128 loc_ramp2(float *_cur, const float _inc) {
+   const float c0 = *_cur;
+   const float c1 = c0 + _inc;
+   *_cur = c1 + _inc;
+   return _mm_setr_ps(c0, c0, c1, c1);
+}
+
+// Per-frame ramp values of 4 mono frames
+static inline __m128 loc_ramp4(float *_cur, const float _inc) {
+   const float c0 = *_cur;
+   const float c1 = c0 + _inc;
+   const float c2 = c1 + _inc;
+   const float c3 = c2 + _inc;
+   *_cur = c3 + _inc;
+   return _mm_setr_ps(c0, c1, c2, c3);
+}
+
+static inline __m128 loc_crush4(const __m128 _in,
+                                const __m128 _bits,
+                                const __m128 _dryWet,
+                                const float  _ampBias,
+                                const float  _ampBiasR
+                                ) {
+   const __m128i i = _mm_cvttps_epi32(_mm_div_ps(_mm_mul_ps(_in, _mm_set1_ps(_ampBias)), _bits));
+   __m128 out = _mm_mul_ps(_mm_mul_ps(_mm_cvtepi32_ps(i), _bits), _mm_set1_ps(_ampBiasR));
+   out = _mm_add_ps(_in, _mm_mul_ps(_mm_sub_ps(out, _in), _dryWet));
+   return _mm_sub_ps(_mm_add_ps(out, _mm_set1_ps(10.0f)), _mm_set1_ps(10.0f));  // see Dstplugin_fix_denorm_32()
+}
+#endif // BITCRUSHER_SSE2
+
 static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
                                               int                 _bMonoIn,
                                               const float        *_samplesIn,
                                               float              *_samplesOut, 
                                               unsigned int        _numFrames
                                               ) {
-   // Ring modulate at (modulated) note frequency
    ST_PLUGIN_VOICE_CAST(bitcrusher_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(bitcrusher_shared_t);
 
+   unsigned int i = 0u;
    unsigned int k = 0u;
 
    float ampBias = voice->amp_bias;
@@ -185,7 +221,22 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
    if(_bMonoIn)
    {
       // Mono input, stereo output
-      for(unsigned int i = 0u; i < _numFrames; i++)
+#ifdef BITCRUSHER_SSE2
+      for(; (i + 4u) <= _numFrames; i += 4u, k += 8u)
+      {
+         const __m128 in0 = _mm_loadu_ps(_samplesIn + k);
+         const __m128 in1 = _mm_loadu_ps(_samplesIn + k + 4u);
+         const __m128 l = _mm_shuffle_ps(in0, in1, _MM_SHUFFLE(2,0,2,0));
+         const __m128 bits   = loc_ramp4(&voice->mod_bits_cur,   voice->mod_bits_inc);
+         const __m128 dryWet = loc_ramp4(&voice->mod_drywet_cur, voice->mod_drywet_inc);
+         const __m128 out = loc_crush4(l, bits, dryWet, ampBias, ampBiasR);
+         _mm_storeu_ps(_samplesOut + k,      _mm_unpacklo_ps(out, out));
+         _mm_storeu_ps(_samplesOut + k + 4u, _mm_unpackhi_ps(out, out));
+      }
+#endif // BITCRUSHER_SSE2
+
+      // Remaining frames (or all frames when SSE2 is not available)
+      for(; i < _numFrames; i++)
       {
          float l = _samplesIn[k];
          int il = (int)((l * ampBias) / voice->mod_bits_cur);
@@ -204,11 +255,21 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
    else
    {
       // Stereo input, stereo output
-      for(unsigned int i = 0u; i < _numFrames; i++)
+#ifdef BITCRUSHER_SSE2
+      for(; (i + 2u) <= _numFrames; i += 2u, k += 4u)
+      {
+         const __m128 bits   = loc_ramp2(&voice->mod_bits_cur,   voice->mod_bits_inc);
+         const __m128 dryWet = loc_ramp2(&voice->mod_drywet_cur, voice->mod_drywet_inc);
+         _mm_storeu_ps(_samplesOut + k, loc_crush4(_mm_loadu_ps(_samplesIn + k), bits, dryWet, ampBias, ampBiasR));
+      }
+#endif // BITCRUSHER_SSE2
+
+      // Remaining frame (or all frames when SSE2 is not available)
+      for(; i < _numFrames; i++)
       {
          float l = _samplesIn[k];
          int il = (int)((l * ampBias)  / voice->mod_bits_cur);
-         float outL = (il * voice->mod_bits_cur);
+         float outL = (il * voice->mod_bits_cur) * ampBiasR;
          outL = l + (outL - l) * voice->mod_drywet_cur;
          outL = Dstplugin_fix_denorm_32(outL);
 
@@ -230,7 +291,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   bitcrusher_shared_t *ret = malloc(sizeof(bitcrusher_shared_t));
+   bitcrusher_shared_t *ret = Dstplugin_alloc(_info, sizeof(bitcrusher_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -241,12 +302,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   bitcrusher_voice_t *ret = malloc(sizeof(bitcrusher_voice_t));
+   bitcrusher_voice_t *ret = Dstplugin_alloc(_info, sizeof(bitcrusher_voice_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -255,8 +316,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(bitcrusher_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free(_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -286,6 +353,7 @@ st_plugin_info_t *bitcrusher_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -8,7 +8,7 @@
 // ---- info   : a bit flipper with configurable resolution
 // ----
 // ---- created: 26May2020
-// ---- changed: 31May2020, 06Feb2023, 21Jan2024, 19Sep2024
+// ---- changed: 31May2020, 06Feb2023, 21Jan2024, 19Sep2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -17,10 +17,17 @@
 #include <string.h>
 #include <math.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define BITFLIPPER_SSE2  1
+#include <emmintrin.h>
+#endif
+
 #include "../../../plugin.h"
 
 #include "biquad.h"
 
+#define CHUNK_SIZE  (64u)  // process_replace() temp buffer (frames)
+
 #define PARAM_DRYWET    0
 #define PARAM_BITS      1
 #define PARAM_MASK      2
@@ -72,10 +79,7 @@ typedef struct bitflipper_voice_s {
    float mod_bits_inc;
    float mod_mask_cur;
    float mod_mask_inc;
-   StBiquad lpf_l_1;
-   StBiquad lpf_l_2;
-   StBiquad lpf_r_1;
-   StBiquad lpf_r_2;
+   StBiquadCascade lpf;  // 2 poles
 } bitflipper_voice_t;
 
 
@@ -127,10 +131,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
    if(!_bGlide)
    {
       memset((void*)voice->mods, 0, sizeof(voice->mods));
-      voice->lpf_l_1.reset();
-      voice->lpf_l_2.reset();
-      voice->lpf_r_1.reset();
-      voice->lpf_r_2.reset();
+      voice->lpf.reset();
    }
 }
 
@@ -197,141 +198,194 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    if(0 == _numFrames)
       _numFrames = 1u;
 
-   voice->lpf_l_1.calcParams(_numFrames,
-                             StBiquad::LPF,
-                             0.0f/*gainDB*/,
-                             modFreq,
-                             modQ
-                             );
-
-   voice->lpf_l_2.calcParams(_numFrames,
-                             StBiquad::LPF,
-                             0.0f/*gainDB*/,
-                             modFreq,
-                             modQ
-                             );
-
-   voice->lpf_r_1.calcParams(_numFrames,
-                             StBiquad::LPF,
-                             0.0f/*gainDB*/,
-                             modFreq,
-                             modQ
-                           );
-
-   voice->lpf_r_2.calcParams(_numFrames,
-                             StBiquad::LPF,
-                             0.0f/*gainDB*/,
-                             modFreq,
-                             modQ
-                             );
+   voice->lpf.calcParams(_numFrames,
+                         StBiquad::LPF,
+                         0.0f/*gainDB*/,
+                         modFreq,
+                         modFreq,
+                         modQ
+                         );
+}
+
+// Flip bits of the (sign / magnitude) integer sample
+static inline float loc_flip(const float _x, const float _bits, const int _mask) {
+   int ix = (int)(_x * _bits);
+   if(ix >= 0)
+      ix ^= _mask;
+   else
+   {
+      ix = -ix;
+      ix ^= _mask;
+      ix = -ix;
+   }
+   return (ix / _bits);
+}
+
+#ifdef BITFLIPPER_SSE2
+// Per-frame ramp values of 2 stereo frames (same float accumulation as the scalar loop)
+static inline __m128 loc_ramp2(float &_cur, const float _inc) {
+   const float c0 = _cur;
+   const float c1 = c0 + _inc;
+   _cur = c1 + _inc;
+   return _mm_setr_ps(c0, c0, c1, c1);
 }
 
+// Per-frame ramp values of 4 mono frames
+static inline __m128 loc_ramp4(float &_cur, const float _inc) {
+   const float c0 = _cur;
+   const float c1 = c0 + _inc;
+   const float c2 = c1 + _inc;
+   const float c3 = c2 + _inc;
+   _cur = c3 + _inc;
+   return _mm_setr_ps(c0, c1, c2, c3);
+}
+
+static inline __m128 loc_flip4(const __m128 _x, const __m128 _bits, const __m128 _mask) {
+   __m128i ix = _mm_cvttps_epi32(_mm_mul_ps(_x, _bits));
+   const __m128i sign = _mm_srai_epi32(ix, 31);             // 0 or -1
+   ix = _mm_sub_epi32(_mm_xor_si128(ix, sign), sign);       // abs
+   ix = _mm_xor_si128(ix, _mm_cvttps_epi32(_mask));
+   ix = _mm_sub_epi32(_mm_xor_si128(ix, sign), sign);       // restore sign
+   return _mm_div_ps(_mm_cvtepi32_ps(ix), _bits);
+}
+#endif // BITFLIPPER_SSE2
+
 static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
                                               int                 _bMonoIn,
                                               const float        *_samplesIn,
                                               float              *_samplesOut, 
                                               unsigned int        _numFrames
                                               ) {
-   // Ring modulate at (modulated) note frequency
    ST_PLUGIN_VOICE_CAST(bitflipper_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(bitflipper_shared_t);
 
-   unsigned int k = 0u;
+   float tmp[CHUNK_SIZE * 2u];
 
-   if(_bMonoIn)
+   unsigned int frameIdx = 0u;
+   while(frameIdx < _numFrames)
    {
-      // Mono input, stereo output
-      for(unsigned int i = 0u; i < _numFrames; i++)
+      unsigned int numChunkFrames = _numFrames - frameIdx;
+      if(numChunkFrames > CHUNK_SIZE)
+         numChunkFrames = CHUNK_SIZE;
+
+      const float *samplesIn  = _samplesIn  + 2u * frameIdx;
+      float       *samplesOut = _samplesOut + 2u * frameIdx;
+
+      unsigned int i = 0u;
+      unsigned int k = 0u;
+      float driveCur  = 1.0f;
+      float dryWetCur = 1.0f;
+
+      if(_bMonoIn)
       {
-         float l = _samplesIn[k];
-         // if(l > 1.0f)
-         //    l = 1.0f;
-         // else if(l < -1.0f)
-         //    l = -1.0f;
-         int il = (int)(l * voice->mod_bits_cur);
-         if(il >= 0)
+         // Mono input, stereo output (dry/wet, then LPF)
+#ifdef BITFLIPPER_SSE2
+         for(; (i + 4u) <= numChunkFrames; i += 4u, k += 8u)
          {
-            il ^= (int)(voice->mod_mask_cur);
+            const __m128 in0 = _mm_loadu_ps(samplesIn + k);
+            const __m128 in1 = _mm_loadu_ps(samplesIn + k + 4u);
+            const __m128 l = _mm_shuffle_ps(in0, in1, _MM_SHUFFLE(2,0,2,0));
+            const __m128 bits   = loc_ramp4(voice->mod_bits_cur,   voice->mod_bits_inc);
+            const __m128 mask   = loc_ramp4(voice->mod_mask_cur,   voice->mod_mask_inc);
+            const __m128 dryWet = loc_ramp4(voice->mod_drywet_cur, voice->mod_drywet_inc);
+            __m128 out = loc_flip4(l, bits, mask);
+            out = _mm_add_ps(l, _mm_mul_ps(_mm_sub_ps(out, l), dryWet));
+            _mm_storeu_ps(tmp + k,      _mm_unpacklo_ps(out, out));
+            _mm_storeu_ps(tmp + k + 4u, _mm_unpackhi_ps(out, out));
          }
-         else
+#endif // BITFLIPPER_SSE2
+
+         // Remaining frames (or all frames when SSE2 is not available)
+         for(; i < numChunkFrames; i++, k += 2u)
          {
-            il = -il;
-            il ^= (int)(voice->mod_mask_cur);
-            il = -il;
+            float l = samplesIn[k];
+            float out = loc_flip(l, voice->mod_bits_cur, (int)voice->mod_mask_cur);
+            out = l + (out - l) * voice->mod_drywet_cur;
+            tmp[k]      = out;
+            tmp[k + 1u] = out;
+
+            // Next frame
+            voice->mod_drywet_cur += voice->mod_drywet_inc;
+            voice->mod_bits_cur   += voice->mod_bits_inc;
+            voice->mod_mask_cur   += voice->mod_mask_inc;
          }
-         float out = (il / voice->mod_bits_cur);
-         out = l + (out - l) * voice->mod_drywet_cur;
-         out = voice->lpf_l_1.filter(out);
-         out = voice->lpf_l_2.filter(out);
-
-         _samplesOut[k]      = out;
-         _samplesOut[k + 1u] = out;
-
-         // Next frame
-         k += 2u;
-         voice->mod_drywet_cur += voice->mod_drywet_inc;
-         voice->mod_bits_cur   += voice->mod_bits_inc;
-         voice->mod_mask_cur   += voice->mod_mask_inc;
+
+         voice->lpf.processStereo(2u/*numPoles*/,
+                                  tmp,
+                                  samplesOut,
+                                  numChunkFrames,
+                                  driveCur,
+                                  0.0f/*driveInc*/,
+                                  dryWetCur,
+                                  0.0f/*dryWetInc*/
+                                  );
       }
-   }
-   else
-   {
-      // Stereo input, stereo output
-      for(unsigned int i = 0u; i < _numFrames; i++)
+      else
       {
-         float l = _samplesIn[k];
-         // if(l > 1.0f)
-         //    l = 1.0f;
-         // else if(l < -1.0f)
-         //    l = -1.0f;
-         int il = (int)(l * voice->mod_bits_cur);
-         if(il >= 0)
-            il ^= (int)(voice->mod_mask_cur);
-         else
+         // Stereo input, stereo output (LPF, then dry/wet)
+         const float dryWetStart = voice->mod_drywet_cur;
+
+#ifdef BITFLIPPER_SSE2
+         for(; (i + 2u) <= numChunkFrames; i += 2u, k += 4u)
          {
-            il = -il;
-            il ^= (int)(voice->mod_mask_cur);
-            il = -il;
+            const __m128 bits = loc_ramp2(voice->mod_bits_cur, voice->mod_bits_inc);
+            const __m128 mask = loc_ramp2(voice->mod_mask_cur, voice->mod_mask_inc);
+            _mm_storeu_ps(tmp + k, loc_flip4(_mm_loadu_ps(samplesIn + k), bits, mask));
          }
-         float outL = (il / voice->mod_bits_cur);
-         outL = voice->lpf_l_1.filter(outL);
-         outL = voice->lpf_l_2.filter(outL);
-
-         float r = _samplesIn[k + 1u];
-         // if(r > 1.0f)
-         //    r = 1.0f;
-         // else if(r < -1.0f)
-         //    r = -1.0f;
-         int ir = (int)(r * voice->mod_bits_cur);
-         if(ir >= 0)
-            ir ^= (int)(voice->mod_mask_cur);
-         else
+#endif // BITFLIPPER_SSE2
+
+         // Remaining frame (or all frames when SSE2 is not available)
+         for(; i < numChunkFrames; i++, k += 2u)
          {
-            ir = -ir;
-            ir ^= (int)(voice->mod_mask_cur);
-            ir = -ir;
+            const int mask = (int)voice->mod_mask_cur;
+            tmp[k]      = loc_flip(samplesIn[k],      voice->mod_bits_cur, mask);
+            tmp[k + 1u] = loc_flip(samplesIn[k + 1u], voice->mod_bits_cur, mask);
+
+            // Next frame
+            voice->mod_bits_cur += voice->mod_bits_inc;
+            voice->mod_mask_cur += voice->mod_mask_inc;
          }
-         float outR = (ir / voice->mod_bits_cur);
-         outR = voice->lpf_r_1.filter(outR);
-         outR = voice->lpf_r_2.filter(outR);
 
-         outL = l + (outL - l) * voice->mod_drywet_cur;
-         outR = r + (outR - r) * voice->mod_drywet_cur;
+         voice->lpf.processStereo(2u/*numPoles*/,
+                                  tmp,
+                                  tmp,
+                                  numChunkFrames,
+                                  driveCur,
+                                  0.0f/*driveInc*/,
+                                  dryWetCur,
+                                  0.0f/*dryWetInc*/
+                                  );
+
+         i = 0u;
+         k = 0u;
+         voice->mod_drywet_cur = dryWetStart;
+
+#ifdef BITFLIPPER_SSE2
+         for(; (i + 2u) <= numChunkFrames; i += 2u, k += 4u)
+         {
+            const __m128 in     = _mm_loadu_ps(samplesIn + k);
+            const __m128 dryWet = loc_ramp2(voice->mod_drywet_cur, voice->mod_drywet_inc);
+            _mm_storeu_ps(samplesOut + k, _mm_add_ps(in, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(tmp + k), in), dryWet)));
+         }
+#endif // BITFLIPPER_SSE2
 
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outR;
+         for(; i < numChunkFrames; i++, k += 2u)
+         {
+            float l = samplesIn[k];
+            float r = samplesIn[k + 1u];
+            samplesOut[k]      = l + (tmp[k]      - l) * voice->mod_drywet_cur;
+            samplesOut[k + 1u] = r + (tmp[k + 1u] - r) * voice->mod_drywet_cur;
 
-         // Next frame
-         k += 2u;
-         voice->mod_drywet_cur += voice->mod_drywet_inc;
-         voice->mod_bits_cur  += voice->mod_bits_inc;
-         voice->mod_mask_cur  += voice->mod_mask_inc;
+            // Next frame
+            voice->mod_drywet_cur += voice->mod_drywet_inc;
+         }
       }
+
+      frameIdx += numChunkFrames;
    }
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   bitflipper_shared_t *ret = (bitflipper_shared_t *)malloc(sizeof(bitflipper_shared_t));
+   bitflipper_shared_t *ret = (bitflipper_shared_t *)Dstplugin_alloc(_info, sizeof(bitflipper_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -342,12 +396,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   bitflipper_voice_t *ret = (bitflipper_voice_t *)malloc(sizeof(bitflipper_voice_t));
+   bitflipper_voice_t *ret = (bitflipper_voice_t *)Dstplugin_alloc(_info, sizeof(bitflipper_voice_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -356,8 +410,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(bitflipper_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -387,6 +447,7 @@ st_plugin_info_t *bitflipper_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
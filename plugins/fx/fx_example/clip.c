@@ -8,7 +8,7 @@
 // ---- info   : clipping amplifier
 // ----
 // ---- created: 31May2020
-// ---- changed: 08Jun2020, 21Jan2024
+// ---- changed: 08Jun2020, 21Jan2024, 16Oct2026
 // ----
 // ----
 // ----
@@ -231,12 +231,14 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    }
 }
 
-static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
-                                              int                 _bMonoIn,
-                                              const float        *_samplesIn,
-                                              float              *_samplesOut, 
-                                              unsigned int        _numFrames
-                                              ) {
+static inline void loc_process(st_plugin_voice_t  *_voice,
+                               int                 _bMonoIn,
+                               const float        *_samplesIn,
+                               float              *_samplesOut,
+                               unsigned int        _numFrames,
+                               const int           _bAdd,
+                               const float         _gain
+                               ) {
    // Ring modulate at (modulated) note frequency
    ST_PLUGIN_VOICE_CAST(clip_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(clip_shared_t);
@@ -257,8 +259,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          outL -= voice->mod_offset_post_cur;
          outL *= voice->mod_gain_cur;
          outL = l + (outL - l) * voice->mod_drywet_cur;
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outL;
+         Dstplugin_out(_bAdd, _samplesOut[k],      outL, _gain);
+         Dstplugin_out(_bAdd, _samplesOut[k + 1u], outL, _gain);
 
          // Next frame
          k += 2u;
@@ -297,8 +299,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          outL = l + (outL - l) * voice->mod_drywet_cur;
          outR = r + (outR - r) * voice->mod_drywet_cur;
          // printf("xxx out=(%f; %f)\n", outL, outR);
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outR;
+         Dstplugin_out(_bAdd, _samplesOut[k],      outL, _gain);
+         Dstplugin_out(_bAdd, _samplesOut[k + 1u], outR, _gain);
 
          // Next frame
          k += 2u;
@@ -314,8 +316,27 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
 }
 
+static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
+                                              int                 _bMonoIn,
+                                              const float        *_samplesIn,
+                                              float              *_samplesOut,
+                                              unsigned int        _numFrames
+                                              ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 0/*bAdd*/, 1.0f/*gain*/);
+}
+
+static void ST_PLUGIN_API loc_process_add(st_plugin_voice_t  *_voice,
+                                          int                 _bMonoIn,
+                                          const float        *_samplesIn,
+                                          float              *_samplesOut,
+                                          unsigned int        _numFrames,
+                                          float               _gain
+                                          ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 1/*bAdd*/, _gain);
+}
+
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   clip_shared_t *ret = (clip_shared_t *)malloc(sizeof(clip_shared_t));
+   clip_shared_t *ret = (clip_shared_t *)Dstplugin_alloc(_info, sizeof(clip_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -326,12 +347,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   clip_voice_t *ret = (clip_voice_t *)malloc(sizeof(clip_voice_t));
+   clip_voice_t *ret = (clip_voice_t *)Dstplugin_alloc(_info, sizeof(clip_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -340,8 +361,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(clip_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -371,6 +398,7 @@ st_plugin_info_t *clip_init(void) {
       ret->base.shared_delete      = &loc_shared_delete;
       ret->base.voice_new          = &loc_voice_new;
       ret->base.voice_delete       = &loc_voice_delete;
+      ret->base.voice_reset        = &loc_voice_reset;
       ret->base.get_param_name     = &loc_get_param_name;
       ret->base.get_param_reset    = &loc_get_param_reset;
       ret->base.get_param_value    = &loc_get_param_value;
@@ -380,6 +408,7 @@ st_plugin_info_t *clip_init(void) {
       ret->base.set_mod_value      = &loc_set_mod_value;
       ret->base.prepare_block      = &loc_prepare_block;
       ret->base.process_replace    = &loc_process_replace;
+      ret->base.process_add        = &loc_process_add;
       ret->base.plugin_exit        = &loc_plugin_exit;
    }
 
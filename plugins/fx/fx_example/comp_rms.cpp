@@ -8,7 +8,7 @@
 // ---- info   : a simple RMS compressor
 // ----
 // ---- created: 06Jun2020
-// ---- changed: 07Jun2020, 08Jun2020, 21Jan2024
+// ---- changed: 07Jun2020, 08Jun2020, 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -18,9 +18,21 @@
 #include <stdio.h>
 #include <math.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define COMP_RMS_SSE2  1
+#include <emmintrin.h>
+#endif
+
 #include "../../../plugin.h"
 
-#include "biquad.h"
+#include "wshaper.h"
+#include "rmsdet.h"
+
+#define CHUNK_SIZE  (64u)  // process_replace() temp buffers (frames)
+
+#define LOOKAHEAD_MAX_MS  (5.0f)
+#define LOOKAHEAD_SIZE    (1024u)  // frames (>= LOOKAHEAD_MAX_MS at 192kHz)
+#define LOOKAHEAD_MASK    (1023u)
 
 #define PARAM_DRYWET   0
 #define PARAM_DRIVE1   1
@@ -30,7 +42,9 @@
 #define PARAM_CEIL     5
 #define PARAM_DRIVE2   6
 #define PARAM_SC_HPF   7
-#define NUM_PARAMS     8
+#define PARAM_LINK     8
+#define PARAM_LOOKAHD  9
+#define NUM_PARAMS     10
 static const char *loc_param_names[NUM_PARAMS] = {
    "Dry / Wet",
    "SC Gain",
@@ -40,6 +54,8 @@ static const char *loc_param_names[NUM_PARAMS] = {
    "Ceil",
    "Gain Reduction",
    "Sidechain HPF",
+   "Stereo Link",
+   "Lookahead",
 };
 static float loc_param_resets[NUM_PARAMS] = {
    1.0f,    // DRYWET
@@ -50,6 +66,8 @@ static float loc_param_resets[NUM_PARAMS] = {
    0.53f,   // CEIL
    0.52f,   // DRIVE2
    0.5f,    // SC_HPF
+   0.0f,    // LINK
+   0.0f,    // LOOKAHD
 };
 
 #define MOD_DRYWET    0
@@ -70,6 +88,7 @@ static const char *loc_mod_names[NUM_MODS] = {
 
 typedef struct comp_rms_info_s {
    st_plugin_info_t base;
+   const st_wshaper_t *ws_tanh;  // shared (see wshaper.h)
 } comp_rms_info_t;
 
 typedef struct comp_rms_shared_s {
@@ -77,86 +96,6 @@ typedef struct comp_rms_shared_s {
    float params[NUM_PARAMS];
 } comp_rms_shared_t;
 
-struct Comp {
-#define MAX_WIN_SIZE 2048
-   float buf[MAX_WIN_SIZE];
-   unsigned int buf_idx;
-   unsigned int win_size_bits;
-   unsigned int win_size;       // power of two
-   unsigned int win_size_mask;  // win_size - 1
-
-   double integrated_val;
-   double smoothed_sign;
-   double last_smoothed_val;
-   double smoothed_val;
-
-   StBiquad hpf;
-
-   void setWinSizeBits(unsigned int _bits) {
-      win_size_bits = _bits;
-      win_size      = (1u << _bits);
-      win_size_mask = (win_size - 1u);
-   }
-
-   void reset(void) {
-      hpf.reset();
-      setWinSizeBits(11u);
-      ::memset((void*)buf, 0, win_size * sizeof(float));
-      buf_idx           = 0u;
-      integrated_val    = 0.0;
-      smoothed_sign     = 0.0;
-      last_smoothed_val = 0.0;
-      smoothed_val      = 0.0;
-   }
-
-   float process(const float _inSmp, 
-                 const float _rise, 
-                 const float _fall
-                 ) {
-      // Sidechain filter
-      float inVal = hpf.filter(_inSmp);
-
-      // Calc square
-      inVal *= inVal;
-
-      // Integrate new input
-      integrated_val += inVal;
-
-      // Subtract oldest input
-      integrated_val -= buf[(buf_idx - win_size + 1u) & win_size_mask];
-
-      buf[buf_idx] = inVal;
-      buf_idx = (buf_idx + 1u) & win_size_mask;
-
-      double outVal = integrated_val / double(win_size);
-      if(outVal > 0.0)
-         outVal = sqrt(outVal);
-
-      // Smoothing
-      double smoothAmt;
-      if(smoothed_sign >= 0.0)
-      {
-         smoothAmt = _rise;
-      }
-      else
-      {
-         smoothAmt = _fall;
-      }
-
-      smoothAmt = (1.0 - smoothAmt);
-      smoothAmt *= smoothAmt;
-      smoothAmt *= smoothAmt;
-      smoothAmt *= smoothAmt;
-      smoothed_val = smoothed_val + (outVal - smoothed_val) * smoothAmt;
-
-      smoothed_sign = (smoothed_val - last_smoothed_val);
-      last_smoothed_val = smoothed_val;
-
-      // Output
-      return float(smoothed_val);
-   }
-};
-
 typedef struct comp_rms_voice_s {
    st_plugin_voice_t base;
    float sample_rate;
@@ -175,10 +114,17 @@ typedef struct comp_rms_voice_s {
    float mod_drive2_inc;
    float mod_drive3_cur;
    float mod_drive3_inc;
-   Comp  comp_l;
-   Comp  comp_r;
+   int   det_mode;  // ST_RMSDET_STEREO or ST_RMSDET_LINKED
+   StRMSDetector det;
+   float la_buf[LOOKAHEAD_SIZE][2];  // lookahead delay line (interleaved stereo)
+   unsigned int la_idx;
+   unsigned int la_frames;  // 0=no lookahead
 } comp_rms_voice_t;
 
+static inline float loc_pow10(const float _x) {
+   return exp2f(_x * 3.32192809f/*log2(10)*/);
+}
+
 
 static const char *ST_PLUGIN_API loc_get_param_name(st_plugin_info_t *_info,
                                                     unsigned int      _paramIdx
@@ -228,8 +174,9 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
    if(!_bGlide)
    {
       memset((void*)voice->mods, 0, sizeof(voice->mods));
-      voice->comp_l.reset();
-      voice->comp_r.reset();
+      voice->det.reset();
+      memset((void*)voice->la_buf, 0, sizeof(voice->la_buf));
+      voice->la_idx = 0u;
 #if 0
       printf("------- comp note on -----\n");
       fflush(stdout);
@@ -270,12 +217,10 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
 
 #if 0
    unsigned int winSizeBits = (unsigned int)(shared->params[PARAM_WINSIZE] * 11.0f + 0.5f);
-   if(winSizeBits != voice->comp_l.win_size_bits)
+   if(winSizeBits != voice->det.win_size_bits)
    {
-      voice->comp_l.reset();
-      voice->comp_r.reset();
-      voice->comp_l.setWinSizeBits(winSizeBits);
-      voice->comp_r.setWinSizeBits(winSizeBits);
+      voice->det.reset();
+      voice->det.setWinSizeBits(winSizeBits);
    }
 #endif
 
@@ -283,25 +228,25 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    modDryWet = Dstplugin_clamp(modDryWet, 0.0f, 1.0f);
 
    float modDrive1 = (shared->params[PARAM_DRIVE1]-0.5f)*2.0f + voice->mods[MOD_DRIVE1];
-   modDrive1 = powf(10.0f, modDrive1 * 2.0f);
+   modDrive1 = loc_pow10(modDrive1 * 2.0f);
 
-   float modRise = shared->params[PARAM_RISE] * powf(10.0f, voice->mods[MOD_RISE]);
+   float modRise = shared->params[PARAM_RISE] * loc_pow10(voice->mods[MOD_RISE]);
    modRise = Dstplugin_clamp(modRise, 0.0f, 1.0f);
 
-   float modFall = shared->params[PARAM_FALL] * powf(10.0f, voice->mods[MOD_FALL]);
+   float modFall = shared->params[PARAM_FALL] * loc_pow10(voice->mods[MOD_FALL]);
    modFall = Dstplugin_clamp(modFall, 0.0f, 1.0f);
 
    float modCeil = (shared->params[PARAM_CEIL]-0.5f)*2.0f;
-   modCeil = powf(10.0f, modCeil * 2.0f);
+   modCeil = loc_pow10(modCeil * 2.0f);
 
    // float modDrive2 = (shared->params[PARAM_DRIVE2]-0.5f)*2.0f + voice->mods[MOD_DRIVE2];
    float modDrive2 = shared->params[PARAM_DRIVE2] + voice->mods[MOD_DRIVE2];
-   modDrive2 = powf(10.0f, -modDrive2 * 2.0f);
+   modDrive2 = loc_pow10(-modDrive2 * 2.0f);
 
    float modDrive3 = (shared->params[PARAM_OUT_GAIN]-0.5f)*2.0f + voice->mods[MOD_OUT_GAIN];
-   modDrive3 = powf(10.0f, modDrive3 * 2.0f);
+   modDrive3 = loc_pow10(modDrive3 * 2.0f);
 
-   float modFreq = _freqHz * powf(10.0f, (shared->params[PARAM_SC_HPF]-0.5f)*2.0f*2.0f);
+   float modFreq = _freqHz * loc_pow10((shared->params[PARAM_SC_HPF]-0.5f)*2.0f*2.0f);
    if(modFreq >= (voice->sample_rate*0.5f))
       modFreq = 1.0f;
    else
@@ -317,6 +262,11 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    }
 #endif
 
+   voice->det_mode = (shared->params[PARAM_LINK] >= 0.5f) ? ST_RMSDET_LINKED : ST_RMSDET_STEREO;
+
+   unsigned int laFrames = (unsigned int)(shared->params[PARAM_LOOKAHD] * LOOKAHEAD_MAX_MS * voice->sample_rate * 0.001f + 0.5f);
+   voice->la_frames = (laFrames > LOOKAHEAD_MASK) ? LOOKAHEAD_MASK : laFrames;
+
    if(_numFrames > 0u)
    {
       // lerp
@@ -350,19 +300,94 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
       _numFrames = 1u;
    }
 
-   voice->comp_l.hpf.calcParams(_numFrames,
-                                StBiquad::HPF,
-                                0.0f/*gainDB*/,
-                                modFreq,
-                                0.0/*modQ*/
-                                );
-
-   voice->comp_r.hpf.calcParams(_numFrames,
-                                StBiquad::HPF,
-                                0.0f/*gainDB*/,
-                                modFreq,
-                                0.0/*modQ*/
-                                );
+   voice->det.hpf.calcParams(_numFrames,
+                             StBiquad::HPF,
+                             0.0f/*gainDB*/,
+                             modFreq,
+                             0.0/*modQ*/
+                             );
+}
+
+// Gain stage: out = in + (tanh(in * drive1 * gain(env)) * drive3 - in) * dryWet
+//  - gain(env) = 1 + (drive2 - 1) * min(env, ceil) / ceil
+static void loc_gain(const comp_rms_info_t *_info,
+                     comp_rms_voice_t      *_voice,
+                     const float           *_samplesIn,
+                     const float           *_env,
+                     float                 *_samplesOut,
+                     unsigned int           _numFrames
+                     ) {
+   comp_rms_voice_t *voice = _voice;
+   unsigned int i = 0u;
+   unsigned int k = 0u;
+
+#ifdef COMP_RMS_SSE2
+   if(_numFrames >= 2u)
+   {
+      // 2 stereo frames per iteration (lanes 0/1 = frame i, lanes 2/3 = frame i+1)
+#define Dramp_setup(n) \
+      __m128 n ## Cur = _mm_setr_ps(voice->mod_ ## n ## _cur, voice->mod_ ## n ## _cur, voice->mod_ ## n ## _cur + voice->mod_ ## n ## _inc, voice->mod_ ## n ## _cur + voice->mod_ ## n ## _inc); \
+      const __m128 n ## Inc = _mm_set1_ps(voice->mod_ ## n ## _inc * 2.0f)
+      Dramp_setup(drywet);
+      Dramp_setup(drive1);
+      Dramp_setup(ceil);
+      Dramp_setup(drive2);
+      Dramp_setup(drive3);
+#undef Dramp_setup
+      const __m128 one    = _mm_set1_ps(1.0f);
+      const __m128 denorm = _mm_set1_ps(10.0f);  // see Dstplugin_fix_denorm_32()
+
+      for(; (i + 2u) <= _numFrames; i += 2u, k += 4u)
+      {
+         const __m128 in = _mm_loadu_ps(_samplesIn + k);
+         __m128 rms = _mm_div_ps(_mm_min_ps(_mm_loadu_ps(_env + k), ceilCur), ceilCur);
+         rms = _mm_add_ps(one, _mm_mul_ps(_mm_sub_ps(drive2Cur, one), rms));
+         __m128 out = _mm_mul_ps(_mm_mul_ps(in, drive1Cur), rms);
+         out = _mm_mul_ps(st_wshaper_lookup4(_info->ws_tanh, out), drive3Cur);
+         out = _mm_add_ps(in, _mm_mul_ps(_mm_sub_ps(out, in), drywetCur));
+         out = _mm_sub_ps(_mm_add_ps(out, denorm), denorm);
+         _mm_storeu_ps(_samplesOut + k, out);
+
+         // Next frames
+         drywetCur = _mm_add_ps(drywetCur, drywetInc);
+         drive1Cur = _mm_add_ps(drive1Cur, drive1Inc);
+         ceilCur   = _mm_add_ps(ceilCur,   ceilInc);
+         drive2Cur = _mm_add_ps(drive2Cur, drive2Inc);
+         drive3Cur = _mm_add_ps(drive3Cur, drive3Inc);
+      }
+
+      voice->mod_drywet_cur = _mm_cvtss_f32(drywetCur);
+      voice->mod_drive1_cur = _mm_cvtss_f32(drive1Cur);
+      voice->mod_ceil_cur   = _mm_cvtss_f32(ceilCur);
+      voice->mod_drive2_cur = _mm_cvtss_f32(drive2Cur);
+      voice->mod_drive3_cur = _mm_cvtss_f32(drive3Cur);
+   }
+#endif // COMP_RMS_SSE2
+
+   // Remaining frame (or all frames when SSE2 is not available)
+   for(; i < _numFrames; i++, k += 2u)
+   {
+      for(unsigned int j = 0u; j < 2u; j++)
+      {
+         const float in = _samplesIn[k + j];
+         float rms = _env[k + j];
+         if(rms > voice->mod_ceil_cur)
+            rms = voice->mod_ceil_cur;
+         rms /= voice->mod_ceil_cur;
+         rms = 1.0f + (voice->mod_drive2_cur - 1.0f) * rms;
+         float out = in * voice->mod_drive1_cur * rms;
+         out = st_wshaper_lookup(_info->ws_tanh, out) * voice->mod_drive3_cur;
+         out = in + (out - in) * voice->mod_drywet_cur;
+         _samplesOut[k + j] = Dstplugin_fix_denorm_32(out);
+      }
+
+      // Next frame
+      voice->mod_drywet_cur += voice->mod_drywet_inc;
+      voice->mod_drive1_cur += voice->mod_drive1_inc;
+      voice->mod_ceil_cur   += voice->mod_ceil_inc;
+      voice->mod_drive2_cur += voice->mod_drive2_inc;
+      voice->mod_drive3_cur += voice->mod_drive3_inc;
+   }
 }
 
 static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
@@ -371,83 +396,63 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
                                               float              *_samplesOut, 
                                               unsigned int        _numFrames
                                               ) {
-   // Ring modulate at (modulated) note frequency
    ST_PLUGIN_VOICE_CAST(comp_rms_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(comp_rms_shared_t);
+   ST_PLUGIN_VOICE_INFO_CAST(comp_rms_info_t);
+   (void)_bMonoIn;
 
-   unsigned int k = 0u;
+   float env[CHUNK_SIZE * 2u];
+   float dly[CHUNK_SIZE * 2u];
 
-   // if(_bMonoIn)
-   // {
-   // }
-   // else
+   unsigned int frameIdx = 0u;
+   while(frameIdx < _numFrames)
    {
-      // Stereo input, stereo output
-      for(unsigned int i = 0u; i < _numFrames; i++)
+      unsigned int numChunkFrames = _numFrames - frameIdx;
+      if(numChunkFrames > CHUNK_SIZE)
+         numChunkFrames = CHUNK_SIZE;
+
+      const float *samplesIn  = _samplesIn  + 2u * frameIdx;
+      float       *samplesOut = _samplesOut + 2u * frameIdx;
+
+      // Sidechain envelope (stereo or linked)
+      float scDriveCur = voice->mod_drive1_cur;
+      voice->det.process(voice->det_mode,
+                         samplesIn,
+                         env,
+                         numChunkFrames,
+                         scDriveCur,
+                         voice->mod_drive1_inc,
+                         voice->mod_rise_cur,
+                         voice->mod_rise_inc,
+                         voice->mod_fall_cur,
+                         voice->mod_fall_inc
+                         );
+
+      if(voice->la_frames > 0u)
       {
-         float l = _samplesIn[k];
-         float r = _samplesIn[k + 1u];
-
-         float outL = l * voice->mod_drive1_cur;
-         float rmsL = voice->comp_l.process(outL, voice->mod_rise_cur, voice->mod_fall_cur);
-#if 0
+         // Delay input (the envelope leads the gain stage by la_frames)
+         unsigned int laIdx = voice->la_idx;
+         const unsigned int laFrames = voice->la_frames;
+         for(unsigned int i = 0u; i < numChunkFrames; i++)
          {
-            static int xxx = 0;
-            if(0 == (++xxx & 2047))
-            {
-               printf("xxx rmsL=%f\n", rmsL);
-               fflush(stdout);
-            }
+            voice->la_buf[laIdx][0] = samplesIn[2u * i];
+            voice->la_buf[laIdx][1] = samplesIn[2u * i + 1u];
+            const float *d = voice->la_buf[(laIdx - laFrames) & LOOKAHEAD_MASK];
+            dly[2u * i]      = d[0];
+            dly[2u * i + 1u] = d[1];
+            laIdx = (laIdx + 1u) & LOOKAHEAD_MASK;
          }
-#endif
-         if(rmsL > voice->mod_ceil_cur)
-            rmsL = voice->mod_ceil_cur;
-         rmsL /= voice->mod_ceil_cur;
-#if 0
-         rmsL = rmsL * rmsL * (3.0f - 2.0f * rmsL);
-#endif
-         rmsL = 1.0f + (voice->mod_drive2_cur - 1.0f) * rmsL;
-         // outR = outR * (1.0f + voice->mod_drive2_cur * (1.0f - rmsR)) * voice->mod_drive3_cur;
-         outL = outL * rmsL;
-         // outL = outL * (1.0f + voice->mod_drive2_cur * (1.0f - rmsL)) * voice->mod_drive3_cur;
-         // outL = outL * (voice->mod_drive2_cur * (voice->mod_ceil_cur - rmsL));
-         outL = tanhf(outL) * voice->mod_drive3_cur;
-
-         float outR = r * voice->mod_drive1_cur;
-         float rmsR = voice->comp_r.process(outR, voice->mod_rise_cur, voice->mod_fall_cur);
-         if(rmsR > voice->mod_ceil_cur)
-            rmsR = voice->mod_ceil_cur;
-         rmsR /= voice->mod_ceil_cur;
-#if 0
-         rmsR = rmsR * rmsR * (3.0f - 2.0f * rmsR);
-#endif
-         rmsR = 1.0f + (voice->mod_drive2_cur - 1.0f) * rmsR;
-         // outR = outR * (1.0f + voice->mod_drive2_cur * (1.0f - rmsR)) * voice->mod_drive3_cur;
-         outR = outR * rmsR;
-         outR = tanhf(outR) * voice->mod_drive3_cur;
-
-         outL = l + (outL - l) * voice->mod_drywet_cur;
-         outR = r + (outR - r) * voice->mod_drywet_cur;
-         outL = Dstplugin_fix_denorm_32(outL);
-         outR = Dstplugin_fix_denorm_32(outR);
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outR;
-
-         // Next frame
-         k += 2u;
-         voice->mod_drywet_cur += voice->mod_drywet_inc;
-         voice->mod_drive1_cur += voice->mod_drive1_inc;
-         voice->mod_rise_cur   += voice->mod_rise_inc;
-         voice->mod_fall_cur   += voice->mod_fall_inc;
-         voice->mod_ceil_cur   += voice->mod_ceil_inc;
-         voice->mod_drive2_cur += voice->mod_drive2_inc;
-         voice->mod_drive3_cur += voice->mod_drive3_inc;
+         voice->la_idx = laIdx;
+         samplesIn = dly;
       }
+
+      loc_gain(info, voice, samplesIn, env, samplesOut, numChunkFrames);
+
+      frameIdx += numChunkFrames;
    }
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   comp_rms_shared_t *ret = (comp_rms_shared_t *)malloc(sizeof(comp_rms_shared_t));
+   comp_rms_shared_t *ret = (comp_rms_shared_t *)Dstplugin_alloc(_info, sizeof(comp_rms_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -458,12 +463,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   comp_rms_voice_t *ret = (comp_rms_voice_t *)malloc(sizeof(comp_rms_voice_t));
+   comp_rms_voice_t *ret = (comp_rms_voice_t *)Dstplugin_alloc(_info, sizeof(comp_rms_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -472,8 +477,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(comp_rms_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -502,6 +513,7 @@ st_plugin_info_t *comp_rms_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -513,6 +525,8 @@ st_plugin_info_t *comp_rms_init(void) {
       ret->base.prepare_block    = &loc_prepare_block;
       ret->base.process_replace  = &loc_process_replace;
       ret->base.plugin_exit      = &loc_plugin_exit;
+
+      ret->ws_tanh = st_wshaper_tanh_get();
    }
 
    return &ret->base;
@@ -4,7 +4,7 @@
 // ---- info   : monophonic delay line
 // ----
 // ---- created: 24May2020
-// ---- changed: 13Oct2021, 27Sep2024
+// ---- changed: 13Oct2021, 27Sep2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -22,38 +22,125 @@
 #endif // ST_DELAY_MASK
 #endif // ST_DELAY_SIZE
 
+// Max. number of frames per readLinearBlock() / pushRawBlock() call (see dly_1.cpp)
+//  (note) delay times shorter than this (~0.7ms @44.1kHz) are processed per frame
+#define ST_DELAY_BLOCK_SIZE  (32u)
+
+// History buffer
+//  - ST_DELAY_SIZE is the max. size, the actual (power of two) size is determined by allocHistory()
+//     (e.g. from the max. delay time at the current sample rate, see set_sample_rate())
+//  - (modulated) read offsets must be clamped via clampOffset()
+//  - allocated via the host allocator (see Dstplugin_alloc())
+//  - until allocHistory() has been called (or when it failed), a 2 frame buffer embedded in the struct is used
+//     (=> clampOffset() returns 0 but push() / read*() are always safe to call)
+//  - init() must be called after the (memset() cleared) struct has been allocated, freeHistory() before it is freed
 struct StDelay {
+   float       *history;
+   unsigned int size;
+   unsigned int mask;
    unsigned int io_offset;
+   unsigned int b_wrapped;  // 1=io_offset has wrapped around since the last reset() / clear()
    float        last_out;
-   float        history[ST_DELAY_SIZE];
+   float        history_none[2];
 
    StDelay(void) {
-      reset();
+      init();
    }
 
    ~StDelay() {
    }
 
+   void init(void) {
+      history   = history_none;
+      size      = 2u;
+      mask      = 1u;
+      io_offset = 0u;
+      b_wrapped = 0u;
+      last_out  = 0.0f;
+      history_none[0] = history_none[1] = 0.0f;
+   }
+
+   // (Re-)allocate history for delay times of up to _maxDelayFrames
+   //  - size is the next power of two >= _maxDelayFrames (rounded to the nearest frame), max. ST_DELAY_SIZE
+   //     (e.g. the ~371ms max. delay time of the dly_* plugins => 16384 frames @44.1kHz, 32768 frames @48kHz)
+   //  - (note) clampOffset() takes the interpolation / ramp rounding margin from the top of the buffer
+   //  - keeps the current buffer (and its contents) when the size does not change
+   //  - returns false when the allocation failed (falls back to the embedded 2 frame buffer)
+   bool allocHistory(st_plugin_info_t *_info, float _maxDelayFrames) {
+      unsigned int numFrames = ST_DELAY_SIZE;
+      if(_maxDelayFrames < float(ST_DELAY_SIZE))
+         numFrames = (unsigned int)(_maxDelayFrames + 0.5f);
+      unsigned int newSize = 2u;
+      while(newSize < numFrames)
+         newSize <<= 1;
+      if(newSize > ST_DELAY_SIZE)
+         newSize = ST_DELAY_SIZE;
+
+      if(newSize == size)
+         return true;
+
+      freeHistory(_info);
+
+      if(newSize > 2u)
+      {
+         float *newHistory = (float*)Dstplugin_alloc(_info, sizeof(float) * newSize);
+         if(NULL == newHistory)
+            return false;
+         memset((void*)newHistory, 0, sizeof(float) * newSize);
+         history = newHistory;
+         size    = newSize;
+         mask    = newSize - 1u;
+      }
+      return true;
+   }
+
+   // Clamp (modulated) read offset to the current history size
+   //  - keeps 3 frames of headroom (+1 interpolation, +1 current frame, +1 ramp rounding)
+   float clampOffset(float _offset) const {
+      const float maxOffset = (size > 3u) ? float(size - 3u) : 0.0f;
+      return (_offset >= maxOffset) ? maxOffset : _offset;
+   }
+
+   void freeHistory(st_plugin_info_t *_info) {
+      if(history_none != history)
+      {
+         Dstplugin_free(_info, history);
+      }
+      init();
+   }
+
    void reset(void) {
+      // (note) history is zero outside of the touched region
+      clear();
+   }
+
+   // Same as reset() but only clears the part of the history that has been written to
+   void clear(void) {
+      if(b_wrapped)
+         memset((void*)history, 0, sizeof(float) * size);
+      else
+         memset((void*)history, 0, sizeof(float) * (io_offset + 1u));
       io_offset = 0u;
+      b_wrapped = 0u;
       last_out  = 0.0f;
-      memset((void*)history, 0, sizeof(history));
    }
 
    void push(float _smp, float _fbAmt) {
       // fb
-      io_offset = (io_offset + 1u) & ST_DELAY_MASK;
+      io_offset = (io_offset + 1u) & mask;
+      b_wrapped |= (0u == io_offset);
       history[io_offset] = _smp + (last_out * _fbAmt);
    }
 
    void pushRaw(float _smp) {
       // no fb  (or external fb)
-      io_offset = (io_offset + 1u) & ST_DELAY_MASK;
+      io_offset = (io_offset + 1u) & mask;
+      b_wrapped |= (0u == io_offset);
       history[io_offset] = _smp;
    }
 
    float readNearest(unsigned int _offset) {
-      _offset = (io_offset - _offset) & ST_DELAY_MASK;
+      _offset = (io_offset - _offset) & mask;
       last_out = history[_offset];
       return last_out;
    }
@@ -61,17 +148,17 @@ struct StDelay {
    float readLinear(float _offset) {
       unsigned int offC = (unsigned int)(_offset);
       unsigned int offN = (unsigned int)(_offset + 1u);
-      offC = (io_offset - offC) & ST_DELAY_MASK;
-      offN = (io_offset - offN) & ST_DELAY_MASK;
+      offC = (io_offset - offC) & mask;
+      offN = (io_offset - offN) & mask;
       float t = (_offset - (int)_offset);
       last_out = history[offC] + (history[offN] - history[offC]) * t;
       return last_out;
    }
 
    float readLinearNorm(float _offsetNorm) {
-      _offsetNorm *= (float)(ST_DELAY_SIZE - 1u);
-      if(_offsetNorm >= (float)(ST_DELAY_SIZE - 1u))
-         _offsetNorm = (float)(ST_DELAY_SIZE - 1u);
+      _offsetNorm *= (float)(size - 1u);
+      if(_offsetNorm >= (float)(size - 1u))
+         _offsetNorm = (float)(size - 1u);
       last_out = readLinear(_offsetNorm);
       return last_out;
    }
@@ -79,6 +166,88 @@ struct StDelay {
    void add(float _smp) {
       history[io_offset] += _smp;
    }
+
+   // Block read / write
+   //  - when all delay times in a block are long enough, the reads do not depend on the samples
+   //     that are written in the same block
+   //     => read the whole block via readLinearBlock(), then write it via pushRawBlock()
+   //  - _ioOff: number of push*() calls before the first read (1: push-then-read order, 0: read-then-push order)
+   //  - readLinearBlock() returns the same values as per-frame readLinear() calls (bit-exact)
+   //  - (note) +1 frame margin for ramped offsets (_offsetMin / _offsetMax are estimated from the ramp end points)
+   //           (i.e. offsets clamped via clampOffset() can always be read as a block)
+   bool canReadBlock(float _offsetMin, float _offsetMax, unsigned int _numFrames, unsigned int _ioOff) const {
+      return (_offsetMin >= float(_numFrames + _ioOff)) && ((_offsetMax + 2.0f) < float(size));
+   }
+
+   // Read _numFrames linearly interpolated samples (the i-th read happens after (_ioOff + i) pushes)
+   //  - _offset is incremented by _offsetInc after each frame, returns the updated offset
+   //  - constant delay times read contiguous history spans (split at the wrap-around point)
+   float readLinearBlock(float *_out, unsigned int _numFrames, float _offset, float _offsetInc, unsigned int _ioOff) {
+      unsigned int io = io_offset + _ioOff;
+      if(0.0f == _offsetInc)
+      {
+         unsigned int offC = (unsigned int)(_offset);
+         unsigned int offN = (unsigned int)(_offset + 1u);
+         unsigned int dist = offN - offC;  // 1, or 2 when (_offset + 1) rounds up
+         float t = (_offset - (int)_offset);
+         unsigned int idxC = (io - offC) & mask;
+         unsigned int i = 0u;
+         while(i < _numFrames)
+         {
+            if(idxC < dist)
+            {
+               // previous tap wraps around
+               _out[i++] = history[idxC] + (history[(idxC - dist) & mask] - history[idxC]) * t;
+               idxC = (idxC + 1u) & mask;
+            }
+            else
+            {
+               unsigned int numSpan = size - idxC;
+               if(numSpan > (_numFrames - i))
+                  numSpan = (_numFrames - i);
+               const float *s = history + idxC;
+               const float *sN = s - dist;
+               float *d = _out + i;
+               for(unsigned int j = 0u; j < numSpan; j++)
+                  d[j] = s[j] + (sN[j] - s[j]) * t;
+               i += numSpan;
+               idxC = (idxC + numSpan) & mask;
+            }
+         }
+      }
+      else
+      {
+         for(unsigned int i = 0u; i < _numFrames; i++)
+         {
+            unsigned int offC = (unsigned int)(_offset);
+            unsigned int offN = (unsigned int)(_offset + 1u);
+            offC = (io + i - offC) & mask;
+            offN = (io + i - offN) & mask;
+            float t = (_offset - (int)_offset);
+            _out[i] = history[offC] + (history[offN] - history[offC]) * t;
+            _offset += _offsetInc;
+         }
+      }
+      last_out = _out[_numFrames - 1u];
+      return _offset;
+   }
+
+   // Write _numFrames samples (same as _numFrames pushRaw() calls)
+   void pushRawBlock(const float *_smp, unsigned int _numFrames) {
+      unsigned int idx = (io_offset + 1u) & mask;
+      b_wrapped |= ((io_offset + _numFrames) >= size);
+      io_offset = (io_offset + _numFrames) & mask;
+      while(_numFrames > 0u)
+      {
+         unsigned int numSpan = size - idx;
+         if(numSpan > _numFrames)
+            numSpan = _numFrames;
+         memcpy((void*)(history + idx), (const void*)_smp, sizeof(float) * numSpan);
+         _smp += numSpan;
+         _numFrames -= numSpan;
+         idx = (idx + numSpan) & mask;
+      }
+   }
 };
 
 
@@ -8,7 +8,7 @@
 // ---- info   : a cross feedback delay line
 // ----
 // ---- created: 24May2020
-// ---- changed: 25May2020, 31May2020, 08Jun2020, 05Jan2022, 21Jan2024, 27Sep2024
+// ---- changed: 25May2020, 31May2020, 08Jun2020, 05Jan2022, 21Jan2024, 27Sep2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -95,6 +95,7 @@ typedef struct dly_2_voice_s {
    float   mod_fb_r2l_inc;
    StDelay dly_l;
    StDelay dly_r;
+   stplugin_tail_t tail;
 } dly_2_voice_t;
 
 
@@ -103,6 +104,15 @@ static void ST_PLUGIN_API loc_set_sample_rate(st_plugin_voice_t *_voice,
                                               ) {
    ST_PLUGIN_VOICE_CAST(dly_2_voice_t);
    voice->sample_rate = _sampleRate;
+   const float maxMs = (float(ST_DELAY_SIZE) / 88.200f);    // see loc_prepare_block()
+   const float maxFrames = maxMs * (_sampleRate / 1000.0f);
+   if(!voice->dly_l.allocHistory(voice->base.info, maxFrames) ||
+      !voice->dly_r.allocHistory(voice->base.info, maxFrames)
+      )
+   {
+      // (note) the delay line falls back to its embedded 2 frame buffer (zero delay time)
+      printf("[---] dly_2::set_sample_rate: failed to allocate delay history\n");
+   }
 }
 
 static const char *ST_PLUGIN_API loc_get_param_name(st_plugin_info_t *_info,
@@ -161,6 +171,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
                                       float               _vel
                                       ) {
    ST_PLUGIN_VOICE_CAST(dly_2_voice_t);
+   Dstplugin_tail_reset(voice->tail);
    (void)_bGlide;
    (void)_note;
    (void)_vel;
@@ -223,13 +234,11 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
 
    modTimeL = Dstplugin_clamp(voice->mod_time_l_smooth, 0.0f, 1.0f);
    modTimeL = (modTimeL * maxMs * (voice->sample_rate / 1000.0f));
-   if(modTimeL >= (float)(ST_DELAY_SIZE - 1u))
-      modTimeL = (float)(ST_DELAY_SIZE - 1u);
+   modTimeL = voice->dly_l.clampOffset(modTimeL);
 
    modTimeR = Dstplugin_clamp(voice->mod_time_r_smooth, 0.0f, 1.0f);
    modTimeR = (modTimeR * maxMs * (voice->sample_rate / 1000.0f));
-   if(modTimeR >= (float)(ST_DELAY_SIZE - 1u))
-      modTimeR = (float)(ST_DELAY_SIZE - 1u);
+   modTimeR = voice->dly_r.clampOffset(modTimeR);
 
    float modFb = powf(10.0f, voice->mods[MOD_FB]);
 
@@ -278,16 +287,12 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    }
 }
 
-static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
-                                              int                 _bMonoIn,
-                                              const float        *_samplesIn,
-                                              float              *_samplesOut,
-                                              unsigned int        _numFrames
-                                              ) {
-   // Ring modulate at (modulated) note frequency
-   ST_PLUGIN_VOICE_CAST(dly_2_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(dly_2_shared_t);
-
+static void loc_process_frames(dly_2_voice_t *voice,
+                               const float   *_samplesIn,
+                               float         *_samplesOut,
+                               unsigned int   _numFrames,
+                               float         &_peakWet
+                               ) {
    unsigned int k = 0u;
 
    // Stereo input, stereo output
@@ -302,7 +307,9 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
       voice->dly_r.push(r + lastOutL * voice->mod_fb_l2r_cur, voice->mod_fb_r_cur);
       float outR = voice->dly_r.readLinear(voice->mod_time_r_cur);
 
+      Dstplugin_peak(_peakWet, outL);
       outL = l + (outL - l) * voice->mod_drywet_cur;
+      Dstplugin_peak(_peakWet, outR);
       outR = r + (outR - r) * voice->mod_drywet_cur;
 
       _samplesOut[k]      = outL;
@@ -320,8 +327,108 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
    }
 }
 
+static void loc_process_block(dly_2_voice_t *voice,
+                              const float   *_samplesIn,
+                              float         *_samplesOut,
+                              unsigned int   _numFrames,
+                              float         &_peakWet
+                              ) {
+   // (note) delay times >= _numFrames: read all delayed frames first, then write the block
+   float outL[ST_DELAY_BLOCK_SIZE];
+   float outR[ST_DELAY_BLOCK_SIZE];
+   float newL[ST_DELAY_BLOCK_SIZE];
+   float newR[ST_DELAY_BLOCK_SIZE];
+   float lastOutL = voice->dly_l.last_out;
+   float lastOutR = voice->dly_r.last_out;
+   unsigned int k = 0u;
+
+   voice->mod_time_l_cur = voice->dly_l.readLinearBlock(outL, _numFrames, voice->mod_time_l_cur, voice->mod_time_l_inc, 1u/*ioOff*/);
+   voice->mod_time_r_cur = voice->dly_r.readLinearBlock(outR, _numFrames, voice->mod_time_r_cur, voice->mod_time_r_inc, 1u/*ioOff*/);
+
+   // Stereo input, stereo output
+   for(unsigned int i = 0u; i < _numFrames; i++)
+   {
+      float l = _samplesIn[k];
+      float r = _samplesIn[k + 1u];
+      newL[i] = (l + lastOutR * voice->mod_fb_r2l_cur) + (lastOutL * voice->mod_fb_l_cur);
+      newR[i] = (r + lastOutL * voice->mod_fb_l2r_cur) + (lastOutR * voice->mod_fb_r_cur);
+      lastOutL = outL[i];
+      lastOutR = outR[i];
+
+      float oL = outL[i];
+      float oR = outR[i];
+      Dstplugin_peak(_peakWet, oL);
+      oL = l + (oL - l) * voice->mod_drywet_cur;
+      Dstplugin_peak(_peakWet, oR);
+      oR = r + (oR - r) * voice->mod_drywet_cur;
+
+      _samplesOut[k]      = oL;
+      _samplesOut[k + 1u] = oR;
+
+      // Next frame
+      k += 2u;
+      voice->mod_drywet_cur += voice->mod_drywet_inc;
+      voice->mod_fb_l_cur   += voice->mod_fb_l_inc;
+      voice->mod_fb_r_cur   += voice->mod_fb_r_inc;
+      voice->mod_fb_l2r_cur += voice->mod_fb_l2r_inc;
+      voice->mod_fb_r2l_cur += voice->mod_fb_r2l_inc;
+   }
+
+   voice->dly_l.pushRawBlock(newL, _numFrames);
+   voice->dly_r.pushRawBlock(newR, _numFrames);
+}
+
+static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
+                                              int                 _bMonoIn,
+                                              const float        *_samplesIn,
+                                              float              *_samplesOut,
+                                              unsigned int        _numFrames
+                                              ) {
+   // Ring modulate at (modulated) note frequency
+   ST_PLUGIN_VOICE_CAST(dly_2_voice_t);
+
+   float peakIn = 0.0f;
+   Dstplugin_peak_buf(peakIn, _samplesIn, _numFrames * 2u);
+   float peakWet = 0.0f;
+
+   // Process in chunks (block read / write when both delay times are longer than the chunk)
+   unsigned int frameIdx = 0u;
+   while(frameIdx < _numFrames)
+   {
+      unsigned int numFrames = _numFrames - frameIdx;
+      if(numFrames > ST_DELAY_BLOCK_SIZE)
+         numFrames = ST_DELAY_BLOCK_SIZE;
+
+      const float timeLEnd = voice->mod_time_l_cur + voice->mod_time_l_inc * (numFrames - 1u);
+      const float timeREnd = voice->mod_time_r_cur + voice->mod_time_r_inc * (numFrames - 1u);
+      if(voice->dly_l.canReadBlock(Dstplugin_min(voice->mod_time_l_cur, timeLEnd),
+                                   Dstplugin_max(voice->mod_time_l_cur, timeLEnd),
+                                   numFrames,
+                                   1u/*ioOff*/
+                                   )
+         && voice->dly_r.canReadBlock(Dstplugin_min(voice->mod_time_r_cur, timeREnd),
+                                      Dstplugin_max(voice->mod_time_r_cur, timeREnd),
+                                      numFrames,
+                                      1u/*ioOff*/
+                                      )
+         )
+         loc_process_block(voice, _samplesIn + 2u * frameIdx, _samplesOut + 2u * frameIdx, numFrames, peakWet);
+      else
+         loc_process_frames(voice, _samplesIn + 2u * frameIdx, _samplesOut + 2u * frameIdx, numFrames, peakWet);
+
+      frameIdx += numFrames;
+   }
+
+   Dstplugin_tail_update(voice->tail, peakIn, peakWet, _numFrames);
+}
+
+static unsigned int ST_PLUGIN_API loc_query_tail_state(st_plugin_voice_t *_voice) {
+   ST_PLUGIN_VOICE_CAST(dly_2_voice_t);
+   return Dstplugin_tail_state(voice->tail);
+}
+
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   dly_2_shared_t *ret = (dly_2_shared_t *)malloc(sizeof(dly_2_shared_t));
+   dly_2_shared_t *ret = (dly_2_shared_t *)Dstplugin_alloc(_info, sizeof(dly_2_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -332,22 +439,38 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   dly_2_voice_t *ret = (dly_2_voice_t *)malloc(sizeof(dly_2_voice_t));
+   dly_2_voice_t *ret = (dly_2_voice_t *)Dstplugin_alloc(_info, sizeof(dly_2_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
       ret->base.info   = _info;
+      ret->dly_l.init();
+      ret->dly_r.init();
+      ret->tail.num_tail_frames = ST_DELAY_SIZE;
    }
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(dly_2_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear_to(voice, dly_l);
+   voice->dly_l.clear();
+   voice->dly_r.clear();
+   Dstplugin_voice_clear_from(voice, tail);
+   voice->tail.num_tail_frames = ST_DELAY_SIZE;
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   ST_PLUGIN_VOICE_CAST(dly_2_voice_t);
+   voice->dly_l.freeHistory(_voice->info);
+   voice->dly_r.freeHistory(_voice->info);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -377,6 +500,7 @@ st_plugin_info_t *dly_2_init(void) {
       ret->base.shared_delete          = &loc_shared_delete;
       ret->base.voice_new              = &loc_voice_new;
       ret->base.voice_delete           = &loc_voice_delete;
+      ret->base.voice_reset            = &loc_voice_reset;
       ret->base.get_param_name         = &loc_get_param_name;
       ret->base.get_param_reset        = &loc_get_param_reset;
       ret->base.get_param_value        = &loc_get_param_value;
@@ -388,6 +512,7 @@ st_plugin_info_t *dly_2_init(void) {
       ret->base.set_mod_value          = &loc_set_mod_value;
       ret->base.prepare_block          = &loc_prepare_block;
       ret->base.process_replace        = &loc_process_replace;
+      ret->base.query_tail_state       = &loc_query_tail_state;
       ret->base.plugin_exit            = &loc_plugin_exit;
    }
 
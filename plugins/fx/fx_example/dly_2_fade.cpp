@@ -8,7 +8,7 @@
 // ---- info   : a cross feedback delay line
 // ----
 // ---- created: 24May2020
-// ---- changed: 25May2020, 31May2020, 08Jun2020, 11Feb2021, 21Jan2024, 27Sep2024
+// ---- changed: 25May2020, 31May2020, 08Jun2020, 11Feb2021, 21Jan2024, 27Sep2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -102,6 +102,7 @@ typedef struct dly_2_fade_voice_s {
    float        mod_fb_r2l_inc;
    StDelay      dly_l;
    StDelay      dly_r;
+   stplugin_tail_t tail;
 } dly_2_fade_voice_t;
 
 
@@ -110,6 +111,15 @@ static void ST_PLUGIN_API loc_set_sample_rate(st_plugin_voice_t *_voice,
                                               ) {
    ST_PLUGIN_VOICE_CAST(dly_2_fade_voice_t);
    voice->sample_rate = _sampleRate;
+   const float maxMs = (float(ST_DELAY_SIZE) / 88.200f);    // see loc_prepare_block()
+   const float maxFrames = maxMs * (_sampleRate / 1000.0f);
+   if(!voice->dly_l.allocHistory(voice->base.info, maxFrames) ||
+      !voice->dly_r.allocHistory(voice->base.info, maxFrames)
+      )
+   {
+      // (note) the delay line falls back to its embedded 2 frame buffer (zero delay time)
+      printf("[---] dly_2_fade::set_sample_rate: failed to allocate delay history\n");
+   }
 }
 
 static const char *ST_PLUGIN_API loc_get_param_name(st_plugin_info_t *_info,
@@ -168,6 +178,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
                                       float               _vel
                                       ) {
    ST_PLUGIN_VOICE_CAST(dly_2_fade_voice_t);
+   Dstplugin_tail_reset(voice->tail);
    (void)_bGlide;
    (void)_note;
    (void)_vel;
@@ -230,13 +241,11 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
 
    modTimeL = Dstplugin_clamp(voice->mod_time_l_smooth, 0.0f, 1.0f);
    modTimeL = (modTimeL * maxMs * (voice->sample_rate / 1000.0f));
-   if(modTimeL >= (float)(ST_DELAY_SIZE - 1u))
-      modTimeL = (float)(ST_DELAY_SIZE - 1u);
+   modTimeL = voice->dly_l.clampOffset(modTimeL);
 
    modTimeR = Dstplugin_clamp(voice->mod_time_r_smooth, 0.0f, 1.0f);
    modTimeR = (modTimeR * maxMs * (voice->sample_rate / 1000.0f));
-   if(modTimeR >= (float)(ST_DELAY_SIZE - 1u))
-      modTimeR = (float)(ST_DELAY_SIZE - 1u);
+   modTimeR = voice->dly_r.clampOffset(modTimeR);
 
    float modFb = powf(10.0f, voice->mods[MOD_FB]);
 
@@ -289,16 +298,12 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    }
 }
 
-static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
-                                              int                 _bMonoIn,
-                                              const float        *_samplesIn,
-                                              float              *_samplesOut,
-                                              unsigned int        _numFrames
-                                              ) {
-   // Ring modulate at (modulated) note frequency
-   ST_PLUGIN_VOICE_CAST(dly_2_fade_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(dly_2_fade_shared_t);
-
+static void loc_process_frames(dly_2_fade_voice_t *voice,
+                               const float        *_samplesIn,
+                               float              *_samplesOut,
+                               unsigned int        _numFrames,
+                               float              &_peakWet
+                               ) {
    unsigned int k = 0u;
    float c;
    float n;
@@ -321,7 +326,80 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
       voice->dly_r.pushRaw(r + lastOutL * voice->mod_fb_l2r_cur + outR * voice->mod_fb_r_cur);
       voice->dly_l.last_out = outR;
 
+      Dstplugin_peak(_peakWet, outL);
+      outL = l + (outL - l) * voice->mod_drywet_cur;
+      Dstplugin_peak(_peakWet, outR);
+      outR = r + (outR - r) * voice->mod_drywet_cur;
+
+      _samplesOut[k]      = outL;
+      _samplesOut[k + 1u] = outR;
+
+      // Next frame
+      k += 2u;
+      voice->mod_drywet_cur += voice->mod_drywet_inc;
+      voice->mod_fb_l_cur   += voice->mod_fb_l_inc;
+      voice->mod_fb_r_cur   += voice->mod_fb_r_inc;
+      voice->mod_fb_l2r_cur += voice->mod_fb_l2r_inc;
+      voice->mod_fb_r2l_cur += voice->mod_fb_r2l_inc;
+
+      if(0u == (++voice->time_fade_idx & (FADE_LEN-1)))
+      {
+         voice->mod_time_l_cur  = voice->mod_time_l_next;
+         voice->mod_time_l_next = voice->mod_time_l_target;
+         voice->mod_time_r_cur  = voice->mod_time_r_next;
+         voice->mod_time_r_next = voice->mod_time_r_target;
+         voice->time_fade_amt = 0.0f;
+      }
+      else
+      {
+         voice->time_fade_amt += (1.0f / FADE_LEN);
+      }
+   }
+}
+
+static void loc_process_block(dly_2_fade_voice_t *voice,
+                              const float        *_samplesIn,
+                              float              *_samplesOut,
+                              unsigned int        _numFrames,
+                              float              &_peakWet
+                              ) {
+   // (note) delay times >= _numFrames and chunk does not cross a fade boundary (constant cur / next times):
+   //         read all delayed frames first, then write the block
+   float cL[ST_DELAY_BLOCK_SIZE];
+   float nL[ST_DELAY_BLOCK_SIZE];
+   float cR[ST_DELAY_BLOCK_SIZE];
+   float nR[ST_DELAY_BLOCK_SIZE];
+   float newL[ST_DELAY_BLOCK_SIZE];
+   float newR[ST_DELAY_BLOCK_SIZE];
+   unsigned int k = 0u;
+
+   // (note) same cross-feedback sources as the per-frame path:
+   //         l2r: dly_l.last_out (=outR of the previous frame)
+   //         r2l: dly_r.last_out (=next time tap of the previous frame)
+   float lastOutL = voice->dly_l.last_out;
+   float lastOutR = voice->dly_r.last_out;
+
+   voice->dly_l.readLinearBlock(cL, _numFrames, voice->mod_time_l_cur,  0.0f, 0u/*ioOff*/);
+   voice->dly_l.readLinearBlock(nL, _numFrames, voice->mod_time_l_next, 0.0f, 0u/*ioOff*/);
+   voice->dly_r.readLinearBlock(cR, _numFrames, voice->mod_time_r_cur,  0.0f, 0u/*ioOff*/);
+   voice->dly_r.readLinearBlock(nR, _numFrames, voice->mod_time_r_next, 0.0f, 0u/*ioOff*/);
+
+   // Stereo input, stereo output
+   for(unsigned int i = 0u; i < _numFrames; i++)
+   {
+      float l = _samplesIn[k];
+      float outL = cL[i] + (nL[i] - cL[i]) * voice->time_fade_amt;
+      newL[i] = l + lastOutR * voice->mod_fb_r2l_cur + outL * voice->mod_fb_l_cur;
+
+      float r = _samplesIn[k + 1u];
+      float outR = cR[i] + (nR[i] - cR[i]) * voice->time_fade_amt;
+      newR[i] = r + lastOutL * voice->mod_fb_l2r_cur + outR * voice->mod_fb_r_cur;
+      lastOutL = outR;
+      lastOutR = nR[i];
+
+      Dstplugin_peak(_peakWet, outL);
       outL = l + (outL - l) * voice->mod_drywet_cur;
+      Dstplugin_peak(_peakWet, outR);
       outR = r + (outR - r) * voice->mod_drywet_cur;
 
       _samplesOut[k]      = outL;
@@ -337,6 +415,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
       if(0u == (++voice->time_fade_idx & (FADE_LEN-1)))
       {
+         // (note) last frame of chunk
          voice->mod_time_l_cur  = voice->mod_time_l_next;
          voice->mod_time_l_next = voice->mod_time_l_target;
          voice->mod_time_r_cur  = voice->mod_time_r_next;
@@ -348,10 +427,64 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          voice->time_fade_amt += (1.0f / FADE_LEN);
       }
    }
+
+   voice->dly_l.pushRawBlock(newL, _numFrames);
+   voice->dly_r.pushRawBlock(newR, _numFrames);
+   voice->dly_l.last_out = lastOutL;
+}
+
+static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
+                                              int                 _bMonoIn,
+                                              const float        *_samplesIn,
+                                              float              *_samplesOut,
+                                              unsigned int        _numFrames
+                                              ) {
+   // Ring modulate at (modulated) note frequency
+   ST_PLUGIN_VOICE_CAST(dly_2_fade_voice_t);
+
+   float peakIn = 0.0f;
+   Dstplugin_peak_buf(peakIn, _samplesIn, _numFrames * 2u);
+   float peakWet = 0.0f;
+
+   // Process in chunks that end at fade boundaries (block read / write when all delay times are longer than the chunk)
+   unsigned int frameIdx = 0u;
+   while(frameIdx < _numFrames)
+   {
+      unsigned int numFrames = _numFrames - frameIdx;
+      if(numFrames > ST_DELAY_BLOCK_SIZE)
+         numFrames = ST_DELAY_BLOCK_SIZE;
+      const unsigned int numFade = FADE_LEN - (voice->time_fade_idx & (FADE_LEN-1));
+      if(numFrames > numFade)
+         numFrames = numFade;
+
+      if(voice->dly_l.canReadBlock(Dstplugin_min(voice->mod_time_l_cur, voice->mod_time_l_next),
+                                   Dstplugin_max(voice->mod_time_l_cur, voice->mod_time_l_next),
+                                   numFrames,
+                                   0u/*ioOff*/
+                                   )
+         && voice->dly_r.canReadBlock(Dstplugin_min(voice->mod_time_r_cur, voice->mod_time_r_next),
+                                      Dstplugin_max(voice->mod_time_r_cur, voice->mod_time_r_next),
+                                      numFrames,
+                                      0u/*ioOff*/
+                                      )
+         )
+         loc_process_block(voice, _samplesIn + 2u * frameIdx, _samplesOut + 2u * frameIdx, numFrames, peakWet);
+      else
+         loc_process_frames(voice, _samplesIn + 2u * frameIdx, _samplesOut + 2u * frameIdx, numFrames, peakWet);
+
+      frameIdx += numFrames;
+   }
+
+   Dstplugin_tail_update(voice->tail, peakIn, peakWet, _numFrames);
+}
+
+static unsigned int ST_PLUGIN_API loc_query_tail_state(st_plugin_voice_t *_voice) {
+   ST_PLUGIN_VOICE_CAST(dly_2_fade_voice_t);
+   return Dstplugin_tail_state(voice->tail);
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   dly_2_fade_shared_t *ret = (dly_2_fade_shared_t *)malloc(sizeof(dly_2_fade_shared_t));
+   dly_2_fade_shared_t *ret = (dly_2_fade_shared_t *)Dstplugin_alloc(_info, sizeof(dly_2_fade_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -362,22 +495,38 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   dly_2_fade_voice_t *ret = (dly_2_fade_voice_t *)malloc(sizeof(dly_2_fade_voice_t));
+   dly_2_fade_voice_t *ret = (dly_2_fade_voice_t *)Dstplugin_alloc(_info, sizeof(dly_2_fade_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
       ret->base.info   = _info;
+      ret->dly_l.init();
+      ret->dly_r.init();
+      ret->tail.num_tail_frames = ST_DELAY_SIZE;
    }
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(dly_2_fade_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear_to(voice, dly_l);
+   voice->dly_l.clear();
+   voice->dly_r.clear();
+   Dstplugin_voice_clear_from(voice, tail);
+   voice->tail.num_tail_frames = ST_DELAY_SIZE;
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   ST_PLUGIN_VOICE_CAST(dly_2_fade_voice_t);
+   voice->dly_l.freeHistory(_voice->info);
+   voice->dly_r.freeHistory(_voice->info);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -407,6 +556,7 @@ st_plugin_info_t *dly_2_fade_init(void) {
       ret->base.shared_delete          = &loc_shared_delete;
       ret->base.voice_new              = &loc_voice_new;
       ret->base.voice_delete           = &loc_voice_delete;
+      ret->base.voice_reset            = &loc_voice_reset;
       ret->base.get_param_name         = &loc_get_param_name;
       ret->base.get_param_reset        = &loc_get_param_reset;
       ret->base.get_param_value        = &loc_get_param_value;
@@ -418,6 +568,7 @@ st_plugin_info_t *dly_2_fade_init(void) {
       ret->base.set_mod_value          = &loc_set_mod_value;
       ret->base.prepare_block          = &loc_prepare_block;
       ret->base.process_replace        = &loc_process_replace;
+      ret->base.query_tail_state       = &loc_query_tail_state;
       ret->base.plugin_exit            = &loc_plugin_exit;
    }
 
@@ -8,7 +8,7 @@
 // ---- info   : a cross feedback delay line with variable shape (sweepable multimode) filtering
 // ----
 // ---- created: 25May2020
-// ---- changed: 31May2020, 08Jun2020, 10Feb2021, 21Jan2024, 27Sep2024
+// ---- changed: 31May2020, 08Jun2020, 10Feb2021, 21Jan2024, 27Sep2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -125,6 +125,7 @@ typedef struct dly_flt_2_voice_s {
       }
    }
 
+   stplugin_tail_t tail;
 } dly_flt_2_voice_t;
 
 
@@ -133,6 +134,15 @@ static void ST_PLUGIN_API loc_set_sample_rate(st_plugin_voice_t *_voice,
                                               ) {
    ST_PLUGIN_VOICE_CAST(dly_flt_2_voice_t);
    voice->sample_rate = _sampleRate;
+   const float maxMs = (float(ST_DELAY_SIZE) / 88.200f);    // see loc_prepare_block()
+   const float maxFrames = maxMs * (_sampleRate / 1000.0f);
+   if(!voice->dly_l.allocHistory(voice->base.info, maxFrames) ||
+      !voice->dly_r.allocHistory(voice->base.info, maxFrames)
+      )
+   {
+      // (note) the delay line falls back to its embedded 2 frame buffer (zero delay time)
+      printf("[---] dly_flt_2::set_sample_rate: failed to allocate delay history\n");
+   }
 }
 
 static const char *ST_PLUGIN_API loc_get_param_name(st_plugin_info_t *_info,
@@ -191,6 +201,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
                                       float               _vel
                                       ) {
    ST_PLUGIN_VOICE_CAST(dly_flt_2_voice_t);
+   Dstplugin_tail_reset(voice->tail);
    (void)_bGlide;
    (void)_note;
    (void)_vel;
@@ -245,14 +256,12 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    float modTimeL = voice->mod_time_smooth;
    modTimeL = Dstplugin_clamp(modTimeL, 0.0f, 1.0f);
    modTimeL = (modTimeL * maxMs * (voice->sample_rate / 1000.0f));
-   if(modTimeL >= (float)(ST_DELAY_SIZE - 1u))
-      modTimeL = (float)(ST_DELAY_SIZE - 1u);
+   modTimeL = voice->dly_l.clampOffset(modTimeL);
 
    float modTimeR = voice->mod_time_smooth * modTimeSclR;
    modTimeR = Dstplugin_clamp(modTimeR, 0.0f, 1.0f);
    modTimeR = (modTimeR * maxMs * (voice->sample_rate / 1000.0f));
-   if(modTimeR >= (float)(ST_DELAY_SIZE - 1u))
-      modTimeR = (float)(ST_DELAY_SIZE - 1u);
+   modTimeR = voice->dly_r.clampOffset(modTimeR);
 
    float modFbAmt = powf(10.0f, voice->mods[MOD_FB]);
 
@@ -306,16 +315,13 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    }
 }
 
-static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
-                                              int                 _bMonoIn,
-                                              const float        *_samplesIn,
-                                              float              *_samplesOut,
-                                              unsigned int        _numFrames
-                                              ) {
-   // Ring modulate at (modulated) note frequency
-   ST_PLUGIN_VOICE_CAST(dly_flt_2_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(dly_flt_2_shared_t);
-
+static void loc_process_frames(dly_flt_2_voice_t *voice,
+                               const float       *_samplesIn,
+                               float             *_samplesOut,
+                               unsigned int       _numFrames,
+                               const float        _drywet,
+                               float             &_peakWet
+                               ) {
    unsigned int k = 0u;
 
    // Stereo input, stereo output
@@ -370,8 +376,10 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
       outR = Dstplugin_fix_denorm_32(outR);
 #endif
 
-      outL = l + (outL - l) * shared->params[PARAM_DRYWET];
-      outR = r + (outR - r) * shared->params[PARAM_DRYWET];
+      Dstplugin_peak(_peakWet, outL);
+      outL = l + (outL - l) * _drywet;
+      Dstplugin_peak(_peakWet, outR);
+      outR = r + (outR - r) * _drywet;
 
       _samplesOut[k]      = outL;
       _samplesOut[k + 1u] = outR;
@@ -385,8 +393,109 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
    }
 }
 
+static void loc_process_block(dly_flt_2_voice_t *voice,
+                              const float       *_samplesIn,
+                              float             *_samplesOut,
+                              unsigned int       _numFrames,
+                              const float        _drywet,
+                              float             &_peakWet
+                              ) {
+   // (note) delay times >= _numFrames: read all delayed frames first, then filter + write the block
+   float outL[ST_DELAY_BLOCK_SIZE];
+   float outR[ST_DELAY_BLOCK_SIZE];
+   float fltL[ST_DELAY_BLOCK_SIZE];
+   float fltR[ST_DELAY_BLOCK_SIZE];
+   float lastOutL = voice->dly_l.last_out;
+   float lastOutR = voice->dly_r.last_out;
+   unsigned int k = 0u;
+
+   voice->mod_time_l_cur = voice->dly_l.readLinearBlock(outL, _numFrames, voice->mod_time_l_cur, voice->mod_time_l_inc, 1u/*ioOff*/);
+   voice->mod_time_r_cur = voice->dly_r.readLinearBlock(outR, _numFrames, voice->mod_time_r_cur, voice->mod_time_r_inc, 1u/*ioOff*/);
+
+   // Stereo input, stereo output
+   //  (note) filter in feedback loop
+   for(unsigned int i = 0u; i < _numFrames; i++)
+   {
+      float l = _samplesIn[k];
+      float r = _samplesIn[k + 1u];
+      fltL[i] = voice->flt_1_l.filter(l + lastOutL * voice->mod_fb_cur + lastOutR * voice->mod_xfb_cur);
+      fltR[i] = voice->flt_1_r.filter(r + lastOutR * voice->mod_fb_cur + lastOutL * voice->mod_xfb_cur);
+      lastOutL = outL[i];
+      lastOutR = outR[i];
+
+      float oL = Dstplugin_fix_denorm_32(outL[i]);
+      float oR = Dstplugin_fix_denorm_32(outR[i]);
+      Dstplugin_peak(_peakWet, oL);
+      oL = l + (oL - l) * _drywet;
+      Dstplugin_peak(_peakWet, oR);
+      oR = r + (oR - r) * _drywet;
+
+      _samplesOut[k]      = oL;
+      _samplesOut[k + 1u] = oR;
+
+      // Next frame
+      k += 2u;
+      voice->mod_fb_cur     += voice->mod_fb_inc;
+      voice->mod_xfb_cur    += voice->mod_xfb_inc;
+   }
+
+   voice->dly_l.pushRawBlock(fltL, _numFrames);
+   voice->dly_r.pushRawBlock(fltR, _numFrames);
+}
+
+static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
+                                              int                 _bMonoIn,
+                                              const float        *_samplesIn,
+                                              float              *_samplesOut,
+                                              unsigned int        _numFrames
+                                              ) {
+   // Ring modulate at (modulated) note frequency
+   ST_PLUGIN_VOICE_CAST(dly_flt_2_voice_t);
+   ST_PLUGIN_VOICE_SHARED_CAST(dly_flt_2_shared_t);
+
+   float peakIn = 0.0f;
+   Dstplugin_peak_buf(peakIn, _samplesIn, _numFrames * 2u);
+   float peakWet = 0.0f;
+   const float drywet = shared->params[PARAM_DRYWET];
+
+   // Process in chunks (block read / write when both delay times are longer than the chunk)
+   unsigned int frameIdx = 0u;
+   while(frameIdx < _numFrames)
+   {
+      unsigned int numFrames = _numFrames - frameIdx;
+      if(numFrames > ST_DELAY_BLOCK_SIZE)
+         numFrames = ST_DELAY_BLOCK_SIZE;
+
+      const float timeLEnd = voice->mod_time_l_cur + voice->mod_time_l_inc * (numFrames - 1u);
+      const float timeREnd = voice->mod_time_r_cur + voice->mod_time_r_inc * (numFrames - 1u);
+      if(voice->dly_l.canReadBlock(Dstplugin_min(voice->mod_time_l_cur, timeLEnd),
+                                   Dstplugin_max(voice->mod_time_l_cur, timeLEnd),
+                                   numFrames,
+                                   1u/*ioOff*/
+                                   )
+         && voice->dly_r.canReadBlock(Dstplugin_min(voice->mod_time_r_cur, timeREnd),
+                                      Dstplugin_max(voice->mod_time_r_cur, timeREnd),
+                                      numFrames,
+                                      1u/*ioOff*/
+                                      )
+         )
+         loc_process_block(voice, _samplesIn + 2u * frameIdx, _samplesOut + 2u * frameIdx, numFrames, drywet, peakWet);
+      else
+         loc_process_frames(voice, _samplesIn + 2u * frameIdx, _samplesOut + 2u * frameIdx, numFrames, drywet, peakWet);
+
+      frameIdx += numFrames;
+   }
+
+   Dstplugin_tail_update(voice->tail, peakIn, peakWet, _numFrames);
+}
+
+static unsigned int ST_PLUGIN_API loc_query_tail_state(st_plugin_voice_t *_voice) {
+   ST_PLUGIN_VOICE_CAST(dly_flt_2_voice_t);
+   return Dstplugin_tail_state(voice->tail);
+}
+
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   dly_flt_2_shared_t *ret = (dly_flt_2_shared_t *)malloc(sizeof(dly_flt_2_shared_t));
+   dly_flt_2_shared_t *ret = (dly_flt_2_shared_t *)Dstplugin_alloc(_info, sizeof(dly_flt_2_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -397,22 +506,38 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   dly_flt_2_voice_t *ret = (dly_flt_2_voice_t *)malloc(sizeof(dly_flt_2_voice_t));
+   dly_flt_2_voice_t *ret = (dly_flt_2_voice_t *)Dstplugin_alloc(_info, sizeof(dly_flt_2_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
       ret->base.info   = _info;
+      ret->dly_l.init();
+      ret->dly_r.init();
+      ret->tail.num_tail_frames = ST_DELAY_SIZE + 256u;  // +filter ring-out
    }
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(dly_flt_2_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear_to(voice, dly_l);
+   voice->dly_l.clear();
+   voice->dly_r.clear();
+   Dstplugin_voice_clear_from(voice, coeff_lpf);
+   voice->tail.num_tail_frames = ST_DELAY_SIZE + 256u;  // +filter ring-out
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   ST_PLUGIN_VOICE_CAST(dly_flt_2_voice_t);
+   voice->dly_l.freeHistory(_voice->info);
+   voice->dly_r.freeHistory(_voice->info);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -442,6 +567,7 @@ st_plugin_info_t *dly_flt_2_init(void) {
       ret->base.shared_delete          = &loc_shared_delete;
       ret->base.voice_new              = &loc_voice_new;
       ret->base.voice_delete           = &loc_voice_delete;
+      ret->base.voice_reset            = &loc_voice_reset;
       ret->base.get_param_name         = &loc_get_param_name;
       ret->base.get_param_reset        = &loc_get_param_reset;
       ret->base.get_param_value        = &loc_get_param_value;
@@ -453,6 +579,7 @@ st_plugin_info_t *dly_flt_2_init(void) {
       ret->base.set_mod_value          = &loc_set_mod_value;
       ret->base.prepare_block          = &loc_prepare_block;
       ret->base.process_replace        = &loc_process_replace;
+      ret->base.query_tail_state       = &loc_query_tail_state;
       ret->base.plugin_exit            = &loc_plugin_exit;
    }
 
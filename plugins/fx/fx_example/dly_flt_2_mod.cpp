@@ -13,7 +13,7 @@
 // ----           - time modulation LFO
 // ----
 // ---- created: 25May2020
-// ---- changed: 31May2020, 08Jun2020, 10Feb2021, 21Jan2024, 27Sep2024
+// ---- changed: 31May2020, 08Jun2020, 10Feb2021, 21Jan2024, 27Sep2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -122,6 +122,7 @@ typedef struct dly_flt_2_mod_voice_s {
    StBiquad      hpf_l;
    StBiquad      hpf_r;
    float         lfo_phase;  // updated @1kHz rate (prepare_block())
+   stplugin_tail_t tail;
 } dly_flt_2_mod_voice_t;
 
 
@@ -130,6 +131,15 @@ static void ST_PLUGIN_API loc_set_sample_rate(st_plugin_voice_t *_voice,
                                               ) {
    ST_PLUGIN_VOICE_CAST(dly_flt_2_mod_voice_t);
    voice->sample_rate = _sampleRate;
+   const float maxMs = (float(ST_DELAY_SIZE) / 88.200f);    // see loc_prepare_block()
+   const float maxFrames = maxMs * (_sampleRate / 1000.0f);
+   if(!voice->dly_l.allocHistory(voice->base.info, maxFrames) ||
+      !voice->dly_r.allocHistory(voice->base.info, maxFrames)
+      )
+   {
+      // (note) the delay line falls back to its embedded 2 frame buffer (zero delay time)
+      printf("[---] dly_flt_2_mod::set_sample_rate: failed to allocate delay history\n");
+   }
 }
 
 static const char *ST_PLUGIN_API loc_get_param_name(st_plugin_info_t *_info,
@@ -188,6 +198,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
                                       float               _vel
                                       ) {
    ST_PLUGIN_VOICE_CAST(dly_flt_2_mod_voice_t);
+   Dstplugin_tail_reset(voice->tail);
    (void)_bGlide;
    (void)_note;
    (void)_vel;
@@ -261,14 +272,12 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    float modTimeL = voice->mod_time_smooth;
    modTimeL = Dstplugin_clamp(modTimeL, 0.0f, 1.0f);
    modTimeL = (modTimeL * maxMs * (voice->sample_rate / 1000.0f));
-   if(modTimeL >= (float)(ST_DELAY_SIZE - 1u))
-      modTimeL = (float)(ST_DELAY_SIZE - 1u);
+   modTimeL = voice->dly_l.clampOffset(modTimeL);
 
    float modTimeR = voice->mod_time_smooth * modTimeSclR;
    modTimeR = Dstplugin_clamp(modTimeR, 0.0f, 1.0f);
    modTimeR = (modTimeR * maxMs * (voice->sample_rate / 1000.0f));
-   if(modTimeR >= (float)(ST_DELAY_SIZE - 1u))
-      modTimeR = (float)(ST_DELAY_SIZE - 1u);
+   modTimeR = voice->dly_r.clampOffset(modTimeR);
 
    float modFbAmt = powf(10.0f, voice->mods[MOD_FB]);
 
@@ -380,6 +389,10 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
    unsigned int k = 0u;
 
+   float peakIn = 0.0f;
+   Dstplugin_peak_buf(peakIn, _samplesIn, _numFrames * 2u);
+   float peakWet = 0.0f;
+
    // Stereo input, stereo output
    for(unsigned int i = 0u; i < _numFrames; i++)
    {
@@ -399,7 +412,9 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
       float outR = voice->dly_r.readLinear(voice->mod_time_r_cur);
       outR = Dstplugin_fix_denorm_32(outR);
 
+      Dstplugin_peak(peakWet, outL);
       outL = l + (outL - l) * voice->mod_drywet_cur;
+      Dstplugin_peak(peakWet, outR);
       outR = r + (outR - r) * voice->mod_drywet_cur;
 
       _samplesOut[k]      = outL;
@@ -414,10 +429,17 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
       voice->mod_fb_cur     += voice->mod_fb_inc;
       voice->mod_xfb_cur    += voice->mod_xfb_inc;
    }
+
+   Dstplugin_tail_update(voice->tail, peakIn, peakWet, _numFrames);
+}
+
+static unsigned int ST_PLUGIN_API loc_query_tail_state(st_plugin_voice_t *_voice) {
+   ST_PLUGIN_VOICE_CAST(dly_flt_2_mod_voice_t);
+   return Dstplugin_tail_state(voice->tail);
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   dly_flt_2_mod_shared_t *ret = (dly_flt_2_mod_shared_t *)malloc(sizeof(dly_flt_2_mod_shared_t));
+   dly_flt_2_mod_shared_t *ret = (dly_flt_2_mod_shared_t *)Dstplugin_alloc(_info, sizeof(dly_flt_2_mod_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -428,22 +450,38 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   dly_flt_2_mod_voice_t *ret = (dly_flt_2_mod_voice_t *)malloc(sizeof(dly_flt_2_mod_voice_t));
+   dly_flt_2_mod_voice_t *ret = (dly_flt_2_mod_voice_t *)Dstplugin_alloc(_info, sizeof(dly_flt_2_mod_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
       ret->base.info   = _info;
+      ret->dly_l.init();
+      ret->dly_r.init();
+      ret->tail.num_tail_frames = ST_DELAY_SIZE + 256u;  // +filter ring-out
    }
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(dly_flt_2_mod_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear_to(voice, dly_l);
+   voice->dly_l.clear();
+   voice->dly_r.clear();
+   Dstplugin_voice_clear_from(voice, coeff_tmp);
+   voice->tail.num_tail_frames = ST_DELAY_SIZE + 256u;  // +filter ring-out
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   ST_PLUGIN_VOICE_CAST(dly_flt_2_mod_voice_t);
+   voice->dly_l.freeHistory(_voice->info);
+   voice->dly_r.freeHistory(_voice->info);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -473,6 +511,7 @@ st_plugin_info_t *dly_flt_2_mod_init(void) {
       ret->base.shared_delete          = &loc_shared_delete;
       ret->base.voice_new              = &loc_voice_new;
       ret->base.voice_delete           = &loc_voice_delete;
+      ret->base.voice_reset            = &loc_voice_reset;
       ret->base.get_param_name         = &loc_get_param_name;
       ret->base.get_param_reset        = &loc_get_param_reset;
       ret->base.get_param_value        = &loc_get_param_value;
@@ -484,6 +523,7 @@ st_plugin_info_t *dly_flt_2_mod_init(void) {
       ret->base.set_mod_value          = &loc_set_mod_value;
       ret->base.prepare_block          = &loc_prepare_block;
       ret->base.process_replace        = &loc_process_replace;
+      ret->base.query_tail_state       = &loc_query_tail_state;
       ret->base.plugin_exit            = &loc_plugin_exit;
    }
 
@@ -8,7 +8,7 @@
 // ---- info   : simple 3-band EQ
 // ----
 // ---- created: 31May2021
-// ---- changed: 21Jan2024
+// ---- changed: 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -18,6 +18,11 @@
 #include <string.h>
 #include <math.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define EQ3_SSE2  1
+#include <emmintrin.h>
+#endif
+
 #include "../../../plugin.h"
 
 #define PARAM_DRYWET   0
@@ -78,7 +83,43 @@ typedef struct eq3_shared_s {
 typedef float sF32;
 typedef double sF64;
 
-class EQ3Filter {
+// (re-)calc cached exp2f(x * scale) / sin + cos only when the (modulated) input has changed
+typedef struct eq3_cache_s {
+   int   b_valid;
+   float x;
+   float y;
+} eq3_cache_t;
+
+typedef struct eq3_sincos_cache_s {
+   int    b_valid;
+   double a;
+   double s;  // sin(a)
+   double c;  // cos(a)
+} eq3_sincos_cache_t;
+
+static inline float loc_exp2_cached(eq3_cache_t *_c, const float _x, const float _scale) {
+   if(!_c->b_valid || _c->x != _x)
+   {
+      _c->b_valid = 1;
+      _c->x = _x;
+      _c->y = exp2f(_x * _scale);
+   }
+   return _c->y;
+}
+
+static inline void loc_sincos_cached(eq3_sincos_cache_t *_c, const double _a) {
+   if(!_c->b_valid || _c->a != _a)
+   {
+      _c->b_valid = 1;
+      _c->a = _a;
+      _c->s = sin(_a);
+      _c->c = cos(_a);
+   }
+}
+
+#define LOG2_10  (3.32192809f)
+
+struct EQ3Filter {
    //---------------------------------------------------------------------------
    //
    // 3 Band EQ :)
@@ -104,85 +145,28 @@ class EQ3Filter {
    //
    // - Now with P4 Denormal fix :)
    //----------------------------------------------------------------------------
+   //
+   // - stereo filter bank: lane 0 = left channel, lane 1 = right channel
+   //    (both bands and channels are processed in one loop, SSE2 or scalar fallback, see loc_process_filter())
 
-   // Filter #1 (Low band)
-   sF64 f1p0; // Poles ...
-   sF64 f1p1;
-   sF64 f1p2;
-   sF64 f1p3;
-      
-   // Filter #2 (High band)
-   sF64 f2p0; // Poles ...
-   sF64 f2p1;
-   sF64 f2p2;
-   sF64 f2p3;
-      
-   // Sample history buffer
-   sF64 sdm1; // Sample data minus 1
-   sF64 sdm2; // 2
-   sF64 sdm3; // 3
-
-public:
-   EQ3Filter(void) {
-   }
-   ~EQ3Filter() {
-   }
+   sF64 f1p[4][2];  // Filter #1 (Low band) poles
+   sF64 f2p[4][2];  // Filter #2 (High band) poles
+   sF64 sdm[3][2];  // Sample history buffer (sample data minus 1, 2, 3)
 
    void reset(void) {
-      f1p0 = f1p1 = f1p2 = f1p3 = 0.0;
-      f2p0 = f2p1 = f2p2 = f2p3 = 0.0;
-      sdm1 = sdm2 = sdm3 = 0.0f;
+      ::memset((void*)this, 0, sizeof(*this));
    }
-   
-   sF32 process(const sF32 _smp,
-                const sF32 _freqLo,
-                const sF32 _gainLo,
-                const sF32 _freqHi,
-                const sF32 _gainHi,
-                const sF32 _gainMid
-                ) {
-      sF64 lf = 1.0 * sin(ST_PLUGIN_PI * _freqLo);
-      sF64 hf = 1.0 * sin(ST_PLUGIN_PI * _freqHi);
-
-      // // sF64 lf = 1.0 * sin(ST_PLUGIN_PI * _freqLo);
-      // // sF64 hf = 1.0 * sin(ST_PLUGIN_PI * _freqHi);
-
-#define vsa (1.0 / 4294967295.0) // Very small amount (Denormal Fix)
 
-      // Filter #1 (lowpass)
-      f1p0 += (lf * (_smp - f1p0)) + vsa;
-      f1p1 += (lf * (f1p0 - f1p1));
-      f1p2 += (lf * (f1p1 - f1p2));
-      f1p3 += (lf * (f1p2 - f1p3));
-
-      sF64 l = f1p3;
-
-      // Filter #2 (highpass)
-      f2p0 += (hf * (_smp - f2p0)) + vsa;
-      f2p1 += (hf * (f2p0 - f2p1));
-      f2p2 += (hf * (f2p1 - f2p2));
-      f2p3 += (hf * (f2p2 - f2p3));
-
-#undef vsa
-
-      sF64 h = sdm3 - f2p3;
-
-      // Calculate midrange (signal - (low + high))
-      sF64 m = sdm3 - (h + l);
-
-      // Scale and Combine
-      l *= _gainLo;
-      m *= _gainMid;
-      h *= _gainHi;
-   
-      sF64 out = (l + m + h);
-
-      // Shuffle history buffer
-      sdm3 = sdm2;
-      sdm2 = sdm1;
-      sdm1 = _smp;
-
-      return sF32(out);
+   // Initialize the poles with the DC response to the last input frame (see loc_process_bypass())
+   void prime(void) {
+      for(unsigned int p = 0u; p < 4u; p++)
+      {
+         for(unsigned int j = 0u; j < 2u; j++)
+         {
+            f1p[p][j] = sdm[0][j];
+            f2p[p][j] = sdm[0][j];
+         }
+      }
    }
 };
 
@@ -205,8 +189,21 @@ typedef struct eq3_voice_s {
    float    mod_gainmid_cur;
    float    mod_gainmid_inc;
 
-   EQ3Filter eq_l;
-   EQ3Filter eq_r;
+   eq3_cache_t cache_gain;
+   eq3_cache_t cache_freqlo;
+   eq3_cache_t cache_gainlo;
+   eq3_cache_t cache_freqhi;
+   eq3_cache_t cache_gainhi;
+   eq3_cache_t cache_gainmid;
+
+   // sin(PI * freq) at block start, and per-frame rotation
+   eq3_sincos_cache_t lf_start;
+   eq3_sincos_cache_t lf_rot;
+   eq3_sincos_cache_t hf_start;
+   eq3_sincos_cache_t hf_rot;
+
+   EQ3Filter eq;
+   int       b_eq_idle;  // 1=filter bank was bypassed (unity gains), prime() before it is used again
 
    unsigned int tick_nr;
 
@@ -269,8 +266,8 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
    {
       memset((void*)voice->mods, 0, sizeof(voice->mods));
 
-      voice->eq_l.reset();
-      voice->eq_r.reset();
+      voice->eq.reset();
+      voice->b_eq_idle = 0;
 
       voice->tick_nr = 0u;
    }
@@ -304,10 +301,10 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    modDryWet = Dstplugin_clamp(modDryWet, 0.0f, 1.0f);
 
    float modGain = (( (shared->params[PARAM_GAIN] + voice->mods[MOD_GAIN]) - 0.5f) * 2.0f);
-   modGain = powf(10.0f, modGain * 2.0f);
+   modGain = loc_exp2_cached(&voice->cache_gain, modGain, 2.0f * LOG2_10);
 
    float modFreqLo = shared->params[PARAM_FREQLO] + voice->mods[MOD_FREQLO];
-   modFreqLo = powf(2.0f, modFreqLo * 8.0f);
+   modFreqLo = loc_exp2_cached(&voice->cache_freqlo, modFreqLo, 8.0f);
    modFreqLo *= _freqHz;
 #define fmax (2.0f * 0.089f)
    if(modFreqLo > (voice->sample_rate * fmax))
@@ -319,14 +316,14 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
   
 
    float modGainLo = (( (shared->params[PARAM_GAINLO] + voice->mods[MOD_GAINLO]) - 0.5f) * 2.0f);
-   modGainLo = powf(10.0f, modGainLo * 2.0f);
+   modGainLo = loc_exp2_cached(&voice->cache_gainlo, modGainLo, 2.0f * LOG2_10);
 
    float modFreqHi = shared->params[PARAM_FREQHI] + voice->mods[MOD_FREQHI];
    modFreqHi = Dstplugin_clamp(modFreqHi, 0.0f, 1.0f);
    // // if(modFreqHi > 0.5f)
    // //    modFreqHi = 0.5f + (modFreqHi - 0.5f) * 0.5f;  // => 0..0.75
    // // modFreqHi = (powf(2.0f, modFreqHi * 7.0f) - 1.0f) / 127.0f;
-   modFreqHi = powf(2.0f, modFreqHi * 8.0f);
+   modFreqHi = loc_exp2_cached(&voice->cache_freqhi, modFreqHi, 8.0f);
    modFreqHi *= 0.5f*_freqHz;
 #define fmax (2.0f * 0.291768721876f)
    if(modFreqHi > (voice->sample_rate * fmax))
@@ -337,10 +334,10 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
       modFreqHi = 0.0f;
 
    float modGainHi = (( (shared->params[PARAM_GAINHI] + voice->mods[MOD_GAINHI]) - 0.5f) * 2.0f);
-   modGainHi = powf(10.0f, modGainHi * 2.0f);
+   modGainHi = loc_exp2_cached(&voice->cache_gainhi, modGainHi, 2.0f * LOG2_10);
 
    float modGainMid = (( (shared->params[PARAM_GAINMID] + voice->mods[MOD_GAINMID]) - 0.5f) * 2.0f);
-   modGainMid = powf(10.0f, modGainMid * 2.0f);
+   modGainMid = loc_exp2_cached(&voice->cache_gainmid, modGainMid, 2.0f * LOG2_10);
 
    if(_numFrames > 0u)
    {
@@ -383,44 +380,171 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    voice->tick_nr++;
 }
 
-static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
-                                              int                 _bMonoIn,
-                                              const float        *_samplesIn,
-                                              float              *_samplesOut, 
-                                              unsigned int        _numFrames
-                                              ) {
-   // Ring modulate at (modulated) note frequency
-   ST_PLUGIN_VOICE_CAST(eq3_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(eq3_shared_t);
+#ifdef EQ3_SSE2
+static void loc_process_filter(eq3_voice_t  *_voice,
+                               const float  *_samplesIn,
+                               float        *_samplesOut,
+                               unsigned int  _numFrames
+                               ) {
+   eq3_voice_t *voice = _voice;
+   EQ3Filter *eq = &voice->eq;
+
+   // lane 0 = lf = sin(PI * freqLo), lane 1 = hf = sin(PI * freqHi) (rotated per frame)
+   __m128d fs  = _mm_setr_pd(voice->lf_start.s, voice->hf_start.s);
+   __m128d fc  = _mm_setr_pd(voice->lf_start.c, voice->hf_start.c);
+   const __m128d frs = _mm_setr_pd(voice->lf_rot.s, voice->hf_rot.s);
+   const __m128d frc = _mm_setr_pd(voice->lf_rot.c, voice->hf_rot.c);
+
+   __m128d f1p0 = _mm_loadu_pd(eq->f1p[0]);
+   __m128d f1p1 = _mm_loadu_pd(eq->f1p[1]);
+   __m128d f1p2 = _mm_loadu_pd(eq->f1p[2]);
+   __m128d f1p3 = _mm_loadu_pd(eq->f1p[3]);
+   __m128d f2p0 = _mm_loadu_pd(eq->f2p[0]);
+   __m128d f2p1 = _mm_loadu_pd(eq->f2p[1]);
+   __m128d f2p2 = _mm_loadu_pd(eq->f2p[2]);
+   __m128d f2p3 = _mm_loadu_pd(eq->f2p[3]);
+   __m128d sdm1 = _mm_loadu_pd(eq->sdm[0]);
+   __m128d sdm2 = _mm_loadu_pd(eq->sdm[1]);
+   __m128d sdm3 = _mm_loadu_pd(eq->sdm[2]);
+
+   const __m128d vsa = _mm_set1_pd(1.0 / 4294967295.0);  // Very small amount (Denormal Fix)
+   unsigned int k = 0u;
+
+   for(unsigned int i = 0u; i < _numFrames; i++)
+   {
+      const __m128 in = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(_samplesIn + k));
+      const __m128d smp = _mm_cvtps_pd(_mm_mul_ps(in, _mm_set1_ps(voice->mod_gain_cur)));
+      const __m128d lf = _mm_unpacklo_pd(fs, fs);
+      const __m128d hf = _mm_unpackhi_pd(fs, fs);
+
+      // Filter #1 (lowpass)
+      f1p0 = _mm_add_pd(f1p0, _mm_add_pd(_mm_mul_pd(lf, _mm_sub_pd(smp,  f1p0)), vsa));
+      f1p1 = _mm_add_pd(f1p1, _mm_mul_pd(lf, _mm_sub_pd(f1p0, f1p1)));
+      f1p2 = _mm_add_pd(f1p2, _mm_mul_pd(lf, _mm_sub_pd(f1p1, f1p2)));
+      f1p3 = _mm_add_pd(f1p3, _mm_mul_pd(lf, _mm_sub_pd(f1p2, f1p3)));
+
+      // Filter #2 (highpass)
+      f2p0 = _mm_add_pd(f2p0, _mm_add_pd(_mm_mul_pd(hf, _mm_sub_pd(smp,  f2p0)), vsa));
+      f2p1 = _mm_add_pd(f2p1, _mm_mul_pd(hf, _mm_sub_pd(f2p0, f2p1)));
+      f2p2 = _mm_add_pd(f2p2, _mm_mul_pd(hf, _mm_sub_pd(f2p1, f2p2)));
+      f2p3 = _mm_add_pd(f2p3, _mm_mul_pd(hf, _mm_sub_pd(f2p2, f2p3)));
+
+      const __m128d l = f1p3;
+      const __m128d h = _mm_sub_pd(sdm3, f2p3);
+
+      // Calculate midrange (signal - (low + high))
+      const __m128d m = _mm_sub_pd(sdm3, _mm_add_pd(h, l));
+
+      // Scale and Combine
+      const __m128d out = _mm_add_pd(_mm_add_pd(_mm_mul_pd(l, _mm_set1_pd(voice->mod_gainlo_cur)),
+                                                _mm_mul_pd(m, _mm_set1_pd(voice->mod_gainmid_cur))
+                                                ),
+                                     _mm_mul_pd(h, _mm_set1_pd(voice->mod_gainhi_cur))
+                                     );
+
+      // Shuffle history buffer
+      sdm3 = sdm2;
+      sdm2 = sdm1;
+      sdm1 = smp;
+
+      __m128 out32 = _mm_cvtpd_ps(out);
+      out32 = _mm_add_ps(in, _mm_mul_ps(_mm_sub_ps(out32, in), _mm_set1_ps(voice->mod_drywet_cur)));
+      _mm_storel_pi((__m64*)(_samplesOut + k), out32);
+
+      // Next frame
+      k += 2u;
+      const __m128d fsN = _mm_add_pd(_mm_mul_pd(fs, frc), _mm_mul_pd(fc, frs));
+      fc = _mm_sub_pd(_mm_mul_pd(fc, frc), _mm_mul_pd(fs, frs));
+      fs = fsN;
+      voice->mod_drywet_cur  += voice->mod_drywet_inc;
+      voice->mod_gain_cur    += voice->mod_gain_inc;
+      voice->mod_freqlo_cur  += voice->mod_freqlo_inc;
+      voice->mod_gainlo_cur  += voice->mod_gainlo_inc;
+      voice->mod_freqhi_cur  += voice->mod_freqhi_inc;
+      voice->mod_gainhi_cur  += voice->mod_gainhi_inc;
+      voice->mod_gainmid_cur += voice->mod_gainmid_inc;
+   }
+
+   _mm_storeu_pd(eq->f1p[0], f1p0);
+   _mm_storeu_pd(eq->f1p[1], f1p1);
+   _mm_storeu_pd(eq->f1p[2], f1p2);
+   _mm_storeu_pd(eq->f1p[3], f1p3);
+   _mm_storeu_pd(eq->f2p[0], f2p0);
+   _mm_storeu_pd(eq->f2p[1], f2p1);
+   _mm_storeu_pd(eq->f2p[2], f2p2);
+   _mm_storeu_pd(eq->f2p[3], f2p3);
+   _mm_storeu_pd(eq->sdm[0], sdm1);
+   _mm_storeu_pd(eq->sdm[1], sdm2);
+   _mm_storeu_pd(eq->sdm[2], sdm3);
+}
+#else
+static void loc_process_filter(eq3_voice_t  *_voice,
+                               const float  *_samplesIn,
+                               float        *_samplesOut,
+                               unsigned int  _numFrames
+                               ) {
+   eq3_voice_t *voice = _voice;
+   EQ3Filter *eq = &voice->eq;
+
+   // sin(PI * freq) (rotated per frame)
+   sF64 lfS = voice->lf_start.s;
+   sF64 lfC = voice->lf_start.c;
+   sF64 hfS = voice->hf_start.s;
+   sF64 hfC = voice->hf_start.c;
+
+#define vsa (1.0 / 4294967295.0) // Very small amount (Denormal Fix)
 
    unsigned int k = 0u;
 
-   // Stereo input, stereo output
    for(unsigned int i = 0u; i < _numFrames; i++)
    {
-      float l = _samplesIn[k];
-      float r = _samplesIn[k + 1u];
-      float outL = voice->eq_l.process(l * voice->mod_gain_cur,
-                                       voice->mod_freqlo_cur,
-                                       voice->mod_gainlo_cur,
-                                       voice->mod_freqhi_cur,
-                                       voice->mod_gainhi_cur,
-                                       voice->mod_gainmid_cur
-                                       );
-      float outR = voice->eq_r.process(r * voice->mod_gain_cur,
-                                       voice->mod_freqlo_cur,
-                                       voice->mod_gainlo_cur,
-                                       voice->mod_freqhi_cur,
-                                       voice->mod_gainhi_cur,
-                                       voice->mod_gainmid_cur
-                                       );
-      outL = l + (outL - l) * voice->mod_drywet_cur;
-      outR = r + (outR - r) * voice->mod_drywet_cur;
-      _samplesOut[k]      = outL;
-      _samplesOut[k + 1u] = outR;
+      for(unsigned int j = 0u; j < 2u; j++)
+      {
+         const sF32 in  = _samplesIn[k + j];
+         const sF32 smp = in * voice->mod_gain_cur;
+
+         // Filter #1 (lowpass)
+         eq->f1p[0][j] += (lfS * (smp - eq->f1p[0][j])) + vsa;
+         eq->f1p[1][j] += (lfS * (eq->f1p[0][j] - eq->f1p[1][j]));
+         eq->f1p[2][j] += (lfS * (eq->f1p[1][j] - eq->f1p[2][j]));
+         eq->f1p[3][j] += (lfS * (eq->f1p[2][j] - eq->f1p[3][j]));
+
+         sF64 l = eq->f1p[3][j];
+
+         // Filter #2 (highpass)
+         eq->f2p[0][j] += (hfS * (smp - eq->f2p[0][j])) + vsa;
+         eq->f2p[1][j] += (hfS * (eq->f2p[0][j] - eq->f2p[1][j]));
+         eq->f2p[2][j] += (hfS * (eq->f2p[1][j] - eq->f2p[2][j]));
+         eq->f2p[3][j] += (hfS * (eq->f2p[2][j] - eq->f2p[3][j]));
+
+         sF64 h = eq->sdm[2][j] - eq->f2p[3][j];
+
+         // Calculate midrange (signal - (low + high))
+         sF64 m = eq->sdm[2][j] - (h + l);
+
+         // Scale and Combine
+         l *= voice->mod_gainlo_cur;
+         m *= voice->mod_gainmid_cur;
+         h *= voice->mod_gainhi_cur;
+
+         sF32 out = sF32(l + m + h);
+
+         // Shuffle history buffer
+         eq->sdm[2][j] = eq->sdm[1][j];
+         eq->sdm[1][j] = eq->sdm[0][j];
+         eq->sdm[0][j] = smp;
+
+         _samplesOut[k + j] = in + (out - in) * voice->mod_drywet_cur;
+      }
 
       // Next frame
       k += 2u;
+      sF64 t = lfS * voice->lf_rot.c + lfC * voice->lf_rot.s;
+      lfC = lfC * voice->lf_rot.c - lfS * voice->lf_rot.s;
+      lfS = t;
+      t = hfS * voice->hf_rot.c + hfC * voice->hf_rot.s;
+      hfC = hfC * voice->hf_rot.c - hfS * voice->hf_rot.s;
+      hfS = t;
       voice->mod_drywet_cur  += voice->mod_drywet_inc;
       voice->mod_gain_cur    += voice->mod_gain_inc;
       voice->mod_freqlo_cur  += voice->mod_freqlo_inc;
@@ -430,10 +554,81 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
       voice->mod_gainmid_cur += voice->mod_gainmid_inc;
    }
 
+#undef vsa
+}
+#endif // EQ3_SSE2
+
+// Unity band gains: low + mid + high = input delayed by 3 frames (filter bank is not evaluated)
+static void loc_process_bypass(eq3_voice_t  *_voice,
+                               const float  *_samplesIn,
+                               float        *_samplesOut,
+                               unsigned int  _numFrames
+                               ) {
+   eq3_voice_t *voice = _voice;
+   EQ3Filter *eq = &voice->eq;
+   unsigned int k = 0u;
+
+   for(unsigned int i = 0u; i < _numFrames; i++)
+   {
+      for(unsigned int j = 0u; j < 2u; j++)
+      {
+         const sF32 in = _samplesIn[k + j];
+         const sF32 out = sF32(eq->sdm[2][j]);
+
+         // Shuffle history buffer
+         eq->sdm[2][j] = eq->sdm[1][j];
+         eq->sdm[1][j] = eq->sdm[0][j];
+         eq->sdm[0][j] = in * voice->mod_gain_cur;
+
+         _samplesOut[k + j] = in + (out - in) * voice->mod_drywet_cur;
+      }
+
+      // Next frame
+      k += 2u;
+      voice->mod_drywet_cur  += voice->mod_drywet_inc;
+      voice->mod_gain_cur    += voice->mod_gain_inc;
+      voice->mod_freqlo_cur  += voice->mod_freqlo_inc;
+      voice->mod_freqhi_cur  += voice->mod_freqhi_inc;
+   }
+}
+
+static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
+                                              int                 _bMonoIn,
+                                              const float        *_samplesIn,
+                                              float              *_samplesOut, 
+                                              unsigned int        _numFrames
+                                              ) {
+   ST_PLUGIN_VOICE_CAST(eq3_voice_t);
+   (void)_bMonoIn;
+
+   if(1.0f == voice->mod_gainlo_cur  && 0.0f == voice->mod_gainlo_inc  &&
+      1.0f == voice->mod_gainmid_cur && 0.0f == voice->mod_gainmid_inc &&
+      1.0f == voice->mod_gainhi_cur  && 0.0f == voice->mod_gainhi_inc
+      )
+   {
+      loc_process_bypass(voice, _samplesIn, _samplesOut, _numFrames);
+      voice->b_eq_idle = 1;
+   }
+   else
+   {
+      if(voice->b_eq_idle)
+      {
+         voice->eq.prime();
+         voice->b_eq_idle = 0;
+      }
+
+      // (note) recalc only when the modulated frequencies have changed
+      loc_sincos_cached(&voice->lf_start, ST_PLUGIN_PI * voice->mod_freqlo_cur);
+      loc_sincos_cached(&voice->lf_rot,   ST_PLUGIN_PI * voice->mod_freqlo_inc);
+      loc_sincos_cached(&voice->hf_start, ST_PLUGIN_PI * voice->mod_freqhi_cur);
+      loc_sincos_cached(&voice->hf_rot,   ST_PLUGIN_PI * voice->mod_freqhi_inc);
+
+      loc_process_filter(voice, _samplesIn, _samplesOut, _numFrames);
+   }
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   eq3_shared_t *ret = (eq3_shared_t *)malloc(sizeof(eq3_shared_t));
+   eq3_shared_t *ret = (eq3_shared_t *)Dstplugin_alloc(_info, sizeof(eq3_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -444,12 +639,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   eq3_voice_t *ret = (eq3_voice_t *)malloc(sizeof(eq3_voice_t));
+   eq3_voice_t *ret = (eq3_voice_t *)Dstplugin_alloc(_info, sizeof(eq3_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -458,8 +653,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(eq3_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -490,6 +691,7 @@ st_plugin_info_t *eq3_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -9,7 +9,7 @@
 // ----           see <http://musicdsp.org/showArchiveComment.php?ArchiveID=24>
 // ----
 // ---- created: 05Jun2020
-// ---- changed: 
+// ---- changed: 17Oct2026
 // ----
 // ----
 // ----
@@ -17,125 +17,510 @@
 #ifndef ST_LADDER_LPF_H__
 #define ST_LADDER_LPF_H__
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define ST_LADDER_LPF_SSE2  1
+#include <emmintrin.h>
+#endif
+
+
+// L/R lane pair operations
+//  - SSE2: lane 0 = left, lane 1 = right (lanes 2/3 are unused and stay 0, except in StLadderLPF_process_cascade())
+//           tanh() / sin() / exp() are evaluated with polynomial approximations
+//           (max. abs. error: tanh() ~1.5e-7 (rel. error < 7e-7, also near 0), sin() ~1.8e-7, asym() ~1.7e-6)
+//  - fallback: plain C, libm
+#ifdef ST_LADDER_LPF_SSE2
+struct StLadderLanes {
+   typedef __m128 vec_t;
+
+   static inline vec_t load  (const float *_s)       { return _mm_loadu_ps(_s); }
+   static inline void  store (float *_d, vec_t _v)   { _mm_storeu_ps(_d, _v); }
+   static inline vec_t load2 (const float *_s)       { return _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)_s); }
+   static inline void  store2(float *_d, vec_t _v)   { _mm_storel_pi((__m64*)_d, _v); }
+   static inline vec_t set   (float _l, float _r)    { return _mm_setr_ps(_l, _r, 0.0f, 0.0f); }
+   static inline vec_t set1  (float _f)              { return _mm_set1_ps(_f); }
+   static inline float left  (vec_t _v)              { return _mm_cvtss_f32(_v); }
+   static inline vec_t add   (vec_t _a, vec_t _b)    { return _mm_add_ps(_a, _b); }
+   static inline vec_t sub   (vec_t _a, vec_t _b)    { return _mm_sub_ps(_a, _b); }
+   static inline vec_t mul   (vec_t _a, vec_t _b)    { return _mm_mul_ps(_a, _b); }
+   static inline vec_t div   (vec_t _a, vec_t _b)    { return _mm_div_ps(_a, _b); }
+   static inline vec_t min   (vec_t _a, vec_t _b)    { return _mm_min_ps(_a, _b); }
+   static inline vec_t max   (vec_t _a, vec_t _b)    { return _mm_max_ps(_a, _b); }
+
+   static inline vec_t fixDenorm(vec_t _v) {
+      // see Dstplugin_fix_denorm_32()
+      const __m128 c = _mm_set1_ps(10.0f);
+      return _mm_sub_ps(_mm_add_ps(_v, c), c);
+   }
 
+   // 2^x (x=-126..126), rel. error < 2e-7
+   static inline vec_t pow2(vec_t _x) {
+      _x = _mm_min_ps(_mm_max_ps(_x, _mm_set1_ps(-126.0f)), _mm_set1_ps(126.0f));
+      __m128i n = _mm_cvtps_epi32(_x);  // round to nearest
+      __m128  f = _mm_sub_ps(_x, _mm_cvtepi32_ps(n));  // -0.5..0.5
+      __m128  p = _mm_set1_ps(1.5403530e-4f);
+      p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.3333558e-3f));
+      p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(9.6181291e-3f));
+      p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(5.5504109e-2f));
+      p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(2.4022651e-1f));
+      p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(6.9314718e-1f));
+      p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.0f));
+      __m128i e = _mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23);
+      return _mm_mul_ps(p, _mm_castsi128_ps(e));
+   }
+
+   // 2^x - 1 (x=-126..126), without the cancellation of pow2(x) - 1 near x=0 (rel. error < 7e-7)
+   static inline vec_t pow2m1(vec_t _x) {
+      _x = _mm_min_ps(_mm_max_ps(_x, _mm_set1_ps(-126.0f)), _mm_set1_ps(126.0f));
+      __m128i n = _mm_cvtps_epi32(_x);  // round to nearest
+      __m128  f = _mm_sub_ps(_x, _mm_cvtepi32_ps(n));  // -0.5..0.5
+      __m128  p = _mm_set1_ps(1.5403530e-4f);
+      p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.3333558e-3f));
+      p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(9.6181291e-3f));
+      p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(5.5504109e-2f));
+      p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(2.4022651e-1f));
+      p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(6.9314718e-1f));
+      p = _mm_mul_ps(p, f);  // 2^f - 1
+      // 2^n * (2^f - 1) + (2^n - 1)
+      __m128 e = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+      return _mm_add_ps(_mm_mul_ps(p, e), _mm_sub_ps(e, _mm_set1_ps(1.0f)));
+   }
+
+   static inline vec_t exp(vec_t _x) {
+      return pow2(_mm_mul_ps(_x, _mm_set1_ps(1.44269504f)));
+   }
+
+   // (e^2x - 1) / (e^2x + 1)
+   static inline vec_t tanh(vec_t _x) {
+      _x = _mm_min_ps(_mm_max_ps(_x, _mm_set1_ps(-9.0f)), _mm_set1_ps(9.0f));
+      __m128 em1 = pow2m1(_mm_mul_ps(_x, _mm_set1_ps(2.0f * 1.44269504f)));
+      return _mm_div_ps(em1, _mm_add_ps(em1, _mm_set1_ps(2.0f)));
+   }
+
+   static inline vec_t sin(vec_t _x) {
+      // reduce to -PI/2..PI/2, sin(x + k*PI) = (-1)^k * sin(x)
+      __m128i k  = _mm_cvtps_epi32(_mm_mul_ps(_x, _mm_set1_ps(0.318309886f)));
+      __m128  kf = _mm_cvtepi32_ps(k);
+      __m128  r  = _mm_sub_ps(_x, _mm_mul_ps(kf, _mm_set1_ps(3.140625f)));
+      r = _mm_sub_ps(r, _mm_mul_ps(kf, _mm_set1_ps(9.67653589793e-4f)));
+      __m128  r2 = _mm_mul_ps(r, r);
+      __m128  p  = _mm_set1_ps(-2.5052108e-8f);
+      p = _mm_add_ps(_mm_mul_ps(p, r2), _mm_set1_ps( 2.7557319e-6f));
+      p = _mm_add_ps(_mm_mul_ps(p, r2), _mm_set1_ps(-1.9841270e-4f));
+      p = _mm_add_ps(_mm_mul_ps(p, r2), _mm_set1_ps( 8.3333333e-3f));
+      p = _mm_add_ps(_mm_mul_ps(p, r2), _mm_set1_ps(-1.6666667e-1f));
+      p = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, r2), r), r);
+      __m128i sgn = _mm_slli_epi32(k, 31);
+      return _mm_xor_ps(p, _mm_castsi128_ps(sgn));
+   }
+
+   // asymmetric waveshaper
+   //   (exp(4*sin(x)) - exp(-5*sin(x))) / (exp(4*sin(x)) + exp(-4*sin(x)))
+   //    = (exp(9*sin(x)) - 1) / (exp(9*sin(x)) + exp(sin(x)))
+   static inline vec_t asym(vec_t _x) {
+      __m128 s    = sin(_x);
+      __m128 e9m1 = pow2m1(_mm_mul_ps(s, _mm_set1_ps(9.0f * 1.44269504f)));
+      __m128 e1   = exp(s);
+      return _mm_div_ps(e9m1, _mm_add_ps(e9m1, _mm_add_ps(e1, _mm_set1_ps(1.0f))));
+   }
+};
+#else
+struct StLadderLanes {
+   struct vec_t { float l, r; };
+
+   static inline vec_t load  (const float *_s)       { vec_t r = { _s[0], _s[1] }; return r; }
+   static inline void  store (float *_d, vec_t _v)   { _d[0] = _v.l; _d[1] = _v.r; }
+   static inline vec_t load2 (const float *_s)       { return load(_s); }
+   static inline void  store2(float *_d, vec_t _v)   { store(_d, _v); }
+   static inline vec_t set   (float _l, float _r)    { vec_t r = { _l, _r }; return r; }
+   static inline vec_t set1  (float _f)              { vec_t r = { _f, _f }; return r; }
+   static inline float left  (vec_t _v)              { return _v.l; }
+   static inline vec_t add   (vec_t _a, vec_t _b)    { return set(_a.l + _b.l, _a.r + _b.r); }
+   static inline vec_t sub   (vec_t _a, vec_t _b)    { return set(_a.l - _b.l, _a.r - _b.r); }
+   static inline vec_t mul   (vec_t _a, vec_t _b)    { return set(_a.l * _b.l, _a.r * _b.r); }
+   static inline vec_t div   (vec_t _a, vec_t _b)    { return set(_a.l / _b.l, _a.r / _b.r); }
+   static inline vec_t min   (vec_t _a, vec_t _b)    { return set(Dstplugin_min(_a.l, _b.l), Dstplugin_min(_a.r, _b.r)); }
+   static inline vec_t max   (vec_t _a, vec_t _b)    { return set(Dstplugin_max(_a.l, _b.l), Dstplugin_max(_a.r, _b.r)); }
+   static inline vec_t fixDenorm(vec_t _v)           { return set(Dstplugin_fix_denorm_32(_v.l), Dstplugin_fix_denorm_32(_v.r)); }
+   static inline vec_t pow2  (vec_t _x)              { return set(powf(2.0f, _x.l), powf(2.0f, _x.r)); }
+   static inline vec_t tanh  (vec_t _x)              { return set(tanhf(_x.l), tanhf(_x.r)); }
+
+   static inline float asym1(float _x) {
+      return (float) (
+         (exp(sin(_x)*4) - exp(-sin(_x)*4*1.25)) /
+         (exp(sin(_x)*4) + exp(-sin(_x)*4))
+                      );
+   }
+   static inline vec_t asym  (vec_t _x)              { return set(asym1(_x.l), asym1(_x.r)); }
+};
+#endif // ST_LADDER_LPF_SSE2
+
+
+// stereo (L/R lanes) ladder filter
 class StLadderLPF {
   public:
-   float x, y1, y2, y3, y4; // temporary
-   float oldx, oldy1, oldy2, oldy3;
-   float newy4;
-
-   float param_p_cur;
-   float param_p_inc;
-   float param_k_cur;
-   float param_k_inc;
-   float param_r_cur;
-   float param_r_inc;
-   float gain_cur;
-   float gain_inc;
-   float gain2_cur;
-   float gain2_inc;
+   typedef StLadderLanes L;
+
+   // (note) float[4] + unaligned loads/stores: voice structs are not necessarily 16 byte aligned
+   float oldx[4];
+   float y1[4], y2[4], y3[4], y4[4];
+
+   float param_p_cur[4];
+   float param_p_inc[4];
+   float param_k_cur[4];
+   float param_k_inc[4];
+   float param_r_cur[4];
+   float param_r_inc[4];
+   float gain_cur[4];
+   float gain_inc[4];
+   float gain2_cur[4];
+   float gain2_inc[4];
 
    inline void reset(void) {
-      x = y1 = y2 = y3 = y4 = 0.0f;
-      oldx = oldy1 = oldy2 = oldy3 = 0.0f;
-      newy4 = 0.0f;
+      for(unsigned int i = 0u; i < 4u; i++)
+      {
+         oldx[i] = y1[i] = y2[i] = y3[i] = y4[i] = 0.0f;
+      }
    }
 
-   inline void shuffle(void) {
-      oldx  = x;
-      oldy1 = y1;
-      oldy2 = y2;
-      oldy3 = y3;
-      y4    = newy4;
-   }
+   void calcCoeff(unsigned int _numFrames, L::vec_t freq, L::vec_t q, float drive3/*1.13f*/, float drive4/*1.0f*/) {
+      // p = freq * (1.8 - 0.8 * freq)
+      L::vec_t nextP = L::mul(freq, L::sub(L::set1(1.8f), L::mul(L::set1(0.8f), freq)));
+      L::vec_t nextK = L::sub(L::add(nextP, nextP), L::set1(1.0f));
 
-   void calcCoeff(unsigned int _numFrames, float freq, float q, float drive3/*1.13f*/, float drive4/*1.0f*/) {
-      float nextP = freq * (1.8f - 0.8f * freq);
-      float nextK = nextP + nextP - 1.0f;
-      
-      float t  = (1.0f - nextP) * 1.386249f;
-      float t2 = 12.0f + t * t;
-      float nextR = q * (t2 + 6.0f * t) / (t2 - 6.0f * t);
+      L::vec_t t  = L::mul(L::sub(L::set1(1.0f), nextP), L::set1(1.386249f));
+      L::vec_t t2 = L::add(L::set1(12.0f), L::mul(t, t));
+      L::vec_t t6 = L::mul(L::set1(6.0f), t);
+      L::vec_t nextR = L::div(L::mul(q, L::add(t2, t6)), L::sub(t2, t6));
 
 #define FREQ_THRESHOLD 0.4f
-      float nextGain;
-      if(freq <= FREQ_THRESHOLD)
-      {
-         float f = (freq / FREQ_THRESHOLD);
-         nextGain = q * (1.0f-f);
-         nextGain = nextGain*nextGain * (3.02f - 2.0f*nextGain);
-         /* nextGain = (/\*1.0f + *\/nextGain * drive3/\**1.13f*\/); */
-         nextGain = ((1.0f + nextGain) * drive3/**1.13f*/);
-      }
-      else
-         nextGain = drive3;
+      // (note) f=1 above FREQ_THRESHOLD => nextGain = drive3
+      L::vec_t f = L::min(L::div(freq, L::set1(FREQ_THRESHOLD)), L::set1(1.0f));
+      L::vec_t nextGain = L::mul(q, L::sub(L::set1(1.0f), f));
+      nextGain = L::mul(L::mul(nextGain, nextGain), L::sub(L::set1(3.02f), L::add(nextGain, nextGain)));
+      nextGain = L::mul(L::add(L::set1(1.0f), nextGain), L::set1(drive3/**1.13f*/));
+#undef FREQ_THRESHOLD
+
+      L::vec_t nextGain2 = L::set1(drive4);
 
       if(0u == _numFrames)
       {
-         param_p_cur = nextP;
-         param_p_inc = 0.0f;
-         param_k_cur = nextK;
-         param_k_inc = 0.0f;
-         param_r_cur = nextR;
-         param_r_inc = 0.0f;
-         gain_cur = nextGain;
-         gain_inc = 0.0f;
-         gain2_cur = drive4;
-         gain2_inc = 0.0f;
+         L::store(param_p_cur, nextP);
+         L::store(param_k_cur, nextK);
+         L::store(param_r_cur, nextR);
+         L::store(gain_cur,    nextGain);
+         L::store(gain2_cur,   nextGain2);
+         L::store(param_p_inc, L::set1(0.0f));
+         L::store(param_k_inc, L::set1(0.0f));
+         L::store(param_r_inc, L::set1(0.0f));
+         L::store(gain_inc,    L::set1(0.0f));
+         L::store(gain2_inc,   L::set1(0.0f));
       }
       else
       {
-         float recBlockSize = (1.0f / _numFrames);
-         param_p_inc = (nextP    - param_p_cur) * recBlockSize;
-         param_k_inc = (nextK    - param_k_cur) * recBlockSize;
-         param_r_inc = (nextR    - param_r_cur) * recBlockSize;
-         gain_inc    = (nextGain - gain_cur)    * recBlockSize;
-         gain2_inc   = (drive4   - gain2_cur)   * recBlockSize;
+         L::vec_t recBlockSize = L::set1(1.0f / _numFrames);
+         L::store(param_p_inc, L::mul(L::sub(nextP,     L::load(param_p_cur)), recBlockSize));
+         L::store(param_k_inc, L::mul(L::sub(nextK,     L::load(param_k_cur)), recBlockSize));
+         L::store(param_r_inc, L::mul(L::sub(nextR,     L::load(param_r_cur)), recBlockSize));
+         L::store(gain_inc,    L::mul(L::sub(nextGain,  L::load(gain_cur)),    recBlockSize));
+         L::store(gain2_inc,   L::mul(L::sub(nextGain2, L::load(gain2_cur)),   recBlockSize));
       }
    }
 
-   inline float filter(float _smp) {
+   void calcCoeff(unsigned int _numFrames, float freqL, float freqR, float q, float drive3/*1.13f*/, float drive4/*1.0f*/) {
+      calcCoeff(_numFrames, L::set(freqL, freqR), L::set1(q), drive3, drive4);
+   }
+
+   // one filter step (updates the state args)
+   static inline L::vec_t Tick(L::vec_t _smp,
+                               L::vec_t _p, L::vec_t _k, L::vec_t _r, L::vec_t _gain, L::vec_t _gain2,
+                               L::vec_t &_oldx, L::vec_t &_y1, L::vec_t &_y2, L::vec_t &_y3, L::vec_t &_y4
+                               ) {
       // Inverted feed back for corner peaking
-      x = _smp - param_r_cur * y4;
-      x = Dstplugin_fix_denorm_32(x);
+      L::vec_t x = L::fixDenorm(L::sub(_smp, L::mul(_r, _y4)));
 
       //Four cascaded onepole filters (bilinear transform)
-      y1    = x *param_p_cur + oldx *param_p_cur - y1*param_k_cur;
-      y2    = y1*param_p_cur + oldy1*param_p_cur - y2*param_k_cur;
-      y3    = y2*param_p_cur + oldy2*param_p_cur - y3*param_k_cur;
-      newy4 = y3*param_p_cur + oldy3*param_p_cur - y4*param_k_cur;   
-
-#if 1
-      y1    = Dstplugin_fix_denorm_32(y1);
-      y2    = Dstplugin_fix_denorm_32(y2);
-      y3    = Dstplugin_fix_denorm_32(y3);
-      newy4 = Dstplugin_fix_denorm_32(newy4);
-#endif
+      //  (note) same operation order as the scalar filter (x*p + oldx*p - y*k) => no extra rounding differences
+      L::vec_t y1n = L::fixDenorm(L::sub(L::add(L::mul(x,   _p), L::mul(_oldx, _p)), L::mul(_y1, _k)));
+      L::vec_t y2n = L::fixDenorm(L::sub(L::add(L::mul(y1n, _p), L::mul(_y1,   _p)), L::mul(_y2, _k)));
+      L::vec_t y3n = L::fixDenorm(L::sub(L::add(L::mul(y2n, _p), L::mul(_y2,   _p)), L::mul(_y3, _k)));
+      L::vec_t y4n = L::fixDenorm(L::sub(L::add(L::mul(y3n, _p), L::mul(_y3,   _p)), L::mul(_y4, _k)));
 
       //Clipper band limited sigmoid
-      newy4 = newy4 - ((newy4*newy4*newy4)/6.0f);
+      y4n = L::sub(y4n, L::div(L::mul(L::mul(y4n, y4n), y4n), L::set1(6.0f)));
+
+      y4n = L::tanh(L::mul(_gain, y4n));
+
+      _oldx = x;
+      _y1   = y1n;
+      _y2   = y2n;
+      _y3   = y3n;
+      _y4   = y4n;
+
+      return L::tanh(L::mul(_gain2, y4n));
+   }
+
+   inline L::vec_t filter(L::vec_t _smp) {
+      L::vec_t p     = L::load(param_p_cur);
+      L::vec_t k     = L::load(param_k_cur);
+      L::vec_t r     = L::load(param_r_cur);
+      L::vec_t gain  = L::load(gain_cur);
+      L::vec_t gain2 = L::load(gain2_cur);
 
-      /* if(newy4 > 2.0f) */
-      /*    newy4 = 2.0f; */
-      /* else if(newy4 < -2.0f) */
-      /*    newy4 = -2.0f; */
-      newy4 = tanhf(gain_cur * newy4);
-      /* newy4 = gain_cur * newy4; */
+      L::vec_t x  = L::load(oldx);
+      L::vec_t s1 = L::load(this->y1);
+      L::vec_t s2 = L::load(this->y2);
+      L::vec_t s3 = L::load(this->y3);
+      L::vec_t s4 = L::load(this->y4);
 
-      float out = tanhf(gain2_cur * newy4);
-      /* float out = gain2_cur * newy4; */
+      L::vec_t out = Tick(_smp, p, k, r, gain, gain2, x, s1, s2, s3, s4);
 
-      param_p_cur += param_p_inc;
-      param_k_cur += param_k_inc;
-      param_r_cur += param_r_inc;
-      gain_cur    += gain_inc;
-      gain2_cur   += gain2_inc;
+      L::store(param_p_cur, L::add(p,     L::load(param_p_inc)));
+      L::store(param_k_cur, L::add(k,     L::load(param_k_inc)));
+      L::store(param_r_cur, L::add(r,     L::load(param_r_inc)));
+      L::store(gain_cur,    L::add(gain,  L::load(gain_inc)));
+      L::store(gain2_cur,   L::add(gain2, L::load(gain2_inc)));
 
-      shuffle();
+      L::store(oldx,     x);
+      L::store(this->y1, s1);
+      L::store(this->y2, s2);
+      L::store(this->y3, s3);
+      L::store(this->y4, s4);
 
       return out;
    }
 };
 
 
+// Serial (per-frame, per-stage) reference implementation of StLadderLPF_process_cascade()
+template <unsigned int NS>
+static void StLadderLPF_process_serial(StLadderLPF  *_lpf,
+                                       int           _bMonoIn,
+                                       const float  *_samplesIn,
+                                       float        *_samplesOut,
+                                       unsigned int  _numFrames,
+                                       float        &_drive1Cur,
+                                       float         _drive1Inc,
+                                       float        &_drive2Cur,
+                                       float         _drive2Inc,
+                                       float        &_drywetCur,
+                                       float         _drywetInc
+                                       ) {
+   typedef StLadderLanes L;
+   unsigned int k = 0u;
+
+   for(unsigned int i = 0u; i < _numFrames; i++)
+   {
+      L::vec_t in  = _bMonoIn ? L::set1(_samplesIn[k]) : L::load2(&_samplesIn[k]);
+      L::vec_t out = in;
+
+      L::vec_t drive1 = L::set1(_drive1Cur);
+      L::vec_t drive2 = L::set1(_drive2Cur);
+
+      for(unsigned int stageIdx = 0u; stageIdx < NS; stageIdx++)
+      {
+         out = L::mul(L::tanh(L::mul(out, drive1)), drive2);
+         out = L::asym(out);
+         out = _lpf[stageIdx].filter(out);
+      }
+      out = L::add(in, L::mul(L::sub(out, in), L::set1(_drywetCur)));
+      L::store2(&_samplesOut[k], out);
+
+      // Next frame
+      k += 2u;
+      _drywetCur += _drywetInc;
+      _drive1Cur += _drive1Inc;
+      _drive2Cur += _drive2Inc;
+   }
+}
+
+
+// Stereo cascade of NS (drive + asym waveshaper + ladder filter) stages, followed by the dry/wet mix (ladder_lpf* plugins)
+//  - SSE2: the stages are evaluated as a wavefront: in step t, stage s renders frame (t - s).
+//           Two stages (L/R) share an __m128, i.e. all stages run in parallel instead of forming one long
+//           serial (tanh -> asym -> filter -> tanh ..) dependency chain per sample frame.
+//  - single stage / no SSE2: serial per-frame / per-stage loop (StLadderLPF_process_serial())
+//  - _samplesIn may be equal to _samplesOut (in-place processing)
+//  - _bMonoIn: read left input channel only
+template <unsigned int NS>
+static void StLadderLPF_process_cascade(StLadderLPF  *_lpf,
+                                        int           _bMonoIn,
+                                        const float  *_samplesIn,
+                                        float        *_samplesOut,
+                                        unsigned int  _numFrames,
+                                        float        &_drive1Cur,
+                                        float         _drive1Inc,
+                                        float        &_drive2Cur,
+                                        float         _drive2Inc,
+                                        float        &_drywetCur,
+                                        float         _drywetInc
+                                        ) {
+   if(0u == _numFrames)
+      return;
+
+#ifdef ST_LADDER_LPF_SSE2
+   typedef StLadderLanes L;
+
+   if(NS < 2u)
+   {
+      // (note) a single stage does not benefit from the wavefront (frames are not serially dependent before the filter)
+      StLadderLPF_process_serial<NS>(_lpf, _bMonoIn, _samplesIn, _samplesOut, _numFrames,
+                                     _drive1Cur, _drive1Inc, _drive2Cur, _drive2Inc, _drywetCur, _drywetInc
+                                     );
+      return;
+   }
+
+   // lane = (stageIdx * 2 + channelIdx), vector v holds stages (2*v) and (2*v + 1)
+   const unsigned int NV = (NS + 1u) >> 1;
+
+   StLadderLPF lpfNone;  // unused upper lanes when NS is odd
+   memset((void*)&lpfNone, 0, sizeof(lpfNone));
+
+   __m128 vOldx[NV], vY1[NV], vY2[NV], vY3[NV], vY4[NV];
+   __m128 vP[NV], vK[NV], vR[NV], vGain[NV], vGain2[NV];
+   __m128 vPInc[NV], vKInc[NV], vRInc[NV], vGainInc[NV], vGain2Inc[NV];
+   __m128 vDrive1[NV], vDrive2[NV];
+   __m128 vStage[NV];
+   __m128 vOut[NV];
+
+   const __m128 vDrive1Inc = _mm_set1_ps(_drive1Inc);
+   const __m128 vDrive2Inc = _mm_set1_ps(_drive2Inc);
+
+#define Dpack(a) _mm_movelh_ps(L::load2(lpfA.a), L::load2(lpfB.a))
+   for(unsigned int v = 0u; v < NV; v++)
+   {
+      const StLadderLPF &lpfA = _lpf[2u * v];
+      const StLadderLPF &lpfB = ((2u * v + 1u) < NS) ? _lpf[2u * v + 1u] : lpfNone;
+
+      vStage[v] = _mm_setr_ps(float(2u * v), float(2u * v), float(2u * v + 1u), float(2u * v + 1u));
+
+      vOldx[v] = Dpack(oldx);
+      vY1[v]   = Dpack(y1);
+      vY2[v]   = Dpack(y2);
+      vY3[v]   = Dpack(y3);
+      vY4[v]   = Dpack(y4);
+
+      // (note) the parameter ramps only advance while a stage renders a frame of this block (see bMask),
+      //         i.e. they accumulate exactly like the serial loop (StLadderLPF_process_serial())
+      vPInc[v]     = Dpack(param_p_inc);
+      vKInc[v]     = Dpack(param_k_inc);
+      vRInc[v]     = Dpack(param_r_inc);
+      vGainInc[v]  = Dpack(gain_inc);
+      vGain2Inc[v] = Dpack(gain2_inc);
+      vP[v]        = Dpack(param_p_cur);
+      vK[v]        = Dpack(param_k_cur);
+      vR[v]        = Dpack(param_r_cur);
+      vGain[v]     = Dpack(gain_cur);
+      vGain2[v]    = Dpack(gain2_cur);
+      vDrive1[v]   = L::set1(_drive1Cur);
+      vDrive2[v]   = L::set1(_drive2Cur);
+
+      vOut[v] = _mm_setzero_ps();
+   }
+#undef Dpack
+
+   const unsigned int numSteps = _numFrames + NS - 1u;
+   const __m128 vNumFrames = _mm_set1_ps(float(_numFrames));
+
+   for(unsigned int t = 0u; t < numSteps; t++)
+   {
+      __m128 in;
+      if(t < _numFrames)
+         in = _bMonoIn ? _mm_set1_ps(_samplesIn[2u * t]) : L::load2(&_samplesIn[2u * t]);
+      else
+         in = _mm_setzero_ps();
+
+      // shift previous stage outputs to next stage inputs
+      __m128 x[NV];
+      x[0] = _mm_movelh_ps(in, vOut[0]);
+      for(unsigned int v = 1u; v < NV; v++)
+         x[v] = _mm_shuffle_ps(vOut[v - 1u], vOut[v], _MM_SHUFFLE(1,0,3,2));
+
+      // pipeline fill / drain: lanes outside of the block keep their state and parameters
+      const bool bMask = (t < (NS - 1u)) || (t >= _numFrames);
+      const __m128 vT = _mm_set1_ps(float(t));
+
+      for(unsigned int v = 0u; v < NV; v++)
+      {
+         __m128 smp = L::mul(L::tanh(L::mul(x[v], vDrive1[v])), vDrive2[v]);
+         smp = L::asym(smp);
+
+         if(bMask)
+         {
+            const __m128 frameIdx = _mm_sub_ps(vT, vStage[v]);
+            const __m128 m = _mm_and_ps(_mm_cmpge_ps(frameIdx, _mm_setzero_ps()),
+                                        _mm_cmplt_ps(frameIdx, vNumFrames)
+                                        );
+            __m128 s0 = vOldx[v], s1 = vY1[v], s2 = vY2[v], s3 = vY3[v], s4 = vY4[v];
+            vOut[v] = StLadderLPF::Tick(smp, vP[v], vK[v], vR[v], vGain[v], vGain2[v], s0, s1, s2, s3, s4);
+#define Dblend(d,n) d = _mm_or_ps(_mm_and_ps(m, n), _mm_andnot_ps(m, d))
+            Dblend(vOldx[v], s0);
+            Dblend(vY1[v],   s1);
+            Dblend(vY2[v],   s2);
+            Dblend(vY3[v],   s3);
+            Dblend(vY4[v],   s4);
+#undef Dblend
+            vP[v]      = L::add(vP[v],      _mm_and_ps(m, vPInc[v]));
+            vK[v]      = L::add(vK[v],      _mm_and_ps(m, vKInc[v]));
+            vR[v]      = L::add(vR[v],      _mm_and_ps(m, vRInc[v]));
+            vGain[v]   = L::add(vGain[v],   _mm_and_ps(m, vGainInc[v]));
+            vGain2[v]  = L::add(vGain2[v],  _mm_and_ps(m, vGain2Inc[v]));
+            vDrive1[v] = L::add(vDrive1[v], _mm_and_ps(m, vDrive1Inc));
+            vDrive2[v] = L::add(vDrive2[v], _mm_and_ps(m, vDrive2Inc));
+         }
+         else
+         {
+            vOut[v] = StLadderLPF::Tick(smp, vP[v], vK[v], vR[v], vGain[v], vGain2[v], vOldx[v], vY1[v], vY2[v], vY3[v], vY4[v]);
+            vP[v]      = L::add(vP[v],      vPInc[v]);
+            vK[v]      = L::add(vK[v],      vKInc[v]);
+            vR[v]      = L::add(vR[v],      vRInc[v]);
+            vGain[v]   = L::add(vGain[v],   vGainInc[v]);
+            vGain2[v]  = L::add(vGain2[v],  vGain2Inc[v]);
+            vDrive1[v] = L::add(vDrive1[v], vDrive1Inc);
+            vDrive2[v] = L::add(vDrive2[v], vDrive2Inc);
+         }
+      }
+
+      if(t >= (NS - 1u))
+      {
+         // last stage output = frame (t - NS + 1)
+         const unsigned int k = 2u * (t - (NS - 1u));
+         __m128 out = vOut[(NS - 1u) >> 1];
+         if(0u == (NS & 1u))
+            out = _mm_movehl_ps(out, out);
+         const __m128 dry = _bMonoIn ? _mm_set1_ps(_samplesIn[k]) : L::load2(&_samplesIn[k]);
+         out = L::add(dry, L::mul(L::sub(out, dry), L::set1(_drywetCur)));
+         L::store2(&_samplesOut[k], out);
+         _drywetCur += _drywetInc;
+      }
+   }
+
+   for(unsigned int v = 0u; v < NV; v++)
+   {
+      StLadderLPF &lpfA = _lpf[2u * v];
+      StLadderLPF &lpfB = ((2u * v + 1u) < NS) ? _lpf[2u * v + 1u] : lpfNone;
+#define Dunpack(a,s) L::store2(lpfA.a, s); _mm_storeh_pi((__m64*)lpfB.a, s)
+      Dunpack(oldx, vOldx[v]);
+      Dunpack(y1,   vY1[v]);
+      Dunpack(y2,   vY2[v]);
+      Dunpack(y3,   vY3[v]);
+      Dunpack(y4,   vY4[v]);
+      Dunpack(param_p_cur, vP[v]);
+      Dunpack(param_k_cur, vK[v]);
+      Dunpack(param_r_cur, vR[v]);
+      Dunpack(gain_cur,    vGain[v]);
+      Dunpack(gain2_cur,   vGain2[v]);
+#undef Dunpack
+   }
+
+   // (note) all lanes have advanced by _numFrames steps
+   _drive1Cur = _mm_cvtss_f32(vDrive1[0]);
+   _drive2Cur = _mm_cvtss_f32(vDrive2[0]);
+
+#else
+   StLadderLPF_process_serial<NS>(_lpf, _bMonoIn, _samplesIn, _samplesOut, _numFrames,
+                                  _drive1Cur, _drive1Inc, _drive2Cur, _drive2Inc, _drywetCur, _drywetInc
+                                  );
+#endif // ST_LADDER_LPF_SSE2
+}
+
 #endif // ST_LADDER_LPF_H__
@@ -9,7 +9,7 @@
 // ----           see <http://musicdsp.org/showArchiveComment.php?ArchiveID=24>
 // ----
 // ---- created: 05Jun2020
-// ---- changed: 08Jun2020, 21Jan2024
+// ---- changed: 08Jun2020, 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -87,8 +87,7 @@ typedef struct ladder_lpf_no_pan_voice_s {
    float     mod_drive1_inc;
    float     mod_drive2_cur;
    float     mod_drive2_inc;
-   StLadderLPF lpf_l[NUM_STAGES];
-   StLadderLPF lpf_r[NUM_STAGES];
+   StLadderLPF lpf[NUM_STAGES];
 } ladder_lpf_no_pan_voice_t;
 
 
@@ -150,8 +149,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
 
       for(unsigned int i = 0u; i < NUM_STAGES; i++)
       {
-         voice->lpf_l[i].reset();
-         voice->lpf_r[i].reset();
+         voice->lpf[i].reset();
       }
    }
 }
@@ -225,19 +223,13 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
 
    for(unsigned int i = 0u; i < NUM_STAGES; i++)
    {
-      voice->lpf_l[i].calcCoeff(_numFrames,
-                                modFreq,
-                                modQ,
-                                modDrive3,
-                                modDrive4
-                                );
-
-      voice->lpf_r[i].calcCoeff(_numFrames,
-                                modFreq,
-                                modQ,
-                                modDrive3,
-                                modDrive4
-                                );
+      voice->lpf[i].calcCoeff(_numFrames,
+                              modFreq,
+                              modFreq,
+                              modQ,
+                              modDrive3,
+                              modDrive4
+                              );
    }
 
 }
@@ -252,87 +244,22 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
    ST_PLUGIN_VOICE_CAST(ladder_lpf_no_pan_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(ladder_lpf_no_pan_shared_t);
 
-   unsigned int k = 0u;
-
-   if(_bMonoIn)
-   {
-      // Mono input, stereo output
-      for(unsigned int i = 0u; i < _numFrames; i++)
-      {
-         float l = _samplesIn[k];
-
-         float outL = l;
-
-         for(unsigned int i = 0u; i < NUM_STAGES; i++)
-         {
-#if 1
-            outL = tanhf(outL * voice->mod_drive1_cur) * voice->mod_drive2_cur;
-// #else
-            outL = (float) (
-               (exp(sin(outL)*4) - exp(-sin(outL)*4*1.25)) /
-               (exp(sin(outL)*4) + exp(-sin(outL)*4))
-                            );
-#endif
-            outL = voice->lpf_l[i].filter(outL);
-         }
-         outL = l + (outL - l) * voice->mod_drywet_cur;
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outL;
-
-         // Next frame
-         k += 2u;
-         voice->mod_drywet_cur += voice->mod_drywet_inc;
-         voice->mod_drive1_cur += voice->mod_drive1_inc;
-         voice->mod_drive2_cur += voice->mod_drive2_inc;
-      }
-   }
-   else
-   {
-      // Stereo input, stereo output
-      for(unsigned int i = 0u; i < _numFrames; i++)
-      {
-         float l = _samplesIn[k];
-         float r = _samplesIn[k + 1u];
-
-         float outL = l;
-         float outR = r;
-
-         for(unsigned int i = 0u; i < NUM_STAGES; i++)
-         {
-#if 1
-            outL = tanhf(outL * voice->mod_drive1_cur) * voice->mod_drive2_cur;
-            outR = tanhf(outR * voice->mod_drive1_cur) * voice->mod_drive2_cur;
-// #else
-            outL = (float) (
-               (exp(sin(outL)*4) - exp(-sin(outL)*4*1.25)) /
-               (exp(sin(outL)*4) + exp(-sin(outL)*4))
-                            );
-
-            outR = (float) (
-               (exp(sin(outR)*4) - exp(-sin(outR)*4*1.25)) /
-               (exp(sin(outR)*4) + exp(-sin(outR)*4))
-                            );
-#endif
-            outL = voice->lpf_l[i].filter(outL);
-            outR = voice->lpf_r[i].filter(outR);
-         }
-         outL = l + (outL - l) * voice->mod_drywet_cur;
-         outR = r + (outR - r) * voice->mod_drywet_cur;
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outR;
-
-         // Next frame
-         k += 2u;
-         voice->mod_drywet_cur += voice->mod_drywet_inc;
-         voice->mod_drive1_cur += voice->mod_drive1_inc;
-         voice->mod_drive2_cur += voice->mod_drive2_inc;
-      }
-   }
-
+   StLadderLPF_process_cascade<NUM_STAGES>(voice->lpf,
+                                           _bMonoIn,
+                                           _samplesIn,
+                                           _samplesOut,
+                                           _numFrames,
+                                           voice->mod_drive1_cur,
+                                           voice->mod_drive1_inc,
+                                           voice->mod_drive2_cur,
+                                           voice->mod_drive2_inc,
+                                           voice->mod_drywet_cur,
+                                           voice->mod_drywet_inc
+                                           );
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   ladder_lpf_no_pan_shared_t *ret = (ladder_lpf_no_pan_shared_t *)malloc(sizeof(ladder_lpf_no_pan_shared_t));
+   ladder_lpf_no_pan_shared_t *ret = (ladder_lpf_no_pan_shared_t *)Dstplugin_alloc(_info, sizeof(ladder_lpf_no_pan_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -343,12 +270,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   ladder_lpf_no_pan_voice_t *ret = (ladder_lpf_no_pan_voice_t *)malloc(sizeof(ladder_lpf_no_pan_voice_t));
+   ladder_lpf_no_pan_voice_t *ret = (ladder_lpf_no_pan_voice_t *)Dstplugin_alloc(_info, sizeof(ladder_lpf_no_pan_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -357,8 +284,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(ladder_lpf_no_pan_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -389,6 +322,7 @@ st_plugin_info_t *ladder_lpf_no_pan_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -11,7 +11,7 @@
 // ----           (note) see modfm_* Cycle voice plugin patches for a mathematically correct (but "clinical" sounding) implementation
 // ----
 // ---- created: 05Feb2024
-// ---- changed: 
+// ---- changed: , 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -23,6 +23,16 @@
 
 #include "../../../plugin.h"
 
+#include "wshaper.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define MODFM_SSE2  1
+#include <emmintrin.h>
+#endif
+
+#define MODFM_MAX_HARMONICS  36u   // multiple of 4 (max. "n" param value is 33)
+#define MODFM_LN_COEF_MAX    69.0  // harmonic amplitudes are clamped to 1e-30..1e30 (output is clamped to -16..16)
+
 #define PARAM_AMP      0
 #define PARAM_K        1
 #define PARAM_N        2
@@ -55,6 +65,8 @@ static const char *loc_mod_names[NUM_MODS] = {
 
 typedef struct modfm_info_s {
    st_plugin_info_t base;
+   const st_wshaper_t *ws_sin;  // shared (see wshaper.h)
+   double ln_fac[MODFM_MAX_HARMONICS];  // log(loc_fac(n + 1))
 } modfm_info_t;
 
 typedef struct modfm_shared_s {
@@ -78,6 +90,9 @@ typedef struct modfm_voice_s {
    float phase_c;  // 0..2PI
    float phase_m;  // 0..2PI
    float w_c;
+
+   // Harmonic amplitudes (k dependent terms, updated per sample frame)
+   float coef[MODFM_MAX_HARMONICS];
 } modfm_voice_t;
 
 
@@ -203,12 +218,40 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
 }
 
 static unsigned int loc_fac(unsigned int i) {
+   // (note) wraps around for i > 12 (this is part of the sound)
    unsigned int r = i;
    while(i > 2u)
       r *= --i;
    return r;
 }
 
+static void loc_calc_coefs(modfm_voice_t *_voice, const modfm_info_t *_info, unsigned int _numHarmonics) {
+   // In(k) = e^k / sqrt(2pi*k)
+   // A/e^k * sum{ In(k) * cos(wc*t + n*wm*t)
+   //
+   //  k=modulation index (modamt, e.g. 5)
+   //  n=bessel function order
+   //
+   //  (note) orig. per-sample evaluation (e^k cancels out):
+   //          inkNorm = e^k / k
+   //          ink     = (k/2)^(n+2) / (fac(1) * fac(n+1))
+   //          out     = A * sum{ inkNorm * ink * cos(..) } / e^k / 1.75^k
+   //  (note) evaluated as log(k/2)*(n+2) - log(fac(n+1)) - log(k) - log(1.75)*k (avoids overflows)
+   double k = _voice->mod_k_cur;
+   if(k < 0.0)
+      k = 1.0;
+   else if(k < 1.0e-9)
+      k = 1.0e-9;
+   const double lnK2 = log(k * 0.5);
+   const double lnC  = 2.0 * lnK2 - log(k) - 0.5596157879354227/*log(1.75)*/ * k;
+   for(unsigned int n = 0u; n < _numHarmonics; n++)
+   {
+      double lnCoef = lnC + lnK2 * n - _info->ln_fac[n];
+      lnCoef = Dstplugin_clamp(lnCoef, -MODFM_LN_COEF_MAX, MODFM_LN_COEF_MAX);
+      _voice->coef[n] = (float)exp(lnCoef);
+   }
+}
+
 static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
                                               int                 _bMonoIn,
                                               const float        *_samplesIn,
@@ -217,71 +260,155 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
                                               ) {
    // Ring modulate at (modulated) note frequency
    ST_PLUGIN_VOICE_CAST(modfm_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(modfm_shared_t);
+   ST_PLUGIN_VOICE_INFO_CAST(modfm_info_t);
+   (void)_bMonoIn;
+   (void)_samplesIn;
+
+   if(0u == _numFrames)
+      return;
+
+   // Number of harmonics (max. in this block)
+   float nfMax = voice->mod_n_cur;
+   if(voice->mod_n_inc > 0.0f)
+      nfMax += voice->mod_n_inc * _numFrames;
+   unsigned int numHarmonics = (nfMax > 0.0f) ? (unsigned int)(nfMax + 0.5f) : 0u;
+   numHarmonics = (numHarmonics + 3u) & ~3u;
+   if(numHarmonics > MODFM_MAX_HARMONICS)
+      numHarmonics = MODFM_MAX_HARMONICS;
+
+   // Harmonic amplitudes at block start
+   //  (note) k is interpolated linearly => coef(k+inc) = coef(k) * ((k+inc)/k)^(n+1) / 1.75^inc
+   loc_calc_coefs(voice, info, numHarmonics);
+   const float coefMulK = powf(1.75f, -voice->mod_k_inc);
+
+   // (note) mod_r is not interpolated
+   const float w_m = voice->w_c * voice->mod_r_cur;
 
    unsigned int outIdx = 0u;
 
    // Mono output
    for(unsigned int i = 0u; i < _numFrames; i++)
    {
-      // // float l = _samplesIn[outIdx];
-      double k = voice->mod_k_cur;
-      if(k < 0.0)
-         k = 1.0;
-
       float nf = voice->mod_n_cur;
       if(nf < 0.0f)
          nf = 0.0f;
       unsigned int nMax = (unsigned int)(nf+0.5f);
+      if(nMax > numHarmonics)
+         nMax = numHarmonics;
 
-      // In(k) = e^k / sqrt(2pi*k)
-      // A/e^k * sum{ In(k) * cos(wc*t + n*wm*t)
-      //
-      //  k=modulation index (modamt, e.g. 5)
-      //  n=bessel function order
-
-      double ek = pow(ST_PLUGIN_E, k);
-      double sqk = sqrt(ST_PLUGIN_2PI * k);
-      // double inkNorm = ek / sqk;  // orig
-      double inkNorm = ek / k;
-      // double inkNorm = 1.0f;
-      double aek = 1.0f / ek;
-      inkNorm *= voice->mod_amp_cur;
-
-      double outL = 0.0;
-      for(unsigned int n = 0u; n < nMax; n++)
+      // cos(phase_c + n * phase_m) = Re{ e^(i*phase_c) * e^(i*phase_m)^n }
+      float sinC, cosC, sinM, cosM;
+#ifdef MODFM_SSE2
+      {
+         union { __m128 v; float f[4]; } u;
+         u.v = st_wshaper_lookup4(info->ws_sin, _mm_setr_ps(voice->phase_c, voice->phase_c + ST_PLUGIN_PI2_F,
+                                                             voice->phase_m, voice->phase_m + ST_PLUGIN_PI2_F
+                                                             )
+                                  );
+         sinC = u.f[0];
+         cosC = u.f[1];
+         sinM = u.f[2];
+         cosM = u.f[3];
+      }
+#else
+      sinC = st_wshaper_lookup(info->ws_sin, voice->phase_c);
+      cosC = st_wshaper_lookup(info->ws_sin, voice->phase_c + ST_PLUGIN_PI2_F);
+      sinM = st_wshaper_lookup(info->ws_sin, voice->phase_m);
+      cosM = st_wshaper_lookup(info->ws_sin, voice->phase_m + ST_PLUGIN_PI2_F);
+#endif // MODFM_SSE2
+
+      float outL;
+#ifdef MODFM_SSE2
       {
-         double ink = 0.0;
-         for(unsigned int m = 1u; m < 2u; m++)
+         // 4 harmonics per iteration (rotate by e^(i*phase_m*4))
+         const float m2Re = cosM * cosM - sinM * sinM;
+         const float m2Im = 2.0f * cosM * sinM;
+         const float m3Re = m2Re * cosM - m2Im * sinM;
+         const float m3Im = m2Re * sinM + m2Im * cosM;
+         const __m128 m4Re = _mm_set1_ps(m2Re * m2Re - m2Im * m2Im);
+         const __m128 m4Im = _mm_set1_ps(2.0f * m2Re * m2Im);
+         __m128 zRe = _mm_setr_ps(cosC,
+                                  cosC * cosM - sinC * sinM,
+                                  cosC * m2Re - sinC * m2Im,
+                                  cosC * m3Re - sinC * m3Im
+                                  );
+         __m128 zIm = _mm_setr_ps(sinC,
+                                  cosC * sinM + sinC * cosM,
+                                  cosC * m2Im + sinC * m2Re,
+                                  cosC * m3Im + sinC * m3Re
+                                  );
+         __m128 n = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+         const __m128 nMaxV = _mm_set1_ps((float)nMax);
+         __m128 acc = _mm_setzero_ps();
+         for(unsigned int j = 0u; j < nMax; j += 4u)
          {
-            ink += pow(k*0.5, n+2*m) / ( loc_fac(m) * loc_fac(m + n) );
+            const __m128 t = _mm_mul_ps(_mm_loadu_ps(&voice->coef[j]), zRe);
+            acc = _mm_add_ps(acc, _mm_and_ps(t, _mm_cmplt_ps(n, nMaxV)));
+            const __m128 zReN = _mm_sub_ps(_mm_mul_ps(zRe, m4Re), _mm_mul_ps(zIm, m4Im));
+            zIm = _mm_add_ps(_mm_mul_ps(zRe, m4Im), _mm_mul_ps(zIm, m4Re));
+            zRe = zReN;
+            n = _mm_add_ps(n, _mm_set1_ps(4.0f));
          }
-         static int xxx = 0;
-         // if(0 == (++xxx & 16383))
-         //    printf("xxx ink=%f inkNorm=%f aek=%f\n", ink, inkNorm, aek);
+         acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+         acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, _MM_SHUFFLE(1,1,1,1)));
+         outL = _mm_cvtss_f32(acc);
 
-         outL += inkNorm * ink * cos(voice->phase_c + n * voice->phase_m);
+         // Next k
+         if(voice->mod_k_cur > 0.0f)
+         {
+            const float r  = (voice->mod_k_cur + voice->mod_k_inc) / voice->mod_k_cur;
+            const float r2 = r * r;
+            const __m128 r4 = _mm_set1_ps(r2 * r2);
+            __m128 mul = _mm_mul_ps(_mm_setr_ps(r, r2, r2 * r, r2 * r2), _mm_set1_ps(coefMulK));
+            for(unsigned int j = 0u; j < numHarmonics; j += 4u)
+            {
+               const __m128 c = _mm_mul_ps(_mm_loadu_ps(&voice->coef[j]), mul);
+               _mm_storeu_ps(&voice->coef[j], _mm_min_ps(_mm_max_ps(c, _mm_set1_ps(1.0e-30f)), _mm_set1_ps(1.0e30f)));
+               mul = _mm_mul_ps(mul, r4);
+            }
+         }
       }
+#else
+      {
+         float zRe = cosC;
+         float zIm = sinC;
+         outL = 0.0f;
+         for(unsigned int n = 0u; n < nMax; n++)
+         {
+            outL += voice->coef[n] * zRe;
+            const float zReN = zRe * cosM - zIm * sinM;
+            zIm = zRe * sinM + zIm * cosM;
+            zRe = zReN;
+         }
+         // Next k
+         if(voice->mod_k_cur > 0.0f)
+         {
+            const float r = (voice->mod_k_cur + voice->mod_k_inc) / voice->mod_k_cur;
+            float mul = coefMulK;
+            for(unsigned int n = 0u; n < numHarmonics; n++)
+            {
+               mul *= r;
+               voice->coef[n] = Dstplugin_clamp(voice->coef[n] * mul, 1.0e-30f, 1.0e30f);
+            }
+         }
+      }
+#endif // MODFM_SSE2
 
-      outL *= aek;
-      outL *= (1.0 / pow(1.75, k));
-      // outL *= (1.0f / powf(1.75f, k));
-
-      // outL = l + (outL - l) * voice->mod_drywet_cur;
+      outL *= voice->mod_amp_cur;
 
       if(outL > 16.0f)
          outL = 16.0f;
       else if(outL < -16.0f)
          outL = -16.0f;
 
-      _samplesOut[outIdx]      = (float)outL;
-      _samplesOut[outIdx + 1u] = (float)outL;
+      _samplesOut[outIdx]      = outL;
+      _samplesOut[outIdx + 1u] = outL;
 
       voice->phase_c += voice->w_c;
       if(voice->phase_c >= ST_PLUGIN_2PI_F)
          voice->phase_c -= voice->phase_c;
 
-      voice->phase_m += voice->w_c * voice->mod_r_cur;
+      voice->phase_m += w_m;
       if(voice->phase_m >= ST_PLUGIN_2PI_F)
          voice->phase_m -= voice->phase_m;
 
@@ -296,7 +423,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   modfm_shared_t *ret = (modfm_shared_t *)malloc(sizeof(modfm_shared_t));
+   modfm_shared_t *ret = (modfm_shared_t *)Dstplugin_alloc(_info, sizeof(modfm_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -307,12 +434,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   modfm_voice_t *ret = (modfm_voice_t *)malloc(sizeof(modfm_voice_t));
+   modfm_voice_t *ret = (modfm_voice_t *)Dstplugin_alloc(_info, sizeof(modfm_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -321,8 +448,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(modfm_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -352,6 +485,7 @@ st_plugin_info_t *modfm_init(void) {
       ret->base.shared_delete      = &loc_shared_delete;
       ret->base.voice_new          = &loc_voice_new;
       ret->base.voice_delete       = &loc_voice_delete;
+      ret->base.voice_reset        = &loc_voice_reset;
       ret->base.get_param_name     = &loc_get_param_name;
       ret->base.get_param_reset    = &loc_get_param_reset;
       ret->base.get_param_value    = &loc_get_param_value;
@@ -363,6 +497,14 @@ st_plugin_info_t *modfm_init(void) {
       ret->base.prepare_block      = &loc_prepare_block;
       ret->base.process_replace    = &loc_process_replace;
       ret->base.plugin_exit        = &loc_plugin_exit;
+
+      ret->ws_sin = st_wshaper_sin_get();
+
+      for(unsigned int n = 0u; n < MODFM_MAX_HARMONICS; n++)
+      {
+         const unsigned int fac = loc_fac(n + 1u);
+         ret->ln_fac[n] = (0u != fac) ? log((double)fac) : HUGE_VAL;  // (n+1)! wrapped to 0 => coef=1e-30
+      }
    }
 
    return &ret->base;
@@ -0,0 +1,143 @@
+// ----
+// ---- file   : multitap.h
+// ---- author : Bastian Spiegel <bs@tkscript.de>
+// ---- legal  : (c) 2026 by Bastian Spiegel.
+// ----          Distributed under terms of the GNU LESSER GENERAL PUBLIC LICENSE (LGPL). See
+// ----          http://www.gnu.org/licenses/licenses.html#LGPL or COPYING for further information.
+// ----
+// ---- info   : sine LFO modulated multi-tap delay read (wave_multiplier_delay4/8/16)
+// ----
+// ---- created: 17Oct2026
+// ---- changed:
+// ----
+// ----
+// ----
+
+#ifndef __ST_MULTITAP_H__
+#define __ST_MULTITAP_H__
+
+// (note) include after delay.h (ST_DELAY_SIZE is defined per plugin) and sintbl.h
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define ST_MULTITAP_SSE2  1
+#include <emmintrin.h>
+#endif
+
+
+// Stereo multi-tap delay read
+//  - one sine LFO per tap modulates the tap's delay time (frame_base + max_frames * sin(angle))
+//  - the tap offsets are calculated once per frame and shared by the left and right delay lines
+//  - per-tap state is stored in SoA layout, SSE2: 4 taps per SIMD lane group
+//     (tap reads are gathered by scalar loads, offset / index / interpolation math is vectorized)
+//  - NUM_TAPS must be a multiple of 4
+template <unsigned int NUM_TAPS>
+struct StMultiTap {
+   float angle     [NUM_TAPS];  // 0..65536
+   float speed     [NUM_TAPS];  // angle increment per frame
+   float frame_base[NUM_TAPS];
+   float max_frames[NUM_TAPS];  // LFO depth
+   float level  [2][NUM_TAPS];  // l, r
+
+   // Read all taps from _dly[0] (left) and _dly[1] (right), sum them (weighted by level[]) and advance the LFOs
+   //  - call before the frame is pushed to the delay lines (same as StDelay::readLinear())
+   //  - (note) sets neither _dly[].last_out nor the delay lines' write position
+   void read(const float *_sintbl, const StDelay *_dly, float &_retL, float &_retR) {
+#ifdef ST_MULTITAP_SSE2
+      const __m128  maxOff   = _mm_set1_ps((float)(ST_DELAY_SIZE - 1u));
+      const __m128  one      = _mm_set1_ps(1.0f);
+      const __m128  period   = _mm_set1_ps(65536.0f);
+      const __m128  zero     = _mm_setzero_ps();
+      const __m128i tblMask  = _mm_set1_epi32(ST_SINTBL_MASK);
+      const __m128i ioL      = _mm_set1_epi32((int)_dly[0].io_offset);
+      const __m128i ioR      = _mm_set1_epi32((int)_dly[1].io_offset);
+      const __m128i maskL    = _mm_set1_epi32((int)_dly[0].mask);
+      const __m128i maskR    = _mm_set1_epi32((int)_dly[1].mask);
+      const float  *histL    = _dly[0].history;
+      const float  *histR    = _dly[1].history;
+      __m128 sumL = _mm_setzero_ps();
+      __m128 sumR = _mm_setzero_ps();
+
+      for(unsigned int tapIdx = 0u; tapIdx < NUM_TAPS; tapIdx += 4u)
+      {
+         // LFO (linearly interpolated sine table)
+         __m128  ang    = _mm_loadu_ps(angle + tapIdx);
+         __m128i angI   = _mm_cvttps_epi32(ang);
+         __m128  angF   = _mm_sub_ps(ang, _mm_cvtepi32_ps(angI));
+         union { __m128i v; int i[4]; } tc, tn;
+         tc.v = _mm_and_si128(angI, tblMask);
+         tn.v = _mm_and_si128(_mm_cvttps_epi32(_mm_add_ps(ang, one)), tblMask);
+         __m128 sinC = _mm_setr_ps(_sintbl[tc.i[0]], _sintbl[tc.i[1]], _sintbl[tc.i[2]], _sintbl[tc.i[3]]);
+         __m128 sinN = _mm_setr_ps(_sintbl[tn.i[0]], _sintbl[tn.i[1]], _sintbl[tn.i[2]], _sintbl[tn.i[3]]);
+         __m128 sinA = _mm_add_ps(sinC, _mm_mul_ps(_mm_sub_ps(sinN, sinC), angF));
+
+         // Delay time
+         __m128 off = _mm_add_ps(_mm_loadu_ps(frame_base + tapIdx), _mm_mul_ps(_mm_loadu_ps(max_frames + tapIdx), sinA));
+         off = _mm_min_ps(_mm_max_ps(off, zero), maxOff);
+         __m128i offC = _mm_cvttps_epi32(off);
+         __m128i offN = _mm_cvttps_epi32(_mm_add_ps(off, one));
+         __m128  t    = _mm_sub_ps(off, _mm_cvtepi32_ps(offC));
+
+         // Gather + interpolate
+         union { __m128i v; int i[4]; } ic, in;
+         ic.v = _mm_and_si128(_mm_sub_epi32(ioL, offC), maskL);
+         in.v = _mm_and_si128(_mm_sub_epi32(ioL, offN), maskL);
+         __m128 c = _mm_setr_ps(histL[ic.i[0]], histL[ic.i[1]], histL[ic.i[2]], histL[ic.i[3]]);
+         __m128 n = _mm_setr_ps(histL[in.i[0]], histL[in.i[1]], histL[in.i[2]], histL[in.i[3]]);
+         __m128 d = _mm_add_ps(c, _mm_mul_ps(_mm_sub_ps(n, c), t));
+         sumL = _mm_add_ps(sumL, _mm_mul_ps(d, _mm_loadu_ps(level[0] + tapIdx)));
+
+         ic.v = _mm_and_si128(_mm_sub_epi32(ioR, offC), maskR);
+         in.v = _mm_and_si128(_mm_sub_epi32(ioR, offN), maskR);
+         c = _mm_setr_ps(histR[ic.i[0]], histR[ic.i[1]], histR[ic.i[2]], histR[ic.i[3]]);
+         n = _mm_setr_ps(histR[in.i[0]], histR[in.i[1]], histR[in.i[2]], histR[in.i[3]]);
+         d = _mm_add_ps(c, _mm_mul_ps(_mm_sub_ps(n, c), t));
+         sumR = _mm_add_ps(sumR, _mm_mul_ps(d, _mm_loadu_ps(level[1] + tapIdx)));
+
+         // Next LFO angle (wrap around to 0..65536)
+         ang = _mm_add_ps(ang, _mm_loadu_ps(speed + tapIdx));
+         __m128 wrapDn = _mm_and_ps(_mm_cmpge_ps(ang, period), period);
+         __m128 wrapUp = _mm_and_ps(_mm_cmple_ps(ang, zero),   period);
+         ang = _mm_add_ps(_mm_sub_ps(ang, wrapDn), wrapUp);
+         _mm_storeu_ps(angle + tapIdx, ang);
+      }
+
+      // Horizontal sums
+      __m128 sumLR = _mm_add_ps(_mm_unpacklo_ps(sumL, sumR), _mm_unpackhi_ps(sumL, sumR));  // l01 r01 l23 r23
+      sumLR = _mm_add_ps(sumLR, _mm_movehl_ps(sumLR, sumLR));
+      union { __m128 v; float f[4]; } u;
+      u.v = sumLR;
+      _retL = u.f[0];
+      _retR = u.f[1];
+#else
+      float outL = 0.0f;
+      float outR = 0.0f;
+      for(unsigned int tapIdx = 0u; tapIdx < NUM_TAPS; tapIdx++)
+      {
+         float sinAng = st_sintbl_lerp(_sintbl, angle[tapIdx]);
+         float off = frame_base[tapIdx] + max_frames[tapIdx] * sinAng;
+         off = Dstplugin_clamp(off, 0.0f, (float)(ST_DELAY_SIZE - 1u));
+         unsigned int offC = (unsigned int)(off);
+         unsigned int offN = (unsigned int)(off + 1u);
+         float t = (off - (int)off);
+         const StDelay &dL = _dly[0];
+         const StDelay &dR = _dly[1];
+         float c = dL.history[(dL.io_offset - offC) & dL.mask];
+         outL += (c + (dL.history[(dL.io_offset - offN) & dL.mask] - c) * t) * level[0][tapIdx];
+         c = dR.history[(dR.io_offset - offC) & dR.mask];
+         outR += (c + (dR.history[(dR.io_offset - offN) & dR.mask] - c) * t) * level[1][tapIdx];
+
+         float ang = angle[tapIdx] + speed[tapIdx];
+         if(ang >= 65536.0f)
+            ang -= 65536.0f;
+         else if(ang <= 0.0f)
+            ang += 65536.0f;
+         angle[tapIdx] = ang;
+      }
+      _retL = outL;
+      _retR = outR;
+#endif // ST_MULTITAP_SSE2
+   }
+};
+
+
+#endif // __ST_MULTITAP_H__
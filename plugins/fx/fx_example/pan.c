@@ -8,7 +8,7 @@
 // ---- info   : amplifier
 // ----
 // ---- created: 21May2020
-// ---- changed: 24May2020 31May2020, 08Jun2020, 21Jan2024
+// ---- changed: 24May2020 31May2020, 08Jun2020, 21Jan2024, 16Oct2026
 // ----
 // ----
 // ----
@@ -35,6 +35,9 @@ static float loc_param_resets[NUM_PARAMS] = {
    0.5f,  // PAN
 };
 
+// process_replace_planar(): number of frames per ramp chunk
+#define PLANAR_CHUNK_SIZE  (64u)
+
 #define MOD_DRYWET  0
 #define MOD_DRIVE   1
 #define MOD_PAN     2
@@ -174,12 +177,14 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    }
 }
 
-static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
-                                              int                 _bMonoIn,
-                                              const float        *_samplesIn,
-                                              float              *_samplesOut, 
-                                              unsigned int        _numFrames
-                                              ) {
+static inline void loc_process(st_plugin_voice_t  *_voice,
+                               int                 _bMonoIn,
+                               const float        *_samplesIn,
+                               float              *_samplesOut,
+                               unsigned int        _numFrames,
+                               const int           _bAdd,
+                               const float         _gain
+                               ) {
    // Ring modulate at (modulated) note frequency
    ST_PLUGIN_VOICE_CAST(pan_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(pan_shared_t);
@@ -195,8 +200,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
       float outR = r * voice->mod_drive_r_cur;
       outL = l + (outL - l) * voice->mod_drywet_cur;
       outR = r + (outR - r) * voice->mod_drywet_cur;
-      _samplesOut[k]      = outL;
-      _samplesOut[k + 1u] = outR;
+      Dstplugin_out(_bAdd, _samplesOut[k],      outL, _gain);
+      Dstplugin_out(_bAdd, _samplesOut[k + 1u], outR, _gain);
 
       // Next frame
       k += 2u;
@@ -207,8 +212,81 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
 }
 
+static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
+                                              int                 _bMonoIn,
+                                              const float        *_samplesIn,
+                                              float              *_samplesOut,
+                                              unsigned int        _numFrames
+                                              ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 0/*bAdd*/, 1.0f/*gain*/);
+}
+
+static void ST_PLUGIN_API loc_process_add(st_plugin_voice_t  *_voice,
+                                          int                 _bMonoIn,
+                                          const float        *_samplesIn,
+                                          float              *_samplesOut,
+                                          unsigned int        _numFrames,
+                                          float               _gain
+                                          ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 1/*bAdd*/, _gain);
+}
+
+static void ST_PLUGIN_API loc_process_replace_planar(st_plugin_voice_t  *_voice,
+                                                     int                 _bMonoIn,
+                                                     const float        *_samplesInL,
+                                                     const float        *_samplesInR,
+                                                     float              *_samplesOutL,
+                                                     float              *_samplesOutR,
+                                                     unsigned int        _numFrames
+                                                     ) {
+   ST_PLUGIN_VOICE_CAST(pan_voice_t);
+   (void)_bMonoIn;
+
+   // (note) the parameter ramps are unrolled into small arrays first so the per-channel loops
+   //         can be vectorized (same results as process_replace())
+   float driveL[PLANAR_CHUNK_SIZE];
+   float driveR[PLANAR_CHUNK_SIZE];
+   float drywet[PLANAR_CHUNK_SIZE];
+
+   unsigned int frameOff = 0u;
+   while(frameOff < _numFrames)
+   {
+      unsigned int numChunkFrames = Dstplugin_min(_numFrames - frameOff, PLANAR_CHUNK_SIZE);
+
+      for(unsigned int i = 0u; i < numChunkFrames; i++)
+      {
+         driveL[i] = voice->mod_drive_l_cur;
+         driveR[i] = voice->mod_drive_r_cur;
+         drywet[i] = voice->mod_drywet_cur;
+         voice->mod_drywet_cur  += voice->mod_drywet_inc;
+         voice->mod_drive_l_cur += voice->mod_drive_l_inc;
+         voice->mod_drive_r_cur += voice->mod_drive_r_inc;
+      }
+
+      const float *inL  = _samplesInL  + frameOff;
+      const float *inR  = _samplesInR  + frameOff;
+      float       *outL = _samplesOutL + frameOff;
+      float       *outR = _samplesOutR + frameOff;
+
+      // Stereo input, stereo output
+      for(unsigned int i = 0u; i < numChunkFrames; i++)
+      {
+         float l = inL[i];
+         outL[i] = l + (l * driveL[i] - l) * drywet[i];
+      }
+
+      for(unsigned int i = 0u; i < numChunkFrames; i++)
+      {
+         float r = inR[i];
+         outR[i] = r + (r * driveR[i] - r) * drywet[i];
+      }
+
+      frameOff += numChunkFrames;
+   }
+}
+
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   pan_shared_t *ret = (pan_shared_t *)malloc(sizeof(pan_shared_t));
+   pan_shared_t *ret = (pan_shared_t *)Dstplugin_alloc(_info, sizeof(pan_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -219,12 +297,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   pan_voice_t *ret = (pan_voice_t *)malloc(sizeof(pan_voice_t));
+   pan_voice_t *ret = (pan_voice_t *)Dstplugin_alloc(_info, sizeof(pan_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -233,8 +311,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(pan_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -255,7 +339,7 @@ st_plugin_info_t *pan_init(void) {
       ret->base.author      = "bsp";
       ret->base.name        = "pan";
       ret->base.short_name  = "pan";
-      ret->base.flags       = ST_PLUGIN_FLAG_FX | ST_PLUGIN_FLAG_TRUE_STEREO_OUT;
+      ret->base.flags       = ST_PLUGIN_FLAG_FX | ST_PLUGIN_FLAG_TRUE_STEREO_OUT | ST_PLUGIN_FLAG_PLANAR;
       ret->base.category    = ST_PLUGIN_CAT_PAN;
       ret->base.num_params  = NUM_PARAMS;
       ret->base.num_mods    = NUM_MODS;
@@ -264,6 +348,7 @@ st_plugin_info_t *pan_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -273,6 +358,8 @@ st_plugin_info_t *pan_init(void) {
       ret->base.set_mod_value    = &loc_set_mod_value;
       ret->base.prepare_block    = &loc_prepare_block;
       ret->base.process_replace  = &loc_process_replace;
+      ret->base.process_add      = &loc_process_add;
+      ret->base.process_replace_planar = &loc_process_replace_planar;
       ret->base.plugin_exit      = &loc_plugin_exit;
    }
 
@@ -8,7 +8,7 @@
 // ---- info   : a resampler with linear filtering and pitch follower
 // ----
 // ---- created: 21May2020
-// ---- changed: 24May2020, 31May2020, 02Jun2020, 08Jun2020, 21Jan2024
+// ---- changed: 24May2020, 31May2020, 02Jun2020, 08Jun2020, 21Jan2024, 16Oct2026
 // ----
 // ----
 // ----
@@ -278,7 +278,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   resample_tuned_shared_t *ret = (resample_tuned_shared_t *)malloc(sizeof(resample_tuned_shared_t));
+   resample_tuned_shared_t *ret = (resample_tuned_shared_t *)Dstplugin_alloc(_info, sizeof(resample_tuned_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -289,12 +289,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   resample_tuned_voice_t *ret = (resample_tuned_voice_t *)malloc(sizeof(resample_tuned_voice_t));
+   resample_tuned_voice_t *ret = (resample_tuned_voice_t *)Dstplugin_alloc(_info, sizeof(resample_tuned_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -303,8 +303,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(resample_tuned_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -334,6 +340,7 @@ st_plugin_info_t *resample_tuned_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
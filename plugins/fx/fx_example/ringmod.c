@@ -9,7 +9,7 @@
 // ----
 // ---- created: 16May2020
 // ---- changed: 17May2020, 18May2020, 19May2020, 20May2020, 21May2020, 22May2020, 31May2020
-// ----          08Jun2020, 02May2021, 21Jan2024
+// ----          08Jun2020, 02May2021, 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -19,6 +19,11 @@
 
 #include "../../../plugin.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define RINGMOD_SSE2  1
+#include <emmintrin.h>
+#endif
+
 #define PARAM_DRYWET     0
 #define PARAM_FREQ_MUL   1
 #define PARAM_FREQ_MIN   2
@@ -227,81 +232,134 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
                                               ) {
    // Ring modulate at (modulated) note frequency
    ST_PLUGIN_VOICE_CAST(ringmod_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(ringmod_shared_t);
 
-   float phase    = voice->phase;
-   unsigned int k = 0u;
+   // b  = sin(phase * 2PI) * 0.5 + 0.5
+   // bh = cos(2 * phase * 2PI) * 0.25 + 0.25
+   //
+   // a = l (* 0.5)
+   //   (-a * -bh) + (a * bh)
+   // = bh * 2*a
+   // = l * cos(phase * 2PI)^2
+   //
+   // out = l * (b + (cos^2 - b) * 2x)
+   //
+   // Carrier phasors e^(i*phase*2PI) for 4 consecutive frames (lane j = frame i+j)
+   //  (note) freq is interpolated linearly:
+   //          phase(i+j)           = phase(i) + j*freq(i) + inc*j*(j-1)/2
+   //          phase(i+j+4)-phase(i+j) = 4*freq(i) + (4j+6)*inc   (lane rotation, rotated by 16*inc per iteration)
+   //  (note) re-synced to 'phase' at block start (no transcendental calls in the per-sample path)
+   const double freq = voice->mod_freq_cur;
+   const double inc  = voice->mod_freq_inc;
+   float zRe[4], zIm[4];
+   float rRe[4], rIm[4];
+   for(unsigned int j = 0u; j < 4u; j++)
+   {
+      const double p = ST_PLUGIN_2PI * (voice->phase + j * freq + inc * 0.5 * j * (j - 1.0));
+      zRe[j] = (float)cos(p);
+      zIm[j] = (float)sin(p);
+      const double r = ST_PLUGIN_2PI * (4.0 * freq + (4.0 * j + 6.0) * inc);
+      rRe[j] = (float)cos(r);
+      rIm[j] = (float)sin(r);
+   }
+   const float dRe = (float)cos(ST_PLUGIN_2PI * 16.0 * inc);
+   const float dIm = (float)sin(ST_PLUGIN_2PI * 16.0 * inc);
 
-   float pi2 = ST_PLUGIN_2PI_F;
+   unsigned int i = 0u;
+   unsigned int k = 0u;
 
-   if(_bMonoIn)
+#ifdef RINGMOD_SSE2
    {
-      // Mono input, stereo output
-         // a = 0.5 * l
-         //   (-a * -bh) + (a * bh)
-         // = bh * (-a *-1) + bh * (a)
-         // = bh * (a + a)
-         // = bh * 2*a
-         // = b * a = b * 0.5*l
-      for(unsigned int i = 0u; i < _numFrames; i++)
+      __m128 vZRe = _mm_loadu_ps(zRe);
+      __m128 vZIm = _mm_loadu_ps(zIm);
+      __m128 vRRe = _mm_loadu_ps(rRe);
+      __m128 vRIm = _mm_loadu_ps(rIm);
+      const __m128 vDRe = _mm_set1_ps(dRe);
+      const __m128 vDIm = _mm_set1_ps(dIm);
+      const __m128 vDryWetCur = _mm_set1_ps(voice->mod_drywet_cur);
+      const __m128 vDryWetInc = _mm_set1_ps(voice->mod_drywet_inc);
+      const __m128 v2xCur     = _mm_set1_ps(voice->mod_2x_cur);
+      const __m128 v2xInc     = _mm_set1_ps(voice->mod_2x_inc);
+      const __m128 vHalf      = _mm_set1_ps(0.5f);
+      const __m128 vOne       = _mm_set1_ps(1.0f);
+      __m128 vJ = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+
+      for(; (i + 4u) <= _numFrames; i += 4u)
       {
-         float l = _samplesIn[k];
-         float a = l;/// * 0.5f;
-         float b = sinf(phase * pi2) * 0.5f + 0.5f;
-         float bh = cosf(2.0f * phase * pi2) * 0.25f + 0.25f;
-         float f1 = (l * b);
-         float f2 = (-a * -bh) + (a * bh);
-         float out = f1 + (f2 - f1) * voice->mod_2x_cur;
-         // // float out = l * (1.0f + (outL - 1.0f) * voice->mod_drywet_cur);
-         out = l + (out - l) * voice->mod_drywet_cur;
-         _samplesOut[k]      = out;
-         _samplesOut[k + 1u] = out;
-         // Next frame
-         k += 2u;
-         phase += voice->mod_freq_cur;
-         voice->mod_drywet_cur += voice->mod_drywet_inc;
-         voice->mod_freq_cur   += voice->mod_freq_inc;
-         voice->mod_2x_cur     += voice->mod_2x_inc;
+         const __m128 b   = _mm_add_ps(_mm_mul_ps(vZIm, vHalf), vHalf);
+         const __m128 bh2 = _mm_mul_ps(vZRe, vZRe);
+         const __m128 g   = _mm_add_ps(b, _mm_mul_ps(_mm_sub_ps(bh2, b), _mm_add_ps(v2xCur, _mm_mul_ps(v2xInc, vJ))));
+         // out = l + (l * g - l) * drywet = l * (1 + (g - 1) * drywet)
+         const __m128 m   = _mm_add_ps(vOne, _mm_mul_ps(_mm_sub_ps(g, vOne), _mm_add_ps(vDryWetCur, _mm_mul_ps(vDryWetInc, vJ))));
+
+         __m128 in01 = _mm_loadu_ps(_samplesIn + k);
+         __m128 in23 = _mm_loadu_ps(_samplesIn + k + 4u);
+         if(_bMonoIn)
+         {
+            in01 = _mm_shuffle_ps(in01, in01, _MM_SHUFFLE(2,2,0,0));
+            in23 = _mm_shuffle_ps(in23, in23, _MM_SHUFFLE(2,2,0,0));
+         }
+         _mm_storeu_ps(_samplesOut + k,      _mm_mul_ps(in01, _mm_unpacklo_ps(m, m)));
+         _mm_storeu_ps(_samplesOut + k + 4u, _mm_mul_ps(in23, _mm_unpackhi_ps(m, m)));
+
+         // Next 4 frames
+         k += 8u;
+         vJ = _mm_add_ps(vJ, _mm_set1_ps(4.0f));
+         const __m128 zReN = _mm_sub_ps(_mm_mul_ps(vZRe, vRRe), _mm_mul_ps(vZIm, vRIm));
+         vZIm = _mm_add_ps(_mm_mul_ps(vZRe, vRIm), _mm_mul_ps(vZIm, vRRe));
+         vZRe = zReN;
+         const __m128 rReN = _mm_sub_ps(_mm_mul_ps(vRRe, vDRe), _mm_mul_ps(vRIm, vDIm));
+         vRIm = _mm_add_ps(_mm_mul_ps(vRRe, vDIm), _mm_mul_ps(vRIm, vDRe));
+         vRRe = rReN;
       }
+
+      _mm_storeu_ps(zRe, vZRe);
+      _mm_storeu_ps(zIm, vZIm);
+      _mm_storeu_ps(rRe, vRRe);
+      _mm_storeu_ps(rIm, vRIm);
    }
-   else
+#endif // RINGMOD_SSE2
+
+   // Remaining frames (or all frames when SSE2 is not available)
+   for(; i < _numFrames; i++)
    {
-      // Stereo input, stereo output
-      for(unsigned int i = 0u; i < _numFrames; i++)
+      const unsigned int j = (i & 3u);
+      const float fi = (float)i;
+      const float b   = zIm[j] * 0.5f + 0.5f;
+      const float bh2 = zRe[j] * zRe[j];
+      const float g   = b + (bh2 - b) * (voice->mod_2x_cur + voice->mod_2x_inc * fi);
+      const float m   = 1.0f + (g - 1.0f) * (voice->mod_drywet_cur + voice->mod_drywet_inc * fi);
+      const float l = _samplesIn[k];
+      const float r = _bMonoIn ? l : _samplesIn[k + 1u];
+      _samplesOut[k]      = l * m;
+      _samplesOut[k + 1u] = r * m;
+      k += 2u;
+
+      if(3u == j)
       {
-         float l = _samplesIn[k];
-         float r = _samplesIn[k + 1u];
-         float al = l; // * 0.5f
-         float ar = r; // * 0.5f
-         float b = sinf(phase * pi2) * 0.5f + 0.5f;
-         float bh = cosf(2.0f * phase * pi2) * 0.25f + 0.25f;
-         float f1L = (l * b);
-         float f2L = (-al * -bh) + (al * bh);
-         float outL = f1L + (f2L - f1L) * voice->mod_2x_cur;
-         // // float outL = l * (1.0f + (outL - 1.0f) * voice->mod_drywet_cur);
-         outL = l + (outL - l) * voice->mod_drywet_cur;
-         float f1R = (r * b);
-         float f2R = (-ar * -bh) + (ar * bh);
-         float outR = f1R + (f2R - f1R) * voice->mod_2x_cur;
-         // // float outR = r * (1.0f + (outR - 1.0f) * voice->mod_drywet_cur);
-         outR = r + (outR - r) * voice->mod_drywet_cur;
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outR;
-         // Next frame
-         k += 2u;
-         phase += voice->mod_freq_cur;
-         voice->mod_drywet_cur += voice->mod_drywet_inc;
-         voice->mod_freq_cur   += voice->mod_freq_inc;
-         voice->mod_2x_cur     += voice->mod_2x_inc;
+         // Next 4 frames
+         for(unsigned int jr = 0u; jr < 4u; jr++)
+         {
+            const float zReN = zRe[jr] * rRe[jr] - zIm[jr] * rIm[jr];
+            zIm[jr] = zRe[jr] * rIm[jr] + zIm[jr] * rRe[jr];
+            zRe[jr] = zReN;
+            const float rReN = rRe[jr] * dRe - rIm[jr] * dIm;
+            rIm[jr] = rRe[jr] * dIm + rIm[jr] * dRe;
+            rRe[jr] = rReN;
+         }
       }
    }
-   if(phase >= 1.0f)
-      phase -= 1.0f;
-   voice->phase = phase;
+
+   // Next block
+   double phase = voice->phase + _numFrames * freq + inc * 0.5 * _numFrames * (_numFrames - 1.0);
+   phase -= floor(phase);
+   voice->phase = (float)phase;
+   voice->mod_drywet_cur += voice->mod_drywet_inc * _numFrames;
+   voice->mod_freq_cur   += voice->mod_freq_inc   * _numFrames;
+   voice->mod_2x_cur     += voice->mod_2x_inc     * _numFrames;
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   ringmod_shared_t *ret = malloc(sizeof(ringmod_shared_t));
+   ringmod_shared_t *ret = Dstplugin_alloc(_info, sizeof(ringmod_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -312,12 +370,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   ringmod_voice_t *ret = malloc(sizeof(ringmod_voice_t));
+   ringmod_voice_t *ret = Dstplugin_alloc(_info, sizeof(ringmod_voice_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -327,8 +385,15 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(ringmod_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+   voice->phase = 0.0f;
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free(_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -358,6 +423,7 @@ st_plugin_info_t *ringmod_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -8,7 +8,7 @@
 // ---- info   : RMS envelope generator
 // ----
 // ---- created: 09Jun2020
-// ---- changed: 21Jan2024
+// ---- changed: 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -20,7 +20,9 @@
 
 #include "../../../plugin.h"
 
-#include "biquad.h"
+#include "rmsdet.h"
+
+#define CHUNK_SIZE  (64u)  // process_replace() temp buffers (frames)
 
 #define PARAM_DRYWET   0
 #define PARAM_DRIVE    1
@@ -28,14 +30,16 @@
 #define PARAM_FALL     3
 #define PARAM_HPF      4
 #define PARAM_WINSIZE  5
-#define NUM_PARAMS     6
+#define PARAM_LINK     6
+#define NUM_PARAMS     7
 static const char *loc_param_names[NUM_PARAMS] = {
    "Dry / Wet",
    "Drive",
    "Rise",
    "Fall",
    "HPF",
-   "Window"
+   "Window",
+   "Stereo Link",
 };
 static float loc_param_resets[NUM_PARAMS] = {
    1.0f,    // DRYWET
@@ -44,6 +48,7 @@ static float loc_param_resets[NUM_PARAMS] = {
    0.5f,    // FALL
    0.0f,    // HPF
    0.5f,    // WIN
+   0.0f,    // LINK
 };
 
 #define MOD_DRYWET   0
@@ -69,86 +74,6 @@ typedef struct rms_shared_s {
    float params[NUM_PARAMS];
 } rms_shared_t;
 
-struct RMS {
-#define MAX_WIN_SIZE 2048
-   float buf[MAX_WIN_SIZE];
-   unsigned int buf_idx;
-   unsigned int win_size_bits;
-   unsigned int win_size;       // power of two
-   unsigned int win_size_mask;  // win_size - 1
-
-   double integrated_val;
-   double smoothed_sign;
-   double last_smoothed_val;
-   double smoothed_val;
-
-   StBiquad hpf;
-
-   void setWinSizeBits(unsigned int _bits) {
-      win_size_bits = _bits;
-      win_size      = (1u << _bits);
-      win_size_mask = (win_size - 1u);
-   }
-
-   void reset(void) {
-      hpf.reset();
-      setWinSizeBits(11u);
-      ::memset((void*)buf, 0, win_size * sizeof(float));
-      buf_idx           = 0u;
-      integrated_val    = 0.0;
-      smoothed_sign     = 0.0;
-      last_smoothed_val = 0.0;
-      smoothed_val      = 0.0;
-   }
-
-   float process(const float _inSmp, 
-                 const float _rise, 
-                 const float _fall
-                 ) {
-      // Sidechain filter
-      float inVal = hpf.filter(_inSmp);
-
-      // Calc square
-      inVal *= inVal;
-
-      // Integrate new input
-      integrated_val += inVal;
-
-      // Subtract oldest input
-      integrated_val -= buf[(buf_idx - win_size + 1u) & win_size_mask];
-
-      buf[buf_idx] = inVal;
-      buf_idx = (buf_idx + 1u) & win_size_mask;
-
-      double outVal = integrated_val / double(win_size);
-      if(outVal > 0.0)
-         outVal = sqrt(outVal);
-
-      // Smoothing
-      double smoothAmt;
-      if(smoothed_sign >= 0.0)
-      {
-         smoothAmt = _rise;
-      }
-      else
-      {
-         smoothAmt = _fall;
-      }
-
-      smoothAmt = (1.0 - smoothAmt);
-      smoothAmt *= smoothAmt;
-      smoothAmt *= smoothAmt;
-      smoothAmt *= smoothAmt;
-      smoothed_val = smoothed_val + (outVal - smoothed_val) * smoothAmt;
-
-      smoothed_sign = (smoothed_val - last_smoothed_val);
-      last_smoothed_val = smoothed_val;
-
-      // Output
-      return float(smoothed_val);
-   }
-};
-
 typedef struct rms_voice_s {
    st_plugin_voice_t base;
    float sample_rate;
@@ -161,10 +86,13 @@ typedef struct rms_voice_s {
    float mod_rise_inc;
    float mod_fall_cur;
    float mod_fall_inc;
-   RMS   rms_l;
-   RMS   rms_r;
+   StRMSDetector det;
 } rms_voice_t;
 
+static inline float loc_pow10(const float _x) {
+   return exp2f(_x * 3.32192809f/*log2(10)*/);
+}
+
 
 static const char *ST_PLUGIN_API loc_get_param_name(st_plugin_info_t *_info,
                                                     unsigned int      _paramIdx
@@ -214,8 +142,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
    if(!_bGlide)
    {
       memset((void*)voice->mods, 0, sizeof(voice->mods));
-      voice->rms_l.reset();
-      voice->rms_r.reset();
+      voice->det.reset();
    }
 }
 
@@ -251,27 +178,25 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    (void)_pan;
 
    unsigned int winSizeBits = (unsigned int)(shared->params[PARAM_WINSIZE] * 11.0f + 0.5f);
-   if(winSizeBits != voice->rms_l.win_size_bits)
+   if(winSizeBits != voice->det.win_size_bits)
    {
-      voice->rms_l.reset();
-      voice->rms_r.reset();
-      voice->rms_l.setWinSizeBits(winSizeBits);
-      voice->rms_r.setWinSizeBits(winSizeBits);
+      voice->det.reset();
+      voice->det.setWinSizeBits(winSizeBits);
    }
 
    float modDryWet = shared->params[PARAM_DRYWET]   + voice->mods[MOD_DRYWET];
    modDryWet = Dstplugin_clamp(modDryWet, 0.0f, 1.0f);
 
    float modDrive = (shared->params[PARAM_DRIVE]-0.5f)*2.0f + voice->mods[MOD_DRIVE];
-   modDrive = powf(10.0f, modDrive * 2.0f);
+   modDrive = loc_pow10(modDrive * 2.0f);
 
-   float modRise = shared->params[PARAM_RISE] * powf(10.0f, voice->mods[MOD_RISE]);
+   float modRise = shared->params[PARAM_RISE] * loc_pow10(voice->mods[MOD_RISE]);
    modRise = Dstplugin_clamp(modRise, 0.0f, 1.0f);
 
-   float modFall = shared->params[PARAM_FALL] * powf(10.0f, voice->mods[MOD_FALL]);
+   float modFall = shared->params[PARAM_FALL] * loc_pow10(voice->mods[MOD_FALL]);
    modFall = Dstplugin_clamp(modFall, 0.0f, 1.0f);
 
-   float modFreq = _freqHz * powf(10.0f, (shared->params[PARAM_HPF]-0.5f)*2.0f*2.0f);
+   float modFreq = _freqHz * loc_pow10((shared->params[PARAM_HPF]-0.5f)*2.0f*2.0f);
    if(modFreq >= (voice->sample_rate*0.5f))
       modFreq = 1.0f;
    else
@@ -301,19 +226,12 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
       _numFrames = 1u;
    }
 
-   voice->rms_l.hpf.calcParams(_numFrames,
-                               StBiquad::HPF,
-                               0.0f/*gainDB*/,
-                               modFreq,
-                               0.0/*modQ*/
-                               );
-
-   voice->rms_r.hpf.calcParams(_numFrames,
-                               StBiquad::HPF,
-                               0.0f/*gainDB*/,
-                               modFreq,
-                               0.0/*modQ*/
-                               );
+   voice->det.hpf.calcParams(_numFrames,
+                             StBiquad::HPF,
+                             0.0f/*gainDB*/,
+                             modFreq,
+                             0.0/*modQ*/
+                             );
 }
 
 static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
@@ -322,78 +240,78 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
                                               float              *_samplesOut, 
                                               unsigned int        _numFrames
                                               ) {
-   // Ring modulate at (modulated) note frequency
    ST_PLUGIN_VOICE_CAST(rms_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(rms_shared_t);
 
-   unsigned int k = 0u;
+   const int detMode = _bMonoIn ? ST_RMSDET_MONO
+                                : (shared->params[PARAM_LINK] >= 0.5f) ? ST_RMSDET_LINKED : ST_RMSDET_STEREO;
+   float env[CHUNK_SIZE * 2u];
 
-   if(_bMonoIn)
+   unsigned int frameIdx = 0u;
+   while(frameIdx < _numFrames)
    {
-      // Mono input, stereo output
-      for(unsigned int i = 0u; i < _numFrames; i++)
+      unsigned int numChunkFrames = _numFrames - frameIdx;
+      if(numChunkFrames > CHUNK_SIZE)
+         numChunkFrames = CHUNK_SIZE;
+
+      const float *samplesIn  = _samplesIn  + 2u * frameIdx;
+      float       *samplesOut = _samplesOut + 2u * frameIdx;
+
+      voice->det.process(detMode,
+                         samplesIn,
+                         env,
+                         numChunkFrames,
+                         voice->mod_drive_cur,
+                         voice->mod_drive_inc,
+                         voice->mod_rise_cur,
+                         voice->mod_rise_inc,
+                         voice->mod_fall_cur,
+                         voice->mod_fall_inc
+                         );
+
+      unsigned int k = 0u;
+      if(_bMonoIn)
       {
-         float l = _samplesIn[k];
-
-         float outL = l * voice->mod_drive_cur;
-         outL = voice->rms_l.process(outL, voice->mod_rise_cur, voice->mod_fall_cur);
-
-         outL = l + (outL - l) * voice->mod_drywet_cur;
-         outL = Dstplugin_fix_denorm_32(outL);
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outL;
-
-         // Next frame
-         k += 2u;
-         voice->mod_drywet_cur += voice->mod_drywet_inc;
-         voice->mod_drive_cur  += voice->mod_drive_inc;
-         voice->mod_rise_cur   += voice->mod_rise_inc;
-         voice->mod_fall_cur   += voice->mod_fall_inc;
+         // Mono input, stereo output
+         for(unsigned int i = 0u; i < numChunkFrames; i++)
+         {
+            float l = samplesIn[k];
+            float outL = l + (env[k] - l) * voice->mod_drywet_cur;
+            outL = Dstplugin_fix_denorm_32(outL);
+            samplesOut[k]      = outL;
+            samplesOut[k + 1u] = outL;
+
+            // Next frame
+            k += 2u;
+            voice->mod_drywet_cur += voice->mod_drywet_inc;
+         }
       }
-   }
-   else
-   {
-      // Stereo input, stereo output
-      for(unsigned int i = 0u; i < _numFrames; i++)
+      else
       {
-         float l = _samplesIn[k];
-         float r = _samplesIn[k + 1u];
-
-         float outL = l * voice->mod_drive_cur;
-         outL = voice->rms_l.process(outL, voice->mod_rise_cur, voice->mod_fall_cur);
-#if 0
+         // Stereo input, stereo output
+         for(unsigned int i = 0u; i < numChunkFrames; i++)
          {
-            static int xxx = 0;
-            if(0 == (++xxx & 2047))
-            {
-               printf("xxx rmsL=%f\n", rmsL);
-               fflush(stdout);
-            }
+            float l = samplesIn[k];
+            float r = samplesIn[k + 1u];
+            float outL = l + (env[k]      - l) * voice->mod_drywet_cur;
+            float outR = r + (env[k + 1u] - r) * voice->mod_drywet_cur;
+            outL = Dstplugin_fix_denorm_32(outL);
+            outR = Dstplugin_fix_denorm_32(outR);
+            samplesOut[k]      = outL;
+            samplesOut[k + 1u] = outR;
+
+            // Next frame
+            k += 2u;
+            voice->mod_drywet_cur += voice->mod_drywet_inc;
          }
-#endif
-
-         float outR = r * voice->mod_drive_cur;
-         outR = voice->rms_r.process(outR, voice->mod_rise_cur, voice->mod_fall_cur);
-
-         outL = l + (outL - l) * voice->mod_drywet_cur;
-         outR = r + (outR - r) * voice->mod_drywet_cur;
-         outL = Dstplugin_fix_denorm_32(outL);
-         outR = Dstplugin_fix_denorm_32(outR);
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outR;
-
-         // Next frame
-         k += 2u;
-         voice->mod_drywet_cur += voice->mod_drywet_inc;
-         voice->mod_drive_cur  += voice->mod_drive_inc;
-         voice->mod_rise_cur   += voice->mod_rise_inc;
-         voice->mod_fall_cur   += voice->mod_fall_inc;
       }
+
+      frameIdx += numChunkFrames;
    }
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   rms_shared_t *ret = (rms_shared_t *)malloc(sizeof(rms_shared_t));
+   rms_shared_t *ret = (rms_shared_t *)Dstplugin_alloc(_info, sizeof(rms_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -404,12 +322,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   rms_voice_t *ret = (rms_voice_t *)malloc(sizeof(rms_voice_t));
+   rms_voice_t *ret = (rms_voice_t *)Dstplugin_alloc(_info, sizeof(rms_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -418,8 +336,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(rms_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -448,6 +372,7 @@ st_plugin_info_t *rms_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -0,0 +1,246 @@
+// ----
+// ---- file   : rmsdet.cpp
+// ---- author : Bastian Spiegel <bs@tkscript.de>
+// ---- legal  : (c) 2026 by Bastian Spiegel.
+// ----          Distributed under terms of the GNU LESSER GENERAL PUBLIC LICENSE (LGPL). See
+// ----          http://www.gnu.org/licenses/licenses.html#LGPL or COPYING for further information.
+// ----
+// ---- info   : stereo RMS envelope detector (sidechain HPF, moving RMS window, rise / fall smoothing)
+// ----
+// ---- created: 17Oct2026
+// ---- changed:
+// ----
+// ----
+// ----
+
+#include <string.h>
+#include <math.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define ST_RMSDET_SSE2  1
+#include <emmintrin.h>
+#endif
+
+#include "../../../plugin.h"
+
+#include "rmsdet.h"
+
+
+void StRMSDetector::setWinSizeBits(unsigned int _bits) {
+   if(_bits > ST_RMSDET_MAX_WIN_SIZE_BITS)
+      _bits = ST_RMSDET_MAX_WIN_SIZE_BITS;
+   win_size_bits = _bits;
+   win_size      = (1u << _bits);
+   win_size_mask = (win_size - 1u);
+}
+
+void StRMSDetector::reset(void) {
+   hpf.reset();
+   setWinSizeBits(ST_RMSDET_MAX_WIN_SIZE_BITS);
+   ::memset((void*)buf, 0, sizeof(buf));
+   buf_idx = 0u;
+   for(unsigned int j = 0u; j < 2u; j++)
+   {
+      integrated_val   [j] = 0.0;
+      smoothed_sign    [j] = 0.0;
+      smoothed_val     [j] = 0.0;
+      last_smoothed_val[j] = 0.0;
+      hpf_z1           [j] = 0.0;
+      hpf_z2           [j] = 0.0;
+   }
+}
+
+#ifdef ST_RMSDET_SSE2
+void StRMSDetector::process(int           _mode,
+                            const float  *_samplesIn,
+                            float        *_envOut,
+                            unsigned int  _numFrames,
+                            float        &_driveCur,
+                            const float   _driveInc,
+                            float        &_riseCur,
+                            const float   _riseInc,
+                            float        &_fallCur,
+                            const float   _fallInc
+                            ) {
+   __m128d a0 = _mm_set1_pd(hpf.cur.a0);  const __m128d sa0 = _mm_set1_pd(hpf.step.a0);
+   __m128d a1 = _mm_set1_pd(hpf.cur.a1);  const __m128d sa1 = _mm_set1_pd(hpf.step.a1);
+   __m128d a2 = _mm_set1_pd(hpf.cur.a2);  const __m128d sa2 = _mm_set1_pd(hpf.step.a2);
+   __m128d b1 = _mm_set1_pd(hpf.cur.b1);  const __m128d sb1 = _mm_set1_pd(hpf.step.b1);
+   __m128d b2 = _mm_set1_pd(hpf.cur.b2);  const __m128d sb2 = _mm_set1_pd(hpf.step.b2);
+
+   __m128d z1       = _mm_loadu_pd(hpf_z1);
+   __m128d z2       = _mm_loadu_pd(hpf_z2);
+   __m128d integ    = _mm_loadu_pd(integrated_val);
+   __m128d smoothed = _mm_loadu_pd(smoothed_val);
+   __m128d lastSm   = _mm_loadu_pd(last_smoothed_val);
+   __m128d sign     = _mm_loadu_pd(smoothed_sign);
+
+   const __m128  denorm  = _mm_set1_ps(10.0f);  // see Dstplugin_fix_denorm_32()
+   const __m128d one     = _mm_set1_pd(1.0);
+   const __m128d zero    = _mm_setzero_pd();
+   const __m128d recWin  = _mm_set1_pd(1.0 / win_size);  // exact (power of two)
+   const unsigned int mask = win_size_mask;
+
+   float driveCur = _driveCur;
+   float riseCur  = _riseCur;
+   float fallCur  = _fallCur;
+   unsigned int idx = buf_idx;
+   unsigned int k = 0u;
+
+   for(unsigned int i = 0u; i < _numFrames; i++)
+   {
+      // Sidechain filter
+      __m128 in = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(_samplesIn + k));
+      if(ST_RMSDET_MONO == _mode)
+         in = _mm_shuffle_ps(in, in, _MM_SHUFFLE(0,0,0,0));
+      const __m128d x = _mm_cvtps_pd(_mm_mul_ps(in, _mm_set1_ps(driveCur)));
+      const __m128d out = _mm_add_pd(_mm_mul_pd(x, a0), z1);
+      z1 = _mm_sub_pd(_mm_add_pd(_mm_mul_pd(x, a1), z2), _mm_mul_pd(b1, out));
+      z2 = _mm_sub_pd(_mm_mul_pd(x, a2), _mm_mul_pd(b2, out));
+      a0 = _mm_add_pd(a0, sa0);
+      a1 = _mm_add_pd(a1, sa1);
+      a2 = _mm_add_pd(a2, sa2);
+      b1 = _mm_add_pd(b1, sb1);
+      b2 = _mm_add_pd(b2, sb2);
+      __m128 out32 = _mm_sub_ps(_mm_add_ps(_mm_cvtpd_ps(out), denorm), denorm);
+
+      // Calc square
+      __m128 sq = _mm_mul_ps(out32, out32);
+      if(ST_RMSDET_LINKED == _mode)
+         sq = _mm_mul_ps(_mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2,3,0,1))), _mm_set1_ps(0.5f));
+
+      // Integrate new input, subtract oldest input
+      integ = _mm_add_pd(integ, _mm_cvtps_pd(sq));
+      integ = _mm_sub_pd(integ, _mm_cvtps_pd(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)buf[(idx + 1u) & mask])));
+      _mm_storel_pi((__m64*)buf[idx], sq);
+      idx = (idx + 1u) & mask;
+
+      __m128d rms = _mm_mul_pd(integ, recWin);
+      const __m128d rmsPos = _mm_cmpgt_pd(rms, zero);
+      rms = _mm_or_pd(_mm_and_pd(rmsPos, _mm_sqrt_pd(rms)), _mm_andnot_pd(rmsPos, rms));
+
+      // Smoothing (rise amount in lane 0, fall amount in lane 1)
+      __m128d amt = _mm_sub_pd(one, _mm_cvtps_pd(_mm_setr_ps(riseCur, fallCur, 0.0f, 0.0f)));
+      amt = _mm_mul_pd(amt, amt);
+      amt = _mm_mul_pd(amt, amt);
+      amt = _mm_mul_pd(amt, amt);
+      const __m128d bRise = _mm_cmpge_pd(sign, zero);
+      amt = _mm_or_pd(_mm_and_pd   (bRise, _mm_unpacklo_pd(amt, amt)),
+                      _mm_andnot_pd(bRise, _mm_unpackhi_pd(amt, amt))
+                      );
+      smoothed = _mm_add_pd(smoothed, _mm_mul_pd(_mm_sub_pd(rms, smoothed), amt));
+      sign     = _mm_sub_pd(smoothed, lastSm);
+      lastSm   = smoothed;
+
+      // Output
+      _mm_storel_pi((__m64*)(_envOut + k), _mm_cvtpd_ps(smoothed));
+
+      // Next frame
+      k += 2u;
+      driveCur += _driveInc;
+      riseCur  += _riseInc;
+      fallCur  += _fallInc;
+   }
+
+   _mm_storel_pd(&hpf.cur.a0, a0);
+   _mm_storel_pd(&hpf.cur.a1, a1);
+   _mm_storel_pd(&hpf.cur.a2, a2);
+   _mm_storel_pd(&hpf.cur.b1, b1);
+   _mm_storel_pd(&hpf.cur.b2, b2);
+
+   _mm_storeu_pd(hpf_z1,            z1);
+   _mm_storeu_pd(hpf_z2,            z2);
+   _mm_storeu_pd(integrated_val,    integ);
+   _mm_storeu_pd(smoothed_val,      smoothed);
+   _mm_storeu_pd(last_smoothed_val, lastSm);
+   _mm_storeu_pd(smoothed_sign,     sign);
+
+   buf_idx   = idx;
+   _driveCur = driveCur;
+   _riseCur  = riseCur;
+   _fallCur  = fallCur;
+}
+#else
+void StRMSDetector::process(int           _mode,
+                            const float  *_samplesIn,
+                            float        *_envOut,
+                            unsigned int  _numFrames,
+                            float        &_driveCur,
+                            const float   _driveInc,
+                            float        &_riseCur,
+                            const float   _riseInc,
+                            float        &_fallCur,
+                            const float   _fallInc
+                            ) {
+   const double recWin = 1.0 / win_size;  // exact (power of two)
+   float driveCur = _driveCur;
+   float riseCur  = _riseCur;
+   float fallCur  = _fallCur;
+   unsigned int k = 0u;
+
+   for(unsigned int i = 0u; i < _numFrames; i++)
+   {
+      // Sidechain filter
+      float sq[2];
+      for(unsigned int j = 0u; j < 2u; j++)
+      {
+         float x = _samplesIn[k + ((ST_RMSDET_MONO == _mode) ? 0u : j)] * driveCur;
+         double out = x * hpf.cur.a0 + hpf_z1[j];
+         hpf_z1[j] = x * hpf.cur.a1 + hpf_z2[j] - hpf.cur.b1 * out;
+         hpf_z2[j] = x * hpf.cur.a2 - hpf.cur.b2 * out;
+         float out32 = float(out);
+         out32 = Dstplugin_fix_denorm_32(out32);
+
+         // Calc square
+         sq[j] = out32 * out32;
+      }
+      hpf.stepCoeff();
+
+      if(ST_RMSDET_LINKED == _mode)
+         sq[0] = sq[1] = (sq[0] + sq[1]) * 0.5f;
+
+      double riseAmt = (1.0 - riseCur);
+      riseAmt *= riseAmt;
+      riseAmt *= riseAmt;
+      riseAmt *= riseAmt;
+
+      double fallAmt = (1.0 - fallCur);
+      fallAmt *= fallAmt;
+      fallAmt *= fallAmt;
+      fallAmt *= fallAmt;
+
+      const float *bufOld = buf[(buf_idx + 1u) & win_size_mask];
+
+      for(unsigned int j = 0u; j < 2u; j++)
+      {
+         // Integrate new input, subtract oldest input
+         integrated_val[j] += sq[j];
+         integrated_val[j] -= bufOld[j];
+         buf[buf_idx][j] = sq[j];
+
+         double rms = integrated_val[j] * recWin;
+         if(rms > 0.0)
+            rms = sqrt(rms);
+
+         // Smoothing
+         smoothed_val[j] = smoothed_val[j] + (rms - smoothed_val[j]) * ((smoothed_sign[j] >= 0.0) ? riseAmt : fallAmt);
+         smoothed_sign[j] = (smoothed_val[j] - last_smoothed_val[j]);
+         last_smoothed_val[j] = smoothed_val[j];
+
+         // Output
+         _envOut[k + j] = float(smoothed_val[j]);
+      }
+      buf_idx = (buf_idx + 1u) & win_size_mask;
+
+      // Next frame
+      k += 2u;
+      driveCur += _driveInc;
+      riseCur  += _riseInc;
+      fallCur  += _fallInc;
+   }
+
+   _driveCur = driveCur;
+   _riseCur  = riseCur;
+   _fallCur  = fallCur;
+}
+#endif // ST_RMSDET_SSE2
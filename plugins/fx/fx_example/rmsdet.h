@@ -0,0 +1,73 @@
+// ----
+// ---- file   : rmsdet.h
+// ---- author : Bastian Spiegel <bs@tkscript.de>
+// ---- legal  : (c) 2026 by Bastian Spiegel.
+// ----          Distributed under terms of the GNU LESSER GENERAL PUBLIC LICENSE (LGPL). See
+// ----          http://www.gnu.org/licenses/licenses.html#LGPL or COPYING for further information.
+// ----
+// ---- info   : stereo RMS envelope detector (sidechain HPF, moving RMS window, rise / fall smoothing)
+// ----
+// ---- created: 17Oct2026
+// ---- changed:
+// ----
+// ----
+// ----
+
+#ifndef __ST_RMSDET_H__
+#define __ST_RMSDET_H__
+
+#include "biquad.h"
+
+#define ST_RMSDET_MAX_WIN_SIZE_BITS  (11u)
+#define ST_RMSDET_MAX_WIN_SIZE       (1u << ST_RMSDET_MAX_WIN_SIZE_BITS)
+
+// Detector modes
+#define ST_RMSDET_STEREO  0  // independent left / right detectors
+#define ST_RMSDET_LINKED  1  // single detector fed with the mean square of both channels (same envelope on both channels)
+#define ST_RMSDET_MONO    2  // left input channel only (same envelope on both channels)
+
+// Stereo RMS envelope detector
+//  - left / right channels are processed in two SIMD lanes (SSE2, scalar fallback on other architectures)
+//  - same signal flow as the (former) per-channel detectors in comp_rms / rms:
+//     sidechain HPF (double precision) => square => moving sum (2^n frames) => sqrt => rise / fall smoothing
+struct StRMSDetector {
+
+   // lane 0 = left channel, lane 1 = right channel
+   float  buf[ST_RMSDET_MAX_WIN_SIZE][2];  // squared (filtered) input
+   unsigned int buf_idx;
+   unsigned int win_size_bits;
+   unsigned int win_size;       // power of two
+   unsigned int win_size_mask;  // win_size - 1
+
+   double integrated_val[2];
+   double smoothed_sign     [2];  // smoothed_val - last_smoothed_val
+   double smoothed_val      [2];
+   double last_smoothed_val [2];  // (note) kept separately so the sign is calculated from the stored (rounded) value
+
+   double hpf_z1[2];
+   double hpf_z2[2];
+   StBiquad hpf;  // sidechain HPF coefficients (same for both channels, filter state is kept in hpf_z1/z2)
+
+   void setWinSizeBits (unsigned int _bits);
+
+   void reset (void);
+
+   // Calc envelope of interleaved stereo sample frames ('_envOut' = interleaved stereo envelope frames)
+   //  - '_mode' is one of ST_RMSDET_STEREO, ST_RMSDET_LINKED, ST_RMSDET_MONO
+   //  - 'drive' (sidechain gain), 'rise' and 'fall' (0..1) are interpolated per sample frame (cur += inc),
+   //     the final values are written back
+   void process (int           _mode,
+                 const float  *_samplesIn,
+                 float        *_envOut,
+                 unsigned int  _numFrames,
+                 float        &_driveCur,
+                 const float   _driveInc,
+                 float        &_riseCur,
+                 const float   _riseInc,
+                 float        &_fallCur,
+                 const float   _fallInc
+                 );
+};
+
+
+#endif // __ST_RMSDET_H__
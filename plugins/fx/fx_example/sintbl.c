@@ -0,0 +1,40 @@
+// ----
+// ---- file   : sintbl.c
+// ---- author : Bastian Spiegel <bs@tkscript.de>
+// ---- legal  : (c) 2026 by Bastian Spiegel.
+// ----          Distributed under terms of the GNU LESSER GENERAL PUBLIC LICENSE (LGPL). See
+// ----          http://www.gnu.org/licenses/licenses.html#LGPL or COPYING for further information.
+// ----
+// ---- info   : shared sine table (one period, 65536 entries)
+// ----
+// ---- created: 17Oct2026
+// ---- changed:
+// ----
+// ----
+// ----
+
+#include <math.h>
+
+#include "../../../plugin.h"
+
+#include "sintbl.h"
+
+static float loc_sintbl[ST_SINTBL_SIZE];
+static int   loc_b_sintbl_init = 0;
+
+const float *st_sintbl_get(void) {
+   // (note) st_plugin_init() is not called concurrently => no locking
+   if(!loc_b_sintbl_init)
+   {
+      float w = (float)(6.28318530718f / 65536.0f);
+      float a = 0.0f;
+      unsigned int i;
+      for(i = 0u; i < ST_SINTBL_SIZE; i++)
+      {
+         loc_sintbl[i] = sinf(a);
+         a += w;
+      }
+      loc_b_sintbl_init = 1;
+   }
+   return loc_sintbl;
+}
@@ -0,0 +1,43 @@
+// ----
+// ---- file   : sintbl.h
+// ---- author : Bastian Spiegel <bs@tkscript.de>
+// ---- legal  : (c) 2026 by Bastian Spiegel.
+// ----          Distributed under terms of the GNU LESSER GENERAL PUBLIC LICENSE (LGPL). See
+// ----          http://www.gnu.org/licenses/licenses.html#LGPL or COPYING for further information.
+// ----
+// ---- info   : shared sine table (one period, 65536 entries)
+// ----
+// ---- created: 17Oct2026
+// ---- changed:
+// ----
+// ----
+// ----
+
+#ifndef __ST_SINTBL_H__
+#define __ST_SINTBL_H__
+
+#define ST_SINTBL_SIZE  (65536u)
+#define ST_SINTBL_MASK  (65535u)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Returns the (read-only) sine table that is shared by all plugins in this library
+//  - built on first call (call it from the plugin init function, i.e. while the host enumerates the plugins)
+//  - angle 0..65536 => 0..2PI
+extern const float *st_sintbl_get (void);
+
+#ifdef __cplusplus
+}
+
+// Linearly interpolated lookup, _angle: 0..65536
+static inline float st_sintbl_lerp(const float *_tbl, const float _angle) {
+   float c = _tbl[(unsigned short)_angle];
+   float n = _tbl[(unsigned short)(_angle + 1)];
+   float f = _angle - (float)((int)_angle);
+   return c + (n - c) * f;
+}
+#endif // __cplusplus
+
+#endif // __ST_SINTBL_H__
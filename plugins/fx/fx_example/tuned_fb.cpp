@@ -8,11 +8,12 @@
 // ---- info   : a cross feedback delay line with variable shape (sweepable multimode) filtering
 // ----
 // ---- created: 25May2020
-// ---- changed: 31May2020, 01Jun2020, 02Jun2020, 08Jun2020, 21Jan2024
+// ---- changed: 31May2020, 01Jun2020, 02Jun2020, 08Jun2020, 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
@@ -22,6 +23,10 @@
 #include "delay.h"
 #include "biquad.h"
 
+// lowest playable note (MIDI note 0 = ~8.18Hz), determines the delay history size (see loc_set_sample_rate())
+//  - (note) lower (modulated) tunings are clamped to the history size
+#define MIN_NOTE_FREQ_HZ  (8.1758f)
+
 #define PARAM_DRYWET       0
 #define PARAM_FREQ         1  // 0..1 => 0..~371ms
 #define PARAM_FB           2
@@ -117,6 +122,7 @@ typedef struct tuned_fb_voice_s {
       }
    }
 
+   stplugin_tail_t tail;
 } tuned_fb_voice_t;
 
 static float loc_bipolar_to_scale(float _t, float _mul, float _div) {
@@ -143,6 +149,15 @@ static void ST_PLUGIN_API loc_set_sample_rate(st_plugin_voice_t *_voice,
                                               ) {
    ST_PLUGIN_VOICE_CAST(tuned_fb_voice_t);
    voice->sample_rate = _sampleRate;
+   // (note) delay time depends on note frequency => max. size at the lowest playable note
+   const float maxFrames = _sampleRate / MIN_NOTE_FREQ_HZ;
+   if(!voice->dly_l.allocHistory(voice->base.info, maxFrames) ||
+      !voice->dly_r.allocHistory(voice->base.info, maxFrames)
+      )
+   {
+      // (note) the delay line falls back to its embedded 2 frame buffer (zero delay time)
+      printf("[---] tuned_fb::set_sample_rate: failed to allocate delay history\n");
+   }
 }
 
 static const char *ST_PLUGIN_API loc_get_param_name(st_plugin_info_t *_info,
@@ -187,6 +202,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
                                       float               _vel
                                       ) {
    ST_PLUGIN_VOICE_CAST(tuned_fb_voice_t);
+   Dstplugin_tail_reset(voice->tail);
    (void)_bGlide;
    (void)_note;
    (void)_vel;
@@ -243,8 +259,7 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
 
    float modTime = voice->mod_time_smooth;
 
-   if(modTime >= (float)(ST_DELAY_SIZE - 1u))
-      modTime = (float)(ST_DELAY_SIZE - 1u);
+   modTime = voice->dly_l.clampOffset(modTime);
 
    float modFbAmt = powf(10.0f, voice->mods[MOD_FB]);
    float modFb = (shared->params[PARAM_FB]-0.5f)*2.0f * modFbAmt;
@@ -314,6 +329,10 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
    unsigned int k = 0u;
 
+   float peakIn = 0.0f;
+   Dstplugin_peak_buf(peakIn, _samplesIn, _numFrames * 2u);
+   float peakWet = 0.0f;
+
    if(_bMonoIn)
    {
       // Mono input, stereo output
@@ -327,6 +346,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          float outL = voice->dly_l.readLinear(voice->mod_time_cur);
          outL = Dstplugin_fix_denorm_32(outL);
 
+         Dstplugin_peak(peakWet, outL);
          outL = l + (outL - l) * shared->params[PARAM_DRYWET];
 
          _samplesOut[k]      = outL;
@@ -357,7 +377,9 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          float outR = voice->dly_r.readLinear(voice->mod_time_cur);
          outR = Dstplugin_fix_denorm_32(outR);
 
+         Dstplugin_peak(peakWet, outL);
          outL = l + (outL - l) * shared->params[PARAM_DRYWET];
+         Dstplugin_peak(peakWet, outR);
          outR = r + (outR - r) * shared->params[PARAM_DRYWET];
 
          _samplesOut[k]      = outL;
@@ -369,10 +391,17 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          voice->mod_fb_cur   += voice->mod_fb_inc;
       }
    }
+
+   Dstplugin_tail_update(voice->tail, peakIn, peakWet, _numFrames);
+}
+
+static unsigned int ST_PLUGIN_API loc_query_tail_state(st_plugin_voice_t *_voice) {
+   ST_PLUGIN_VOICE_CAST(tuned_fb_voice_t);
+   return Dstplugin_tail_state(voice->tail);
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   tuned_fb_shared_t *ret = (tuned_fb_shared_t *)malloc(sizeof(tuned_fb_shared_t));
+   tuned_fb_shared_t *ret = (tuned_fb_shared_t *)Dstplugin_alloc(_info, sizeof(tuned_fb_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -383,22 +412,38 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   tuned_fb_voice_t *ret = (tuned_fb_voice_t *)malloc(sizeof(tuned_fb_voice_t));
+   tuned_fb_voice_t *ret = (tuned_fb_voice_t *)Dstplugin_alloc(_info, sizeof(tuned_fb_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
       ret->base.info   = _info;
+      ret->dly_l.init();
+      ret->dly_r.init();
+      ret->tail.num_tail_frames = ST_DELAY_SIZE + 256u;  // +filter ring-out
    }
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(tuned_fb_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear_to(voice, dly_l);
+   voice->dly_l.clear();
+   voice->dly_r.clear();
+   Dstplugin_voice_clear_from(voice, coeff_lpf);
+   voice->tail.num_tail_frames = ST_DELAY_SIZE + 256u;  // +filter ring-out
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   ST_PLUGIN_VOICE_CAST(tuned_fb_voice_t);
+   voice->dly_l.freeHistory(_voice->info);
+   voice->dly_r.freeHistory(_voice->info);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -428,6 +473,7 @@ st_plugin_info_t *tuned_fb_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -438,6 +484,7 @@ st_plugin_info_t *tuned_fb_init(void) {
       ret->base.set_mod_value    = &loc_set_mod_value;
       ret->base.prepare_block    = &loc_prepare_block;
       ret->base.process_replace  = &loc_process_replace;
+      ret->base.query_tail_state = &loc_query_tail_state;
       ret->base.plugin_exit      = &loc_plugin_exit;
    }
 
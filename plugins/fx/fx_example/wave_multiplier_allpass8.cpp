@@ -8,7 +8,7 @@
 // ---- info   : pseudo phase shifter
 // ----
 // ---- created: 13Oct2021
-// ---- changed: 21Jan2024
+// ---- changed: 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -21,6 +21,7 @@
 #include "../../../plugin.h"
 
 #include "allpass.h"
+#include "sintbl.h"
 
 #define MAX_PARTS  8
 #define NUM_POLES  8
@@ -77,7 +78,7 @@ static const char *loc_mod_names[NUM_MODS] = {
 
 typedef struct wave_multiplier_allpass8_info_s {
    st_plugin_info_t base;
-   float sintbl[65536];
+   const float *sintbl;  // shared (see sintbl.h)
    unsigned int lfsr_state;
 } wave_multiplier_allpass8_info_t;
 
@@ -107,19 +108,10 @@ typedef struct wave_multiplier_allpass8_voice_s {
    float   mod_drywet_inc;
    // // unsigned int num_parts;
    wave_multiplier_allpass8_part_t parts[MAX_PARTS];
+   stplugin_tail_t tail;
 } wave_multiplier_allpass8_voice_t;
 
 
-static void loc_init_sintbl(wave_multiplier_allpass8_info_t *_info) {
-   float w = (float)(6.28318530718f / 65536.0f);
-   float a = 0.0f;
-   for(unsigned int i = 0u; i < 65536u; i++)
-   {
-      _info->sintbl[i] = sinf(a);
-      a += w;
-   }
-}
-
 static unsigned int loc_lfsr_randi(unsigned int &state) {
    state ^= (state >> 7);
    state ^= (state << 9);
@@ -184,6 +176,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
    ST_PLUGIN_VOICE_CAST(wave_multiplier_allpass8_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(wave_multiplier_allpass8_shared_t);
    ST_PLUGIN_VOICE_INFO_CAST(wave_multiplier_allpass8_info_t);
+   Dstplugin_tail_reset(voice->tail);
    (void)_bGlide;
    (void)_note;
    (void)_vel;
@@ -298,8 +291,28 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
    unsigned int k = 0u;
 
+   float peakIn = 0.0f;
+   Dstplugin_peak_buf(peakIn, _samplesIn, _numFrames * 2u);
+   float peakWet = 0.0f;
+
    for(unsigned int i = 0u; i < _numFrames; i++)
    {
+      // LFOs (shared by both channels)
+      float freq[MAX_PARTS];
+      for(unsigned int partIdx = 0u; partIdx < MAX_PARTS/*voice->num_parts*/; partIdx++)
+      {
+         wave_multiplier_allpass8_part_t *part = &voice->parts[partIdx];
+
+         float sinAng = st_sintbl_lerp(info->sintbl, part->angle);
+         freq[partIdx] = part->freq_base + part->freq_rand * sinAng;
+
+         part->angle += part->speed;
+         if(part->angle >= 65536.0f)
+            part->angle -= 65536.0f;
+         else if(part->angle <= 0.0f)
+            part->angle += 65536.0f;
+      }
+
       for(unsigned int ch = 0u; ch < 2u; ch++)
       {
          float l = _samplesIn[k];
@@ -309,27 +322,14 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          {
             wave_multiplier_allpass8_part_t *part = &voice->parts[partIdx];
 
-            float sinAngC = info->sintbl[(unsigned short)part->angle];
-            float angFrac = part->angle - (float)((int)part->angle);
-            float sinAngN = info->sintbl[(unsigned short)(part->angle+1)];
-            float sinAng = sinAngC + (sinAngN - sinAngC) * angFrac;
-            float freq = part->freq_base + part->freq_rand * sinAng;
             float flt = l;
             for(unsigned int poleIdx = 0u; poleIdx < NUM_POLES; poleIdx++)
             {
-               part->ap[ch][poleIdx].setC(freq);
+               part->ap[ch][poleIdx].setC(freq[partIdx]);
                flt = part->ap[ch][poleIdx].process(flt);
             }
             out += flt * part->level[ch];
-
-            if(1u == ch)
-            {
-               part->angle += part->speed;
-               if(part->angle >= 65536.0f)
-                  part->angle -= 65536.0f;
-               else if(part->angle <= 0.0f)
-                  part->angle += 65536.0f;
-            }
+            Dstplugin_peak(peakWet, flt);
          }
 
          out = l + (out - l) * voice->mod_drywet_cur;
@@ -341,10 +341,16 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
       voice->mod_drywet_cur  += voice->mod_drywet_inc;
    }
 
+   Dstplugin_tail_update(voice->tail, peakIn, peakWet, _numFrames);
+}
+
+static unsigned int ST_PLUGIN_API loc_query_tail_state(st_plugin_voice_t *_voice) {
+   ST_PLUGIN_VOICE_CAST(wave_multiplier_allpass8_voice_t);
+   return Dstplugin_tail_state(voice->tail);
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   wave_multiplier_allpass8_shared_t *ret = (wave_multiplier_allpass8_shared_t *)malloc(sizeof(wave_multiplier_allpass8_shared_t));
+   wave_multiplier_allpass8_shared_t *ret = (wave_multiplier_allpass8_shared_t *)Dstplugin_alloc(_info, sizeof(wave_multiplier_allpass8_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -355,22 +361,30 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   wave_multiplier_allpass8_voice_t *ret = (wave_multiplier_allpass8_voice_t *)malloc(sizeof(wave_multiplier_allpass8_voice_t));
+   wave_multiplier_allpass8_voice_t *ret = (wave_multiplier_allpass8_voice_t *)Dstplugin_alloc(_info, sizeof(wave_multiplier_allpass8_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
       ret->base.info = _info;
+      ret->tail.num_tail_frames = 256u;  // allpass ring-out
    }
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(wave_multiplier_allpass8_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+   voice->tail.num_tail_frames = 256u;  // allpass ring-out
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -401,6 +415,7 @@ st_plugin_info_t *wave_multiplier_allpass8_init(void) {
       ret->base.shared_delete      = &loc_shared_delete;
       ret->base.voice_new          = &loc_voice_new;
       ret->base.voice_delete       = &loc_voice_delete;
+      ret->base.voice_reset        = &loc_voice_reset;
       ret->base.get_param_name     = &loc_get_param_name;
       ret->base.get_param_reset    = &loc_get_param_reset;
       ret->base.get_param_value    = &loc_get_param_value;
@@ -411,9 +426,10 @@ st_plugin_info_t *wave_multiplier_allpass8_init(void) {
       ret->base.set_mod_value      = &loc_set_mod_value;
       ret->base.prepare_block      = &loc_prepare_block;
       ret->base.process_replace    = &loc_process_replace;
+      ret->base.query_tail_state   = &loc_query_tail_state;
       ret->base.plugin_exit        = &loc_plugin_exit;
 
-      loc_init_sintbl(ret);
+      ret->sintbl = st_sintbl_get();
       ret->lfsr_state = 0x44894489u;////(unsigned int)(shared->params[PARAM_SEED] * 65536u);
    }
 
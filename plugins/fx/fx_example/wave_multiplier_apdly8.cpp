@@ -8,7 +8,7 @@
 // ---- info   : multiple randomized+modulated delay lines with allpass filter in feedback loop
 // ----
 // ---- created: 13Oct2021
-// ---- changed: 14Oct2021, 21Jan2024
+// ---- changed: 14Oct2021, 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -16,6 +16,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 #include <math.h>
 
 #include "../../../plugin.h"
@@ -25,6 +26,7 @@
 #define ST_DELAY_SIZE 1024
 #define ST_DELAY_MASK 1023
 #include "delay.h"
+#include "sintbl.h"
 
 #define MAX_PARTS  8
 #define NUM_POLES  8
@@ -81,7 +83,7 @@ static const char *loc_mod_names[NUM_MODS] = {
 
 typedef struct wave_multiplier_apdly8_info_s {
    st_plugin_info_t base;
-   float sintbl[65536];
+   const float *sintbl;  // shared (see sintbl.h)
    unsigned int lfsr_state;
 } wave_multiplier_apdly8_info_t;
 
@@ -124,19 +126,10 @@ typedef struct wave_multiplier_apdly8_voice_s {
    float   mod_drywet_inc;
    float   fb;
    wave_multiplier_apdly8_part_t parts[MAX_PARTS];
+   stplugin_tail_t tail;
 } wave_multiplier_apdly8_voice_t;
 
 
-static void loc_init_sintbl(wave_multiplier_apdly8_info_t *_info) {
-   float w = (float)(6.28318530718f / 65536.0f);
-   float a = 0.0f;
-   for(unsigned int i = 0u; i < 65536u; i++)
-   {
-      _info->sintbl[i] = sinf(a);
-      a += w;
-   }
-}
-
 static unsigned int loc_lfsr_randi(unsigned int &state) {
    state ^= (state >> 7);
    state ^= (state << 9);
@@ -155,6 +148,16 @@ static void ST_PLUGIN_API loc_set_sample_rate(st_plugin_voice_t *_voice,
                                               ) {
    ST_PLUGIN_VOICE_CAST(wave_multiplier_apdly8_voice_t);
    voice->sample_rate = _sampleRate;
+   // (note) modulated tap offsets are not clamped to the max. delay time => max. size
+   for(unsigned int partIdx = 0u; partIdx < MAX_PARTS; partIdx++)
+   {
+      if(!voice->parts[partIdx].dly[0].allocHistory(voice->base.info, float(ST_DELAY_SIZE)) ||
+         !voice->parts[partIdx].dly[1].allocHistory(voice->base.info, float(ST_DELAY_SIZE))
+         )
+      {
+         printf("[---] wave_multiplier_apdly8::set_sample_rate: failed to allocate delay history\n");
+      }
+   }
 }
 
 static const char *ST_PLUGIN_API loc_get_param_name(st_plugin_info_t *_info,
@@ -201,6 +204,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
    ST_PLUGIN_VOICE_CAST(wave_multiplier_apdly8_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(wave_multiplier_apdly8_shared_t);
    ST_PLUGIN_VOICE_INFO_CAST(wave_multiplier_apdly8_info_t);
+   Dstplugin_tail_reset(voice->tail);
    (void)_bGlide;
    (void)_note;
    (void)_vel;
@@ -363,8 +367,39 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
    unsigned int k = 0u;
 
+   float peakIn = 0.0f;
+   Dstplugin_peak_buf(peakIn, _samplesIn, _numFrames * 2u);
+   float peakWet = 0.0f;
+
    for(unsigned int i = 0u; i < _numFrames; i++)
    {
+      // LFOs (shared by both channels)
+      float freq[MAX_PARTS];
+      float off[MAX_PARTS];
+      for(unsigned int partIdx = 0u; partIdx < MAX_PARTS/*voice->num_parts*/; partIdx++)
+      {
+         wave_multiplier_apdly8_part_t *part = &voice->parts[partIdx];
+
+         float sinAng = st_sintbl_lerp(info->sintbl, part->lfo_freq.angle);
+         freq[partIdx] = part->freq_base + part->freq_rand * sinAng;
+
+         sinAng = st_sintbl_lerp(info->sintbl, part->lfo_delay.angle);
+         off[partIdx] = part->delay_base + part->delay_rand * sinAng;
+         off[partIdx] = Dstplugin_clamp(off[partIdx], 0.0f, (float)(ST_DELAY_SIZE - 1u));
+
+         part->lfo_freq.angle += part->lfo_freq.speed;
+         if(part->lfo_freq.angle >= 65536.0f)
+            part->lfo_freq.angle -= 65536.0f;
+         else if(part->lfo_freq.angle <= 0.0f)
+            part->lfo_freq.angle += 65536.0f;
+
+         part->lfo_delay.angle += part->lfo_delay.speed;
+         if(part->lfo_delay.angle >= 65536.0f)
+            part->lfo_delay.angle -= 65536.0f;
+         else if(part->lfo_delay.angle <= 0.0f)
+            part->lfo_delay.angle += 65536.0f;
+      }
+
       for(unsigned int ch = 0u; ch < 2u; ch++)
       {
          float l = _samplesIn[k];
@@ -374,52 +409,20 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          {
             wave_multiplier_apdly8_part_t *part = &voice->parts[partIdx];
 
-            float freq;
-            {
-               float sinAngC = info->sintbl[(unsigned short)part->lfo_freq.angle];
-               float angFrac = part->lfo_freq.angle - (float)((int)part->lfo_freq.angle);
-               float sinAngN = info->sintbl[(unsigned short)(part->lfo_freq.angle+1)];
-               float sinAng = sinAngC + (sinAngN - sinAngC) * angFrac;
-               freq = part->freq_base + part->freq_rand * sinAng;
-            }
-
             float lastOut = part->dly[ch].last_out;
 
             float flt = l + lastOut * voice->fb;
             for(unsigned int poleIdx = 0u; poleIdx < NUM_POLES; poleIdx++)
             {
-               part->ap[ch][poleIdx].setC(freq);
+               part->ap[ch][poleIdx].setC(freq[partIdx]);
                flt = part->ap[ch][poleIdx].process(flt);
             }
             part->dly[ch].pushRaw(flt);
+            Dstplugin_peak(peakWet, flt);
 
-            float off;
-            {
-               float sinAngC = info->sintbl[(unsigned short)part->lfo_delay.angle];
-               float angFrac = part->lfo_delay.angle - (float)((int)part->lfo_delay.angle);
-               float sinAngN = info->sintbl[(unsigned short)(part->lfo_delay.angle+1)];
-               float sinAng = sinAngC + (sinAngN - sinAngC) * angFrac;
-               off = part->delay_base + part->delay_rand * sinAng;
-               off = Dstplugin_clamp(off, 0.0f, (float)(ST_DELAY_SIZE - 1u));
-            }
-            float dly = part->dly[ch].readLinear(off);
+            float dly = part->dly[ch].readLinear(off[partIdx]);
 
             out += dly * part->level[ch];
-
-            if(1u == ch)
-            {
-               part->lfo_freq.angle += part->lfo_freq.speed;
-               if(part->lfo_freq.angle >= 65536.0f)
-                  part->lfo_freq.angle -= 65536.0f;
-               else if(part->lfo_freq.angle <= 0.0f)
-                  part->lfo_freq.angle += 65536.0f;
-
-               part->lfo_delay.angle += part->lfo_delay.speed;
-               if(part->lfo_delay.angle >= 65536.0f)
-                  part->lfo_delay.angle -= 65536.0f;
-               else if(part->lfo_delay.angle <= 0.0f)
-                  part->lfo_delay.angle += 65536.0f;
-            }
          }
 
          out = l + (out - l) * voice->mod_drywet_cur;
@@ -431,10 +434,16 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
       voice->mod_drywet_cur  += voice->mod_drywet_inc;
    }
 
+   Dstplugin_tail_update(voice->tail, peakIn, peakWet, _numFrames);
+}
+
+static unsigned int ST_PLUGIN_API loc_query_tail_state(st_plugin_voice_t *_voice) {
+   ST_PLUGIN_VOICE_CAST(wave_multiplier_apdly8_voice_t);
+   return Dstplugin_tail_state(voice->tail);
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   wave_multiplier_apdly8_shared_t *ret = (wave_multiplier_apdly8_shared_t *)malloc(sizeof(wave_multiplier_apdly8_shared_t));
+   wave_multiplier_apdly8_shared_t *ret = (wave_multiplier_apdly8_shared_t *)Dstplugin_alloc(_info, sizeof(wave_multiplier_apdly8_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -445,22 +454,50 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   wave_multiplier_apdly8_voice_t *ret = (wave_multiplier_apdly8_voice_t *)malloc(sizeof(wave_multiplier_apdly8_voice_t));
+   wave_multiplier_apdly8_voice_t *ret = (wave_multiplier_apdly8_voice_t *)Dstplugin_alloc(_info, sizeof(wave_multiplier_apdly8_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
       ret->base.info = _info;
+      for(unsigned int partIdx = 0u; partIdx < MAX_PARTS; partIdx++)
+      {
+         ret->parts[partIdx].dly[0].init();
+         ret->parts[partIdx].dly[1].init();
+      }
+      ret->tail.num_tail_frames = ST_DELAY_SIZE + 256u;  // +allpass ring-out
    }
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(wave_multiplier_apdly8_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear_to(voice, parts);
+   for(unsigned int partIdx = 0u; partIdx < MAX_PARTS; partIdx++)
+   {
+      // (note) keep history buffers
+      wave_multiplier_apdly8_part_t *part = &voice->parts[partIdx];
+      memset((void*)part, 0, offsetof(wave_multiplier_apdly8_part_t, dly));
+      part->dly[0].clear();
+      part->dly[1].clear();
+   }
+   Dstplugin_voice_clear_from(voice, tail);
+   voice->tail.num_tail_frames = ST_DELAY_SIZE + 256u;  // +allpass ring-out
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   ST_PLUGIN_VOICE_CAST(wave_multiplier_apdly8_voice_t);
+   for(unsigned int partIdx = 0u; partIdx < MAX_PARTS; partIdx++)
+   {
+      voice->parts[partIdx].dly[0].freeHistory(_voice->info);
+      voice->parts[partIdx].dly[1].freeHistory(_voice->info);
+   }
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -491,6 +528,7 @@ st_plugin_info_t *wave_multiplier_apdly8_init(void) {
       ret->base.shared_delete      = &loc_shared_delete;
       ret->base.voice_new          = &loc_voice_new;
       ret->base.voice_delete       = &loc_voice_delete;
+      ret->base.voice_reset        = &loc_voice_reset;
       ret->base.get_param_name     = &loc_get_param_name;
       ret->base.get_param_reset    = &loc_get_param_reset;
       ret->base.get_param_value    = &loc_get_param_value;
@@ -501,9 +539,10 @@ st_plugin_info_t *wave_multiplier_apdly8_init(void) {
       ret->base.set_mod_value      = &loc_set_mod_value;
       ret->base.prepare_block      = &loc_prepare_block;
       ret->base.process_replace    = &loc_process_replace;
+      ret->base.query_tail_state   = &loc_query_tail_state;
       ret->base.plugin_exit        = &loc_plugin_exit;
 
-      loc_init_sintbl(ret);
+      ret->sintbl = st_sintbl_get();
       ret->lfsr_state = 0x44894489u;////(unsigned int)(shared->params[PARAM_SEED] * 65536u);
    }
 
@@ -8,7 +8,7 @@
 // ---- info   : pseudo phase shifter
 // ----
 // ---- created: 13Oct2021
-// ---- changed: 21Jan2024
+// ---- changed: 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -105,6 +105,7 @@ typedef struct wave_multiplier_delay_voice_s {
    float   mod_time_1_smooth;  // smoothed shifts
    float   mod_time_2_smooth;
    float   mod_time_3_smooth;
+   stplugin_tail_t tail;
 } wave_multiplier_delay_voice_t;
 
 
@@ -113,6 +114,13 @@ static void ST_PLUGIN_API loc_set_sample_rate(st_plugin_voice_t *_voice,
                                               ) {
    ST_PLUGIN_VOICE_CAST(wave_multiplier_delay_voice_t);
    voice->sample_rate = _sampleRate;
+   // (note) modulated tap offsets are not clamped to the max. delay time => max. size
+   if(!voice->dly[0].allocHistory(voice->base.info, float(ST_DELAY_SIZE)) ||
+      !voice->dly[1].allocHistory(voice->base.info, float(ST_DELAY_SIZE))
+      )
+   {
+      printf("[---] wave_multiplier_delay::set_sample_rate: failed to allocate delay history\n");
+   }
 }
 
 static const char *ST_PLUGIN_API loc_get_param_name(st_plugin_info_t *_info,
@@ -157,6 +165,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
                                       float               _vel
                                       ) {
    ST_PLUGIN_VOICE_CAST(wave_multiplier_delay_voice_t);
+   Dstplugin_tail_reset(voice->tail);
    (void)_bGlide;
    (void)_note;
    (void)_vel;
@@ -288,6 +297,9 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
    unsigned int k = 0u;
 
+   float peakIn = 0.0f;
+   Dstplugin_peak_buf(peakIn, _samplesIn, _numFrames * 2u);
+
    for(unsigned int i = 0u; i < _numFrames; i++)
    {
       for(unsigned int ch = 0u; ch < 2u; ch++)
@@ -320,10 +332,17 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
       voice->mod_level3_cur  += voice->mod_level3_inc;
    }
 
+   // (note) feed-forward only: tail ends after ST_DELAY_SIZE frames of silent input
+   Dstplugin_tail_update(voice->tail, peakIn, 0.0f, _numFrames);
+}
+
+static unsigned int ST_PLUGIN_API loc_query_tail_state(st_plugin_voice_t *_voice) {
+   ST_PLUGIN_VOICE_CAST(wave_multiplier_delay_voice_t);
+   return Dstplugin_tail_state(voice->tail);
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   wave_multiplier_delay_shared_t *ret = (wave_multiplier_delay_shared_t *)malloc(sizeof(wave_multiplier_delay_shared_t));
+   wave_multiplier_delay_shared_t *ret = (wave_multiplier_delay_shared_t *)Dstplugin_alloc(_info, sizeof(wave_multiplier_delay_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -334,22 +353,38 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   wave_multiplier_delay_voice_t *ret = (wave_multiplier_delay_voice_t *)malloc(sizeof(wave_multiplier_delay_voice_t));
+   wave_multiplier_delay_voice_t *ret = (wave_multiplier_delay_voice_t *)Dstplugin_alloc(_info, sizeof(wave_multiplier_delay_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
       ret->base.info = _info;
+      ret->dly[0].init();
+      ret->dly[1].init();
+      ret->tail.num_tail_frames = ST_DELAY_SIZE;
    }
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(wave_multiplier_delay_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear_to(voice, dly);
+   voice->dly[0].clear();
+   voice->dly[1].clear();
+   Dstplugin_voice_clear_from(voice, tail);
+   voice->tail.num_tail_frames = ST_DELAY_SIZE;
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   ST_PLUGIN_VOICE_CAST(wave_multiplier_delay_voice_t);
+   voice->dly[0].freeHistory(_voice->info);
+   voice->dly[1].freeHistory(_voice->info);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -380,6 +415,7 @@ st_plugin_info_t *wave_multiplier_delay_init(void) {
       ret->base.shared_delete      = &loc_shared_delete;
       ret->base.voice_new          = &loc_voice_new;
       ret->base.voice_delete       = &loc_voice_delete;
+      ret->base.voice_reset        = &loc_voice_reset;
       ret->base.get_param_name     = &loc_get_param_name;
       ret->base.get_param_reset    = &loc_get_param_reset;
       ret->base.get_param_value    = &loc_get_param_value;
@@ -390,6 +426,7 @@ st_plugin_info_t *wave_multiplier_delay_init(void) {
       ret->base.set_mod_value      = &loc_set_mod_value;
       ret->base.prepare_block      = &loc_prepare_block;
       ret->base.process_replace    = &loc_process_replace;
+      ret->base.query_tail_state   = &loc_query_tail_state;
       ret->base.plugin_exit        = &loc_plugin_exit;
    }
 
@@ -8,7 +8,7 @@
 // ---- info   : pseudo phase shifter
 // ----
 // ---- created: 13Oct2021
-// ---- changed: 21Jan2024
+// ---- changed: 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -23,6 +23,8 @@
 #define ST_DELAY_SIZE 1024
 #define ST_DELAY_MASK 1023
 #include "delay.h"
+#include "sintbl.h"
+#include "multitap.h"
 
 #define MAX_PARTS  8
 
@@ -78,7 +80,7 @@ static const char *loc_mod_names[NUM_MODS] = {
 
 typedef struct wave_multiplier_delay8_info_s {
    st_plugin_info_t base;
-   float sintbl[65536];
+   const float *sintbl;  // shared (see sintbl.h)
    unsigned int lfsr_state;
 } wave_multiplier_delay8_info_t;
 
@@ -88,15 +90,10 @@ typedef struct wave_multiplier_delay8_shared_s {
 } wave_multiplier_delay8_shared_t;
 
 typedef struct wave_multiplier_delay8_part_s {
-   float angle;
-   float speed;
    float          speed_r;
    float          level_r;
    float          pan_r;
    float          delay_r;
-   float          level[2];
-   float          frame_base;
-   float          max_frames;
 } wave_multiplier_delay8_part_t;
 
 typedef struct wave_multiplier_delay8_voice_s {
@@ -107,20 +104,12 @@ typedef struct wave_multiplier_delay8_voice_s {
    float   mod_drywet_inc;
    // // unsigned int num_parts;
    wave_multiplier_delay8_part_t parts[MAX_PARTS];
+   StMultiTap<MAX_PARTS> taps;  // per-part LFO / delay time / level
    StDelay      dly[2];  // stereo
+   stplugin_tail_t tail;
 } wave_multiplier_delay8_voice_t;
 
 
-static void loc_init_sintbl(wave_multiplier_delay8_info_t *_info) {
-   float w = (float)(6.28318530718f / 65536.0f);
-   float a = 0.0f;
-   for(unsigned int i = 0u; i < 65536u; i++)
-   {
-      _info->sintbl[i] = sinf(a);
-      a += w;
-   }
-}
-
 static unsigned int loc_lfsr_randi(unsigned int &state) {
    state ^= (state >> 7);
    state ^= (state << 9);
@@ -139,6 +128,13 @@ static void ST_PLUGIN_API loc_set_sample_rate(st_plugin_voice_t *_voice,
                                               ) {
    ST_PLUGIN_VOICE_CAST(wave_multiplier_delay8_voice_t);
    voice->sample_rate = _sampleRate;
+   // (note) modulated tap offsets are not clamped to the max. delay time => max. size
+   if(!voice->dly[0].allocHistory(voice->base.info, float(ST_DELAY_SIZE)) ||
+      !voice->dly[1].allocHistory(voice->base.info, float(ST_DELAY_SIZE))
+      )
+   {
+      printf("[---] wave_multiplier_delay8::set_sample_rate: failed to allocate delay history\n");
+   }
 }
 
 static const char *ST_PLUGIN_API loc_get_param_name(st_plugin_info_t *_info,
@@ -185,6 +181,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
    ST_PLUGIN_VOICE_CAST(wave_multiplier_delay8_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(wave_multiplier_delay8_shared_t);
    ST_PLUGIN_VOICE_INFO_CAST(wave_multiplier_delay8_info_t);
+   Dstplugin_tail_reset(voice->tail);
    (void)_bGlide;
    (void)_note;
    (void)_vel;
@@ -198,7 +195,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
       {
          wave_multiplier_delay8_part_t *part = &voice->parts[partIdx];
 
-         part->angle = loc_lfsr_randf(info->lfsr_state, 65536.0f/*max*/);
+         voice->taps.angle[partIdx] = loc_lfsr_randf(info->lfsr_state, 65536.0f/*max*/);
          part->speed_r = loc_lfsr_randf(info->lfsr_state, 2.0f) - 1.0f;
          part->level_r = loc_lfsr_randf(info->lfsr_state, 2.0f) - 1.0f;
          part->pan_r   = loc_lfsr_randf(info->lfsr_state, 2.0f) - 1.0f;
@@ -253,18 +250,18 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
       float vol = shared->params[PARAM_LEVEL_BASE] + voice->mods[MOD_LEVEL_BASE] + part->level_r * (shared->params[PARAM_LEVEL_RAND] + voice->mods[MOD_LEVEL_RAND]);
       vol = Dstplugin_clamp(vol, 0.0f, 1.0f) * (1.0f - partIdx/float(MAX_PARTS));
       float ap = ((1.0f - pan) * 0.5f);
-      part->level[0/*l*/] = vol * ap;
-      part->level[1/*r*/] = vol * (1.0f - ap);
+      voice->taps.level[0/*l*/][partIdx] = vol * ap;
+      voice->taps.level[1/*r*/][partIdx] = vol * (1.0f - ap);
 
-      part->speed = (8.0f * (shared->params[PARAM_SPEED_BASE] + voice->mods[MOD_SPEED_BASE] + (shared->params[PARAM_SPEED_RAND] + voice->mods[MOD_SPEED_RAND]) * part->speed_r));
+      voice->taps.speed[partIdx] = (8.0f * (shared->params[PARAM_SPEED_BASE] + voice->mods[MOD_SPEED_BASE] + (shared->params[PARAM_SPEED_RAND] + voice->mods[MOD_SPEED_RAND]) * part->speed_r));
 
-      part->frame_base = (shared->params[PARAM_DELAY_BASE] + voice->mods[MOD_DELAY_BASE]) * maxFrames;
-      part->max_frames = maxFrames * (shared->params[PARAM_DELAY_RAND] + voice->mods[MOD_DELAY_RAND]) * part->delay_r;
+      voice->taps.frame_base[partIdx] = (shared->params[PARAM_DELAY_BASE] + voice->mods[MOD_DELAY_BASE]) * maxFrames;
+      voice->taps.max_frames[partIdx] = maxFrames * (shared->params[PARAM_DELAY_RAND] + voice->mods[MOD_DELAY_RAND]) * part->delay_r;
 
       // {
       //    if(0 == (xxx & 1023))
       //    {
-      //       printf("xxx part[%u] frame_base=%f max_frames=%f pan_r=%f level=%f/%f\n", partIdx, part->frame_base, part->max_frames, part->pan_r, part->level[0], part->level[1]);
+      //       printf("xxx part[%u] frame_base=%f max_frames=%f pan_r=%f level=%f/%f\n", partIdx, voice->taps.frame_base[partIdx], voice->taps.max_frames[partIdx], part->pan_r, voice->taps.level[0][partIdx], voice->taps.level[1][partIdx]);
       //       fflush(stdout);
       //    }
       // }
@@ -298,51 +295,40 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
    unsigned int k = 0u;
 
+   float peakIn = 0.0f;
+   Dstplugin_peak_buf(peakIn, _samplesIn, _numFrames * 2u);
+
    for(unsigned int i = 0u; i < _numFrames; i++)
    {
+      float out[2];
+      voice->taps.read(info->sintbl, voice->dly, out[0], out[1]);
+
       for(unsigned int ch = 0u; ch < 2u; ch++)
       {
          float l = _samplesIn[k];
-         float out = 0.0f;
-
-         for(unsigned int partIdx = 0u; partIdx < MAX_PARTS/*voice->num_parts*/; partIdx++)
-         {
-            wave_multiplier_delay8_part_t *part = &voice->parts[partIdx];
-
-            float sinAngC = info->sintbl[(unsigned short)part->angle];
-            float angFrac = part->angle - (float)((int)part->angle);
-            float sinAngN = info->sintbl[(unsigned short)(part->angle+1)];
-            float sinAng = sinAngC + (sinAngN - sinAngC) * angFrac;
-            float off = part->frame_base + part->max_frames * sinAng;
-            off = Dstplugin_clamp(off, 0.0f, (float)(ST_DELAY_SIZE - 1u));
-            float dly = voice->dly[ch].readLinear(off);
-            out += dly * part->level[ch];
-
-            if(1u == ch)
-            {
-               part->angle += part->speed;
-               if(part->angle >= 65536.0f)
-                  part->angle -= 65536.0f;
-               else if(part->angle <= 0.0f)
-                  part->angle += 65536.0f;
-            }
-         }
-
-         out = l + (out - l) * voice->mod_drywet_cur;
-
-         voice->dly[ch].push(l, 0.0f/*fb*/);
-
-         _samplesOut[k++] = out;
+
+         out[ch] = l + (out[ch] - l) * voice->mod_drywet_cur;
+
+         voice->dly[ch].pushRaw(l);
+
+         _samplesOut[k++] = out[ch];
       }
 
       // Next frame
       voice->mod_drywet_cur  += voice->mod_drywet_inc;
    }
 
+   // (note) feed-forward only: tail ends after ST_DELAY_SIZE frames of silent input
+   Dstplugin_tail_update(voice->tail, peakIn, 0.0f, _numFrames);
+}
+
+static unsigned int ST_PLUGIN_API loc_query_tail_state(st_plugin_voice_t *_voice) {
+   ST_PLUGIN_VOICE_CAST(wave_multiplier_delay8_voice_t);
+   return Dstplugin_tail_state(voice->tail);
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   wave_multiplier_delay8_shared_t *ret = (wave_multiplier_delay8_shared_t *)malloc(sizeof(wave_multiplier_delay8_shared_t));
+   wave_multiplier_delay8_shared_t *ret = (wave_multiplier_delay8_shared_t *)Dstplugin_alloc(_info, sizeof(wave_multiplier_delay8_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -353,22 +339,38 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   wave_multiplier_delay8_voice_t *ret = (wave_multiplier_delay8_voice_t *)malloc(sizeof(wave_multiplier_delay8_voice_t));
+   wave_multiplier_delay8_voice_t *ret = (wave_multiplier_delay8_voice_t *)Dstplugin_alloc(_info, sizeof(wave_multiplier_delay8_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
       ret->base.info = _info;
+      ret->dly[0].init();
+      ret->dly[1].init();
+      ret->tail.num_tail_frames = ST_DELAY_SIZE;
    }
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(wave_multiplier_delay8_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear_to(voice, dly);
+   voice->dly[0].clear();
+   voice->dly[1].clear();
+   Dstplugin_voice_clear_from(voice, tail);
+   voice->tail.num_tail_frames = ST_DELAY_SIZE;
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   ST_PLUGIN_VOICE_CAST(wave_multiplier_delay8_voice_t);
+   voice->dly[0].freeHistory(_voice->info);
+   voice->dly[1].freeHistory(_voice->info);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -399,6 +401,7 @@ st_plugin_info_t *wave_multiplier_delay8_init(void) {
       ret->base.shared_delete      = &loc_shared_delete;
       ret->base.voice_new          = &loc_voice_new;
       ret->base.voice_delete       = &loc_voice_delete;
+      ret->base.voice_reset        = &loc_voice_reset;
       ret->base.get_param_name     = &loc_get_param_name;
       ret->base.get_param_reset    = &loc_get_param_reset;
       ret->base.get_param_value    = &loc_get_param_value;
@@ -409,9 +412,10 @@ st_plugin_info_t *wave_multiplier_delay8_init(void) {
       ret->base.set_mod_value      = &loc_set_mod_value;
       ret->base.prepare_block      = &loc_prepare_block;
       ret->base.process_replace    = &loc_process_replace;
+      ret->base.query_tail_state   = &loc_query_tail_state;
       ret->base.plugin_exit        = &loc_plugin_exit;
 
-      loc_init_sintbl(ret);
+      ret->sintbl = st_sintbl_get();
       ret->lfsr_state = 0x44894489u;////(unsigned int)(shared->params[PARAM_SEED] * 65536u);
    }
 
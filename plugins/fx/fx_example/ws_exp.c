@@ -10,7 +10,7 @@
 // ----
 // ---- created: 10May2009
 // ---- changed: 23May2010, 30Sep2010, 07Oct2010, 20May2020, 21May2020, 24May2020, 31May2020
-// ----          08Jun2020,21Jan2024
+// ----          08Jun2020,21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -20,6 +20,8 @@
 
 #include "../../../plugin.h"
 
+#include "wshaper.h"
+
 #define PARAM_DRYWET        0
 #define PARAM_DRIVE         1
 #define PARAM_INPUT_LEVEL   2
@@ -48,6 +50,7 @@ static const char *loc_mod_names[NUM_MODS] = {
 
 typedef struct ws_exp_info_s {
    st_plugin_info_t base;
+   st_wshaper_t ws;  // transfer curve (periodic, built in ws_exp_init())
 } ws_exp_info_t;
 
 typedef struct ws_exp_shared_s {
@@ -176,81 +179,65 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    }
 }
 
+// Transfer curve (one period)
+static float loc_shape(const float *_keys, float _x) {
+   (void)_keys;
+   double s = sin(_x);
+   return (float) (
+      (exp(s*4) - exp(-s*4*1.25)) /
+      (exp(s*4) + exp(-s*4))
+                   );
+}
+
+static inline void loc_process(st_plugin_voice_t  *_voice,
+                               int                 _bMonoIn,
+                               const float        *_samplesIn,
+                               float              *_samplesOut,
+                               unsigned int        _numFrames,
+                               const int           _bAdd,
+                               const float         _gain
+                               ) {
+   ST_PLUGIN_VOICE_CAST(ws_exp_voice_t);
+   ST_PLUGIN_VOICE_INFO_CAST(ws_exp_info_t);
+
+   st_wshaper_ramp_t ramps[ST_WSHAPER_NUM_RAMPS];
+   ramps[ST_WSHAPER_RAMP_DRYWET].cur = voice->mod_drywet_cur;
+   ramps[ST_WSHAPER_RAMP_DRYWET].inc = voice->mod_drywet_inc;
+   ramps[ST_WSHAPER_RAMP_OFFSET].cur = 0.0f;
+   ramps[ST_WSHAPER_RAMP_OFFSET].inc = 0.0f;
+   ramps[ST_WSHAPER_RAMP_DRIVE ].cur = voice->mod_drive_cur;
+   ramps[ST_WSHAPER_RAMP_DRIVE ].inc = voice->mod_drive_inc;
+   ramps[ST_WSHAPER_RAMP_LEVEL ].cur = voice->mod_max_cur;
+   ramps[ST_WSHAPER_RAMP_LEVEL ].inc = voice->mod_max_inc;
+   st_wshaper_process(&info->ws, ramps, NULL/*adaaLast*/,
+                      _bMonoIn, _samplesIn, _samplesOut, _numFrames, _bAdd, _gain
+                      );
+   voice->mod_drywet_cur = ramps[ST_WSHAPER_RAMP_DRYWET].cur;
+   voice->mod_drive_cur  = ramps[ST_WSHAPER_RAMP_DRIVE ].cur;
+   voice->mod_max_cur    = ramps[ST_WSHAPER_RAMP_LEVEL ].cur;
+}
+
 static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
                                               int                 _bMonoIn,
                                               const float        *_samplesIn,
-                                              float              *_samplesOut, 
+                                              float              *_samplesOut,
                                               unsigned int        _numFrames
                                               ) {
-   // Ring modulate at (modulated) note frequency
-   ST_PLUGIN_VOICE_CAST(ws_exp_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(ws_exp_shared_t);
-
-   unsigned int k = 0u;
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 0/*bAdd*/, 1.0f/*gain*/);
+}
 
-   if(_bMonoIn)
-   {
-      // Mono input, stereo output
-      for(unsigned int i = 0u; i < _numFrames; i++)
-      {
-         float l = _samplesIn[k];
-         float a = l * voice->mod_drive_cur;
-         a = (float) (
-            (exp(sin(a)*4) - exp(-sin(a)*4*1.25)) /
-            (exp(sin(a)*4) + exp(-sin(a)*4))
-                      );
-         a *= voice->mod_max_cur;
-         float out = l + (a - l) * voice->mod_drywet_cur;
-         out = Dstplugin_fix_denorm_32(out);
-         _samplesOut[k]      = out;
-         _samplesOut[k + 1u] = out;
-
-         // Next frame
-         k += 2u;
-         voice->mod_drywet_cur += voice->mod_drywet_inc;
-         voice->mod_drive_cur  += voice->mod_drive_inc;
-         voice->mod_max_cur    += voice->mod_max_inc;
-      }
-   }
-   else
-   {
-      // Stereo input, stereo output
-      for(unsigned int i = 0u; i < _numFrames; i++)
-      {
-         float l = _samplesIn[k];
-         float al = l * voice->mod_drive_cur;
-         al = (float) (
-            (exp(sin(al)*4) - exp(-sin(al)*4*1.25)) /
-            (exp(sin(al)*4) + exp(-sin(al)*4))
-                      );
-         al *= voice->mod_max_cur;
-         float outL = l + (al - l) * voice->mod_drywet_cur;
-         outL = Dstplugin_fix_denorm_32(outL);
-
-         float r = _samplesIn[k + 1u];
-         float ar = r * voice->mod_drive_cur;
-         ar = (float) (
-            (exp(sin(ar)*4) - exp(-sin(ar)*4*1.25)) /
-            (exp(sin(ar)*4) + exp(-sin(ar)*4))
-                      );
-         ar *= voice->mod_max_cur;
-         float outR = r + (ar - r) * voice->mod_drywet_cur;
-         outR = Dstplugin_fix_denorm_32(outR);
-
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outR;
-
-         // Next frame
-         k += 2u;
-         voice->mod_drywet_cur += voice->mod_drywet_inc;
-         voice->mod_drive_cur  += voice->mod_drive_inc;
-         voice->mod_max_cur    += voice->mod_max_inc;
-      }
-   }
+static void ST_PLUGIN_API loc_process_add(st_plugin_voice_t  *_voice,
+                                          int                 _bMonoIn,
+                                          const float        *_samplesIn,
+                                          float              *_samplesOut,
+                                          unsigned int        _numFrames,
+                                          float               _gain
+                                          ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 1/*bAdd*/, _gain);
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   ws_exp_shared_t *ret = malloc(sizeof(ws_exp_shared_t));
+   ws_exp_shared_t *ret = Dstplugin_alloc(_info, sizeof(ws_exp_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -261,12 +248,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   ws_exp_voice_t *ret = malloc(sizeof(ws_exp_voice_t));
+   ws_exp_voice_t *ret = Dstplugin_alloc(_info, sizeof(ws_exp_voice_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -275,8 +262,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(ws_exp_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free(_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -306,6 +299,7 @@ st_plugin_info_t *ws_exp_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -315,7 +309,10 @@ st_plugin_info_t *ws_exp_init(void) {
       ret->base.set_mod_value    = &loc_set_mod_value;
       ret->base.prepare_block    = &loc_prepare_block;
       ret->base.process_replace  = &loc_process_replace;
+      ret->base.process_add      = &loc_process_add;
       ret->base.plugin_exit      = &loc_plugin_exit;
+
+      (void)st_wshaper_update(&ret->ws, &loc_shape, NULL, 0u, 0.0f, ST_PLUGIN_2PI_F, ST_WSHAPER_FLAG_PERIODIC);
    }
 
    return &ret->base;
@@ -9,7 +9,7 @@
 // ----           idea based on DHE's 'cubic' VCV Rack module
 // ----
 // ---- created: 23Feb2021
-// ---- changed: 21Jan2024, 14Oct2024
+// ---- changed: 21Jan2024, 14Oct2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -19,6 +19,8 @@
 
 #include "../../../plugin.h"
 
+#include "wshaper.h"
+
 #define PARAM_DRYWET   0
 #define PARAM_OFF      1
 #define PARAM_DRIVE    2
@@ -27,7 +29,8 @@
 #define PARAM_HALF     5
 #define PARAM_MIDDOWN  6
 #define PARAM_FLOOR    7
-#define NUM_PARAMS     8
+#define PARAM_AA       8
+#define NUM_PARAMS     9
 static const char *loc_param_names[NUM_PARAMS] = {
    "Dry / Wet",
    "Offset",
@@ -36,7 +39,8 @@ static const char *loc_param_names[NUM_PARAMS] = {
    "Mid Up",
    "Half-Way",
    "Mid Down",
-   "Floor"
+   "Floor",
+   "Anti-Alias"
 };
 static float loc_param_resets[NUM_PARAMS] = {
    1.0f,  // DRYWET
@@ -46,7 +50,8 @@ static float loc_param_resets[NUM_PARAMS] = {
    0.5f,  // MIDUP
    0.5f,  // HALF
    0.5f,  // MIDDOWN
-   0.5f  // FLOOR
+   0.5f,  // FLOOR
+   0.0f   // AA (>=0.5: on)
 };
 
 #define MOD_DRYWET   0
@@ -97,6 +102,9 @@ typedef struct ws_flex_voice_s {
    float mod_middown_inc;
    float mod_floor_cur;
    float mod_floor_inc;
+   int   b_lut;         // 1=shape is static during this block (or AA is enabled) => table lookup
+   float adaa_last[2];  // previous curve input (l, r)
+   st_wshaper_t ws;     // (note) not cleared in voice_reset()
 } ws_flex_voice_t;
 
 
@@ -161,6 +169,12 @@ static void ST_PLUGIN_API loc_set_mod_value(st_plugin_voice_t *_voice,
    voice->mods[_modIdx] = _value;
 }
 
+// Transfer curve table range: -1..~1.0005 (819 segments per 0.4 region => region boundaries are table nodes)
+#define LUT_X_MIN  (-1.0f)
+#define LUT_X_MAX  (-1.0f + ST_WSHAPER_SIZE * (0.4f / 819.0f))
+
+static float loc_shape(const float *_keys, float _x);
+
 static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
                                             unsigned int       _numFrames,
                                             float              _freqHz,
@@ -222,6 +236,32 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
       voice->mod_floor_cur   = modFloor;
       voice->mod_floor_inc   = 0.0f;
    }
+
+   // Use transfer curve table while the shape is static (or when anti-aliasing is enabled)
+   //  (note) the table is only rebuilt when the shape has changed
+   const int bAA = (shared->params[PARAM_AA] >= 0.5f);
+   voice->b_lut = bAA || (
+      fabsf(modCeil    - voice->mod_ceil_cur)    < ST_WSHAPER_KEY_EPSILON &&
+      fabsf(modMidUp   - voice->mod_midup_cur)   < ST_WSHAPER_KEY_EPSILON &&
+      fabsf(modHalf    - voice->mod_half_cur)    < ST_WSHAPER_KEY_EPSILON &&
+      fabsf(modMidDown - voice->mod_middown_cur) < ST_WSHAPER_KEY_EPSILON &&
+      fabsf(modFloor   - voice->mod_floor_cur)   < ST_WSHAPER_KEY_EPSILON
+                           );
+   if(voice->b_lut)
+   {
+      voice->mod_ceil_cur    = modCeil;
+      voice->mod_ceil_inc    = 0.0f;
+      voice->mod_midup_cur   = modMidUp;
+      voice->mod_midup_inc   = 0.0f;
+      voice->mod_half_cur    = modHalf;
+      voice->mod_half_inc    = 0.0f;
+      voice->mod_middown_cur = modMidDown;
+      voice->mod_middown_inc = 0.0f;
+      voice->mod_floor_cur   = modFloor;
+      voice->mod_floor_inc   = 0.0f;
+      const float keys[5] = { modCeil, modMidUp, modHalf, modMidDown, modFloor };
+      (void)st_wshaper_update(&voice->ws, &loc_shape, keys, 5u, LUT_X_MIN, LUT_X_MAX, bAA ? ST_WSHAPER_FLAG_ADAA : 0u);
+   }
 }
 
 static float loc_bend(float f, float c) {
@@ -247,18 +287,56 @@ static float loc_bend(float f, float c) {
    return u.f;      
 }
 
-static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
-                                              int                 _bMonoIn,
-                                              const float        *_samplesIn,
-                                              float              *_samplesOut, 
-                                              unsigned int        _numFrames
-                                              ) {
+// Transfer curve (keys: ceil, mid-up, half-way, mid-down, floor)
+static float loc_shape(const float *_keys, float _x) {
+   if(_x >= 1.0f)
+      _x = 1.0f;
+   if(_x >= 0.6f)
+      return loc_bend(_x - 0.6f, _keys[0]) + 0.6f;
+   else if(_x >= 0.2f)
+      return loc_bend(_x - 0.2f, _keys[1]) + 0.2f;
+   else if(_x >= -0.2f)
+      return loc_bend(_x - -0.2f, _keys[2]) + -0.2f;
+   else if(_x >= -0.6f)
+      return loc_bend(_x - -0.6f, _keys[3]) + -0.6f;
+   return loc_bend(_x - -1.0f, _keys[4]) + -1.0f;
+}
+
+static inline void loc_process(st_plugin_voice_t  *_voice,
+                               int                 _bMonoIn,
+                               const float        *_samplesIn,
+                               float              *_samplesOut,
+                               unsigned int        _numFrames,
+                               const int           _bAdd,
+                               const float         _gain
+                               ) {
    // Ring modulate at (modulated) note frequency
    ST_PLUGIN_VOICE_CAST(ws_flex_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(ws_flex_shared_t);
 
    unsigned int k = 0u;
 
+   if(voice->b_lut)
+   {
+      st_wshaper_ramp_t ramps[ST_WSHAPER_NUM_RAMPS];
+      ramps[ST_WSHAPER_RAMP_DRYWET].cur = voice->mod_drywet_cur;
+      ramps[ST_WSHAPER_RAMP_DRYWET].inc = voice->mod_drywet_inc;
+      ramps[ST_WSHAPER_RAMP_OFFSET].cur = voice->mod_off_cur;
+      ramps[ST_WSHAPER_RAMP_OFFSET].inc = voice->mod_off_inc;
+      ramps[ST_WSHAPER_RAMP_DRIVE ].cur = voice->mod_drive_cur;
+      ramps[ST_WSHAPER_RAMP_DRIVE ].inc = voice->mod_drive_inc;
+      ramps[ST_WSHAPER_RAMP_LEVEL ].cur = 1.0f;
+      ramps[ST_WSHAPER_RAMP_LEVEL ].inc = 0.0f;
+      st_wshaper_process(&voice->ws, ramps,
+                         (shared->params[PARAM_AA] >= 0.5f) ? voice->adaa_last : NULL,
+                         _bMonoIn, _samplesIn, _samplesOut, _numFrames, _bAdd, _gain
+                         );
+      voice->mod_drywet_cur = ramps[ST_WSHAPER_RAMP_DRYWET].cur;
+      voice->mod_off_cur    = ramps[ST_WSHAPER_RAMP_OFFSET].cur;
+      voice->mod_drive_cur  = ramps[ST_WSHAPER_RAMP_DRIVE ].cur;
+      return;
+   }
+
    if(_bMonoIn)
    {
       // Mono input, stereo output
@@ -313,8 +391,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
          outL = l + (outL - l) * voice->mod_drywet_cur;
          outL = Dstplugin_fix_denorm_32(outL);
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outL;
+         Dstplugin_out(_bAdd, _samplesOut[k],      outL, _gain);
+         Dstplugin_out(_bAdd, _samplesOut[k + 1u], outL, _gain);
 
          // Next frame
          k += 2u;
@@ -437,8 +515,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          outR = r + (outR - r) * voice->mod_drywet_cur;
          outR = Dstplugin_fix_denorm_32(outR);
 
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outR;
+         Dstplugin_out(_bAdd, _samplesOut[k],      outL, _gain);
+         Dstplugin_out(_bAdd, _samplesOut[k + 1u], outR, _gain);
 
          // Next frame
          k += 2u;
@@ -454,8 +532,27 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
    }
 }
 
+static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
+                                              int                 _bMonoIn,
+                                              const float        *_samplesIn,
+                                              float              *_samplesOut,
+                                              unsigned int        _numFrames
+                                              ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 0/*bAdd*/, 1.0f/*gain*/);
+}
+
+static void ST_PLUGIN_API loc_process_add(st_plugin_voice_t  *_voice,
+                                          int                 _bMonoIn,
+                                          const float        *_samplesIn,
+                                          float              *_samplesOut,
+                                          unsigned int        _numFrames,
+                                          float               _gain
+                                          ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 1/*bAdd*/, _gain);
+}
+
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   ws_flex_shared_t *ret = malloc(sizeof(ws_flex_shared_t));
+   ws_flex_shared_t *ret = Dstplugin_alloc(_info, sizeof(ws_flex_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -466,12 +563,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   ws_flex_voice_t *ret = malloc(sizeof(ws_flex_voice_t));
+   ws_flex_voice_t *ret = Dstplugin_alloc(_info, sizeof(ws_flex_voice_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -480,8 +577,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(ws_flex_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear_to(voice, ws);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free(_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -511,6 +614,7 @@ st_plugin_info_t *ws_flex_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -520,6 +624,7 @@ st_plugin_info_t *ws_flex_init(void) {
       ret->base.set_mod_value    = &loc_set_mod_value;
       ret->base.prepare_block    = &loc_prepare_block;
       ret->base.process_replace  = &loc_process_replace;
+      ret->base.process_add      = &loc_process_add;
       ret->base.plugin_exit      = &loc_plugin_exit;
    }
 
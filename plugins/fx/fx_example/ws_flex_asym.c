@@ -9,7 +9,7 @@
 // ----           idea based on DHE's 'cubic' VCV Rack module
 // ----
 // ---- created: 23Feb2021
-// ---- changed: 21Jan2024
+// ---- changed: 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -20,18 +20,22 @@
 
 #include "../../../plugin.h"
 
+#include "wshaper.h"
+
 #define PARAM_DRYWET   0
 #define PARAM_OFF      1
 #define PARAM_DRIVE    2
 #define PARAM_POS      3
 #define PARAM_NEG      4
-#define NUM_PARAMS     5
+#define PARAM_AA       5
+#define NUM_PARAMS     6
 static const char *loc_param_names[NUM_PARAMS] = {
    "Dry / Wet",
    "Offset",
    "Drive",
    "Pos",
    "Neg",
+   "Anti-Alias",
 };
 static float loc_param_resets[NUM_PARAMS] = {
    1.0f,  // DRYWET
@@ -39,6 +43,7 @@ static float loc_param_resets[NUM_PARAMS] = {
    0.5f,  // DRIVE
    0.5f,  // POS
    0.5f,  // NEG
+   0.0f,  // AA (>=0.5: on)
 };
 
 #define MOD_DRYWET   0
@@ -77,6 +82,9 @@ typedef struct ws_flex_asym_voice_s {
    float mod_pos_inc;
    float mod_neg_cur;
    float mod_neg_inc;
+   int   b_lut;         // 1=shape is static during this block (or AA is enabled) => table lookup
+   float adaa_last[2];  // previous curve input (l, r)
+   st_wshaper_t ws;     // (note) not cleared in voice_reset()
 } ws_flex_asym_voice_t;
 
 
@@ -141,6 +149,8 @@ static void ST_PLUGIN_API loc_set_mod_value(st_plugin_voice_t *_voice,
    voice->mods[_modIdx] = _value;
 }
 
+static float loc_shape(const float *_keys, float _x);
+
 static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
                                             unsigned int       _numFrames,
                                             float              _freqHz,
@@ -190,6 +200,23 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
       voice->mod_neg_cur     = modNeg;
       voice->mod_neg_inc     = 0.0f;
    }
+
+   // Use transfer curve table while the shape is static (or when anti-aliasing is enabled)
+   //  (note) the table is only rebuilt when the shape has changed
+   const int bAA = (shared->params[PARAM_AA] >= 0.5f);
+   voice->b_lut = bAA || (
+      fabsf(modPos - voice->mod_pos_cur) < ST_WSHAPER_KEY_EPSILON &&
+      fabsf(modNeg - voice->mod_neg_cur) < ST_WSHAPER_KEY_EPSILON
+                           );
+   if(voice->b_lut)
+   {
+      voice->mod_pos_cur = modPos;
+      voice->mod_pos_inc = 0.0f;
+      voice->mod_neg_cur = modNeg;
+      voice->mod_neg_inc = 0.0f;
+      const float keys[2] = { modPos, modNeg };
+      (void)st_wshaper_update(&voice->ws, &loc_shape, keys, 2u, -1.0f, 1.0f, bAA ? ST_WSHAPER_FLAG_ADAA : 0u);
+   }
 }
 
 static float loc_bend(float f, float c) {
@@ -215,18 +242,49 @@ static float loc_bend(float f, float c) {
    return u.f;      
 }
 
-static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
-                                              int                 _bMonoIn,
-                                              const float        *_samplesIn,
-                                              float              *_samplesOut, 
-                                              unsigned int        _numFrames
-                                              ) {
+// Transfer curve (keys: pos, neg)
+static float loc_shape(const float *_keys, float _x) {
+   _x = Dstplugin_clamp(_x, -1.0f, 1.0f);
+   if(_x >= 0.0f)
+      return loc_bend(_x, _keys[0]);
+   return -loc_bend(-_x, _keys[1]);
+}
+
+static inline void loc_process(st_plugin_voice_t  *_voice,
+                               int                 _bMonoIn,
+                               const float        *_samplesIn,
+                               float              *_samplesOut,
+                               unsigned int        _numFrames,
+                               const int           _bAdd,
+                               const float         _gain
+                               ) {
    // Ring modulate at (modulated) note frequency
    ST_PLUGIN_VOICE_CAST(ws_flex_asym_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(ws_flex_asym_shared_t);
 
    unsigned int k = 0u;
 
+   if(voice->b_lut)
+   {
+      st_wshaper_ramp_t ramps[ST_WSHAPER_NUM_RAMPS];
+      ramps[ST_WSHAPER_RAMP_DRYWET].cur = voice->mod_drywet_cur;
+      ramps[ST_WSHAPER_RAMP_DRYWET].inc = voice->mod_drywet_inc;
+      ramps[ST_WSHAPER_RAMP_OFFSET].cur = voice->mod_off_cur;
+      ramps[ST_WSHAPER_RAMP_OFFSET].inc = voice->mod_off_inc;
+      ramps[ST_WSHAPER_RAMP_DRIVE ].cur = voice->mod_drive_cur;
+      ramps[ST_WSHAPER_RAMP_DRIVE ].inc = voice->mod_drive_inc;
+      ramps[ST_WSHAPER_RAMP_LEVEL ].cur = 1.0f;
+      ramps[ST_WSHAPER_RAMP_LEVEL ].inc = 0.0f;
+      st_wshaper_process(&voice->ws, ramps,
+                         (shared->params[PARAM_AA] >= 0.5f) ? voice->adaa_last : NULL,
+                         _bMonoIn, _samplesIn, _samplesOut, _numFrames, _bAdd, _gain
+                         );
+      voice->mod_drywet_cur = ramps[ST_WSHAPER_RAMP_DRYWET].cur;
+      voice->mod_off_cur    = ramps[ST_WSHAPER_RAMP_OFFSET].cur;
+      voice->mod_drive_cur  = ramps[ST_WSHAPER_RAMP_DRIVE ].cur;
+      return;
+   }
+
    if(_bMonoIn)
    {
       // Mono input, stereo output
@@ -256,8 +314,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
          outL = l + (outL - l) * voice->mod_drywet_cur;
          outL = Dstplugin_fix_denorm_32(outL);
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outL;
+         Dstplugin_out(_bAdd, _samplesOut[k],      outL, _gain);
+         Dstplugin_out(_bAdd, _samplesOut[k + 1u], outL, _gain);
 
          // Next frame
          k += 2u;
@@ -327,8 +385,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          outR = r + (outR - r) * voice->mod_drywet_cur;
          outR = Dstplugin_fix_denorm_32(outR);
 
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outR;
+         Dstplugin_out(_bAdd, _samplesOut[k],      outL, _gain);
+         Dstplugin_out(_bAdd, _samplesOut[k + 1u], outR, _gain);
 
          // Next frame
          k += 2u;
@@ -341,8 +399,27 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
    }
 }
 
+static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
+                                              int                 _bMonoIn,
+                                              const float        *_samplesIn,
+                                              float              *_samplesOut,
+                                              unsigned int        _numFrames
+                                              ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 0/*bAdd*/, 1.0f/*gain*/);
+}
+
+static void ST_PLUGIN_API loc_process_add(st_plugin_voice_t  *_voice,
+                                          int                 _bMonoIn,
+                                          const float        *_samplesIn,
+                                          float              *_samplesOut,
+                                          unsigned int        _numFrames,
+                                          float               _gain
+                                          ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 1/*bAdd*/, _gain);
+}
+
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   ws_flex_asym_shared_t *ret = malloc(sizeof(ws_flex_asym_shared_t));
+   ws_flex_asym_shared_t *ret = Dstplugin_alloc(_info, sizeof(ws_flex_asym_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -353,12 +430,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   ws_flex_asym_voice_t *ret = malloc(sizeof(ws_flex_asym_voice_t));
+   ws_flex_asym_voice_t *ret = Dstplugin_alloc(_info, sizeof(ws_flex_asym_voice_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -367,8 +444,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(ws_flex_asym_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear_to(voice, ws);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free(_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -398,6 +481,7 @@ st_plugin_info_t *ws_flex_asym_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -407,6 +491,7 @@ st_plugin_info_t *ws_flex_asym_init(void) {
       ret->base.set_mod_value    = &loc_set_mod_value;
       ret->base.prepare_block    = &loc_prepare_block;
       ret->base.process_replace  = &loc_process_replace;
+      ret->base.process_add      = &loc_process_add;
       ret->base.plugin_exit      = &loc_plugin_exit;
    }
 
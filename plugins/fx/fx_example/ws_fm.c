@@ -8,7 +8,7 @@
 // ---- info   : a sine / FM waveshaper that supports per-sample-frame parameter interpolation
 // ----
 // ---- created: 20May2020
-// ---- changed: 21May2020, 24May2020, 31May2020, 08Jun2020, 21Jan2024
+// ---- changed: 21May2020, 24May2020, 31May2020, 08Jun2020, 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -18,6 +18,10 @@
 
 #include "../../../plugin.h"
 
+#include "wshaper.h"
+
+#define CHUNK_SIZE  (64u)  // process_replace() temp buffers (frames)
+
 #define PARAM_DRYWET    0
 #define PARAM_FREQ      1
 #define PARAM_PHASE     2
@@ -66,14 +70,14 @@ typedef union {
    unsigned int u;
 } ws_fm_fi_u;
 
-typedef struct biquad_s {
-   float x1, x2;
-   float y1, y2;
-   float a0, a1, a2, a3, a4;
-} biquad_t;
+typedef struct hpf_s {
+   float s1, s2;  // integrator states
+   float g, k, h;
+} hpf_t;
 
 typedef struct ws_fm_info_s {
    st_plugin_info_t base;
+   const st_wshaper_t *ws_sin;  // shared (see wshaper.h)
 } ws_fm_info_t;
 
 typedef struct ws_fm_shared_s {
@@ -99,59 +103,42 @@ typedef struct ws_fm_voice_s {
    float    lfo_speed;
    float    lfo_level;
    // fixed frequency dc-filter:
-   biquad_t hpf_l;
-   biquad_t hpf_r;
+   hpf_t    hpf_l;
+   hpf_t    hpf_r;
 } ws_fm_voice_t;
 
 
-static void biquad_init(biquad_t *_f) {
+static void hpf_init(hpf_t *_f) {
    // (note) hardcoded sample rate but this does not really matter for this purpose
    float bandwidth = 4.3f;
    float freq = 0.0002f * (0.5f * 44100.0f);
 
-   float omega, sn, cs, alpha;
-   float a0, a1, a2, b0, b1, b2;
-
-   // A = powf(10, dbGain /40);
-   omega = (float) (ST_PLUGIN_2PI_F * freq / 44100.0f);
-   sn = sinf(omega);
-   cs = cosf(omega);
-   alpha = (float) (sn * sinh(ST_PLUGIN_LN2 /2 * bandwidth * omega /sn));
-
-   // HPF
-   b0 = (1 + cs) / 2;
-   b1 = -(1 + cs);
-   b2 = (1 + cs) / 2;
-   a0 = 1 + alpha;
-   a1 = -2 * cs;
-   a2 = 1 - alpha;
-
-   _f->a0 = b0 / a0;
-   _f->a1 = b1 / a0;
-   _f->a2 = b2 / a0;
-   _f->a3 = a1 / a0;
-   _f->a4 = a2 / a0;
+   // RBJ cookbook HPF response (bandwidth in octaves), evaluated as a (TPT) state variable filter
+   //  (note) the previous direct form I biquad had its poles at ~1-6e-4 (1+a1+a2 ~ 4e-7) and amplified
+   //          its own rounding errors to ~56dB SNR (in single precision). The SVF reaches ~145dB.
+   double omega = ST_PLUGIN_2PI * freq / 44100.0;
+   double sn = sin(omega);
+   double alpha = sn * sinh(ST_PLUGIN_LN2 /2 * bandwidth * omega /sn);
+   double k = 2.0 * alpha / sn;  // 1/Q
+   double g = tan(omega * 0.5);
+
+   _f->s1 = 0.0f;
+   _f->s2 = 0.0f;
+   _f->g  = (float)g;
+   _f->k  = (float)k;
+   _f->h  = (float)(1.0 / (1.0 + g * (g + k)));
 }
 
-static float biquad_filter(biquad_t *_f, const float _inSmp) {
-   float outSmp = (float)(
-      _f->a0 * _inSmp + 
-      _f->a1 * _f->x1 + 
-      _f->a2 * _f->x2 -
-      _f->a3 * _f->y1 - 
-      _f->a4 * _f->y2
-                          );
-
-   outSmp = Dstplugin_fix_denorm_32(outSmp);
-
-   // Shuffle history
-   _f->x2 = _f->x1;
-   _f->x1 = _inSmp;
-   _f->x1 = _f->x1;
-   _f->y2 = _f->y1;
-   _f->y1 = outSmp;
-
-   return outSmp;
+static float hpf_filter(hpf_t *_f, const float _inSmp) {
+   float hp = (_inSmp - (_f->k + _f->g) * _f->s1 - _f->s2) * _f->h;
+   float v1 = _f->g * hp;
+   float bp = v1 + _f->s1;
+   _f->s1 = bp + v1;
+   float v2 = _f->g * bp;
+   float lp = v2 + _f->s2;
+   _f->s2 = lp + v2;
+
+   return Dstplugin_fix_denorm_32(hp);
 }
 
 static const char *ST_PLUGIN_API loc_get_param_name(st_plugin_info_t *_info,
@@ -290,6 +277,61 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    }
 }
 
+static void loc_shape(const ws_fm_info_t *_info,
+                      const ws_fm_voice_t *_voice,
+                      const float         *_samplesIn,  // interleaved (stride=2)
+                      const float         *_lfo,
+                      float               *_out,
+                      unsigned int         _frameIdx,  // first frame (param ramps)
+                      unsigned int         _numFrames
+                      ) {
+   // a = sin((phase + lfo + in * freq) * PI/2) * level
+   //  (note) a *= |in| / zero_th when |in| < zero_th
+   unsigned int i = 0u;
+#ifdef ST_WSHAPER_SSE2
+   const __m128 phaseCur  = _mm_set1_ps(_voice->mod_phase_cur);
+   const __m128 phaseInc  = _mm_set1_ps(_voice->mod_phase_inc);
+   const __m128 freqCur   = _mm_set1_ps(_voice->mod_freq_cur);
+   const __m128 freqInc   = _mm_set1_ps(_voice->mod_freq_inc);
+   const __m128 levelCur  = _mm_set1_ps(_voice->mod_level_cur);
+   const __m128 levelInc  = _mm_set1_ps(_voice->mod_level_inc);
+   const __m128 zeroThCur = _mm_set1_ps(_voice->mod_zero_th_cur);
+   const __m128 zeroThInc = _mm_set1_ps(_voice->mod_zero_th_inc);
+   const __m128 absMask   = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFffff));
+   __m128 j = _mm_add_ps(_mm_set1_ps((float)_frameIdx), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+   for(; (i + 4u) <= _numFrames; i += 4u)
+   {
+      const __m128 in = _mm_setr_ps(_samplesIn[2u*i], _samplesIn[2u*i + 2u], _samplesIn[2u*i + 4u], _samplesIn[2u*i + 6u]);
+      __m128 x = _mm_add_ps(phaseCur, _mm_mul_ps(phaseInc, j));
+      x = _mm_add_ps(x, _mm_loadu_ps(&_lfo[i]));
+      x = _mm_add_ps(x, _mm_mul_ps(in, _mm_add_ps(freqCur, _mm_mul_ps(freqInc, j))));
+      __m128 a = st_wshaper_lookup4(_info->ws_sin, _mm_mul_ps(x, _mm_set1_ps(ST_PLUGIN_PI2_F)));
+      a = _mm_mul_ps(a, _mm_add_ps(levelCur, _mm_mul_ps(levelInc, j)));
+      // (note) min() returns 1 when |in|/zero_th is NaN (0/0)
+      const __m128 zeroTh = _mm_add_ps(zeroThCur, _mm_mul_ps(zeroThInc, j));
+      a = _mm_mul_ps(a, _mm_min_ps(_mm_div_ps(_mm_and_ps(in, absMask), zeroTh), _mm_set1_ps(1.0f)));
+      _mm_storeu_ps(&_out[i], a);
+      j = _mm_add_ps(j, _mm_set1_ps(4.0f));
+   }
+#endif // ST_WSHAPER_SSE2
+   for(; i < _numFrames; i++)
+   {
+      const float in = _samplesIn[2u*i];
+      const float j = (float)(_frameIdx + i);
+      float a =
+         st_wshaper_lookup(_info->ws_sin,
+                           ( (_voice->mod_phase_cur + _voice->mod_phase_inc * j) + _lfo[i] +
+                             in * (_voice->mod_freq_cur + _voice->mod_freq_inc * j)
+                             ) * ST_PLUGIN_PI2_F
+                           ) * (_voice->mod_level_cur + _voice->mod_level_inc * j);
+      const float zeroTh = _voice->mod_zero_th_cur + _voice->mod_zero_th_inc * j;
+      ws_fm_fi_u m; m.f = in; m.u &= 0x7FFFffffu;
+      if(m.f < zeroTh)
+         a *= m.f / zeroTh;
+      _out[i] = a;
+   }
+}
+
 static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
                                               int                 _bMonoIn,
                                               const float        *_samplesIn,
@@ -298,84 +340,99 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
                                               ) {
    // Ring modulate at (modulated) note frequency
    ST_PLUGIN_VOICE_CAST(ws_fm_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(ws_fm_shared_t);
+   ST_PLUGIN_VOICE_INFO_CAST(ws_fm_info_t);
+
+   // LFO (quadrature oscillator, synced to lfo_phase at block start)
+   double lfoSin = sin(voice->lfo_phase);
+   double lfoCos = cos(voice->lfo_phase);
+   const double lfoRotSin = sin(voice->lfo_speed);
+   const double lfoRotCos = cos(voice->lfo_speed);
+
+   // (note) keep filter state in registers
+   hpf_t hpfL = voice->hpf_l;
+   hpf_t hpfR = voice->hpf_r;
 
-   unsigned int k = 0u;
+   float lfo[CHUNK_SIZE];
+   float aL[CHUNK_SIZE];
+   float aR[CHUNK_SIZE];
 
-   if(_bMonoIn)
+   unsigned int frameIdx = 0u;
+   while(frameIdx < _numFrames)
    {
-      // Mono input, stereo output
-      for(unsigned int i = 0u; i < _numFrames; i++)
+      unsigned int numChunkFrames = _numFrames - frameIdx;
+      if(numChunkFrames > CHUNK_SIZE)
+         numChunkFrames = CHUNK_SIZE;
+
+      const float *samplesIn  = _samplesIn  + 2u * frameIdx;
+      float       *samplesOut = _samplesOut + 2u * frameIdx;
+
+      for(unsigned int i = 0u; i < numChunkFrames; i++)
       {
-         float l = _samplesIn[k];
-         float a = 
-            sinf( (voice->mod_phase_cur + (sinf(voice->lfo_phase) * voice->lfo_level) + l * voice->mod_freq_cur) * ST_PLUGIN_PI2_F
-                  ) * voice->mod_level_cur;
-         ws_fm_fi_u lm; lm.f = l; lm.u &= 0x7FFFffffu;
-         if(lm.f < voice->mod_zero_th_cur)
-            a *= lm.f / voice->mod_zero_th_cur;
-         a = biquad_filter(&voice->hpf_l, a);
-         float out = l + (a - l) * voice->mod_drywet_cur;
-         out = Dstplugin_fix_denorm_32(out);
-         _samplesOut[k]      = out;
-         _samplesOut[k + 1u] = out;
-         // Next frame
-         k += 2u;
-         voice->mod_drywet_cur  += voice->mod_drywet_inc;
-         voice->mod_freq_cur    += voice->mod_freq_inc;
-         voice->mod_phase_cur   += voice->mod_phase_inc;
-         voice->mod_level_cur   += voice->mod_level_inc;
-         voice->mod_zero_th_cur += voice->mod_zero_th_inc;
+         lfo[i] = (float)lfoSin * voice->lfo_level;
+         const double lfoSinN = lfoSin * lfoRotCos + lfoCos * lfoRotSin;
+         lfoCos = lfoCos * lfoRotCos - lfoSin * lfoRotSin;
+         lfoSin = lfoSinN;
          voice->lfo_phase += voice->lfo_speed;
       }
-   }
-   else
-   {
-      // Stereo input, stereo output
-      for(unsigned int i = 0u; i < _numFrames; i++)
+
+      loc_shape(info, voice, samplesIn, lfo, aL, frameIdx, numChunkFrames);
+
+      if(_bMonoIn)
       {
-         float l = _samplesIn[k];
-         float al = 
-            sinf( (voice->mod_phase_cur + (sinf(voice->lfo_phase) * voice->lfo_level) + l * voice->mod_freq_cur) * ST_PLUGIN_PI2_F
-                  ) * voice->mod_level_cur;
-         ws_fm_fi_u lm; lm.f = l; lm.u &= 0x7FFFffffu;
-         if(lm.f < voice->mod_zero_th_cur)
-            al *= lm.f / voice->mod_zero_th_cur;
-         al = biquad_filter(&voice->hpf_l, al);
-         float outL = l + (al - l) * voice->mod_drywet_cur;
-         outL = Dstplugin_fix_denorm_32(outL);
-
-         float r = _samplesIn[k + 1u];
-         float ar =
-            sinf( (voice->mod_phase_cur + (sinf(voice->lfo_phase) * voice->lfo_level) + r * voice->mod_freq_cur) * ST_PLUGIN_PI2_F
-                  ) * voice->mod_level_cur;
-         ws_fm_fi_u rm; rm.f = r; rm.u &= 0x7FFFffffu;
-         if(rm.f < voice->mod_zero_th_cur)
-            ar *= rm.f / voice->mod_zero_th_cur;
-         ar = biquad_filter(&voice->hpf_r, ar);
-         float outR = r + (ar - r) * voice->mod_drywet_cur;
-         outR = Dstplugin_fix_denorm_32(outR);
-
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outR;
-
-         // Next frame
-         k += 2u;
-         voice->mod_drywet_cur  += voice->mod_drywet_inc;
-         voice->mod_freq_cur    += voice->mod_freq_inc;
-         voice->mod_phase_cur   += voice->mod_phase_inc;
-         voice->mod_level_cur   += voice->mod_level_inc;
-         voice->mod_zero_th_cur += voice->mod_zero_th_inc;
-         voice->lfo_phase += voice->lfo_speed;
+         // Mono input, stereo output
+         for(unsigned int i = 0u; i < numChunkFrames; i++)
+         {
+            const float l = samplesIn[2u*i];
+            const float a = hpf_filter(&hpfL, aL[i]);
+            float out = l + (a - l) * (voice->mod_drywet_cur + voice->mod_drywet_inc * (float)(frameIdx + i));
+            out = Dstplugin_fix_denorm_32(out);
+            samplesOut[2u*i]      = out;
+            samplesOut[2u*i + 1u] = out;
+         }
+      }
+      else
+      {
+         // Stereo input, stereo output
+         loc_shape(info, voice, samplesIn + 1u, lfo, aR, frameIdx, numChunkFrames);
+
+         for(unsigned int i = 0u; i < numChunkFrames; i++)
+         {
+            const float drywet = voice->mod_drywet_cur + voice->mod_drywet_inc * (float)(frameIdx + i);
+
+            const float l = samplesIn[2u*i];
+            const float al = hpf_filter(&hpfL, aL[i]);
+            float outL = l + (al - l) * drywet;
+            outL = Dstplugin_fix_denorm_32(outL);
+
+            const float r = samplesIn[2u*i + 1u];
+            const float ar = hpf_filter(&hpfR, aR[i]);
+            float outR = r + (ar - r) * drywet;
+            outR = Dstplugin_fix_denorm_32(outR);
+
+            samplesOut[2u*i]      = outL;
+            samplesOut[2u*i + 1u] = outR;
+         }
       }
+
+      frameIdx += numChunkFrames;
    }
 
+   voice->hpf_l = hpfL;
+   voice->hpf_r = hpfR;
+
+   // Next block
+   voice->mod_drywet_cur  += voice->mod_drywet_inc  * _numFrames;
+   voice->mod_freq_cur    += voice->mod_freq_inc    * _numFrames;
+   voice->mod_phase_cur   += voice->mod_phase_inc   * _numFrames;
+   voice->mod_level_cur   += voice->mod_level_inc   * _numFrames;
+   voice->mod_zero_th_cur += voice->mod_zero_th_inc * _numFrames;
+
    if(voice->lfo_phase >= ST_PLUGIN_2PI_F)
       voice->lfo_phase -= ST_PLUGIN_2PI_F;
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   ws_fm_shared_t *ret = malloc(sizeof(ws_fm_shared_t));
+   ws_fm_shared_t *ret = Dstplugin_alloc(_info, sizeof(ws_fm_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -386,24 +443,32 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   ws_fm_voice_t *ret = malloc(sizeof(ws_fm_voice_t));
+   ws_fm_voice_t *ret = Dstplugin_alloc(_info, sizeof(ws_fm_voice_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
       ret->base.info   = _info;
-      biquad_init(&ret->hpf_l);
-      biquad_init(&ret->hpf_r);
+      hpf_init(&ret->hpf_l);
+      hpf_init(&ret->hpf_r);
    }
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(ws_fm_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+   hpf_init(&voice->hpf_l);
+   hpf_init(&voice->hpf_r);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free(_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -433,6 +498,7 @@ st_plugin_info_t *ws_fm_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -444,6 +510,8 @@ st_plugin_info_t *ws_fm_init(void) {
       ret->base.prepare_block    = &loc_prepare_block;
       ret->base.process_replace  = &loc_process_replace;
       ret->base.plugin_exit      = &loc_plugin_exit;
+
+      ret->ws_sin = st_wshaper_sin_get();
    }
 
    return &ret->base;
@@ -8,7 +8,7 @@
 // ---- info   : a tanh waveshaper that supports per-sample-frame parameter interpolation
 // ----
 // ---- created: 08Feb2021
-// ---- changed: 21Jan2024, 19Sep2024
+// ---- changed: 21Jan2024, 19Sep2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -18,6 +18,8 @@
 
 #include "../../../plugin.h"
 
+#include "wshaper.h"
+
 #define PARAM_DRYWET     0
 #define PARAM_DRIVE      1
 #define PARAM_BIAS       2
@@ -60,6 +62,7 @@ static const char *loc_mod_names[NUM_MODS] = {
 
 typedef struct ws_fold_sine_info_s {
    st_plugin_info_t base;
+   const st_wshaper_t *ws_sin;  // shared (see wshaper.h)
 } ws_fold_sine_info_t;
 
 typedef struct ws_fold_sine_shared_s {
@@ -216,6 +219,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
                                               ) {
    ST_PLUGIN_VOICE_CAST(ws_fold_sine_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(ws_fold_sine_shared_t);
+   ST_PLUGIN_VOICE_INFO_CAST(ws_fold_sine_info_t);
 
    unsigned int k = 0u;
 
@@ -241,7 +245,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          if(t.f > voice->mod_threshold_cur)
          {
             float p = (t.f - voice->mod_threshold_cur) * voice->mod_fold_cur;
-            t.f = voice->mod_threshold_cur - sinf(p) * voice->mod_level_cur;
+            t.f = voice->mod_threshold_cur - st_wshaper_lookup(info->ws_sin, p) * voice->mod_level_cur;
          }
          t.f -= voice->mod_bias_cur;
          t.ui ^= a.ui & 0x80000000u;
@@ -284,7 +288,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          if(t.f > voice->mod_threshold_cur)
          {
             float p = (t.f - voice->mod_threshold_cur) * voice->mod_fold_cur;
-            t.f = voice->mod_threshold_cur - sinf(p) * voice->mod_level_cur;
+            t.f = voice->mod_threshold_cur - st_wshaper_lookup(info->ws_sin, p) * voice->mod_level_cur;
          }
          t.f -= voice->mod_bias_cur;
          t.ui ^= a.ui & 0x80000000u;
@@ -300,7 +304,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          if(t.f > voice->mod_threshold_cur)
          {
             float p = (t.f - voice->mod_threshold_cur) * voice->mod_fold_cur;
-            t.f = voice->mod_threshold_cur - sinf(p) * voice->mod_level_cur;
+            t.f = voice->mod_threshold_cur - st_wshaper_lookup(info->ws_sin, p) * voice->mod_level_cur;
          }
          t.f -= voice->mod_bias_cur;
          t.ui ^= a.ui & 0x80000000u;
@@ -323,10 +327,11 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   ws_fold_sine_shared_t *ret = malloc(sizeof(ws_fold_sine_shared_t));
+   ws_fold_sine_shared_t *ret = Dstplugin_alloc(_info, sizeof(ws_fold_sine_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
+
       ret->base.info  = _info;
       memcpy((void*)ret->params, (void*)loc_param_resets, NUM_PARAMS * sizeof(float));
    }
@@ -334,12 +339,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   ws_fold_sine_voice_t *ret = malloc(sizeof(ws_fold_sine_voice_t));
+   ws_fold_sine_voice_t *ret = Dstplugin_alloc(_info, sizeof(ws_fold_sine_voice_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -348,8 +353,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(ws_fold_sine_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free(_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -365,6 +376,7 @@ st_plugin_info_t *ws_fold_sine_init(void) {
    {
       memset(ret, 0, sizeof(*ret));
 
+
       ret->base.api_version = ST_PLUGIN_API_VERSION;
       ret->base.id          = "bsp ws fold sine";  // unique id. don't change this in future builds.
       ret->base.author      = "bsp";
@@ -379,6 +391,7 @@ st_plugin_info_t *ws_fold_sine_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -389,6 +402,8 @@ st_plugin_info_t *ws_fold_sine_init(void) {
       ret->base.prepare_block    = &loc_prepare_block;
       ret->base.process_replace  = &loc_process_replace;
       ret->base.plugin_exit      = &loc_plugin_exit;
+
+      ret->ws_sin = st_wshaper_sin_get();
    }
 
    return &ret->base;
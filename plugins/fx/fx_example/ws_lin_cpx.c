@@ -8,7 +8,7 @@
 // ---- info   : a tanh waveshaper that supports per-sample-frame parameter interpolation
 // ----
 // ---- created: 14Oct2024
-// ---- changed:
+// ---- changed:, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -18,6 +18,8 @@
 
 #include "../../../plugin.h"
 
+#include "wshaper.h"
+
 #define PARAM_DRYWET      0
 #define PARAM_DRIVE_PRE   1
 #define PARAM_TH_MIN      2
@@ -65,6 +67,7 @@ static const char *loc_mod_names[NUM_MODS] = {
 
 typedef struct ws_lin_cpx_info_s {
    st_plugin_info_t base;
+   const st_wshaper_t *ws_tanh;  // shared (see wshaper.h)
 } ws_lin_cpx_info_t;
 
 typedef struct ws_lin_cpx_shared_s {
@@ -245,6 +248,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t *_voice,
                                               ) {
    ST_PLUGIN_VOICE_CAST(ws_lin_cpx_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(ws_lin_cpx_shared_t);
+   ST_PLUGIN_VOICE_INFO_CAST(ws_lin_cpx_info_t);
 
    unsigned int k = 0u;
 
@@ -307,8 +311,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t *_voice,
 
       if(voice->mod_sat_amt_cur > 0.0f)
       {
-         wetL = wetL + (tanhf(wetL) - wetL) * voice->mod_sat_amt_cur;
-         wetR = wetR + (tanhf(wetR) - wetR) * voice->mod_sat_amt_cur;
+         wetL = wetL + (st_wshaper_lookup(info->ws_tanh, wetL) - wetL) * voice->mod_sat_amt_cur;
+         wetR = wetR + (st_wshaper_lookup(info->ws_tanh, wetR) - wetR) * voice->mod_sat_amt_cur;
       }
 
       float outL = l + (wetL - l) * voice->mod_drywet_cur;
@@ -333,10 +337,11 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   ws_lin_cpx_shared_t *ret = malloc(sizeof(ws_lin_cpx_shared_t));
+   ws_lin_cpx_shared_t *ret = Dstplugin_alloc(_info, sizeof(ws_lin_cpx_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
+
       ret->base.info  = _info;
       memcpy((void*)ret->params, (void*)loc_param_resets, NUM_PARAMS * sizeof(float));
    }
@@ -344,12 +349,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   ws_lin_cpx_voice_t *ret = malloc(sizeof(ws_lin_cpx_voice_t));
+   ws_lin_cpx_voice_t *ret = Dstplugin_alloc(_info, sizeof(ws_lin_cpx_voice_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -358,8 +363,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(ws_lin_cpx_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free(_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -375,6 +386,7 @@ st_plugin_info_t *ws_lin_cpx_init(void) {
    {
       memset(ret, 0, sizeof(*ret));
 
+
       ret->base.api_version = ST_PLUGIN_API_VERSION;
       ret->base.id          = "bsp ws lin cpx";  // unique id. don't change this in future builds.
       ret->base.author      = "bsp";
@@ -389,6 +401,7 @@ st_plugin_info_t *ws_lin_cpx_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -399,6 +412,8 @@ st_plugin_info_t *ws_lin_cpx_init(void) {
       ret->base.prepare_block    = &loc_prepare_block;
       ret->base.process_replace  = &loc_process_replace;
       ret->base.plugin_exit      = &loc_plugin_exit;
+
+      ret->ws_tanh = st_wshaper_tanh_get();
    }
 
    return &ret->base;
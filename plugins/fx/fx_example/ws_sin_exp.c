@@ -8,7 +8,7 @@
 // ---- info   : experimental waveshaper
 // ----
 // ---- created: 04Jan2023
-// ---- changed: 21Jan2024
+// ---- changed: 21Jan2024, 16Oct2026
 // ----
 // ----
 // ----
@@ -243,12 +243,14 @@ static inline float loc_shape(float _t, float _exp, float _exp2, float _drivePos
    return r;
 }
 
-static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
-                                              int                 _bMonoIn,
-                                              const float        *_samplesIn,
-                                              float              *_samplesOut, 
-                                              unsigned int        _numFrames
-                                              ) {
+static inline void loc_process(st_plugin_voice_t  *_voice,
+                               int                 _bMonoIn,
+                               const float        *_samplesIn,
+                               float              *_samplesOut,
+                               unsigned int        _numFrames,
+                               const int           _bAdd,
+                               const float         _gain
+                               ) {
    ST_PLUGIN_VOICE_CAST(ws_sin_exp_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(ws_sin_exp_shared_t);
 
@@ -265,8 +267,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          float out = ld + (a - ld) * voice->mod_drywet_cur;
          out = l + (out - l) * voice->mod_drywet_cur;
          out = Dstplugin_fix_denorm_32(out);
-         _samplesOut[k]      = out;
-         _samplesOut[k + 1u] = out;
+         Dstplugin_out(_bAdd, _samplesOut[k],      out, _gain);
+         Dstplugin_out(_bAdd, _samplesOut[k + 1u], out, _gain);
          // Next frame
          k += 2u;
          voice->mod_drywet_cur    += voice->mod_drywet_inc;
@@ -294,8 +296,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          outR = r + (outR - r) * voice->mod_drywet_cur;
          outL = Dstplugin_fix_denorm_32(outL);
          outR = Dstplugin_fix_denorm_32(outR);
-         _samplesOut[k]      = outL;
-         _samplesOut[k + 1u] = outR;
+         Dstplugin_out(_bAdd, _samplesOut[k],      outL, _gain);
+         Dstplugin_out(_bAdd, _samplesOut[k + 1u], outR, _gain);
          // Next frame
          k += 2u;
          voice->mod_drywet_cur    += voice->mod_drywet_inc;
@@ -308,8 +310,27 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
    }
 }
 
+static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
+                                              int                 _bMonoIn,
+                                              const float        *_samplesIn,
+                                              float              *_samplesOut,
+                                              unsigned int        _numFrames
+                                              ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 0/*bAdd*/, 1.0f/*gain*/);
+}
+
+static void ST_PLUGIN_API loc_process_add(st_plugin_voice_t  *_voice,
+                                          int                 _bMonoIn,
+                                          const float        *_samplesIn,
+                                          float              *_samplesOut,
+                                          unsigned int        _numFrames,
+                                          float               _gain
+                                          ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 1/*bAdd*/, _gain);
+}
+
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   ws_sin_exp_shared_t *ret = malloc(sizeof(ws_sin_exp_shared_t));
+   ws_sin_exp_shared_t *ret = Dstplugin_alloc(_info, sizeof(ws_sin_exp_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -320,12 +341,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   ws_sin_exp_voice_t *ret = malloc(sizeof(ws_sin_exp_voice_t));
+   ws_sin_exp_voice_t *ret = Dstplugin_alloc(_info, sizeof(ws_sin_exp_voice_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -334,8 +355,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(ws_sin_exp_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free(_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -365,6 +392,7 @@ st_plugin_info_t *ws_sin_exp_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -374,6 +402,7 @@ st_plugin_info_t *ws_sin_exp_init(void) {
       ret->base.set_mod_value    = &loc_set_mod_value;
       ret->base.prepare_block    = &loc_prepare_block;
       ret->base.process_replace  = &loc_process_replace;
+      ret->base.process_add      = &loc_process_add;
       ret->base.plugin_exit      = &loc_plugin_exit;
    }
 
@@ -8,7 +8,7 @@
 // ---- info   : waveshaper with configurable rise/fall slew rates and log..lin..exp curve
 // ----
 // ---- created: 14Apr2021
-// ---- changed: 16Aug2021, 21Jan2024, 14Oct2024
+// ---- changed: 16Aug2021, 21Jan2024, 14Oct2024, 16Oct2026
 // ----
 // ----
 // ----
@@ -394,7 +394,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   ws_slew_8bit_shared_t *ret = malloc(sizeof(ws_slew_8bit_shared_t));
+   ws_slew_8bit_shared_t *ret = Dstplugin_alloc(_info, sizeof(ws_slew_8bit_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -405,12 +405,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   ws_slew_8bit_voice_t *ret = malloc(sizeof(ws_slew_8bit_voice_t));
+   ws_slew_8bit_voice_t *ret = Dstplugin_alloc(_info, sizeof(ws_slew_8bit_voice_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -419,8 +419,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(ws_slew_8bit_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free(_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -450,6 +456,7 @@ st_plugin_info_t *ws_slew_8bit_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -8,7 +8,7 @@
 // ---- info   : waveshaper with configurable neg/pos rise/fall slew rates and log..lin..exp curve
 // ----
 // ---- created: 02May2021
-// ---- changed: 21Jan2024, 14Oct2024
+// ---- changed: 21Jan2024, 14Oct2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -18,6 +18,10 @@
 
 #include "../../../plugin.h"
 
+#include "wshaper.h"
+
+#define WS_SLEW_ASYM_CHUNK_FRAMES  (64u)
+
 #define PARAM_DRYWET_POS  0
 #define PARAM_RISE_POS    1
 #define PARAM_FALL_POS    2
@@ -249,221 +253,204 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    }
 }
 
-static float loc_mathLogLinExpf(float _f, float _c) {
-   // c: <0: log
-   //     0: lin
-   //    >0: exp
+static inline float loc_mathLogLinExpf(float _f, float _e) {
+   // e: 2^c
+   //    <1: log
+   //     1: lin
+   //    >1: exp
    stplugin_fi_t uSign;
    uSign.f = _f;
    stplugin_fi_t u;
    u.f = _f;
    u.u &= 0x7fffFFFFu;
-   u.f = powf(u.f, powf(2.0f, _c));
+   if(1.0f != _e)
+      u.f = st_wshaper_pow_abs_fast(u.f, _e);
    u.u |= uSign.u & 0x80000000u;
    return u.f;
 }
 
+// Apply curve to slew filter output and mix with dry input (interleaved stereo frames)
+//  - positive / negative curve and dry/wet amount are selected by the sign of the input sample
+static void loc_curve_drywet(ws_slew_asym_voice_t *_voice,
+                             int                   _bMonoIn,
+                             const float          *_samplesIn,
+                             const float          *_slew,
+                             float                *_samplesOut,
+                             unsigned int          _numFrames
+                             ) {
+   ws_slew_asym_voice_t *voice = _voice;
+   unsigned int k = 0u;
+   unsigned int frameIdx = 0u;
+
+#ifdef ST_WSHAPER_SSE2
+   if(_numFrames >= 2u)
+   {
+      // 2 frames per iteration (l0 r0 l1 r1)
+      //  (note) the ramps are advanced per frame like in the scalar code (small |x| amplify exponent rounding errors)
+      const int bLin = (0.0f == voice->mod_curve_pos_cur) && (0.0f == voice->mod_curve_pos_inc) &&
+                       (0.0f == voice->mod_curve_neg_cur) && (0.0f == voice->mod_curve_neg_inc);
+      const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32((int)0x80000000u));
+      const __m128 minNorm  = _mm_set1_ps(1.17549435e-38f);  // FLT_MIN
+
+      for(; (frameIdx + 2u) <= _numFrames; frameIdx += 2u)
+      {
+         __m128 in = _mm_loadu_ps(_samplesIn + k);
+         if(_bMonoIn)
+            in = _mm_shuffle_ps(in, in, _MM_SHUFFLE(2,2,0,0));
+         const __m128 bPos = _mm_cmpge_ps(in, _mm_setzero_ps());
+
+         const float drywetPos0 = voice->mod_drywet_pos_cur;
+         const float drywetPos1 = drywetPos0 + voice->mod_drywet_pos_inc;
+         const float drywetNeg0 = voice->mod_drywet_neg_cur;
+         const float drywetNeg1 = drywetNeg0 + voice->mod_drywet_neg_inc;
+         const __m128 drywet = _mm_or_ps(_mm_and_ps   (bPos, _mm_setr_ps(drywetPos0, drywetPos0, drywetPos1, drywetPos1)),
+                                         _mm_andnot_ps(bPos, _mm_setr_ps(drywetNeg0, drywetNeg0, drywetNeg1, drywetNeg1))
+                                         );
+
+         const float curvePos0 = voice->mod_curve_pos_cur;
+         const float curvePos1 = curvePos0 + voice->mod_curve_pos_inc;
+         const float curveNeg0 = voice->mod_curve_neg_cur;
+         const float curveNeg1 = curveNeg0 + voice->mod_curve_neg_inc;
+
+         __m128 out = _mm_loadu_ps(_slew + k);
+         if(!bLin)
+         {
+            const __m128 curve = _mm_or_ps(_mm_and_ps   (bPos, _mm_setr_ps(curvePos0, curvePos0, curvePos1, curvePos1)),
+                                           _mm_andnot_ps(bPos, _mm_setr_ps(curveNeg0, curveNeg0, curveNeg1, curveNeg1))
+                                           );
+            out = _mm_or_ps(_mm_and_ps(out, signMask),
+                            st_wshaper_pow_abs_fast4(out, st_wshaper_exp2_fast4(curve))
+                            );
+         }
+
+         out = _mm_add_ps(in, _mm_mul_ps(_mm_sub_ps(out, in), drywet));
+
+         // Flush denormals
+         //  (note) not (x+10)-10 like Dstplugin_fix_denorm_32() (which -ffast-math removes in the scalar code) => no quantization
+         out = _mm_and_ps(out, _mm_cmpge_ps(_mm_andnot_ps(signMask, out), minNorm));
+         _mm_storeu_ps(_samplesOut + k, out);
+
+         // Next 2 frames
+         k += 4u;
+         voice->mod_drywet_pos_cur = drywetPos1 + voice->mod_drywet_pos_inc;
+         voice->mod_drywet_neg_cur = drywetNeg1 + voice->mod_drywet_neg_inc;
+         voice->mod_curve_pos_cur  = curvePos1  + voice->mod_curve_pos_inc;
+         voice->mod_curve_neg_cur  = curveNeg1  + voice->mod_curve_neg_inc;
+      }
+   }
+#endif // ST_WSHAPER_SSE2
+
+   // Remaining frame (or scalar fallback)
+   for(; frameIdx < _numFrames; frameIdx++)
+   {
+      const float l = _samplesIn[k];
+      const float r = _bMonoIn ? l : _samplesIn[k + 1u];
+
+      // Curve exponents (2^c)
+      const float curvePosE = st_wshaper_exp2_fast(voice->mod_curve_pos_cur);
+      const float curveNegE = st_wshaper_exp2_fast(voice->mod_curve_neg_cur);
+
+      const int bPosL = (l >= 0.0f);
+      float outL = loc_mathLogLinExpf(_slew[k], bPosL ? curvePosE : curveNegE);
+      outL = l + (outL - l) * (bPosL ? voice->mod_drywet_pos_cur : voice->mod_drywet_neg_cur);
+      outL = Dstplugin_fix_denorm_32(outL);
+
+      const int bPosR = (r >= 0.0f);
+      float outR = loc_mathLogLinExpf(_slew[k + 1u], bPosR ? curvePosE : curveNegE);
+      outR = r + (outR - r) * (bPosR ? voice->mod_drywet_pos_cur : voice->mod_drywet_neg_cur);
+      outR = Dstplugin_fix_denorm_32(outR);
+
+      _samplesOut[k]      = outL;
+      _samplesOut[k + 1u] = outR;
+
+      // Next frame
+      k += 2u;
+      voice->mod_drywet_pos_cur += voice->mod_drywet_pos_inc;
+      voice->mod_curve_pos_cur  += voice->mod_curve_pos_inc;
+      voice->mod_drywet_neg_cur += voice->mod_drywet_neg_inc;
+      voice->mod_curve_neg_cur  += voice->mod_curve_neg_inc;
+   }
+}
+
 static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
                                               int                 _bMonoIn,
                                               const float        *_samplesIn,
                                               float              *_samplesOut, 
                                               unsigned int        _numFrames
                                               ) {
-   // Ring modulate at (modulated) note frequency
    ST_PLUGIN_VOICE_CAST(ws_slew_asym_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(ws_slew_asym_shared_t);
 
-   unsigned int k = 0u;
+   // Slew filter (serial) => slew[], then curve + dry/wet (SIMD) per chunk of frames
+   //  (note) in-place processing: samplesIn of a chunk are read before samplesOut are written
+   float slew[2u * WS_SLEW_ASYM_CHUNK_FRAMES];
 
-   if(_bMonoIn)
-   {
-      // Mono input, stereo output
-      for(unsigned int i = 0u; i < _numFrames; i++)
-      {
-         float l = _samplesIn[k];
+   float lastL = voice->last_l;
+   float lastR = voice->last_r;
 
-         if(l >= 0.0f)
-         {
-            if(l >= voice->last_l)
-            {
-               float fRise = voice->mod_rise_pos_cur;
-               fRise = 1.0f - fRise;
-               fRise = fRise * fRise * fRise;
-               voice->last_l += (l - voice->last_l) * fRise;
-            }
-            else
-            {
-               float fFall = voice->mod_fall_pos_cur;
-               fFall = 1.0f - fFall;
-               fFall = fFall * fFall * fFall;
-               voice->last_l += (l - voice->last_l) * fFall;
-            }
-
-            float outL = loc_mathLogLinExpf(voice->last_l, voice->mod_curve_pos_cur);
-
-            outL = l + (outL - l) * voice->mod_drywet_pos_cur;
-            outL = Dstplugin_fix_denorm_32(outL);
-            _samplesOut[k]      = outL;
-            _samplesOut[k + 1u] = outL;
-         }
-         else
-         {
-            if(l >= voice->last_l)
-            {
-               float fRise = voice->mod_rise_neg_cur;
-               fRise = 1.0f - fRise;
-               fRise = fRise * fRise * fRise;
-               voice->last_l += (l - voice->last_l) * fRise;
-            }
-            else
-            {
-               float fFall = voice->mod_fall_neg_cur;
-               fFall = 1.0f - fFall;
-               fFall = fFall * fFall * fFall;
-               voice->last_l += (l - voice->last_l) * fFall;
-            }
-
-            float outL = loc_mathLogLinExpf(voice->last_l, voice->mod_curve_neg_cur);
-
-            outL = l + (outL - l) * voice->mod_drywet_neg_cur;
-            outL = Dstplugin_fix_denorm_32(outL);
-            _samplesOut[k]      = outL;
-            _samplesOut[k + 1u] = outL;
-         }
-
-         // Next frame
-         k += 2u;
-         voice->mod_drywet_pos_cur += voice->mod_drywet_pos_inc;
-         voice->mod_rise_pos_cur   += voice->mod_rise_pos_inc;
-         voice->mod_fall_pos_cur   += voice->mod_fall_pos_inc;
-         voice->mod_curve_pos_cur  += voice->mod_curve_pos_inc;
-         voice->mod_drywet_neg_cur += voice->mod_drywet_neg_inc;
-         voice->mod_rise_neg_cur   += voice->mod_rise_neg_inc;
-         voice->mod_fall_neg_cur   += voice->mod_fall_neg_inc;
-         voice->mod_curve_neg_cur  += voice->mod_curve_neg_inc;
-      }
-   }
-   else
+   unsigned int frameOff = 0u;
+   while(frameOff < _numFrames)
    {
-      // Stereo input, stereo output
-      for(unsigned int i = 0u; i < _numFrames; i++)
-      {
-         // Left
-         float l = _samplesIn[k];
+      unsigned int numFrames = _numFrames - frameOff;
+      if(numFrames > WS_SLEW_ASYM_CHUNK_FRAMES)
+         numFrames = WS_SLEW_ASYM_CHUNK_FRAMES;
 
-         if(l >= 0.0f)
-         {
-            if(l >= voice->last_l)
-            {
-               float fRise = voice->mod_rise_pos_cur;
-               fRise = 1.0f - fRise;
-               fRise = fRise * fRise * fRise;
-               voice->last_l += (l - voice->last_l) * fRise;
-            }
-            else
-            {
-               float fFall = voice->mod_fall_pos_cur;
-               fFall = 1.0f - fFall;
-               fFall = fFall * fFall * fFall;
-               voice->last_l += (l - voice->last_l) * fFall;
-            }
-
-            float outL = loc_mathLogLinExpf(voice->last_l, voice->mod_curve_pos_cur);
-
-            outL = l + (outL - l) * voice->mod_drywet_pos_cur;
-            outL = Dstplugin_fix_denorm_32(outL);
-            _samplesOut[k] = outL;
-         }
-         else
-         {
-            if(l >= voice->last_l)
-            {
-               float fRise = voice->mod_rise_neg_cur;
-               fRise = 1.0f - fRise;
-               fRise = fRise * fRise * fRise;
-               voice->last_l += (l - voice->last_l) * fRise;
-            }
-            else
-            {
-               float fFall = voice->mod_fall_neg_cur;
-               fFall = 1.0f - fFall;
-               fFall = fFall * fFall * fFall;
-               voice->last_l += (l - voice->last_l) * fFall;
-            }
-
-            float outL = loc_mathLogLinExpf(voice->last_l, voice->mod_curve_neg_cur);
-
-            outL = l + (outL - l) * voice->mod_drywet_neg_cur;
-            outL = Dstplugin_fix_denorm_32(outL);
-            _samplesOut[k] = outL;
-         }
+      const float *samplesIn = _samplesIn + (frameOff * 2u);
+      unsigned int k = 0u;
 
-         // Right
-         float r = _samplesIn[k + 1u];
+      for(unsigned int i = 0u; i < numFrames; i++)
+      {
+         float fRisePos = 1.0f - voice->mod_rise_pos_cur;
+         fRisePos = fRisePos * fRisePos * fRisePos;
+         float fFallPos = 1.0f - voice->mod_fall_pos_cur;
+         fFallPos = fFallPos * fFallPos * fFallPos;
+         float fRiseNeg = 1.0f - voice->mod_rise_neg_cur;
+         fRiseNeg = fRiseNeg * fRiseNeg * fRiseNeg;
+         float fFallNeg = 1.0f - voice->mod_fall_neg_cur;
+         fFallNeg = fFallNeg * fFallNeg * fFallNeg;
 
-         if(r >= 0.0f)
+         // Left
+         float l = samplesIn[k];
+         const int bPosL = (l >= 0.0f);
+         const float fRiseL = bPosL ? fRisePos : fRiseNeg;
+         const float fFallL = bPosL ? fFallPos : fFallNeg;
+         lastL += (l - lastL) * ((l >= lastL) ? fRiseL : fFallL);
+         slew[k] = lastL;
+
+         if(_bMonoIn)
          {
-            if(r >= voice->last_r)
-            {
-               float fRise = voice->mod_rise_pos_cur;
-               fRise = 1.0f - fRise;
-               fRise = fRise * fRise * fRise;
-               voice->last_r += (r - voice->last_r) * fRise;
-            }
-            else
-            {
-               float fFall = voice->mod_fall_pos_cur;
-               fFall = 1.0f - fFall;
-               fFall = fFall * fFall * fFall;
-               voice->last_r += (r - voice->last_r) * fFall;
-            }
-
-            float outR = loc_mathLogLinExpf(voice->last_r, voice->mod_curve_pos_cur);
-
-            outR = r + (outR - r) * voice->mod_drywet_pos_cur;
-            outR = Dstplugin_fix_denorm_32(outR);
-            _samplesOut[k + 1u] = outR;
+            // Mono input, stereo output
+            slew[k + 1u] = lastL;
          }
          else
          {
-            if(r >= voice->last_r)
-            {
-               float fRise = voice->mod_rise_neg_cur;
-               fRise = 1.0f - fRise;
-               fRise = fRise * fRise * fRise;
-               voice->last_r += (r - voice->last_r) * fRise;
-            }
-            else
-            {
-               float fFall = voice->mod_fall_neg_cur;
-               fFall = 1.0f - fFall;
-               fFall = fFall * fFall * fFall;
-               voice->last_r += (r - voice->last_r) * fFall;
-            }
-
-            float outR = loc_mathLogLinExpf(voice->last_r, voice->mod_curve_neg_cur);
-
-            outR = r + (outR - r) * voice->mod_drywet_neg_cur;
-            outR = Dstplugin_fix_denorm_32(outR);
-            _samplesOut[k + 1u] = outR;
+            // Right
+            float r = samplesIn[k + 1u];
+            const int bPosR = (r >= 0.0f);
+            const float fRiseR = bPosR ? fRisePos : fRiseNeg;
+            const float fFallR = bPosR ? fFallPos : fFallNeg;
+            lastR += (r - lastR) * ((r >= lastR) ? fRiseR : fFallR);
+            slew[k + 1u] = lastR;
          }
 
          // Next frame
          k += 2u;
-         voice->mod_drywet_pos_cur += voice->mod_drywet_pos_inc;
-         voice->mod_rise_pos_cur   += voice->mod_rise_pos_inc;
-         voice->mod_fall_pos_cur   += voice->mod_fall_pos_inc;
-         voice->mod_curve_pos_cur  += voice->mod_curve_pos_inc;
-         voice->mod_drywet_neg_cur += voice->mod_drywet_neg_inc;
-         voice->mod_rise_neg_cur   += voice->mod_rise_neg_inc;
-         voice->mod_fall_neg_cur   += voice->mod_fall_neg_inc;
-         voice->mod_curve_neg_cur  += voice->mod_curve_neg_inc;
+         voice->mod_rise_pos_cur += voice->mod_rise_pos_inc;
+         voice->mod_fall_pos_cur += voice->mod_fall_pos_inc;
+         voice->mod_rise_neg_cur += voice->mod_rise_neg_inc;
+         voice->mod_fall_neg_cur += voice->mod_fall_neg_inc;
       }
+
+      loc_curve_drywet(voice, _bMonoIn, samplesIn, slew, _samplesOut + (frameOff * 2u), numFrames);
+
+      frameOff += numFrames;
    }
+
+   voice->last_l = lastL;
+   voice->last_r = lastR;
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   ws_slew_asym_shared_t *ret = malloc(sizeof(ws_slew_asym_shared_t));
+   ws_slew_asym_shared_t *ret = Dstplugin_alloc(_info, sizeof(ws_slew_asym_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -474,12 +461,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   ws_slew_asym_voice_t *ret = malloc(sizeof(ws_slew_asym_voice_t));
+   ws_slew_asym_voice_t *ret = Dstplugin_alloc(_info, sizeof(ws_slew_asym_voice_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -488,8 +475,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(ws_slew_asym_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free(_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -519,6 +512,7 @@ st_plugin_info_t *ws_slew_asym_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
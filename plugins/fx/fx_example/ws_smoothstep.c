@@ -9,7 +9,7 @@
 // ----
 // ---- created: 10May2009
 // ---- changed: 23May2010, 30Sep2010, 07Oct2010, 17May2020, 18May2020, 19May2020, 20May2020
-// ----          21May2020, 24May2020, 31May2020, 08Jun2020, 21Jan2024
+// ----          21May2020, 24May2020, 31May2020, 08Jun2020, 21Jan2024, 16Oct2026
 // ----
 // ----
 // ----
@@ -197,12 +197,14 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    }
 }
 
-static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
-                                              int                 _bMonoIn,
-                                              const float        *_samplesIn,
-                                              float              *_samplesOut, 
-                                              unsigned int        _numFrames
-                                              ) {
+static inline void loc_process(st_plugin_voice_t  *_voice,
+                               int                 _bMonoIn,
+                               const float        *_samplesIn,
+                               float              *_samplesOut,
+                               unsigned int        _numFrames,
+                               const int           _bAdd,
+                               const float         _gain
+                               ) {
    // Ring modulate at (modulated) note frequency
    ST_PLUGIN_VOICE_CAST(ws_smoothstep_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(ws_smoothstep_shared_t);
@@ -227,8 +229,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          a *= voice->mod_level_cur;
 
          float out = l + (a - l) * voice->mod_drywet_cur;
-         _samplesOut[k]      = out;
-         _samplesOut[k + 1u] = out;
+         Dstplugin_out(_bAdd, _samplesOut[k],      out, _gain);
+         Dstplugin_out(_bAdd, _samplesOut[k + 1u], out, _gain);
 
          // Next frame
          k += 2u;
@@ -270,8 +272,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
          float outL = l + (al - l) * voice->mod_drywet_cur;
          float outR = r + (ar - r) * voice->mod_drywet_cur;
-         _samplesOut[k]      = Dstplugin_fix_denorm_32(outL);
-         _samplesOut[k + 1u] = Dstplugin_fix_denorm_32(outR);
+         Dstplugin_out(_bAdd, _samplesOut[k],      Dstplugin_fix_denorm_32(outL), _gain);
+         Dstplugin_out(_bAdd, _samplesOut[k + 1u], Dstplugin_fix_denorm_32(outR), _gain);
 
          // Next frame
          k += 2u;
@@ -284,8 +286,27 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
    }
 }
 
+static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
+                                              int                 _bMonoIn,
+                                              const float        *_samplesIn,
+                                              float              *_samplesOut,
+                                              unsigned int        _numFrames
+                                              ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 0/*bAdd*/, 1.0f/*gain*/);
+}
+
+static void ST_PLUGIN_API loc_process_add(st_plugin_voice_t  *_voice,
+                                          int                 _bMonoIn,
+                                          const float        *_samplesIn,
+                                          float              *_samplesOut,
+                                          unsigned int        _numFrames,
+                                          float               _gain
+                                          ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 1/*bAdd*/, _gain);
+}
+
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   ws_smoothstep_shared_t *ret = malloc(sizeof(ws_smoothstep_shared_t));
+   ws_smoothstep_shared_t *ret = Dstplugin_alloc(_info, sizeof(ws_smoothstep_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -296,12 +317,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   ws_smoothstep_voice_t *ret = malloc(sizeof(ws_smoothstep_voice_t));
+   ws_smoothstep_voice_t *ret = Dstplugin_alloc(_info, sizeof(ws_smoothstep_voice_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -310,8 +331,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(ws_smoothstep_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free(_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -341,6 +368,7 @@ st_plugin_info_t *ws_smoothstep_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -350,6 +378,7 @@ st_plugin_info_t *ws_smoothstep_init(void) {
       ret->base.set_mod_value    = &loc_set_mod_value;
       ret->base.prepare_block    = &loc_prepare_block;
       ret->base.process_replace  = &loc_process_replace;
+      ret->base.process_add      = &loc_process_add;
       ret->base.plugin_exit      = &loc_plugin_exit;
    }
 
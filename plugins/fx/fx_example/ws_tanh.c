@@ -9,7 +9,7 @@
 // ----
 // ---- created: 10May2009
 // ---- changed: 23May2010, 30Sep2010, 07Oct2010, 17May2020, 18May2020, 19May2020, 20May2020
-// ----          21May2020, 24May2020, 31May2020, 08Jun2020, 06Jan2023, 21Jan2024
+// ----          21May2020, 24May2020, 31May2020, 08Jun2020, 06Jan2023, 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -19,6 +19,8 @@
 
 #include "../../../plugin.h"
 
+#include "wshaper.h"
+
 #define PARAM_DRYWET   0
 #define PARAM_DRIVE    1
 #define PARAM_APPROX   2
@@ -33,6 +35,9 @@ static float loc_param_resets[NUM_PARAMS] = {
    0.0f   // DRIVE
 };
 
+// process_replace_planar(): number of frames per ramp chunk
+#define PLANAR_CHUNK_SIZE  (64u)
+
 #define MOD_DRYWET  0
 #define MOD_DRIVE   1
 #define NUM_MODS    2
@@ -43,6 +48,7 @@ static const char *loc_mod_names[NUM_MODS] = {
 
 typedef struct ws_tanh_info_s {
    st_plugin_info_t base;
+   const st_wshaper_t *ws_tanh;  // shared (see wshaper.h)
 } ws_tanh_info_t;
 
 typedef struct ws_tanh_shared_s {
@@ -164,12 +170,14 @@ static inline float loc_tanhf_approx(const float f) {
    return f * (27.0f + ff) / (27.0f + 9.0f*ff);
 }
 
-static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
-                                              int                 _bMonoIn,
-                                              const float        *_samplesIn,
-                                              float              *_samplesOut, 
-                                              unsigned int        _numFrames
-                                              ) {
+static inline void loc_process(st_plugin_voice_t  *_voice,
+                               int                 _bMonoIn,
+                               const float        *_samplesIn,
+                               float              *_samplesOut,
+                               unsigned int        _numFrames,
+                               const int           _bAdd,
+                               const float         _gain
+                               ) {
    ST_PLUGIN_VOICE_CAST(ws_tanh_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(ws_tanh_shared_t);
 
@@ -186,8 +194,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
             float a = loc_tanhf_approx(l * voice->mod_drive_cur);
             float out = l + (a - l) * voice->mod_drywet_cur;
             out = Dstplugin_fix_denorm_32(out);
-            _samplesOut[k]      = out;
-            _samplesOut[k + 1u] = out;
+            Dstplugin_out(_bAdd, _samplesOut[k],      out, _gain);
+            Dstplugin_out(_bAdd, _samplesOut[k + 1u], out, _gain);
             // Next frame
             k += 2u;
             voice->mod_drywet_cur += voice->mod_drywet_inc;
@@ -207,8 +215,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
             outR = r + (outR - r) * voice->mod_drywet_cur;
             outL = Dstplugin_fix_denorm_32(outL);
             outR = Dstplugin_fix_denorm_32(outR);
-            _samplesOut[k]      = outL;
-            _samplesOut[k + 1u] = outR;
+            Dstplugin_out(_bAdd, _samplesOut[k],      outL, _gain);
+            Dstplugin_out(_bAdd, _samplesOut[k + 1u], outR, _gain);
             // Next frame
             k += 2u;
             voice->mod_drywet_cur += voice->mod_drywet_inc;
@@ -218,52 +226,149 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
    }
    else
    {
-      if(_bMonoIn)
+      // tanh() table (see wshaper.h)
+      ST_PLUGIN_VOICE_INFO_CAST(ws_tanh_info_t);
+      st_wshaper_ramp_t ramps[ST_WSHAPER_NUM_RAMPS];
+      ramps[ST_WSHAPER_RAMP_DRYWET].cur = voice->mod_drywet_cur;
+      ramps[ST_WSHAPER_RAMP_DRYWET].inc = voice->mod_drywet_inc;
+      ramps[ST_WSHAPER_RAMP_OFFSET].cur = 0.0f;
+      ramps[ST_WSHAPER_RAMP_OFFSET].inc = 0.0f;
+      ramps[ST_WSHAPER_RAMP_DRIVE ].cur = voice->mod_drive_cur;
+      ramps[ST_WSHAPER_RAMP_DRIVE ].inc = voice->mod_drive_inc;
+      ramps[ST_WSHAPER_RAMP_LEVEL ].cur = 1.0f;
+      ramps[ST_WSHAPER_RAMP_LEVEL ].inc = 0.0f;
+      st_wshaper_process(info->ws_tanh, ramps, NULL/*adaaLast*/,
+                         _bMonoIn, _samplesIn, _samplesOut, _numFrames, _bAdd, _gain
+                         );
+      voice->mod_drywet_cur = ramps[ST_WSHAPER_RAMP_DRYWET].cur;
+      voice->mod_drive_cur  = ramps[ST_WSHAPER_RAMP_DRIVE ].cur;
+   }
+}
+
+static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
+                                              int                 _bMonoIn,
+                                              const float        *_samplesIn,
+                                              float              *_samplesOut,
+                                              unsigned int        _numFrames
+                                              ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 0/*bAdd*/, 1.0f/*gain*/);
+}
+
+static void ST_PLUGIN_API loc_process_add(st_plugin_voice_t  *_voice,
+                                          int                 _bMonoIn,
+                                          const float        *_samplesIn,
+                                          float              *_samplesOut,
+                                          unsigned int        _numFrames,
+                                          float               _gain
+                                          ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 1/*bAdd*/, _gain);
+}
+
+static void loc_shape_planar_approx(const float  *_in,
+                                    float        *_out,
+                                    const float  *_drive,
+                                    const float  *_drywet,
+                                    unsigned int  _numFrames
+                                    ) {
+   for(unsigned int i = 0u; i < _numFrames; i++)
+   {
+      float l = _in[i];
+      float a = loc_tanhf_approx(l * _drive[i]);
+      float out = l + (a - l) * _drywet[i];
+      _out[i] = Dstplugin_fix_denorm_32(out);
+   }
+}
+
+static void loc_shape_planar_tanh(const st_wshaper_t *_wsTanh,
+                                   const float        *_in,
+                                   float              *_out,
+                                   const float        *_drive,
+                                   const float        *_drywet,
+                                   unsigned int        _numFrames
+                                   ) {
+   unsigned int i = 0u;
+#ifdef ST_WSHAPER_SSE2
+   const __m128 c10 = _mm_set1_ps(10.0f);
+   for(; (i + 4u) <= _numFrames; i += 4u)
+   {
+      __m128 l = _mm_loadu_ps(_in + i);
+      __m128 a = st_wshaper_lookup4(_wsTanh, _mm_mul_ps(l, _mm_loadu_ps(_drive + i)));
+      __m128 out = _mm_add_ps(l, _mm_mul_ps(_mm_sub_ps(a, l), _mm_loadu_ps(_drywet + i)));
+      _mm_storeu_ps(_out + i, _mm_sub_ps(_mm_add_ps(out, c10), c10));  // Dstplugin_fix_denorm_32()
+   }
+#endif // ST_WSHAPER_SSE2
+   for(; i < _numFrames; i++)
+   {
+      float l = _in[i];
+      float a = st_wshaper_lookup(_wsTanh, l * _drive[i]);
+      float out = l + (a - l) * _drywet[i];
+      _out[i] = Dstplugin_fix_denorm_32(out);
+   }
+}
+
+static void ST_PLUGIN_API loc_process_replace_planar(st_plugin_voice_t  *_voice,
+                                                     int                 _bMonoIn,
+                                                     const float        *_samplesInL,
+                                                     const float        *_samplesInR,
+                                                     float              *_samplesOutL,
+                                                     float              *_samplesOutR,
+                                                     unsigned int        _numFrames
+                                                     ) {
+   ST_PLUGIN_VOICE_CAST(ws_tanh_voice_t);
+   ST_PLUGIN_VOICE_SHARED_CAST(ws_tanh_shared_t);
+   ST_PLUGIN_VOICE_INFO_CAST(ws_tanh_info_t);
+
+   int bApprox = (shared->params[PARAM_APPROX] >= 0.5f);
+
+   // (note) the parameter ramps are unrolled into small arrays first so the per-channel loops
+   //         can be vectorized (same results as process_replace())
+   float drive [PLANAR_CHUNK_SIZE];
+   float drywet[PLANAR_CHUNK_SIZE];
+
+   unsigned int frameOff = 0u;
+   while(frameOff < _numFrames)
+   {
+      unsigned int numChunkFrames = Dstplugin_min(_numFrames - frameOff, PLANAR_CHUNK_SIZE);
+
+      for(unsigned int i = 0u; i < numChunkFrames; i++)
       {
-         // Mono input, stereo output
-         for(unsigned int i = 0u; i < _numFrames; i++)
-         {
-            float l = _samplesIn[k];
-            float a = tanhf(l * voice->mod_drive_cur);
-            float out = l + (a - l) * voice->mod_drywet_cur;
-            out = Dstplugin_fix_denorm_32(out);
-            _samplesOut[k]      = out;
-            _samplesOut[k + 1u] = out;
-            // Next frame
-            k += 2u;
-            voice->mod_drywet_cur += voice->mod_drywet_inc;
-            voice->mod_drive_cur  += voice->mod_drive_inc;
-         }
+         drive [i] = voice->mod_drive_cur;
+         drywet[i] = voice->mod_drywet_cur;
+         voice->mod_drywet_cur += voice->mod_drywet_inc;
+         voice->mod_drive_cur  += voice->mod_drive_inc;
       }
+
+      const float *inL  = _samplesInL  + frameOff;
+      const float *inR  = _samplesInR  + frameOff;
+      float       *outL = _samplesOutL + frameOff;
+      float       *outR = _samplesOutR + frameOff;
+
+      if(bApprox)
+         loc_shape_planar_approx(inL, outL, drive, drywet, numChunkFrames);
       else
+         loc_shape_planar_tanh(info->ws_tanh, inL, outL, drive, drywet, numChunkFrames);
+
+      if(_bMonoIn)
       {
-         // Stereo input, stereo output
-         for(unsigned int i = 0u; i < _numFrames; i++)
-         {
-            float l = _samplesIn[k];
-            float r = _samplesIn[k + 1u];
-            float outL = tanhf(l * voice->mod_drive_cur);
-            float outR = tanhf(r * voice->mod_drive_cur);
-            outL = l + (outL - l) * voice->mod_drywet_cur;
-            outR = r + (outR - r) * voice->mod_drywet_cur;
-            outL = Dstplugin_fix_denorm_32(outL);
-            outR = Dstplugin_fix_denorm_32(outR);
-            _samplesOut[k]      = outL;
-            _samplesOut[k + 1u] = outR;
-            // Next frame
-            k += 2u;
-            voice->mod_drywet_cur += voice->mod_drywet_inc;
-            voice->mod_drive_cur  += voice->mod_drive_inc;
-         }
+         // Mono input, stereo output
+         for(unsigned int i = 0u; i < numChunkFrames; i++)
+            outR[i] = outL[i];
       }
+      else if(bApprox)
+         loc_shape_planar_approx(inR, outR, drive, drywet, numChunkFrames);
+      else
+         loc_shape_planar_tanh(info->ws_tanh, inR, outR, drive, drywet, numChunkFrames);
+
+      frameOff += numChunkFrames;
    }
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   ws_tanh_shared_t *ret = malloc(sizeof(ws_tanh_shared_t));
+   ws_tanh_shared_t *ret = Dstplugin_alloc(_info, sizeof(ws_tanh_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
+
       ret->base.info  = _info;
       memcpy((void*)ret->params, (void*)loc_param_resets, NUM_PARAMS * sizeof(float));
    }
@@ -271,12 +376,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   ws_tanh_voice_t *ret = malloc(sizeof(ws_tanh_voice_t));
+   ws_tanh_voice_t *ret = Dstplugin_alloc(_info, sizeof(ws_tanh_voice_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -285,8 +390,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(ws_tanh_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free(_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -302,12 +413,13 @@ st_plugin_info_t *ws_tanh_init(void) {
    {
       memset(ret, 0, sizeof(*ret));
 
+
       ret->base.api_version = ST_PLUGIN_API_VERSION;
       ret->base.id          = "bsp ws tanh";  // unique id. don't change this in future builds.
       ret->base.author      = "bsp";
       ret->base.name        = "tanh shaper";
       ret->base.short_name  = "tanh";
-      ret->base.flags       = ST_PLUGIN_FLAG_FX;
+      ret->base.flags       = ST_PLUGIN_FLAG_FX | ST_PLUGIN_FLAG_PLANAR;
       ret->base.category    = ST_PLUGIN_CAT_WAVESHAPER;
       ret->base.num_params  = NUM_PARAMS;
       ret->base.num_mods    = NUM_MODS;
@@ -316,6 +428,7 @@ st_plugin_info_t *ws_tanh_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -325,7 +438,11 @@ st_plugin_info_t *ws_tanh_init(void) {
       ret->base.set_mod_value    = &loc_set_mod_value;
       ret->base.prepare_block    = &loc_prepare_block;
       ret->base.process_replace  = &loc_process_replace;
+      ret->base.process_add      = &loc_process_add;
+      ret->base.process_replace_planar = &loc_process_replace_planar;
       ret->base.plugin_exit      = &loc_plugin_exit;
+
+      ret->ws_tanh = st_wshaper_tanh_get();
    }
 
    return &ret->base;
@@ -9,7 +9,7 @@
 // ----
 // ---- created: 10May2009
 // ---- changed: 23May2010, 30Sep2010, 07Oct2010, 17May2020, 18May2020, 19May2020, 20May2020
-// ----          21May2020, 24May2020, 25May2020, 31May2020, 08Jun2020, 08Aug2021, 21Jan2024
+// ----          21May2020, 24May2020, 25May2020, 31May2020, 08Jun2020, 08Aug2021, 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -19,6 +19,8 @@
 
 #include "../../../plugin.h"
 
+#include "wshaper.h"
+
 #define PARAM_DRYWET      0
 #define PARAM_BIAS        1
 #define PARAM_DRIVE_M     2
@@ -57,6 +59,7 @@ static const char *loc_mod_names[NUM_MODS] = {
 
 typedef struct ws_tanh_asym_info_s {
    st_plugin_info_t base;
+   const st_wshaper_t *ws_tanh;  // shared (see wshaper.h)
 } ws_tanh_asym_info_t;
 
 typedef struct ws_tanh_asym_shared_s {
@@ -195,14 +198,17 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    }
 }
 
-static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
-                                              int                 _bMonoIn,
-                                              const float        *_samplesIn,
-                                              float              *_samplesOut,
-                                              unsigned int        _numFrames
-                                              ) {
+static inline void loc_process(st_plugin_voice_t  *_voice,
+                               int                 _bMonoIn,
+                               const float        *_samplesIn,
+                               float              *_samplesOut,
+                               unsigned int        _numFrames,
+                               const int           _bAdd,
+                               const float         _gain
+                               ) {
    ST_PLUGIN_VOICE_CAST(ws_tanh_asym_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(ws_tanh_asym_shared_t);
+   ST_PLUGIN_VOICE_INFO_CAST(ws_tanh_asym_info_t);
 
    unsigned int k = 0u;
 
@@ -215,18 +221,18 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
       float outL = l;
       outL += voice->mod_bias_l_cur;
       if(outL < 0.0f)
-         outL = tanhf(outL * voice->mod_drivem_cur);
+         outL = st_wshaper_lookup(info->ws_tanh, outL * voice->mod_drivem_cur);
       else
-         outL = tanhf(outL * voice->mod_drivep_cur);
+         outL = st_wshaper_lookup(info->ws_tanh, outL * voice->mod_drivep_cur);
       outL -= voice->mod_bias_l_cur;
       outL *= shared->params[PARAM_OUTPUT_LVL];
 
       float outR = r;
       outR += voice->mod_bias_r_cur;
       if(outR < 0.0f)
-         outR = tanhf(outR * voice->mod_drivem_cur);
+         outR = st_wshaper_lookup(info->ws_tanh, outR * voice->mod_drivem_cur);
       else
-         outR = tanhf(outR * voice->mod_drivep_cur);
+         outR = st_wshaper_lookup(info->ws_tanh, outR * voice->mod_drivep_cur);
       outR -= voice->mod_bias_r_cur;
       outR *= shared->params[PARAM_OUTPUT_LVL];
 
@@ -234,8 +240,8 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
       outR = r + (outR - r) * voice->mod_drywet_cur;
       outL = Dstplugin_fix_denorm_32(outL);
       outR = Dstplugin_fix_denorm_32(outR);
-      _samplesOut[k]      = outL;
-      _samplesOut[k + 1u] = outR;
+      Dstplugin_out(_bAdd, _samplesOut[k],      outL, _gain);
+      Dstplugin_out(_bAdd, _samplesOut[k + 1u], outR, _gain);
 
       // Next frame
       voice->mod_drywet_cur += voice->mod_drywet_inc;
@@ -247,11 +253,31 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
    }
 }
 
+static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
+                                              int                 _bMonoIn,
+                                              const float        *_samplesIn,
+                                              float              *_samplesOut,
+                                              unsigned int        _numFrames
+                                              ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 0/*bAdd*/, 1.0f/*gain*/);
+}
+
+static void ST_PLUGIN_API loc_process_add(st_plugin_voice_t  *_voice,
+                                          int                 _bMonoIn,
+                                          const float        *_samplesIn,
+                                          float              *_samplesOut,
+                                          unsigned int        _numFrames,
+                                          float               _gain
+                                          ) {
+   loc_process(_voice, _bMonoIn, _samplesIn, _samplesOut, _numFrames, 1/*bAdd*/, _gain);
+}
+
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   ws_tanh_asym_shared_t *ret = malloc(sizeof(ws_tanh_asym_shared_t));
+   ws_tanh_asym_shared_t *ret = Dstplugin_alloc(_info, sizeof(ws_tanh_asym_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
+
       ret->base.info  = _info;
       memcpy((void*)ret->params, (void*)loc_param_resets, NUM_PARAMS * sizeof(float));
    }
@@ -259,12 +285,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   ws_tanh_asym_voice_t *ret = malloc(sizeof(ws_tanh_asym_voice_t));
+   ws_tanh_asym_voice_t *ret = Dstplugin_alloc(_info, sizeof(ws_tanh_asym_voice_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -273,8 +299,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(ws_tanh_asym_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free(_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -290,6 +322,7 @@ st_plugin_info_t *ws_tanh_asym_init(void) {
    {
       memset(ret, 0, sizeof(*ret));
 
+
       ret->base.api_version = ST_PLUGIN_API_VERSION;
       ret->base.id          = "bsp ws tanh asym";  // unique id. don't change this in future builds.
       ret->base.author      = "bsp";
@@ -304,6 +337,7 @@ st_plugin_info_t *ws_tanh_asym_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -313,7 +347,10 @@ st_plugin_info_t *ws_tanh_asym_init(void) {
       ret->base.set_mod_value    = &loc_set_mod_value;
       ret->base.prepare_block    = &loc_prepare_block;
       ret->base.process_replace  = &loc_process_replace;
+      ret->base.process_add      = &loc_process_add;
       ret->base.plugin_exit      = &loc_plugin_exit;
+
+      ret->ws_tanh = st_wshaper_tanh_get();
    }
 
    return &ret->base;
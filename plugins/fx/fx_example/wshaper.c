@@ -0,0 +1,113 @@
+// ----
+// ---- file   : wshaper.c
+// ---- author : Bastian Spiegel <bs@tkscript.de>
+// ---- legal  : (c) 2026 by Bastian Spiegel.
+// ----          Distributed under terms of the GNU LESSER GENERAL PUBLIC LICENSE (LGPL). See
+// ----          http://www.gnu.org/licenses/licenses.html#LGPL or COPYING for further information.
+// ----
+// ---- info   : table-driven waveshaper (transfer curve LUT, SSE2 block kernel, ADAA)
+// ----
+// ---- created: 17Oct2026
+// ---- changed:
+// ----
+// ----
+// ----
+
+#include <math.h>
+#include <string.h>
+
+#include "../../../plugin.h"
+
+#include "wshaper.h"
+
+static st_wshaper_t loc_tanh;
+static st_wshaper_t loc_sin;
+
+int st_wshaper_update(st_wshaper_t     *_ws,
+                      st_wshaper_fxn_t  _fxn,
+                      const float      *_keys,
+                      unsigned int      _numKeys,
+                      float             _xMin,
+                      float             _xMax,
+                      unsigned int      _flags
+                      ) {
+   if(_numKeys > ST_WSHAPER_MAX_KEYS)
+      _numKeys = ST_WSHAPER_MAX_KEYS;
+
+   if(_ws->b_valid                 &&
+      _ws->flags    == _flags      &&
+      _ws->num_keys == _numKeys    &&
+      _ws->x_min    == _xMin       &&
+      _ws->x_max    == _xMax       &&
+      (0u == _numKeys || 0 == memcmp((const void*)_ws->keys, (const void*)_keys, sizeof(float) * _numKeys))
+      )
+   {
+      // Shape has not changed
+      return 0;
+   }
+
+   _ws->flags    = _flags;
+   _ws->fxn      = _fxn;
+   _ws->num_keys = _numKeys;
+   if(_numKeys > 0u)
+      memcpy((void*)_ws->keys, (const void*)_keys, sizeof(float) * _numKeys);
+   _ws->x_min   = _xMin;
+   _ws->x_max   = _xMax;
+   _ws->x_scale = ST_WSHAPER_SIZE / (_xMax - _xMin);
+
+   const double h = (double)(_xMax - _xMin) / ST_WSHAPER_SIZE;
+   unsigned int i;
+   for(i = 0u; i <= ST_WSHAPER_SIZE; i++)
+      _ws->tbl[i] = _fxn(_keys, (float)(_xMin + i * h));
+   if(_flags & ST_WSHAPER_FLAG_PERIODIC)
+      _ws->tbl[ST_WSHAPER_SIZE] = _ws->tbl[0];
+   _ws->tbl[ST_WSHAPER_SIZE + 1u] = _ws->tbl[ST_WSHAPER_SIZE];  // guard (clamp at x_max)
+
+   // Find segments that are not sufficiently approximated by linear interpolation
+   _ws->b_exact = 0;
+   for(i = 0u; i < ST_WSHAPER_SIZE; i++)
+   {
+      const float fMid = _fxn(_keys, (float)(_xMin + (i + 0.5) * h));
+      const float err  = fMid - (_ws->tbl[i] + _ws->tbl[i + 1u]) * 0.5f;
+      _ws->exact[i] = (fabsf(err) > ST_WSHAPER_MAX_ERROR);
+      _ws->b_exact |= _ws->exact[i];
+   }
+   _ws->exact[ST_WSHAPER_SIZE] = 0u;  // p=ST_WSHAPER_SIZE (clamped to x_max)
+
+   if(_flags & ST_WSHAPER_FLAG_ADAA)
+   {
+      // Integrate linear segments
+      double sum = 0.0;
+      _ws->tbl_int[0] = 0.0;
+      for(i = 1u; i <= ST_WSHAPER_SIZE; i++)
+      {
+         sum += 0.5 * ((double)_ws->tbl[i - 1u] + (double)_ws->tbl[i]) * h;
+         _ws->tbl_int[i] = sum;
+      }
+   }
+
+   _ws->b_valid = 1;
+   return 1;
+}
+
+static float loc_tanh_fxn(const float *_keys, float _x) {
+   (void)_keys;
+   return tanhf(_x);
+}
+
+const st_wshaper_t *st_wshaper_tanh_get(void) {
+   // (note) st_plugin_init() is not called concurrently => no locking
+   (void)st_wshaper_update(&loc_tanh, &loc_tanh_fxn, NULL, 0u, -8.0f, 8.0f, 0u/*flags*/);
+   return &loc_tanh;
+}
+
+static float loc_sin_fxn(const float *_keys, float _x) {
+   (void)_keys;
+   return sinf(_x);
+}
+
+const st_wshaper_t *st_wshaper_sin_get(void) {
+   // (note) st_plugin_init() is not called concurrently => no locking
+   (void)st_wshaper_update(&loc_sin, &loc_sin_fxn, NULL, 0u, 0.0f, (float)ST_PLUGIN_2PI, ST_WSHAPER_FLAG_PERIODIC);
+   return &loc_sin;
+}
@@ -0,0 +1,366 @@
+// ----
+// ---- file   : wshaper.h
+// ---- author : Bastian Spiegel <bs@tkscript.de>
+// ---- legal  : (c) 2026 by Bastian Spiegel.
+// ----          Distributed under terms of the GNU LESSER GENERAL PUBLIC LICENSE (LGPL). See
+// ----          http://www.gnu.org/licenses/licenses.html#LGPL or COPYING for further information.
+// ----
+// ---- info   : table-driven waveshaper (transfer curve LUT, SSE2 block kernel, ADAA), fast log2 / exp2 / pow
+// ----
+// ---- created: 17Oct2026
+// ---- changed:
+// ----
+// ----
+// ----
+
+#ifndef __ST_WSHAPER_H__
+#define __ST_WSHAPER_H__
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define ST_WSHAPER_SSE2  1
+#include <emmintrin.h>
+#endif
+
+#define ST_WSHAPER_SIZE      (4096u)  // number of table segments
+#define ST_WSHAPER_MASK      (4095u)
+#define ST_WSHAPER_MAX_KEYS  (8u)
+
+// Shape param ramps that end closer than this to their target are considered static
+#define ST_WSHAPER_KEY_EPSILON  (0.000001f)
+
+// Table segments whose midpoint interpolation error exceeds this are evaluated by calling the curve function
+//  (e.g. infinite slope at pow(x, <1) knees)
+#define ST_WSHAPER_MAX_ERROR  (0.00001f)
+
+#define ST_WSHAPER_FLAG_PERIODIC  (1u << 0)  // wrap x to x_min..x_max (=one period). default: clamp x
+#define ST_WSHAPER_FLAG_ADAA      (1u << 1)  // also calc antiderivative table (first-order ADAA, clamped tables only)
+
+// Block kernel parameter ramps
+#define ST_WSHAPER_RAMP_DRYWET  0
+#define ST_WSHAPER_RAMP_OFFSET  1  // added to the input, subtracted from the curve output
+#define ST_WSHAPER_RAMP_DRIVE   2  // input gain (after offset)
+#define ST_WSHAPER_RAMP_LEVEL   3  // curve output gain (before offset)
+#define ST_WSHAPER_NUM_RAMPS    4
+
+// Transfer curve (evaluated when the table is (re-)built, and in ST_WSHAPER_MAX_ERROR segments)
+typedef float (*st_wshaper_fxn_t) (const float *_keys, float _x);
+
+typedef struct st_wshaper_ramp_s {
+   float cur;
+   float inc;  // per sample frame
+} st_wshaper_ramp_t;
+
+typedef struct st_wshaper_s {
+   int              b_valid;
+   int              b_exact;  // 1=at least one segment is evaluated by calling fxn
+   unsigned int     flags;
+   st_wshaper_fxn_t fxn;
+   unsigned int     num_keys;
+   float            keys[ST_WSHAPER_MAX_KEYS];  // shape params the table was built for
+   float            x_min;
+   float            x_max;
+   float            x_scale;  // ST_WSHAPER_SIZE / (x_max - x_min)
+   float            tbl[ST_WSHAPER_SIZE + 2u];      // f(x_min + i / x_scale) (+ guard element)
+   unsigned char    exact[ST_WSHAPER_SIZE + 1u];    // 1=segment is evaluated by calling fxn (see ST_WSHAPER_MAX_ERROR)
+   double           tbl_int[ST_WSHAPER_SIZE + 1u];  // antiderivative at the table nodes (ST_WSHAPER_FLAG_ADAA)
+} st_wshaper_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// (Re-)build table when it is not valid, yet, or when keys / range / flags have changed
+//  - returns 1 when the table has been rebuilt
+extern int st_wshaper_update (st_wshaper_t     *_ws,
+                              st_wshaper_fxn_t  _fxn,
+                              const float      *_keys,
+                              unsigned int      _numKeys,
+                              float             _xMin,
+                              float             _xMax,
+                              unsigned int      _flags
+                              );
+
+// Returns the (read-only) tanh() table that is shared by all plugins in this library
+//  - clamped to -8..8 (max. abs. error ~1.5e-6)
+//  - built on first call (call it from the plugin init function)
+extern const st_wshaper_t *st_wshaper_tanh_get (void);
+
+// Returns the (read-only) sin() table that is shared by all plugins in this library
+//  - periodic, 0..2PI (max. abs. error ~3e-7)
+//  - built on first call (call it from the plugin init function)
+extern const st_wshaper_t *st_wshaper_sin_get (void);
+
+#ifdef __cplusplus
+}
+#endif
+
+
+// Fast log2(x) (x must be a positive, normalized number, max. abs. error ~1e-7 + rounding of the exponent part)
+static inline float st_wshaper_log2_fast(const float _x) {
+   // x = m * 2^n, m = sqrt(0.5)..sqrt(2)  =>  log2(m) = 2/ln(2) * atanh((m-1)/(m+1))
+   stplugin_fi_t u;
+   u.f = _x;
+   int n = (int)((u.u >> 23) & 255u) - 127;
+   u.u = (u.u & 0x007FFFFFu) | 0x3F800000u;
+   if(u.f > 1.41421356f)
+   {
+      u.f *= 0.5f;
+      n++;
+   }
+   const float t  = (u.f - 1.0f) / (u.f + 1.0f);
+   const float t2 = t * t;
+   return (float)n + t * (2.88539008f + t2 * (0.961796694f + t2 * (0.577078016f + t2 * (0.412198583f + t2 * 0.320598898f))));
+}
+
+// Fast 2^y (max. rel. error ~1.2e-7, returns 0 when y < -126)
+static inline float st_wshaper_exp2_fast(float _y) {
+   if(_y < -126.0f)
+      return 0.0f;
+   if(_y > 127.0f)
+      _y = 127.0f;
+   // 2^y = 2^n * e^(f*ln(2)), n = round(y), f = -0.5..0.5
+   const int n = (int)lrintf(_y);
+   const float f = _y - (float)n;
+   stplugin_fi_t u;
+   u.u = (unsigned int)(n + 127) << 23;
+   return u.f * (1.0f + f * (0.693147181f + f * (0.240226507f + f * (0.0555041087f + f * (0.00961812911f + f * (0.00133335581f + f * (0.000154035304f + f * 0.0000152527338f)))))));
+}
+
+// Fast pow(|x|, e) (e > 0, returns 0 when x is zero or denormal)
+//  - max. abs. error ~1.5e-7 when |x| <= 1 (e = 0.25..4)
+static inline float st_wshaper_pow_abs_fast(const float _x, const float _e) {
+   stplugin_fi_t u;
+   u.f = _x;
+   u.u &= 0x7FFFFFFFu;
+   if(u.u < 0x00800000u)
+      return 0.0f;
+   return st_wshaper_exp2_fast(_e * st_wshaper_log2_fast(u.f));
+}
+
+#ifdef ST_WSHAPER_SSE2
+// 4 lane versions of st_wshaper_log2_fast(), st_wshaper_exp2_fast(), st_wshaper_pow_abs_fast()
+//  - (note) results may differ by ~1 ulp (-ffast-math replaces the division by rcpps + Newton-Raphson step)
+static inline __m128 st_wshaper_log2_fast4(const __m128 _x) {
+   const __m128i xI = _mm_castps_si128(_x);
+   __m128i n = _mm_sub_epi32(_mm_and_si128(_mm_srli_epi32(xI, 23), _mm_set1_epi32(255)), _mm_set1_epi32(127));
+   __m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(xI, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+   const __m128 bHi = _mm_cmpgt_ps(m, _mm_set1_ps(1.41421356f));
+   m = _mm_or_ps(_mm_and_ps(bHi, _mm_mul_ps(m, _mm_set1_ps(0.5f))), _mm_andnot_ps(bHi, m));
+   n = _mm_sub_epi32(n, _mm_castps_si128(bHi));  // n+1 where m > sqrt(2)
+   const __m128 one = _mm_set1_ps(1.0f);
+   const __m128 t  = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+   const __m128 t2 = _mm_mul_ps(t, t);
+   __m128 r = _mm_add_ps(_mm_set1_ps(0.412198583f), _mm_mul_ps(t2, _mm_set1_ps(0.320598898f)));
+   r = _mm_add_ps(_mm_set1_ps(0.577078016f), _mm_mul_ps(t2, r));
+   r = _mm_add_ps(_mm_set1_ps(0.961796694f), _mm_mul_ps(t2, r));
+   r = _mm_add_ps(_mm_set1_ps(2.88539008f),  _mm_mul_ps(t2, r));
+   return _mm_add_ps(_mm_cvtepi32_ps(n), _mm_mul_ps(t, r));
+}
+
+static inline __m128 st_wshaper_exp2_fast4(__m128 _y) {
+   const __m128 bValid = _mm_cmpge_ps(_y, _mm_set1_ps(-126.0f));
+   _y = _mm_max_ps(_mm_min_ps(_y, _mm_set1_ps(127.0f)), _mm_set1_ps(-126.0f));
+   const __m128i n = _mm_cvtps_epi32(_y);  // round to nearest
+   const __m128 f = _mm_sub_ps(_y, _mm_cvtepi32_ps(n));
+   const __m128 scl = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+   __m128 r = _mm_add_ps(_mm_set1_ps(0.000154035304f), _mm_mul_ps(f, _mm_set1_ps(0.0000152527338f)));
+   r = _mm_add_ps(_mm_set1_ps(0.00133335581f), _mm_mul_ps(f, r));
+   r = _mm_add_ps(_mm_set1_ps(0.00961812911f), _mm_mul_ps(f, r));
+   r = _mm_add_ps(_mm_set1_ps(0.0555041087f),  _mm_mul_ps(f, r));
+   r = _mm_add_ps(_mm_set1_ps(0.240226507f),   _mm_mul_ps(f, r));
+   r = _mm_add_ps(_mm_set1_ps(0.693147181f),   _mm_mul_ps(f, r));
+   r = _mm_add_ps(_mm_set1_ps(1.0f),           _mm_mul_ps(f, r));
+   return _mm_and_ps(bValid, _mm_mul_ps(scl, r));
+}
+
+static inline __m128 st_wshaper_pow_abs_fast4(const __m128 _x, const __m128 _e) {
+   const __m128 a = _mm_and_ps(_x, _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF)));
+   const __m128 bNorm = _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_castps_si128(a), _mm_set1_epi32(0x007FFFFF)));
+   return _mm_and_ps(bNorm, st_wshaper_exp2_fast4(_mm_mul_ps(_e, st_wshaper_log2_fast4(a))));
+}
+#endif // ST_WSHAPER_SSE2
+
+// Linearly interpolated lookup
+static inline float st_wshaper_lookup(const st_wshaper_t *_ws, const float _x) {
+   float p = (_x - _ws->x_min) * _ws->x_scale;
+   int i;
+   if(_ws->flags & ST_WSHAPER_FLAG_PERIODIC)
+   {
+      i = (int)p;
+      if((float)i > p)
+         i--;  // floor
+      p -= (float)i;
+      i &= ST_WSHAPER_MASK;
+   }
+   else
+   {
+      p = Dstplugin_clamp(p, 0.0f, (float)ST_WSHAPER_SIZE);
+      i = (int)p;
+      p -= (float)i;
+   }
+   if(_ws->b_exact && _ws->exact[i])
+      return _ws->fxn(_ws->keys, _ws->x_min + ((float)i + p) / _ws->x_scale);
+   return _ws->tbl[i] + (_ws->tbl[i + 1] - _ws->tbl[i]) * p;
+}
+
+#ifdef ST_WSHAPER_SSE2
+static inline __m128 st_wshaper_lookup4(const st_wshaper_t *_ws, const __m128 _x) {
+   __m128 p = _mm_mul_ps(_mm_sub_ps(_x, _mm_set1_ps(_ws->x_min)), _mm_set1_ps(_ws->x_scale));
+   __m128i pI;
+   if(_ws->flags & ST_WSHAPER_FLAG_PERIODIC)
+   {
+      pI = _mm_cvttps_epi32(p);
+      __m128 pF = _mm_cvtepi32_ps(pI);
+      pI = _mm_add_epi32(pI, _mm_castps_si128(_mm_cmpgt_ps(pF, p)));  // floor (-1 where trunc > p)
+      p  = _mm_sub_ps(p, _mm_cvtepi32_ps(pI));
+      pI = _mm_and_si128(pI, _mm_set1_epi32((int)ST_WSHAPER_MASK));
+   }
+   else
+   {
+      p  = _mm_min_ps(_mm_max_ps(p, _mm_setzero_ps()), _mm_set1_ps((float)ST_WSHAPER_SIZE));
+      pI = _mm_cvttps_epi32(p);
+      p  = _mm_sub_ps(p, _mm_cvtepi32_ps(pI));
+   }
+   union { __m128i v; int i[4]; } u;
+   u.v = pI;
+   const float *tbl = _ws->tbl;
+   const __m128 c = _mm_setr_ps(tbl[u.i[0]],      tbl[u.i[1]],      tbl[u.i[2]],      tbl[u.i[3]]);
+   const __m128 n = _mm_setr_ps(tbl[u.i[0] + 1], tbl[u.i[1] + 1], tbl[u.i[2] + 1], tbl[u.i[3] + 1]);
+   __m128 r = _mm_add_ps(c, _mm_mul_ps(_mm_sub_ps(n, c), p));
+   if(_ws->b_exact)
+   {
+      union { __m128 v; float f[4]; } uP, uR;
+      uP.v = p;
+      uR.v = r;
+      for(unsigned int j = 0u; j < 4u; j++)
+      {
+         if(_ws->exact[u.i[j]])
+            uR.f[j] = _ws->fxn(_ws->keys, _ws->x_min + ((float)u.i[j] + uP.f[j]) / _ws->x_scale);
+      }
+      r = uR.v;
+   }
+   return r;
+}
+#endif // ST_WSHAPER_SSE2
+
+// Antiderivative of the (linearly interpolated) curve, F(x_min)=0
+//  - the curve is constant outside of x_min..x_max
+static inline double st_wshaper_antideriv(const st_wshaper_t *_ws, const float _x) {
+   const double h = (double)(_ws->x_max - _ws->x_min) / ST_WSHAPER_SIZE;
+   const double p = ((double)_x - _ws->x_min) * _ws->x_scale;
+   if(p <= 0.0)
+      return _ws->tbl[0] * p * h;
+   if(p >= (double)ST_WSHAPER_SIZE)
+      return _ws->tbl_int[ST_WSHAPER_SIZE] + _ws->tbl[ST_WSHAPER_SIZE] * (p - ST_WSHAPER_SIZE) * h;
+   const int    i = (int)p;
+   const double t = p - i;
+   return _ws->tbl_int[i] + h * t * (_ws->tbl[i] + 0.5 * (_ws->tbl[i + 1] - _ws->tbl[i]) * t);
+}
+
+// First-order antiderivative anti-aliasing (_x0: previous input, _x1: current input)
+static inline float st_wshaper_adaa(const st_wshaper_t *_ws, const float _x0, const float _x1) {
+   const float d = _x1 - _x0;
+   if(fabsf(d) * _ws->x_scale > 0.001f)
+      return (float)( (st_wshaper_antideriv(_ws, _x1) - st_wshaper_antideriv(_ws, _x0)) / d );
+   // ill-conditioned => evaluate curve at midpoint
+   return st_wshaper_lookup(_ws, (_x0 + _x1) * 0.5f);
+}
+
+// Calc one sample (_p: current ramp values)
+static inline float st_wshaper_sample(const st_wshaper_t *_ws, const float *_p, const float _x, float *_adaaLast) {
+   const float u = (_x + _p[ST_WSHAPER_RAMP_OFFSET]) * _p[ST_WSHAPER_RAMP_DRIVE];
+   float y;
+   if(NULL != _adaaLast)
+   {
+      y = st_wshaper_adaa(_ws, *_adaaLast, u);
+      *_adaaLast = u;
+   }
+   else
+      y = st_wshaper_lookup(_ws, u);
+   y = y * _p[ST_WSHAPER_RAMP_LEVEL] - _p[ST_WSHAPER_RAMP_OFFSET];
+   y = _x + (y - _x) * _p[ST_WSHAPER_RAMP_DRYWET];
+   return Dstplugin_fix_denorm_32(y);
+}
+
+// Shape interleaved stereo samples
+//   out = in + ( (f((in + offset) * drive) * level - offset) - in ) * drywet
+//  - _adaaLast: NULL=no anti-aliasing, otherwise previous (l,r) curve inputs (clamped tables that were built with ST_WSHAPER_FLAG_ADAA)
+//  - _bMonoIn: only the left input channel is read (l=r)
+//  - SSE2 (w/o ADAA): 2 stereo frames per iteration (ramps advance by 2*inc => ulp-level differences to the per-frame ramps)
+static inline void st_wshaper_process(const st_wshaper_t *_ws,
+                                      st_wshaper_ramp_t  *_ramps,
+                                      float              *_adaaLast,
+                                      int                 _bMonoIn,
+                                      const float        *_samplesIn,
+                                      float              *_samplesOut,
+                                      unsigned int        _numFrames,
+                                      const int           _bAdd,
+                                      const float         _gain
+                                      ) {
+   unsigned int k = 0u;
+   unsigned int frameIdx = 0u;
+   unsigned int j;
+
+#ifdef ST_WSHAPER_SSE2
+   if(NULL == _adaaLast && _numFrames >= 2u)
+   {
+      __m128 p[ST_WSHAPER_NUM_RAMPS];
+      __m128 pInc[ST_WSHAPER_NUM_RAMPS];
+      for(j = 0u; j < ST_WSHAPER_NUM_RAMPS; j++)
+      {
+         const float c = _ramps[j].cur;
+         const float d = _ramps[j].inc;
+         p[j]    = _mm_setr_ps(c, c, c + d, c + d);  // l0 r0 l1 r1
+         pInc[j] = _mm_set1_ps(d + d);
+      }
+      const __m128 vGain = _mm_set1_ps(_gain);
+      const __m128 c10   = _mm_set1_ps(10.0f);
+
+      for(; (frameIdx + 2u) <= _numFrames; frameIdx += 2u)
+      {
+         __m128 in = _mm_loadu_ps(_samplesIn + k);
+         if(_bMonoIn)
+            in = _mm_shuffle_ps(in, in, _MM_SHUFFLE(2,2,0,0));
+
+         const __m128 u = _mm_mul_ps(_mm_add_ps(in, p[ST_WSHAPER_RAMP_OFFSET]), p[ST_WSHAPER_RAMP_DRIVE]);
+         __m128 out = st_wshaper_lookup4(_ws, u);
+         out = _mm_sub_ps(_mm_mul_ps(out, p[ST_WSHAPER_RAMP_LEVEL]), p[ST_WSHAPER_RAMP_OFFSET]);
+         out = _mm_add_ps(in, _mm_mul_ps(_mm_sub_ps(out, in), p[ST_WSHAPER_RAMP_DRYWET]));
+         out = _mm_sub_ps(_mm_add_ps(out, c10), c10);  // Dstplugin_fix_denorm_32()
+
+         if(_bAdd)
+            _mm_storeu_ps(_samplesOut + k, _mm_add_ps(_mm_loadu_ps(_samplesOut + k), _mm_mul_ps(out, vGain)));
+         else
+            _mm_storeu_ps(_samplesOut + k, out);
+
+         // Next 2 frames
+         k += 4u;
+         for(j = 0u; j < ST_WSHAPER_NUM_RAMPS; j++)
+            p[j] = _mm_add_ps(p[j], pInc[j]);
+      }
+
+      for(j = 0u; j < ST_WSHAPER_NUM_RAMPS; j++)
+         _ramps[j].cur = _mm_cvtss_f32(p[j]);
+   }
+#endif // ST_WSHAPER_SSE2
+
+   // Remaining frame (ADAA, or scalar fallback)
+   for(; frameIdx < _numFrames; frameIdx++)
+   {
+      float p[ST_WSHAPER_NUM_RAMPS];
+      for(j = 0u; j < ST_WSHAPER_NUM_RAMPS; j++)
+         p[j] = _ramps[j].cur;
+      const float l = _samplesIn[k];
+      const float r = _bMonoIn ? l : _samplesIn[k + 1u];
+      const float outL = st_wshaper_sample(_ws, p, l, (NULL != _adaaLast) ? &_adaaLast[0] : NULL);
+      const float outR = st_wshaper_sample(_ws, p, r, (NULL != _adaaLast) ? &_adaaLast[1] : NULL);
+      Dstplugin_out(_bAdd, _samplesOut[k],      outL, _gain);
+      Dstplugin_out(_bAdd, _samplesOut[k + 1u], outR, _gain);
+      k += 2u;
+      for(j = 0u; j < ST_WSHAPER_NUM_RAMPS; j++)
+         _ramps[j].cur += _ramps[j].inc;
+   }
+}
+
+
+#endif // __ST_WSHAPER_H__
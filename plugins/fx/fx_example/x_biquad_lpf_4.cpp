@@ -8,7 +8,7 @@
 // ---- info   : a biquad low pass filter that supports per-sample-frame parameter interpolation and filter FM
 // ----
 // ---- created: 21May2020
-// ---- changed: 24May2020, 31May2020, 08Jun2020, 09Jun2020, 19Jan2024, 21Jan2024
+// ---- changed: 24May2020, 31May2020, 08Jun2020, 09Jun2020, 19Jan2024, 21Jan2024, 16Oct2026
 // ----
 // ----
 // ----
@@ -308,7 +308,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   x_biquad_lpf_4_shared_t *ret = (x_biquad_lpf_4_shared_t *)malloc(sizeof(x_biquad_lpf_4_shared_t));
+   x_biquad_lpf_4_shared_t *ret = (x_biquad_lpf_4_shared_t *)Dstplugin_alloc(_info, sizeof(x_biquad_lpf_4_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -319,12 +319,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   x_biquad_lpf_4_voice_t *ret = (x_biquad_lpf_4_voice_t *)malloc(sizeof(x_biquad_lpf_4_voice_t));
+   x_biquad_lpf_4_voice_t *ret = (x_biquad_lpf_4_voice_t *)Dstplugin_alloc(_info, sizeof(x_biquad_lpf_4_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -333,8 +333,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(x_biquad_lpf_4_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -365,6 +371,7 @@ st_plugin_info_t *x_biquad_lpf_4_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -9,7 +9,7 @@
 // ----           see <http://musicdsp.org/showArchiveComment.php?ArchiveID=24>
 // ----
 // ---- created: 05Jun2020
-// ---- changed: 08Jun2020, 09Jun2020, 19Jan2024, 21Jan2024
+// ---- changed: 08Jun2020, 09Jun2020, 19Jan2024, 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -102,8 +102,7 @@ typedef struct x_ladder_lpf_x4_voice_s {
    unsigned int mod_voicebus_idx;
    float        mod_bus_lvl_cur;
    float        mod_bus_lvl_inc;
-   StLadderLPF  lpf_l[NUM_STAGES];
-   StLadderLPF  lpf_r[NUM_STAGES];
+   StLadderLPF  lpf[NUM_STAGES];
 } x_ladder_lpf_x4_voice_t;
 
 
@@ -165,8 +164,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
 
       for(unsigned int i = 0u; i < NUM_STAGES; i++)
       {
-         voice->lpf_l[i].reset();
-         voice->lpf_r[i].reset();
+         voice->lpf[i].reset();
       }
    }
 }
@@ -280,57 +278,43 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
    // fflush(stdout);
    // return;
 
+   typedef StLadderLanes L;
    unsigned int k = 0u;
 
    // Stereo input, stereo output
    for(unsigned int i = 0u; i < _numFrames; i++)
    {
-      float l = _samplesIn[k];
-      float r = _samplesIn[k + 1u];
+      L::vec_t in  = L::load2(&_samplesIn[k]);
+      L::vec_t bus = L::mul(L::load2(&samplesBus[k]), L::set1(voice->mod_bus_lvl_cur));
+      L::vec_t q   = L::set1(voice->mod_q_cur);
 
-      float busL = samplesBus[k];
-      float busR = samplesBus[k + 1u];
-
-      float outL = l;
-      float outR = r;
+      L::vec_t out = in;
 
       for(unsigned int i = 0u; i < NUM_STAGES; i++)
       {
-         float modFreqL = Dstplugin_clamp(voice->mod_freql_cur[i] + busL * voice->mod_bus_lvl_cur, 0.0f, 1.0f);
-         float modFreqR = Dstplugin_clamp(voice->mod_freqr_cur[i] + busR * voice->mod_bus_lvl_cur, 0.0f, 1.0f);
-         modFreqL = (powf(2.0f, modFreqL * 7.0f) - 1.0f) / 127.0f;
-         modFreqR = (powf(2.0f, modFreqR * 7.0f) - 1.0f) / 127.0f;
-
-         voice->lpf_l[i].calcCoeff(1u,
-                                   modFreqL,
-                                   voice->mod_q_cur,
-                                   1.0f/*drive3*/,
-                                   1.0f/*drive4*/
-                                   );
+         // (note) per-sample filter FM: L/R coefficients are calculated in parallel (no libm calls)
+         L::vec_t modFreq = L::add(L::set(voice->mod_freql_cur[i], voice->mod_freqr_cur[i]), bus);
+         modFreq = L::min(L::max(modFreq, L::set1(0.0f)), L::set1(1.0f));
+         modFreq = L::div(L::sub(L::pow2(L::mul(modFreq, L::set1(7.0f))), L::set1(1.0f)), L::set1(127.0f));
 
-         voice->lpf_r[i].calcCoeff(1u,
-                                   modFreqR,
-                                   voice->mod_q_cur,
-                                   1.0f/*drive3*/,
-                                   1.0f/*drive4*/
-                                   );
+         voice->lpf[i].calcCoeff(1u,
+                                 modFreq,
+                                 q,
+                                 1.0f/*drive3*/,
+                                 1.0f/*drive4*/
+                                 );
 
+         out = L::tanh(L::mul(out, L::set1(voice->mod_drive_cur[i])));
 
-         outL = tanhf(outL * voice->mod_drive_cur[i]);
-         outR = tanhf(outR * voice->mod_drive_cur[i]);
-
-         outL = voice->lpf_l[i].filter(outL);
-         outR = voice->lpf_r[i].filter(outR);
+         out = voice->lpf[i].filter(out);
 
          voice->mod_drive_cur[i] += voice->mod_drive_inc[i];
          voice->mod_freql_cur[i] += voice->mod_freql_inc[i];
          voice->mod_freqr_cur[i] += voice->mod_freqr_inc[i];
       }
 
-      outL = l + (outL - l) * voice->mod_drywet_cur;
-      outR = r + (outR - r) * voice->mod_drywet_cur;
-      _samplesOut[k]      = outL;
-      _samplesOut[k + 1u] = outR;
+      out = L::add(in, L::mul(L::sub(out, in), L::set1(voice->mod_drywet_cur)));
+      L::store2(&_samplesOut[k], out);
 
       // Next frame
       k += 2u;
@@ -342,7 +326,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   x_ladder_lpf_x4_shared_t *ret = (x_ladder_lpf_x4_shared_t *)malloc(sizeof(x_ladder_lpf_x4_shared_t));
+   x_ladder_lpf_x4_shared_t *ret = (x_ladder_lpf_x4_shared_t *)Dstplugin_alloc(_info, sizeof(x_ladder_lpf_x4_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -353,12 +337,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   x_ladder_lpf_x4_voice_t *ret = (x_ladder_lpf_x4_voice_t *)malloc(sizeof(x_ladder_lpf_x4_voice_t));
+   x_ladder_lpf_x4_voice_t *ret = (x_ladder_lpf_x4_voice_t *)Dstplugin_alloc(_info, sizeof(x_ladder_lpf_x4_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -367,8 +351,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(x_ladder_lpf_x4_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -399,6 +389,7 @@ st_plugin_info_t *x_ladder_lpf_x4_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
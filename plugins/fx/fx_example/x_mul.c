@@ -8,7 +8,7 @@
 // ---- info   : a simple voice bus ring modulator
 // ----
 // ---- created: 08Jun2020
-// ---- changed: 14Jan2024, 19Jan2024, 21Jan2024
+// ---- changed: 14Jan2024, 19Jan2024, 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -19,6 +19,8 @@
 
 #include "../../../plugin.h"
 
+#include "xbus.h"
+
 #define PARAM_DRYWET    0
 #define PARAM_VOICEBUS  1
 #define PARAM_LVL_IN    2
@@ -59,6 +61,14 @@ static const char *loc_mod_names[NUM_MODS] = {
    "Mix Bus",
 };
 
+// (note) same order as the ST_XBUS_OP_xxx ramps
+#define RAMP_DRYWET    0
+#define RAMP_LVL_IN    1
+#define RAMP_LVL_BUS   2
+#define RAMP_MIX_IN    3
+#define RAMP_MIX_BUS   4
+#define NUM_RAMPS      5
+
 typedef struct x_mul_info_s {
    st_plugin_info_t base;
 } x_mul_info_t;
@@ -70,18 +80,9 @@ typedef struct x_mul_shared_s {
 
 typedef struct x_mul_voice_s {
    st_plugin_voice_t base;
-   float        mods[NUM_MODS];
-   float        mod_drywet_cur;
-   float        mod_drywet_inc;
-   unsigned int mod_voicebus_idx;
-   float        mod_lvl_in_cur;
-   float        mod_lvl_in_inc;
-   float        mod_lvl_bus_cur;
-   float        mod_lvl_bus_inc;
-   float        mod_mix_in_cur;
-   float        mod_mix_in_inc;
-   float        mod_mix_bus_cur;
-   float        mod_mix_bus_inc;
+   float          mods[NUM_MODS];
+   st_xbus_ramp_t ramps[NUM_RAMPS];
+   unsigned int   mod_voicebus_idx;
 } x_mul_voice_t;
 
 
@@ -175,25 +176,25 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    {
       // lerp
       float recBlockSize = (1.0f / _numFrames);
-      voice->mod_drywet_inc   = (modDryWet   - voice->mod_drywet_cur)   * recBlockSize;
-      voice->mod_lvl_in_inc   = (modLvlIn    - voice->mod_lvl_in_cur)   * recBlockSize;
-      voice->mod_lvl_bus_inc  = (modLvlBus   - voice->mod_lvl_bus_cur)  * recBlockSize;
-      voice->mod_mix_in_inc   = (modMixIn    - voice->mod_mix_in_cur)   * recBlockSize;
-      voice->mod_mix_bus_inc  = (modMixBus   - voice->mod_mix_bus_cur)  * recBlockSize;
+      voice->ramps[RAMP_DRYWET].inc   = (modDryWet   - voice->ramps[RAMP_DRYWET].cur)   * recBlockSize;
+      voice->ramps[RAMP_LVL_IN].inc   = (modLvlIn    - voice->ramps[RAMP_LVL_IN].cur)   * recBlockSize;
+      voice->ramps[RAMP_LVL_BUS].inc  = (modLvlBus   - voice->ramps[RAMP_LVL_BUS].cur)  * recBlockSize;
+      voice->ramps[RAMP_MIX_IN].inc   = (modMixIn    - voice->ramps[RAMP_MIX_IN].cur)   * recBlockSize;
+      voice->ramps[RAMP_MIX_BUS].inc  = (modMixBus   - voice->ramps[RAMP_MIX_BUS].cur)  * recBlockSize;
    }
    else
    {
       // initial params/modulation (first block, not rendered)
-      voice->mod_drywet_cur   = modDryWet;
-      voice->mod_drywet_inc   = 0.0f;
-      voice->mod_lvl_in_cur   = modLvlIn;
-      voice->mod_lvl_in_inc   = 0.0f;
-      voice->mod_lvl_bus_cur  = modLvlBus;
-      voice->mod_lvl_bus_inc  = 0.0f;
-      voice->mod_mix_in_cur   = modMixIn;
-      voice->mod_mix_in_inc   = 0.0f;
-      voice->mod_mix_bus_cur  = modMixBus;
-      voice->mod_mix_bus_inc  = 0.0f;
+      voice->ramps[RAMP_DRYWET].cur   = modDryWet;
+      voice->ramps[RAMP_DRYWET].inc   = 0.0f;
+      voice->ramps[RAMP_LVL_IN].cur   = modLvlIn;
+      voice->ramps[RAMP_LVL_IN].inc   = 0.0f;
+      voice->ramps[RAMP_LVL_BUS].cur  = modLvlBus;
+      voice->ramps[RAMP_LVL_BUS].inc  = 0.0f;
+      voice->ramps[RAMP_MIX_IN].cur   = modMixIn;
+      voice->ramps[RAMP_MIX_IN].inc   = 0.0f;
+      voice->ramps[RAMP_MIX_BUS].cur  = modMixBus;
+      voice->ramps[RAMP_MIX_BUS].inc  = 0.0f;
    }
 }
 
@@ -205,67 +206,17 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
                                               ) {
    // Ring modulate at (modulated) note frequency
    ST_PLUGIN_VOICE_CAST(x_mul_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(x_mul_shared_t);
-
-   unsigned int k = 0u;
 
    // (note) always a valid ptr (points to "0"-filled buffer if layer does not exist)
    const float *samplesBus = voice->base.voice_bus_buffers[voice->mod_voicebus_idx] + voice->base.voice_bus_read_offset;
 
    // Stereo input, stereo output
-   for(unsigned int i = 0u; i < _numFrames; i++)
-   {
-      const float l = _samplesIn[k];
-      const float r = _samplesIn[k + 1u];
-
-      const float lAmp = l * voice->mod_lvl_in_cur;
-      const float rAmp = r * voice->mod_lvl_in_cur;
-
-      const float busL = samplesBus[k];
-      const float busR = samplesBus[k + 1u];
-
-      const float busLAmp = busL * voice->mod_lvl_bus_cur;
-      const float busRAmp = busR * voice->mod_lvl_bus_cur;
-
-      // printf("xxx bus[%u] = %f    l=%f\n", k, busL, l);
-
-      // (todo) combine mod_lvl_bus_cur * mod_lvl_in_cur
-      float outL =
-         (lAmp * busRAmp)
-         + (l    * voice->mod_mix_in_cur)
-         + (busL * voice->mod_mix_bus_cur)
-         ;
-      float outR =
-         (r * voice->mod_lvl_in_cur) * (busR * voice->mod_lvl_bus_cur)
-         + (r    * voice->mod_mix_in_cur)
-         + (busR * voice->mod_mix_bus_cur)
-         ;
-
-      outL = l + (outL - l) * voice->mod_drywet_cur;
-      outR = r + (outR - r) * voice->mod_drywet_cur;
-
-      // outL = busL;
-      // outR = busR;
-
-      outL = Dstplugin_fix_denorm_32(outL);
-      outR = Dstplugin_fix_denorm_32(outR);
-
-      _samplesOut[k]      = outL;
-      _samplesOut[k + 1u] = outR;
-
-      // Next frame
-      k += 2u;
-      voice->mod_drywet_cur  += voice->mod_drywet_inc;
-      voice->mod_lvl_in_cur  += voice->mod_lvl_in_inc;
-      voice->mod_lvl_bus_cur += voice->mod_lvl_bus_inc;
-      voice->mod_mix_in_cur  += voice->mod_mix_in_inc;
-      voice->mod_mix_bus_cur += voice->mod_mix_bus_inc;
-   }
+   st_xbus_process(ST_XBUS_OP_MUL, voice->ramps, _bMonoIn, _samplesIn, samplesBus, _samplesOut, _numFrames, 0/*bAdd*/, 1.0f/*gain*/);
 
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   x_mul_shared_t *ret = malloc(sizeof(x_mul_shared_t));
+   x_mul_shared_t *ret = Dstplugin_alloc(_info, sizeof(x_mul_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -276,12 +227,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   x_mul_voice_t *ret = malloc(sizeof(x_mul_voice_t));
+   x_mul_voice_t *ret = Dstplugin_alloc(_info, sizeof(x_mul_voice_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -290,8 +241,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(x_mul_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free(_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -321,6 +278,7 @@ st_plugin_info_t *x_mul_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
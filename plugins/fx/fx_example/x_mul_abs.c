@@ -8,7 +8,7 @@
 // ---- info   : a simple voice bus ring modulator (abs(bus))
 // ----
 // ---- created: 08Jun2020
-// ---- changed: 09Jun2020, 19Jan2024, 21Jan2024
+// ---- changed: 09Jun2020, 19Jan2024, 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -18,6 +18,8 @@
 
 #include "../../../plugin.h"
 
+#include "xbus.h"
+
 #define PARAM_DRYWET    0
 #define PARAM_VOICEBUS  1
 #define PARAM_BUSDRIVE  2
@@ -63,6 +65,15 @@ static const char *loc_mod_names[NUM_MODS] = {
    "Drive"
 };
 
+// (note) same order as the ST_XBUS_OP_xxx ramps
+#define RAMP_DRYWET      0
+#define RAMP_BUS_DRIVE   1
+#define RAMP_OFFSET      2
+#define RAMP_ABS         3
+#define RAMP_BLEND       4
+#define RAMP_DRIVE       5
+#define NUM_RAMPS        6
+
 typedef struct x_mul_abs_info_s {
    st_plugin_info_t base;
 } x_mul_abs_info_t;
@@ -74,20 +85,9 @@ typedef struct x_mul_abs_shared_s {
 
 typedef struct x_mul_abs_voice_s {
    st_plugin_voice_t base;
-   float        mods[NUM_MODS];
-   float        mod_drywet_cur;
-   float        mod_drywet_inc;
-   unsigned int mod_voicebus_idx;
-   float        mod_bus_drive_cur;
-   float        mod_bus_drive_inc;
-   float        mod_offset_cur;
-   float        mod_offset_inc;
-   float        mod_abs_cur;
-   float        mod_abs_inc;
-   float        mod_blend_cur;
-   float        mod_blend_inc;
-   float        mod_drive_cur;
-   float        mod_drive_inc;
+   float          mods[NUM_MODS];
+   st_xbus_ramp_t ramps[NUM_RAMPS];
+   unsigned int   mod_voicebus_idx;
 } x_mul_abs_voice_t;
 
 
@@ -190,28 +190,28 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    {
       // lerp
       float recBlockSize = (1.0f / _numFrames);
-      voice->mod_drywet_inc    = (modDryWet   - voice->mod_drywet_cur)    * recBlockSize;
-      voice->mod_bus_drive_inc = (modBusDrive - voice->mod_bus_drive_cur) * recBlockSize;
-      voice->mod_offset_inc    = (modOffset   - voice->mod_offset_cur)    * recBlockSize;
-      voice->mod_abs_inc       = (modAbs      - voice->mod_abs_cur)       * recBlockSize;
-      voice->mod_blend_inc     = (modBlend    - voice->mod_blend_cur)     * recBlockSize;
-      voice->mod_drive_inc     = (modDrive    - voice->mod_drive_cur)     * recBlockSize;
+      voice->ramps[RAMP_DRYWET].inc    = (modDryWet   - voice->ramps[RAMP_DRYWET].cur)    * recBlockSize;
+      voice->ramps[RAMP_BUS_DRIVE].inc = (modBusDrive - voice->ramps[RAMP_BUS_DRIVE].cur) * recBlockSize;
+      voice->ramps[RAMP_OFFSET].inc    = (modOffset   - voice->ramps[RAMP_OFFSET].cur)    * recBlockSize;
+      voice->ramps[RAMP_ABS].inc       = (modAbs      - voice->ramps[RAMP_ABS].cur)       * recBlockSize;
+      voice->ramps[RAMP_BLEND].inc     = (modBlend    - voice->ramps[RAMP_BLEND].cur)     * recBlockSize;
+      voice->ramps[RAMP_DRIVE].inc     = (modDrive    - voice->ramps[RAMP_DRIVE].cur)     * recBlockSize;
    }
    else
    {
       // initial params/modulation (first block, not rendered)
-      voice->mod_drywet_cur    = modDryWet;
-      voice->mod_drywet_inc    = 0.0f;
-      voice->mod_bus_drive_cur = modBusDrive;
-      voice->mod_bus_drive_inc = 0.0f;
-      voice->mod_offset_cur    = modOffset;
-      voice->mod_offset_inc    = 0.0f;
-      voice->mod_abs_cur       = modAbs;
-      voice->mod_abs_inc       = 0.0f;
-      voice->mod_blend_cur     = modBlend;
-      voice->mod_blend_inc     = 0.0f;
-      voice->mod_drive_cur     = modDrive;
-      voice->mod_drive_inc     = 0.0f;
+      voice->ramps[RAMP_DRYWET].cur    = modDryWet;
+      voice->ramps[RAMP_DRYWET].inc    = 0.0f;
+      voice->ramps[RAMP_BUS_DRIVE].cur = modBusDrive;
+      voice->ramps[RAMP_BUS_DRIVE].inc = 0.0f;
+      voice->ramps[RAMP_OFFSET].cur    = modOffset;
+      voice->ramps[RAMP_OFFSET].inc    = 0.0f;
+      voice->ramps[RAMP_ABS].cur       = modAbs;
+      voice->ramps[RAMP_ABS].inc       = 0.0f;
+      voice->ramps[RAMP_BLEND].cur     = modBlend;
+      voice->ramps[RAMP_BLEND].inc     = 0.0f;
+      voice->ramps[RAMP_DRIVE].cur     = modDrive;
+      voice->ramps[RAMP_DRIVE].inc     = 0.0f;
    }
 }
 
@@ -223,72 +223,17 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
                                               ) {
    // Ring modulate at (modulated) note frequency
    ST_PLUGIN_VOICE_CAST(x_mul_abs_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(x_mul_abs_shared_t);
-
-   unsigned int k = 0u;
 
    // (note) always a valid ptr (points to "0"-filled buffer if layer does not exist)
    const float *samplesBus = voice->base.voice_bus_buffers[voice->mod_voicebus_idx] + voice->base.voice_bus_read_offset;
 
-   typedef union uf_u {
-      float f;
-      unsigned int u;
-   } uf_t;
-
    // Stereo input, stereo output
-   for(unsigned int i = 0u; i < _numFrames; i++)
-   {
-      float l = _samplesIn[k];
-      float r = _samplesIn[k + 1u];
-
-      float busL = samplesBus[k];
-      float busR = samplesBus[k + 1u];
-
-      uf_t absBusL; absBusL.f = busL;
-      uf_t absBusR; absBusR.f = samplesBus[k + 1u];
-      absBusL.u &= 0x7FFFffffu;
-      absBusR.u &= 0x7FFFffffu;
-
-      // left
-      float offBusL = (busL + voice->mod_offset_cur) * voice->mod_bus_drive_cur;
-      uf_t absOffBusL; absOffBusL.f = offBusL;
-      absOffBusL.u &= 0x7FFFffffu;
-
-      float outL = offBusL + (absOffBusL.f - offBusL) * voice->mod_abs_cur;
-      outL = outL + (outL*absBusL.f - outL) * voice->mod_blend_cur;
-
-      // right
-      float offBusR = (busR + voice->mod_offset_cur) * voice->mod_bus_drive_cur;
-      uf_t absOffBusR; absOffBusR.f = offBusR;
-      absOffBusR.u &= 0x7FFFffffu;
-
-      float outR = offBusR + (absOffBusR.f - offBusR) * voice->mod_abs_cur;
-      outR = outR + (outR*absBusR.f - outR) * voice->mod_blend_cur;
-      
-      outL *= l * voice->mod_drive_cur;
-      outR *= r * voice->mod_drive_cur;
-
-      outL = l + (outL - l) * voice->mod_drywet_cur;
-      outR = r + (outR - r) * voice->mod_drywet_cur;
-      outL = Dstplugin_fix_denorm_32(outL);
-      outR = Dstplugin_fix_denorm_32(outR);
-      _samplesOut[k]      = outL;
-      _samplesOut[k + 1u] = outR;
-
-      // Next frame
-      k += 2u;
-      voice->mod_drywet_cur    += voice->mod_drywet_inc;
-      voice->mod_bus_drive_cur += voice->mod_bus_drive_inc;
-      voice->mod_offset_cur    += voice->mod_offset_inc;
-      voice->mod_abs_cur       += voice->mod_abs_inc;
-      voice->mod_blend_cur     += voice->mod_blend_inc;
-      voice->mod_drive_cur     += voice->mod_drive_inc;
-   }
+   st_xbus_process(ST_XBUS_OP_MUL_ABS, voice->ramps, _bMonoIn, _samplesIn, samplesBus, _samplesOut, _numFrames, 0/*bAdd*/, 1.0f/*gain*/);
 
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   x_mul_abs_shared_t *ret = malloc(sizeof(x_mul_abs_shared_t));
+   x_mul_abs_shared_t *ret = Dstplugin_alloc(_info, sizeof(x_mul_abs_shared_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -299,12 +244,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free(_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   x_mul_abs_voice_t *ret = malloc(sizeof(x_mul_abs_voice_t));
+   x_mul_abs_voice_t *ret = Dstplugin_alloc(_info, sizeof(x_mul_abs_voice_t));
    if(NULL != ret)
    {
       memset(ret, 0, sizeof(*ret));
@@ -313,8 +258,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(x_mul_abs_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free(_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -344,6 +295,7 @@ st_plugin_info_t *x_mul_abs_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -0,0 +1,308 @@
+// ----
+// ---- file   : xbus.h
+// ---- author : Bastian Spiegel <bs@tkscript.de>
+// ---- legal  : (c) 2026 by Bastian Spiegel.
+// ----          Distributed under terms of the GNU LESSER GENERAL PUBLIC LICENSE (LGPL). See
+// ----          http://www.gnu.org/licenses/licenses.html#LGPL or COPYING for further information.
+// ----
+// ---- info   : voice bus combine kernel (x_mix, x_mul, x_min, x_max, x_mul_abs)
+// ----
+// ---- created: 17Oct2026
+// ---- changed:
+// ----
+// ----
+// ----
+
+#ifndef __ST_XBUS_H__
+#define __ST_XBUS_H__
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define ST_XBUS_SSE2  1
+#include <emmintrin.h>
+#endif
+
+// Combine operations and their (per-sample-frame interpolated) parameters
+//  - ramp 0 is always the dry / wet amount
+#define ST_XBUS_OP_MIX      0  // 1=lvl_in 2=lvl_bus
+#define ST_XBUS_OP_MUL      1  // 1=lvl_in 2=lvl_bus 3=mix_in 4=mix_bus
+#define ST_XBUS_OP_MIN      2  // 1=lvl_in 2=lvl_bus 3=mix_in 4=mix_bus 5=out_in 6=out_bus
+#define ST_XBUS_OP_MAX      3  // 1=lvl_in 2=lvl_bus 3=mix_in 4=mix_bus 5=out_in 6=out_bus
+#define ST_XBUS_OP_MUL_ABS  4  // 1=bus_drive 2=offset 3=abs 4=blend 5=drive
+
+#define ST_XBUS_RAMP_DRYWET  0
+#define ST_XBUS_MAX_RAMPS    7
+
+typedef struct st_xbus_ramp_s {
+   float cur;
+   float inc;  // per sample frame
+} st_xbus_ramp_t;
+
+static inline unsigned int st_xbus_num_ramps(const int _op) {
+   switch(_op)
+   {
+      default:
+      case ST_XBUS_OP_MIX:     return 3u;
+      case ST_XBUS_OP_MUL:     return 5u;
+      case ST_XBUS_OP_MIN:
+      case ST_XBUS_OP_MAX:     return 7u;
+      case ST_XBUS_OP_MUL_ABS: return 6u;
+   }
+}
+
+// Calc one stereo sample frame (_p: current ramp values)
+static inline void st_xbus_frame(const int    _op,
+                                 const float *_p,
+                                 const float  _l,
+                                 const float  _r,
+                                 const float  _busL,
+                                 const float  _busR,
+                                 float       *_retL,
+                                 float       *_retR
+                                 ) {
+   float outL;
+   float outR;
+   switch(_op)
+   {
+      default:
+      case ST_XBUS_OP_MIX:
+         outL = _l * _p[1] + _busL * _p[2];
+         outR = _r * _p[1] + _busR * _p[2];
+         break;
+
+      case ST_XBUS_OP_MUL:
+         // (note) left input is multiplied by the right bus channel (same as the original x_mul implementation)
+         outL = (_l * _p[1]) * (_busR * _p[2]) + (_l * _p[3]) + (_busL * _p[4]);
+         outR = (_r * _p[1]) * (_busR * _p[2]) + (_r * _p[3]) + (_busR * _p[4]);
+         break;
+
+      case ST_XBUS_OP_MIN:
+         outL = ((_l * _p[1]) < (_busL * _p[2])) ? (_l * _p[5]) : (_busL * _p[6]);
+         outR = ((_r * _p[1]) < (_busR * _p[2])) ? (_r * _p[5]) : (_busR * _p[6]);
+         outL = outL + (_l * _p[3]) + (_busL * _p[4]);
+         outR = outR + (_r * _p[3]) + (_busR * _p[4]);
+         break;
+
+      case ST_XBUS_OP_MAX:
+         // (note) mixes in the left and right input (not the bus) (same as the original x_max implementation)
+         outL = ((_l * _p[1]) > (_busL * _p[2])) ? (_l * _p[5]) : (_busL * _p[6]);
+         outR = ((_r * _p[1]) > (_busR * _p[2])) ? (_r * _p[5]) : (_busR * _p[6]);
+         outL = outL + (_l * _p[3]) + (_r * _p[4]);
+         outR = outR + (_l * _p[3]) + (_r * _p[4]);
+         break;
+
+      case ST_XBUS_OP_MUL_ABS:
+      {
+         float offBusL = (_busL + _p[2]) * _p[1];
+         float offBusR = (_busR + _p[2]) * _p[1];
+         outL = offBusL + (fabsf(offBusL) - offBusL) * _p[3];
+         outR = offBusR + (fabsf(offBusR) - offBusR) * _p[3];
+         outL = outL + (outL * fabsf(_busL) - outL) * _p[4];
+         outR = outR + (outR * fabsf(_busR) - outR) * _p[4];
+         outL *= _l * _p[5];
+         outR *= _r * _p[5];
+      }
+      break;
+   }
+
+   outL = _l + (outL - _l) * _p[ST_XBUS_RAMP_DRYWET];
+   outR = _r + (outR - _r) * _p[ST_XBUS_RAMP_DRYWET];
+   *_retL = Dstplugin_fix_denorm_32(outL);
+   *_retR = Dstplugin_fix_denorm_32(outR);
+}
+
+// Returns 1 when all bus samples are (+-)0
+static inline int st_xbus_is_silent(const float *_bus, const unsigned int _numSamples) {
+   unsigned int i = 0u;
+#ifdef ST_XBUS_SSE2
+   __m128i acc = _mm_setzero_si128();
+   for(; (i + 4u) <= _numSamples; i += 4u)
+      acc = _mm_or_si128(acc, _mm_castps_si128(_mm_loadu_ps(_bus + i)));
+   acc = _mm_and_si128(acc, _mm_set1_epi32(0x7FFFffff));
+   if(0xFFFF != _mm_movemask_epi8(_mm_cmpeq_epi32(acc, _mm_setzero_si128())))
+      return 0;
+#endif // ST_XBUS_SSE2
+   for(; i < _numSamples; i++)
+   {
+      if(0.0f != _bus[i])
+         return 0;
+   }
+   return 1;
+}
+
+// Combine interleaved stereo input and voice bus samples
+//  - _op is a compile time constant in the x_* plugins (=> the switch()es are resolved when this is inlined)
+//  - _bMonoIn: only the left input channel is read (l=r)
+//  - no-op (input copy) when the dry / wet amount is 0 during the entire block
+//  - MIX / MUL: input-only path (no bus reads) when the bus is silent
+//  - SSE2: 2 stereo frames per iteration
+//     (lanes hold the ramp values of frames n and n+1, advanced by 2*inc => ulp-level differences to the per-frame ramps)
+static inline void st_xbus_process(const int       _op,
+                                   st_xbus_ramp_t *_ramps,
+                                   int             _bMonoIn,
+                                   const float    *_samplesIn,
+                                   const float    *_samplesBus,
+                                   float          *_samplesOut,
+                                   unsigned int    _numFrames,
+                                   const int       _bAdd,
+                                   const float     _gain
+                                   ) {
+   const unsigned int numRamps = st_xbus_num_ramps(_op);
+   unsigned int k = 0u;
+   unsigned int j;
+
+   if(0.0f == _ramps[ST_XBUS_RAMP_DRYWET].cur && 0.0f == _ramps[ST_XBUS_RAMP_DRYWET].inc)
+   {
+      // Dry only
+      for(unsigned int i = 0u; i < _numFrames; i++)
+      {
+         const float l = _samplesIn[k];
+         const float r = _bMonoIn ? l : _samplesIn[k + 1u];
+         Dstplugin_out(_bAdd, _samplesOut[k],      l, _gain);
+         Dstplugin_out(_bAdd, _samplesOut[k + 1u], r, _gain);
+         k += 2u;
+      }
+      for(j = 1u; j < numRamps; j++)
+         _ramps[j].cur += _ramps[j].inc * _numFrames;
+      return;
+   }
+
+   if((ST_XBUS_OP_MIX == _op || ST_XBUS_OP_MUL == _op) && st_xbus_is_silent(_samplesBus, _numFrames * 2u))
+   {
+      // Silent bus: wet = in * lvl_in (MIX) / in * mix_in (MUL)
+      const unsigned int rampIdx = (ST_XBUS_OP_MIX == _op) ? 1u : 3u;
+      float amt    = _ramps[rampIdx].cur;
+      float drywet = _ramps[ST_XBUS_RAMP_DRYWET].cur;
+      for(unsigned int i = 0u; i < _numFrames; i++)
+      {
+         const float l = _samplesIn[k];
+         const float r = _bMonoIn ? l : _samplesIn[k + 1u];
+         float outL = l + (l * amt - l) * drywet;
+         float outR = r + (r * amt - r) * drywet;
+         outL = Dstplugin_fix_denorm_32(outL);
+         outR = Dstplugin_fix_denorm_32(outR);
+         Dstplugin_out(_bAdd, _samplesOut[k],      outL, _gain);
+         Dstplugin_out(_bAdd, _samplesOut[k + 1u], outR, _gain);
+         k += 2u;
+         amt    += _ramps[rampIdx].inc;
+         drywet += _ramps[ST_XBUS_RAMP_DRYWET].inc;
+      }
+      for(j = 0u; j < numRamps; j++)
+         _ramps[j].cur += _ramps[j].inc * _numFrames;
+      return;
+   }
+
+   unsigned int frameIdx = 0u;
+
+#ifdef ST_XBUS_SSE2
+   if(_numFrames >= 2u)
+   {
+      __m128 p[ST_XBUS_MAX_RAMPS];
+      __m128 pInc[ST_XBUS_MAX_RAMPS];
+      for(j = 0u; j < numRamps; j++)
+      {
+         const float c = _ramps[j].cur;
+         const float d = _ramps[j].inc;
+         p[j]    = _mm_setr_ps(c, c, c + d, c + d);  // l0 r0 l1 r1
+         pInc[j] = _mm_set1_ps(d + d);
+      }
+      const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFffff));
+      const __m128 vGain   = _mm_set1_ps(_gain);
+      const __m128 c10     = _mm_set1_ps(10.0f);
+
+      for(; (frameIdx + 2u) <= _numFrames; frameIdx += 2u)
+      {
+         __m128 in = _mm_loadu_ps(_samplesIn + k);
+         if(_bMonoIn)
+            in = _mm_shuffle_ps(in, in, _MM_SHUFFLE(2,2,0,0));
+         const __m128 bus = _mm_loadu_ps(_samplesBus + k);
+         __m128 out;
+
+         switch(_op)
+         {
+            default:
+            case ST_XBUS_OP_MIX:
+               out = _mm_add_ps(_mm_mul_ps(in, p[1]), _mm_mul_ps(bus, p[2]));
+               break;
+
+            case ST_XBUS_OP_MUL:
+            {
+               const __m128 busRR = _mm_shuffle_ps(bus, bus, _MM_SHUFFLE(3,3,1,1));
+               out = _mm_mul_ps(_mm_mul_ps(in, p[1]), _mm_mul_ps(busRR, p[2]));
+               out = _mm_add_ps(out, _mm_mul_ps(in, p[3]));
+               out = _mm_add_ps(out, _mm_mul_ps(bus, p[4]));
+            }
+            break;
+
+            case ST_XBUS_OP_MIN:
+            case ST_XBUS_OP_MAX:
+            {
+               const __m128 inAmp  = _mm_mul_ps(in,  p[1]);
+               const __m128 busAmp = _mm_mul_ps(bus, p[2]);
+               const __m128 m = (ST_XBUS_OP_MIN == _op) ? _mm_cmplt_ps(inAmp, busAmp) : _mm_cmpgt_ps(inAmp, busAmp);
+               out = _mm_or_ps(_mm_and_ps   (m, _mm_mul_ps(in,  p[5])),
+                               _mm_andnot_ps(m, _mm_mul_ps(bus, p[6]))
+                               );
+               if(ST_XBUS_OP_MIN == _op)
+               {
+                  out = _mm_add_ps(out, _mm_mul_ps(in,  p[3]));
+                  out = _mm_add_ps(out, _mm_mul_ps(bus, p[4]));
+               }
+               else
+               {
+                  const __m128 inLL = _mm_shuffle_ps(in, in, _MM_SHUFFLE(2,2,0,0));
+                  const __m128 inRR = _mm_shuffle_ps(in, in, _MM_SHUFFLE(3,3,1,1));
+                  out = _mm_add_ps(out, _mm_mul_ps(inLL, p[3]));
+                  out = _mm_add_ps(out, _mm_mul_ps(inRR, p[4]));
+               }
+            }
+            break;
+
+            case ST_XBUS_OP_MUL_ABS:
+            {
+               const __m128 offBus = _mm_mul_ps(_mm_add_ps(bus, p[2]), p[1]);
+               out = _mm_add_ps(offBus, _mm_mul_ps(_mm_sub_ps(_mm_and_ps(offBus, absMask), offBus), p[3]));
+               out = _mm_add_ps(out, _mm_mul_ps(_mm_sub_ps(_mm_mul_ps(out, _mm_and_ps(bus, absMask)), out), p[4]));
+               out = _mm_mul_ps(out, _mm_mul_ps(in, p[5]));
+            }
+            break;
+         }
+
+         out = _mm_add_ps(in, _mm_mul_ps(_mm_sub_ps(out, in), p[ST_XBUS_RAMP_DRYWET]));
+         out = _mm_sub_ps(_mm_add_ps(out, c10), c10);  // Dstplugin_fix_denorm_32()
+
+         if(_bAdd)
+            _mm_storeu_ps(_samplesOut + k, _mm_add_ps(_mm_loadu_ps(_samplesOut + k), _mm_mul_ps(out, vGain)));
+         else
+            _mm_storeu_ps(_samplesOut + k, out);
+
+         // Next 2 frames
+         k += 4u;
+         for(j = 0u; j < numRamps; j++)
+            p[j] = _mm_add_ps(p[j], pInc[j]);
+      }
+
+      for(j = 0u; j < numRamps; j++)
+         _ramps[j].cur = _mm_cvtss_f32(p[j]);
+   }
+#endif // ST_XBUS_SSE2
+
+   // Remaining frame(s) (or scalar fallback)
+   for(; frameIdx < _numFrames; frameIdx++)
+   {
+      float p[ST_XBUS_MAX_RAMPS];
+      float outL, outR;
+      for(j = 0u; j < numRamps; j++)
+         p[j] = _ramps[j].cur;
+      const float l = _samplesIn[k];
+      const float r = _bMonoIn ? l : _samplesIn[k + 1u];
+      st_xbus_frame(_op, p, l, r, _samplesBus[k], _samplesBus[k + 1u], &outL, &outR);
+      Dstplugin_out(_bAdd, _samplesOut[k],      outL, _gain);
+      Dstplugin_out(_bAdd, _samplesOut[k + 1u], outR, _gain);
+      k += 2u;
+      for(j = 0u; j < numRamps; j++)
+         _ramps[j].cur += _ramps[j].inc;
+   }
+}
+
+
+#endif // __ST_XBUS_H__
@@ -12,7 +12,7 @@
 // ---- info   : ring modulator (voicebus crossmod version)
 // ----
 // ---- created: 06Jun2020
-// ---- changed: 08Jun2020, 09Jun2020, 19Jan2024, 21Jan2024, 19Sep2024
+// ---- changed: 08Jun2020, 09Jun2020, 19Jan2024, 21Jan2024, 19Sep2024, 16Oct2026
 // ----
 // ----
 // ----
@@ -413,7 +413,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   je_x_ringmod_shared_t *ret = (je_x_ringmod_shared_t *)malloc(sizeof(je_x_ringmod_shared_t));
+   je_x_ringmod_shared_t *ret = (je_x_ringmod_shared_t *)Dstplugin_alloc(_info, sizeof(je_x_ringmod_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -424,12 +424,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   je_x_ringmod_voice_t *ret = (je_x_ringmod_voice_t *)malloc(sizeof(je_x_ringmod_voice_t));
+   je_x_ringmod_voice_t *ret = (je_x_ringmod_voice_t *)Dstplugin_alloc(_info, sizeof(je_x_ringmod_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -438,8 +438,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(je_x_ringmod_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -475,6 +481,7 @@ st_plugin_info_t *je_x_ringmod_init(unsigned int  _outputMode,
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -13,7 +13,7 @@
 // ----           see <http://smc2017.aalto.fi/media/materials/proceedings/SMC17_p336.pdf>
 // ----
 // ---- created: 07Jun2020
-// ---- changed: 08Jun2020, 01Nov2021, 21Jan2024, 19Sep2024
+// ---- changed: 08Jun2020, 01Nov2021, 21Jan2024, 19Sep2024, 16Oct2026
 // ----
 // ----
 // ----
@@ -400,7 +400,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   je_wavefolder_shared_t *ret = (je_wavefolder_shared_t *)malloc(sizeof(je_wavefolder_shared_t));
+   je_wavefolder_shared_t *ret = (je_wavefolder_shared_t *)Dstplugin_alloc(_info, sizeof(je_wavefolder_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -411,12 +411,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   je_wavefolder_voice_t *ret = (je_wavefolder_voice_t *)malloc(sizeof(je_wavefolder_voice_t));
+   je_wavefolder_voice_t *ret = (je_wavefolder_voice_t *)Dstplugin_alloc(_info, sizeof(je_wavefolder_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -427,8 +427,18 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(je_wavefolder_voice_t);
+   (void)_voiceIdx;
+   voice->wf_l.~je_wavefolder_state_t();
+   voice->wf_r.~je_wavefolder_state_t();
+   Dstplugin_voice_clear(voice);
+   new(&voice->wf_l)je_wavefolder_state_t();
+   new(&voice->wf_r)je_wavefolder_state_t();
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -459,6 +469,7 @@ st_plugin_info_t *je_wavefolder_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -11,7 +11,8 @@
 #endif
 #include "functions.h"
 
-#define RS_BUFFER_SIZE 512
+// max. oversample * quality (Decimator / Upsampler kernels), see Resampler
+#define RS_BUFFER_SIZE 128
 #define UPSAMPLE_COMPENSATION 1.3
 
 
@@ -102,7 +103,16 @@ struct Decimator {
     double cutoff = 0.65;
 
 
+    Decimator() {
+    }
+
+
     Decimator(int oversample, int quality) {
+        init(oversample, quality);
+    }
+
+
+    void init(int oversample, int quality) {
         Decimator::oversample = oversample;
         Decimator::quality = quality;
 
@@ -145,7 +155,16 @@ struct Upsampler {
     double cutoff = 0.65;
 
 
+    Upsampler() {
+    }
+
+
     Upsampler(int oversample, int quality) {
+        init(oversample, quality);
+    }
+
+
+    void init(int oversample, int quality) {
         Upsampler::oversample = oversample;
         Upsampler::quality = quality;
 
@@ -197,8 +216,9 @@ struct Resampler {
     double up[CHANNELS][RS_BUFFER_SIZE] = {};
     double data[CHANNELS][RS_BUFFER_SIZE] = {};
 
-    Decimator *decimator[CHANNELS];
-    Upsampler *interpolator[CHANNELS];
+    // (note) embedded (no heap allocations)
+    Decimator decimator[CHANNELS];
+    Upsampler interpolator[CHANNELS];
 
     int oversample;
 
@@ -211,8 +231,8 @@ struct Resampler {
         Resampler::oversample = oversample;
 
         for (int i = 0; i < CHANNELS; i++) {
-            decimator[i] = new Decimator(oversample, quality);
-            interpolator[i] = new Upsampler(oversample, quality);
+            decimator[i].init(oversample, quality);
+            interpolator[i].init(oversample, quality);
         }
     }
 
@@ -236,7 +256,7 @@ struct Resampler {
      * @brief Create up-sampled data out of two basic values
      */
     void doUpsample(int channel, double in) {
-        interpolator[channel]->process(in * UPSAMPLE_COMPENSATION, up[channel]);
+        interpolator[channel].process(in * UPSAMPLE_COMPENSATION, up[channel]);
         /*  y[channel].y0 = y[channel].y1;
           y[channel].y1 = in;
 
@@ -252,7 +272,7 @@ struct Resampler {
      * @return Downsampled point
      */
     double getDownsampled(int channel) {
-        return decimator[channel]->process(data[channel]);
+        return decimator[channel].process(data[channel]);
     }
 
 
@@ -42,14 +42,9 @@ float DiodeLadderStage::getFeedbackOutput() {
 }
 
 
-DiodeLadderFilter::DiodeLadderFilter(float sr) : DSPEffect(sr) {
-    lpf1 = new DiodeLadderStage(sr);
-    lpf2 = new DiodeLadderStage(sr);
-    lpf3 = new DiodeLadderStage(sr);
-    lpf4 = new DiodeLadderStage(sr);
-
-    rs = new Resampler<1>(OVERSAMPLE, 4);
-
+DiodeLadderFilter::DiodeLadderFilter(float sr) : DSPEffect(sr),
+                                                  lpf1(sr), lpf2(sr), lpf3(sr), lpf4(sr),
+                                                  rs(OVERSAMPLE, 4) {
     gamma = 0.f;
     k = 0.f;
     saturation = 1.f;
@@ -59,15 +54,15 @@ DiodeLadderFilter::DiodeLadderFilter(float sr) : DSPEffect(sr) {
     sg3 = 0.f;
     sg4 = 0.f;
 
-    lpf1->gain = 1.f;
-    lpf2->gain = 0.5f;
-    lpf3->gain = 0.5f;
-    lpf4->gain = 0.5f;
+    lpf1.gain = 1.f;
+    lpf2.gain = 0.5f;
+    lpf3.gain = 0.5f;
+    lpf4.gain = 0.5f;
 
-    lpf4->gamma = 1.f;
-    lpf4->delta = 0.f;
-    lpf4->epsilon = 0.f;
-    lpf4->setFeedback(0.f);
+    lpf4.gamma = 1.f;
+    lpf4.delta = 0.f;
+    lpf4.epsilon = 0.f;
+    lpf4.setFeedback(0.f);
 }
 
 
@@ -103,27 +98,27 @@ void DiodeLadderFilter::invalidate() {
     sg3 = G4;
     sg4 = 1.0f;
 
-    lpf1->alpha = g / (1.0f + g);
-    lpf2->alpha = g / (1.0f + g);
-    lpf3->alpha = g / (1.0f + g);
-    lpf4->alpha = g / (1.0f + g);
+    lpf1.alpha = g / (1.0f + g);
+    lpf2.alpha = g / (1.0f + g);
+    lpf3.alpha = g / (1.0f + g);
+    lpf4.alpha = g / (1.0f + g);
 
-    lpf1->beta = 1.0f / (1.0f + g - g * G2);
-    lpf2->beta = 1.0f / (1.0f + g - 0.5f * g * G3);
-    lpf3->beta = 1.0f / (1.0f + g - 0.5f * g * G4);
-    lpf4->beta = 1.0f / (1.0f + g);
+    lpf1.beta = 1.0f / (1.0f + g - g * G2);
+    lpf2.beta = 1.0f / (1.0f + g - 0.5f * g * G3);
+    lpf3.beta = 1.0f / (1.0f + g - 0.5f * g * G4);
+    lpf4.beta = 1.0f / (1.0f + g);
 
-    lpf1->gamma = 1.0f + G1 * G2;
-    lpf2->gamma = 1.0f + G2 * G3;
-    lpf3->gamma = 1.0f + G3 * G4;
+    lpf1.gamma = 1.0f + G1 * G2;
+    lpf2.gamma = 1.0f + G2 * G3;
+    lpf3.gamma = 1.0f + G3 * G4;
 
-    lpf1->delta = g;
-    lpf2->delta = 0.5f * g;
-    lpf3->delta = 0.5f * g;
+    lpf1.delta = g;
+    lpf2.delta = 0.5f * g;
+    lpf3.delta = 0.5f * g;
 
-    lpf1->epsilon = G2;
-    lpf2->epsilon = G3;
-    lpf3->epsilon = G4;
+    lpf1.epsilon = G2;
+    lpf2.epsilon = G3;
+    lpf3.epsilon = G4;
 }
 
 
@@ -137,14 +132,14 @@ void DiodeLadderFilter::process() {
 
 
 void DiodeLadderFilter::process1() {
-    lpf3->setFeedback(lpf4->getFeedbackOutput());
-    lpf2->setFeedback(lpf3->getFeedbackOutput());
-    lpf1->setFeedback(lpf2->getFeedbackOutput());
+    lpf3.setFeedback(lpf4.getFeedbackOutput());
+    lpf2.setFeedback(lpf3.getFeedbackOutput());
+    lpf1.setFeedback(lpf2.getFeedbackOutput());
 
-    float sigma = sg1 * lpf1->getFeedbackOutput() +
-                  sg2 * lpf2->getFeedbackOutput() +
-                  sg3 * lpf3->getFeedbackOutput() +
-                  sg4 * lpf4->getFeedbackOutput();
+    float sigma = sg1 * lpf1.getFeedbackOutput() +
+                  sg2 * lpf2.getFeedbackOutput() +
+                  sg3 * lpf3.getFeedbackOutput() +
+                  sg4 * lpf4.getFeedbackOutput();
 
     float y = (1.0f / fastatan(saturation)) * fastatan(saturation * in);
 
@@ -154,34 +149,34 @@ void DiodeLadderFilter::process1() {
 
     u = fastatan(u / FEEDBACK_LIMITER_GAIN) * FEEDBACK_LIMITER_GAIN; // limit feedback gain of resonance
 
-    lpf1->in = u;
-    lpf1->process();
+    lpf1.in = u;
+    lpf1.process();
 
-    lpf2->in = lpf1->out;
-    lpf2->process();
+    lpf2.in = lpf1.out;
+    lpf2.process();
 
-    lpf3->in = lpf2->out;
-    lpf3->process();
+    lpf3.in = lpf2.out;
+    lpf3.process();
 
-    lpf4->in = lpf3->out;
-    lpf4->process();
+    lpf4.in = lpf3.out;
+    lpf4.process();
 
-    out2 = tanh(u - lpf4->out);
-    out = tanh(lpf4->out);
+    out2 = tanh(u - lpf4.out);
+    out = tanh(lpf4.out);
 }
 
 
 void DiodeLadderFilter::process2() {
-    rs->doUpsample(IN, in);
-    for (int i = 0; i < rs->getFactor(); i++) {
-        in = (float) rs->getUpsampled(IN)[i];
+    rs.doUpsample(IN, in);
+    for (int i = 0; i < rs.getFactor(); i++) {
+        in = (float) rs.getUpsampled(IN)[i];
 
         process1();
 
-        rs->data[IN][i] = out;
+        rs.data[IN][i] = out;
     }
 
-    out = (float) rs->getDownsampled(IN);;
+    out = (float) rs.getDownsampled(IN);;
 }
 
 
@@ -189,10 +184,10 @@ void DiodeLadderFilter::setSamplerate(float sr) {
     DSPEffect::setSamplerate(sr);
 
     /* set samplerate for all submodules */
-    lpf1->setSamplerate(sr);
-    lpf2->setSamplerate(sr);
-    lpf3->setSamplerate(sr);
-    lpf4->setSamplerate(sr);
+    lpf1.setSamplerate(sr);
+    lpf2.setSamplerate(sr);
+    lpf3.setSamplerate(sr);
+    lpf4.setSamplerate(sr);
 }
 
 
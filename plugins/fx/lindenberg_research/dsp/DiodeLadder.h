@@ -51,9 +51,9 @@ struct DiodeLadderFilter : DSPEffect {
 
     float fc, k, saturation, freqHz;
 
-    DiodeLadderStage *lpf1, *lpf2, *lpf3, *lpf4;
+    DiodeLadderStage lpf1, lpf2, lpf3, lpf4;
     Noise noise;
-    Resampler<1> *rs;
+    Resampler<1> rs;
 
     bool low = false;
 
@@ -87,15 +87,15 @@ struct DiodeLadderFilter : DSPEffect {
 
 
     void reset() {
-        lpf1->resetZ1();
-        lpf2->resetZ1();
-        lpf3->resetZ1();
-        lpf4->resetZ1();
-
-        lpf1->setFeedback(0.f);
-        lpf2->setFeedback(0.f);
-        lpf3->setFeedback(0.f);
-        lpf4->setFeedback(0.f);
+        lpf1.resetZ1();
+        lpf2.resetZ1();
+        lpf3.resetZ1();
+        lpf4.resetZ1();
+
+        lpf1.setFeedback(0.f);
+        lpf2.setFeedback(0.f);
+        lpf3.setFeedback(0.f);
+        lpf4.setFeedback(0.f);
     }
 };
 
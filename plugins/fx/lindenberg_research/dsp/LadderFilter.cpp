@@ -20,10 +20,10 @@ void LadderFilter::invalidate() {
  * @return
  */
 void LadderFilter::process() {
-    rs->doUpsample(LOWPASS, in);
+    rs.doUpsample(LOWPASS, in);
 
-    for (int i = 0; i < rs->getFactor(); i++) {
-        float x = (float)rs->getUpsampled(LOWPASS)[i];
+    for (int i = 0; i < rs.getFactor(); i++) {
+        float x = (float)rs.getUpsampled(LOWPASS)[i];
 
         // non linear feedback with nice saturation
         x -= fastatan(bx * q);
@@ -58,10 +58,10 @@ void LadderFilter::process() {
 
 
         // overdrive with fast atan, which folds back the waves at high input and creates a noisy bright sound
-        rs->data[LOWPASS][i] = fastatan(y);
+        rs.data[LOWPASS][i] = fastatan(y);
     }
 
-    lpOut = (float)rs->getDownsampled(LOWPASS) * (INPUT_GAIN / (drive * 20.0f + 1.0f) * (quadraticBipolar(drive * 3.0f) + 1));
+    lpOut = (float)rs.getDownsampled(LOWPASS) * (INPUT_GAIN / (drive * 20.0f + 1.0f) * (quadraticBipolar(drive * 3.0f) + 1));
 }
 
 
@@ -210,6 +210,5 @@ void LadderFilter::setLightValue(float lightValue) {
 }
 
 
-LadderFilter::LadderFilter(float sr) : DSPEffect(sr) {
-    rs = new Resampler<1>(OVERSAMPLE, 8);
+LadderFilter::LadderFilter(float sr) : DSPEffect(sr), rs(OVERSAMPLE, 8) {
 }
@@ -25,7 +25,7 @@ private:
     float in, lpOut;
     float lightValue;
 
-    Resampler<1> *rs;
+    Resampler<1> rs;
     Noise noise;
 
     void updateResExp();
@@ -25,15 +25,15 @@ void MS20zdf::invalidate() {
  */
 void MS20zdf::process() {
     //rs.next(IN, input[IN].value);
-    rs->doUpsample(IN, input[IN].value);
+    rs.doUpsample(IN, input[IN].value);
 
     float s1, s2;
     float gain = quadraticBipolar(param[DRIVE].value) * DRIVE_GAIN + 1.f;
     float type = param[TYPE].value;
     float x = 0;
 
-    for (int i = 0; i < rs->getFactor(); i++) {
-        x = (float)rs->getUpsampled(IN)[i];
+    for (int i = 0; i < rs.getFactor(); i++) {
+        x = (float)rs.getUpsampled(IN)[i];
 
         zdf1.set(x - ky, g);
         s1 = zdf1.s;
@@ -46,14 +46,14 @@ void MS20zdf::process() {
         ky = k * fastatan(y / 70.f) * 70.f;
 
         if (type > 0) {
-            rs->data[IN][i] = atanShaper(gain * y / 10.f) * 10.f;
+            rs.data[IN][i] = atanShaper(gain * y / 10.f) * 10.f;
         } else {
-            rs->data[IN][i] = fastatan(gain * y / 10.f) * 10.f;
+            rs.data[IN][i] = fastatan(gain * y / 10.f) * 10.f;
 
         }
     }
 
-    float out = (float)rs->getDownsampled(IN);
+    float out = (float)rs.getDownsampled(IN);
 
     output[OUT].value = out;
 }
@@ -63,7 +63,6 @@ void MS20zdf::process() {
  * @brief Inherit constructor
  * @param sr sample rate
  */
-MS20zdf::MS20zdf(float sr) : DSPSystem(sr) {
-    rs = new Resampler<1>(OVERSAMPLE, 8);
+MS20zdf::MS20zdf(float sr) : DSPSystem(sr), rs(OVERSAMPLE, 8) {
 }
 
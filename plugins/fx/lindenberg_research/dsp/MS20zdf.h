@@ -70,7 +70,7 @@ private:
     float freqHz = 0;
 
     MS20ZDF zdf1, zdf2;
-    Resampler<1> *rs;
+    Resampler<1> rs;
 
 public:
     explicit MS20zdf(float sr);
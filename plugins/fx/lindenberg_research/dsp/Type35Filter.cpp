@@ -92,12 +92,12 @@ void dsp::Type35Filter::init() {
 
 
     /* lowpass stages */
-    lpf1->init();
-    lpf2->init();
+    lpf1.init();
+    lpf2.init();
 
     /* highpass stages */
-    hpf1->init();
-    hpf2->init();
+    hpf1.init();
+    hpf2.init();
 }
 
 
@@ -127,20 +127,20 @@ void dsp::Type35Filter::invalidate() {
 
     if (type == HPF) {
         /* HIGHPASS */
-        lpf1->alpha = G;
-        hpf1->alpha = G;
-        hpf2->alpha = G;
+        lpf1.alpha = G;
+        hpf1.alpha = G;
+        hpf2.alpha = G;
 
-        hpf2->beta = -1.f * G / (1.f + g);
-        lpf1->beta = 1.f / (1.f + g);
+        hpf2.beta = -1.f * G / (1.f + g);
+        lpf1.beta = 1.f / (1.f + g);
     } else {
         /* LOWPASS */
-        lpf1->alpha = G;
-        lpf2->alpha = G;
-        hpf1->alpha = G;
+        lpf1.alpha = G;
+        lpf2.alpha = G;
+        hpf1.alpha = G;
 
-        lpf2->beta = (peak - peak * G) / (1.f + g);
-        hpf1->beta = -1.f / (1.f + g);
+        lpf2.beta = (peak - peak * G) / (1.f + g);
+        hpf1.beta = -1.f / (1.f + g);
     }
 
     Ga = 1.f / (1.f - peak * G + peak * G * G);
@@ -159,25 +159,25 @@ void dsp::Type35Filter::process() {
  * @brief Do the lowpass filtering and oversampling
  */
 void dsp::Type35Filter::processLPF() {
-    lpf1->in = in + noise.nextFloat(NOISE_GAIN);;
-    lpf1->process();
-    float y1 = lpf1->out;
+    lpf1.in = in + noise.nextFloat(NOISE_GAIN);;
+    lpf1.process();
+    float y1 = lpf1.out;
 
-    float s35h = hpf1->getFeedback() + lpf2->getFeedback();
+    float s35h = hpf1.getFeedback() + lpf2.getFeedback();
 
     float u = Ga * (y1 + s35h);
     //float y = peak * fastatan(sat * u * 0.1) * 10.f;
 
     u = fastatan(sat * u * 0.1f) * 10.f;
 
-    lpf2->in = u;
-    lpf2->process();
+    lpf2.in = u;
+    lpf2.process();
 
-    float y = peak * lpf2->out;
+    float y = peak * lpf2.out;
 
 
-    hpf1->in = y;
-    hpf1->process();
+    hpf1.in = y;
+    hpf1.process();
 
 
     if (peak > 0) {
@@ -192,20 +192,20 @@ void dsp::Type35Filter::processLPF() {
  * @brief Do the highpass filtering and oversampling
  */
 void dsp::Type35Filter::processHPF() {
-    hpf1->in = in + noise.nextFloat(NOISE_GAIN);
-    hpf1->process();
-    float y1 = hpf1->out;
+    hpf1.in = in + noise.nextFloat(NOISE_GAIN);
+    hpf1.process();
+    float y1 = hpf1.out;
 
-    float s35h = hpf2->getFeedback() + lpf1->getFeedback();
+    float s35h = hpf2.getFeedback() + lpf1.getFeedback();
 
     float u = Ga * (y1 + s35h);
     float y = peak * fastatan(sat * u * 0.1f) * 10.f;
 
-    hpf2->in = y;
-    hpf2->process();
+    hpf2.in = y;
+    hpf2.process();
 
-    lpf1->in = hpf2->out;
-    lpf1->process();
+    lpf1.in = hpf2.out;
+    lpf1.process();
 
     if (peak > 0) {
         y *= 1.f / peak; // normalize
@@ -223,10 +223,10 @@ void dsp::Type35Filter::setSamplerate(float sr) {
     DSPEffect::setSamplerate(sr * OVERSAMPLE);
 
     // derive samplerate change
-    lpf1->setSamplerate(sr * OVERSAMPLE);
-    lpf2->setSamplerate(sr * OVERSAMPLE);
-    hpf1->setSamplerate(sr * OVERSAMPLE);
-    hpf2->setSamplerate(sr * OVERSAMPLE);
+    lpf1.setSamplerate(sr * OVERSAMPLE);
+    lpf2.setSamplerate(sr * OVERSAMPLE);
+    hpf1.setSamplerate(sr * OVERSAMPLE);
+    hpf2.setSamplerate(sr * OVERSAMPLE);
 
     invalidate();
 }
@@ -236,15 +236,15 @@ void dsp::Type35Filter::setSamplerate(float sr) {
  * @brief Top function which handles the oversampling
  */
 void dsp::Type35Filter::process2() {
-    rs->doUpsample(IN, in);
+    rs.doUpsample(IN, in);
 
-    for (int i = 0; i < rs->getFactor(); i++) {
-        in = (float) rs->getUpsampled(IN)[i];
+    for (int i = 0; i < rs.getFactor(); i++) {
+        in = (float) rs.getUpsampled(IN)[i];
 
         process();
 
-        rs->data[IN][i] = out;
+        rs.data[IN][i] = out;
     }
 
-    out = (float) rs->getDownsampled(IN);;
+    out = (float) rs.getDownsampled(IN);;
 }
@@ -72,10 +72,10 @@ struct Type35Filter : DSPEffect {
     };
 
 
-    Type35FilterStage *lpf1, *lpf2, *hpf1, *hpf2;
+    Type35FilterStage lpf1, lpf2, hpf1, hpf2;
     FilterType type;
     Noise noise;
-    Resampler<1> *rs;
+    Resampler<1> rs;
 
     float Ga;
 
@@ -85,15 +85,13 @@ struct Type35Filter : DSPEffect {
     float fc, peak, sat;
 
 
-    Type35Filter(float sr, FilterType type) : DSPEffect(sr * OVERSAMPLE) {
+    Type35Filter(float sr, FilterType type) : DSPEffect(sr * OVERSAMPLE),
+                                              lpf1(sr * OVERSAMPLE, Type35FilterStage::LP_STAGE),
+                                              lpf2(sr * OVERSAMPLE, Type35FilterStage::LP_STAGE),
+                                              hpf1(sr * OVERSAMPLE, Type35FilterStage::HP_STAGE),
+                                              hpf2(sr * OVERSAMPLE, Type35FilterStage::HP_STAGE),
+                                              rs(OVERSAMPLE, 8) {
         Type35Filter::type = type;
-
-        rs = new Resampler<1>(OVERSAMPLE, 8);
-
-        lpf1 = new Type35FilterStage(sr * OVERSAMPLE, Type35FilterStage::LP_STAGE);
-        lpf2 = new Type35FilterStage(sr * OVERSAMPLE, Type35FilterStage::LP_STAGE);
-        hpf1 = new Type35FilterStage(sr * OVERSAMPLE, Type35FilterStage::HP_STAGE);
-        hpf2 = new Type35FilterStage(sr * OVERSAMPLE, Type35FilterStage::HP_STAGE);
     }
 
 
@@ -8,7 +8,7 @@
 // ----           (adapted for 'stfx' plugin API by bsp)
 // ----
 // ---- created: 07Jun2020
-// ---- changed: 21Jan2024
+// ---- changed: 21Jan2024, 16Oct2026
 // ----
 // ----
 // ----
@@ -334,7 +334,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   lrt_laika_shared_t *ret = (lrt_laika_shared_t *)malloc(sizeof(lrt_laika_shared_t));
+   lrt_laika_shared_t *ret = (lrt_laika_shared_t *)Dstplugin_alloc(_info, sizeof(lrt_laika_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -345,12 +345,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   lrt_laika_voice_t *ret = (lrt_laika_voice_t *)malloc(sizeof(lrt_laika_voice_t));
+   lrt_laika_voice_t *ret = (lrt_laika_voice_t *)Dstplugin_alloc(_info, sizeof(lrt_laika_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -361,11 +361,21 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(lrt_laika_voice_t);
+   (void)_voiceIdx;
+   voice->flt_l.~LaikaFilter();
+   voice->flt_r.~LaikaFilter();
+   Dstplugin_voice_clear(voice);
+   new(&voice->flt_l)LaikaFilter();
+   new(&voice->flt_r)LaikaFilter();
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
    ST_PLUGIN_VOICE_CAST(lrt_laika_voice_t);
    voice->flt_l.~LaikaFilter();
    voice->flt_r.~LaikaFilter();
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -394,6 +404,7 @@ st_plugin_info_t *lrt_laika_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
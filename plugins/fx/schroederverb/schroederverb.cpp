@@ -6,11 +6,12 @@
 // ----          http://www.gnu.org/licenses/licenses.html#LGPL or COPYING for further information.
 // ----
 // ---- info   : simple stereo reverb.
-// ----           - all voices share the same instance (=> don't alloc more than 1 voice)
+// ----           - all voices share the same instance (=> don't alloc more than 1 voice,
+// ----              or let the host sum the voices into a bus, see process_shared())
 // ----           - uses more than 8 (shared) parameters (55)
 // ----
 // ---- created: 28Jun2019
-// ---- changed: 07Jul2019, 08Jul2019, 10Jul2019, 12Jul2019, 20Apr2023, 21Jan2024
+// ---- changed: 07Jul2019, 08Jul2019, 10Jul2019, 12Jul2019, 20Apr2023, 21Jan2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -346,6 +347,14 @@ typedef struct schroederverb_shared_s {
    sF32 out_lpf;
    sF32 out_lvl;
 
+   // process_shared() parameter smoothing
+   sF32 bus_drywet_cur;
+   sF32 bus_in_amt_cur;
+   sUI  b_bus_started;
+
+   // tail tracker (the reverb state is shared by all voices, see loc_query_tail_state())
+   stplugin_tail_t tail;
+
 #ifdef USE_PRIME_LOCK
    PrimeLock prime_lock;
 #endif // USE_PRIME_LOCK
@@ -1021,6 +1030,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
                                       ) {
    ST_PLUGIN_VOICE_CAST(schroederverb_voice_t);
    ST_PLUGIN_VOICE_SHARED_CAST(schroederverb_shared_t);
+   Dstplugin_tail_reset(shared->tail);
    (void)_bGlide;
    (void)_note;
    (void)_vel;
@@ -1077,17 +1087,17 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    }
 }
 
-static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
-                                              int                 _bMonoIn,
-                                              const float        *_samplesIn,
-                                              float              *_samplesOut, 
-                                              unsigned int        _numFrames
-                                              ) {
-   // Ring modulate at (modulated) note frequency
-   ST_PLUGIN_VOICE_CAST(schroederverb_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(schroederverb_shared_t);
-   // return; // xxxxxxxxxx
-
+static inline void loc_process(schroederverb_shared_t *shared,
+                               int                     _bMonoIn,
+                               const float            *_samplesIn,
+                               float                  *_samplesOut,
+                               unsigned int            _numFrames,
+                               float                  &_dryWetCur,
+                               const float             _dryWetInc,
+                               float                  &_inAmtCur,
+                               const float             _inAmtInc,
+                               float                  &_peakWet
+                               ) {
    unsigned int kIn = 0u;
    unsigned int kOut = 0u;
 
@@ -1117,7 +1127,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          // printf("xxx f = %f\n", f);
 
          // // f = ch->ap_1.process(inSmp * in_amt + fO * x2_amt);  // v4
-         f = ch->ap_1.process(inSmp * voice->mod_in_amt_cur); // shared->in_amt
+         f = ch->ap_1.process(inSmp * _inAmtCur); // shared->in_amt
          f = ch->ap_2.process(f);
 
          sF32 fCb1 = ch->cb_1.process(f);
@@ -1140,11 +1150,12 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
          f = f - 10.0f;
 
          ch->last_out = ch->last_out * shared->x3_amt + f * shared->x4_amt;
+         Dstplugin_peak(_peakWet, f);
          f *= shared->wet_gain;
          sF32 lpf = ((ch->last_f + f) * 0.5f);
          ch->last_f = f;
          f = f + (lpf - f) * shared->out_lpf;
-         f  = inSmpRaw + ((f - inSmpRaw) * voice->mod_drywet_cur) * voice->mod_drywet_cur;  // wet_amt
+         f  = inSmpRaw + ((f - inSmpRaw) * _dryWetCur) * _dryWetCur;  // wet_amt
          
          _samplesOut[kOut++] = f * shared->out_lvl;
 
@@ -1153,14 +1164,81 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
       } // loop ch
 
-      voice->mod_drywet_cur += voice->mod_drywet_inc;
-      voice->mod_in_amt_cur += voice->mod_in_amt_inc;
+      _dryWetCur += _dryWetInc;
+      _inAmtCur  += _inAmtInc;
    } // loop frames
+}
+
+static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
+                                              int                 _bMonoIn,
+                                              const float        *_samplesIn,
+                                              float              *_samplesOut, 
+                                              unsigned int        _numFrames
+                                              ) {
+   ST_PLUGIN_VOICE_CAST(schroederverb_voice_t);
+   ST_PLUGIN_VOICE_SHARED_CAST(schroederverb_shared_t);
+
+   float peakIn = 0.0f;
+   Dstplugin_peak_buf(peakIn, _samplesIn, _numFrames * 2u);
+   float peakWet = 0.0f;
 
+   loc_process(shared, _bMonoIn, _samplesIn, _samplesOut, _numFrames,
+               voice->mod_drywet_cur, voice->mod_drywet_inc,
+               voice->mod_in_amt_cur, voice->mod_in_amt_inc,
+               peakWet
+               );
+
+   // (note) each voice steps the shared reverb, i.e. any voice with a non-silent input (or a ringing reverb) keeps all voices active
+   Dstplugin_tail_update(shared->tail, peakIn, peakWet, _numFrames);
+}
+
+static void ST_PLUGIN_API loc_process_shared(st_plugin_shared_t *_shared,
+                                             int                 _bMonoIn,
+                                             const float        *_samplesIn,
+                                             float              *_samplesOut,
+                                             unsigned int        _numFrames
+                                             ) {
+   // Summed voice bus: process reverb once per block (no per-voice modulation)
+   ST_PLUGIN_SHARED_CAST(schroederverb_shared_t);
+
+   float dryWet = Dstplugin_clamp(shared->wet_amt, 0.0f, 1.0f);
+   float inAmt  = Dstplugin_clamp(shared->in_amt,  0.0f, 1.0f);
+   if(!shared->b_bus_started)
+   {
+      shared->bus_drywet_cur = dryWet;
+      shared->bus_in_amt_cur = inAmt;
+      shared->b_bus_started  = 1u;
+   }
+
+   float dryWetInc = 0.0f;
+   float inAmtInc  = 0.0f;
+   if(_numFrames > 0u)
+   {
+      float recBlockSize = (1.0f / _numFrames);
+      dryWetInc = (dryWet - shared->bus_drywet_cur) * recBlockSize;
+      inAmtInc  = (inAmt  - shared->bus_in_amt_cur) * recBlockSize;
+   }
+
+   float peakIn = 0.0f;
+   Dstplugin_peak_buf(peakIn, _samplesIn, _numFrames * 2u);
+   float peakWet = 0.0f;
+   loc_process(shared, _bMonoIn, _samplesIn, _samplesOut, _numFrames,
+               shared->bus_drywet_cur, dryWetInc,
+               shared->bus_in_amt_cur, inAmtInc,
+               peakWet
+               );
+
+   Dstplugin_tail_update(shared->tail, peakIn, peakWet, _numFrames);
+}
+
+static unsigned int ST_PLUGIN_API loc_query_tail_state(st_plugin_voice_t *_voice) {
+   // (note) the reverb state is shared by all voices => report the shared tail state
+   ST_PLUGIN_VOICE_SHARED_CAST(schroederverb_shared_t);
+   return Dstplugin_tail_state(shared->tail);
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   schroederverb_shared_t *ret = (schroederverb_shared_t *)malloc(sizeof(schroederverb_shared_t));
+   schroederverb_shared_t *ret = (schroederverb_shared_t *)Dstplugin_alloc(_info, sizeof(schroederverb_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -1193,17 +1271,18 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
       ret->clip_lvl     = 1.0f;
       ret->dly_lerp_spd = 0.05f;
 
+      ret->tail.num_tail_frames = 5u * BUF_SIZE;  // ap_1 -> ap_2 -> cb_x -> ap_fb -> dly_x
    }
    return &ret->base;
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   schroederverb_voice_t *ret = (schroederverb_voice_t *)malloc(sizeof(schroederverb_voice_t));
+   schroederverb_voice_t *ret = (schroederverb_voice_t *)Dstplugin_alloc(_info, sizeof(schroederverb_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -1212,8 +1291,14 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(schroederverb_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -1235,7 +1320,7 @@ st_plugin_info_t *schroederverb_init(void) {
       ret->base.author      = "bsp";
       ret->base.name        = "schroederverb";
       ret->base.short_name  = "schroederverb";
-      ret->base.flags       = ST_PLUGIN_FLAG_FX;
+      ret->base.flags       = ST_PLUGIN_FLAG_FX | ST_PLUGIN_FLAG_SHARED_BUS;
       ret->base.category    = ST_PLUGIN_CAT_REVERB;
       ret->base.num_params  = NUM_PARAMS;
       ret->base.num_mods    = NUM_MODS;
@@ -1244,6 +1329,7 @@ st_plugin_info_t *schroederverb_init(void) {
       ret->base.shared_delete      = &loc_shared_delete;
       ret->base.voice_new          = &loc_voice_new;
       ret->base.voice_delete       = &loc_voice_delete;
+      ret->base.voice_reset        = &loc_voice_reset;
       ret->base.get_param_name     = &loc_get_param_name;
       ret->base.get_param_reset    = &loc_get_param_reset;
       ret->base.get_param_value    = &loc_get_param_value;
@@ -1254,6 +1340,8 @@ st_plugin_info_t *schroederverb_init(void) {
       ret->base.set_mod_value      = &loc_set_mod_value;
       ret->base.prepare_block      = &loc_prepare_block;
       ret->base.process_replace    = &loc_process_replace;
+      ret->base.query_tail_state   = &loc_query_tail_state;
+      ret->base.process_shared     = &loc_process_shared;
       ret->base.plugin_exit        = &loc_plugin_exit;
    }
 
@@ -27,7 +27,7 @@
 // ----           (adapted for 'stfx' plugin API by bsp)
 // ----
 // ---- created: 07Jun2020
-// ---- changed: 08Jun2020, 21Jan2024
+// ---- changed: 08Jun2020, 21Jan2024, 16Oct2026
 // ----
 // ----
 // ----
@@ -247,7 +247,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   sql_bootyshifter_pan_shared_t *ret = (sql_bootyshifter_pan_shared_t *)malloc(sizeof(sql_bootyshifter_pan_shared_t));
+   sql_bootyshifter_pan_shared_t *ret = (sql_bootyshifter_pan_shared_t *)Dstplugin_alloc(_info, sizeof(sql_bootyshifter_pan_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -258,12 +258,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   sql_bootyshifter_pan_voice_t *ret = (sql_bootyshifter_pan_voice_t *)malloc(sizeof(sql_bootyshifter_pan_voice_t));
+   sql_bootyshifter_pan_voice_t *ret = (sql_bootyshifter_pan_voice_t *)Dstplugin_alloc(_info, sizeof(sql_bootyshifter_pan_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -274,8 +274,18 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(sql_bootyshifter_pan_voice_t);
+   (void)_voiceIdx;
+   voice->fs_l.~FrequencyShifter();
+   voice->fs_r.~FrequencyShifter();
+   Dstplugin_voice_clear(voice);
+   new(&voice->fs_l)FrequencyShifter();
+   new(&voice->fs_r)FrequencyShifter();
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -304,6 +314,7 @@ st_plugin_info_t *sql_bootyshifter_pan_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -178,6 +178,37 @@ void Dattorro::clear() {
     rightOut = 0.0f;
 }
 
+// Return to the initial (constructor) state without reallocating the delay lines
+//  (note) parameters are expected to be updated by the caller before the next process() call
+void Dattorro::reset() {
+    clear();
+
+    _tankFeed = 0.0;
+    _decay = 0.0;
+    _freeze = false;
+    _fade = 1.0;
+    _fadeDir = 1.0;
+
+    _lfo1 = TriSawLFO();
+    _lfo2 = TriSawLFO();
+    _lfo3 = TriSawLFO();
+    _lfo4 = TriSawLFO();
+
+    _lfo1.setFrequency(_lfo1Freq);
+    _lfo2.setFrequency(_lfo2Freq);
+    _lfo3.setFrequency(_lfo3Freq);
+    _lfo4.setFrequency(_lfo4Freq);
+
+    _lfo2.phase = 0.25;
+    _lfo3.phase = 0.5;
+    _lfo4.phase = 0.75;
+
+    _lfo1.setRevPoint(0.5);
+    _lfo2.setRevPoint(0.5);
+    _lfo3.setRevPoint(0.5);
+    _lfo4.setRevPoint(0.5);
+}
+
 void Dattorro::setTimeScale(double timeScale) {
     _timeScale = timeScale;
     if(_timeScale < 0.0001) {
@@ -13,6 +13,7 @@ public:
     Dattorro();
     void process(double leftInput, double rightInput);
     void clear();
+    void reset();
     void setTimeScale(double timeScale);
     void setPreDelay(double time);
     void setModShape(double shape);
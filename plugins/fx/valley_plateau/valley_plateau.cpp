@@ -7,7 +7,7 @@
 //          Reference: Dattorro, J. (1997). Effect design part 1: Reverberator and other filters, J. Audio
 //          Eng. Soc, 45(9), 660-684."
 
-// 19Sep2024
+// 19Sep2024, 16Oct2026, 17Oct2026
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -22,6 +22,10 @@
 
 #include "Plateau/Dattorro.hpp"
 
+// Max. reverb tail (seconds) before the wet output is considered to have ended
+//  (max. pre-delay (1s) + input diffusers + tank loop at max. size, in 29761Hz Dattorro samples)
+#define TAIL_SEC  (1.0f + (904.0f + 21589.0f * 4.0f) / 29761.0f)
+
 
 #define PARAM_DRY                0
 #define PARAM_WET                1
@@ -137,6 +141,7 @@ typedef struct valley_plateau_voice_s {
    bool     frozen;
    bool     cleared;
    Dattorro reverb;
+   stplugin_tail_t tail;
 } valley_plateau_voice_t;
 
 
@@ -145,6 +150,7 @@ static void ST_PLUGIN_API loc_set_sample_rate(st_plugin_voice_t *_voice,
                                               ) {
    ST_PLUGIN_VOICE_CAST(valley_plateau_voice_t);
    voice->reverb.setSampleRate(_sampleRate);
+   voice->tail.num_tail_frames = (unsigned int)(_sampleRate * TAIL_SEC);
 }
 
 static const char *ST_PLUGIN_API loc_get_param_name(st_plugin_info_t *_info,
@@ -189,6 +195,7 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
                                       float               _vel
                                       ) {
    ST_PLUGIN_VOICE_CAST(valley_plateau_voice_t);
+   Dstplugin_tail_reset(voice->tail);
    (void)_bGlide;
    (void)_note;
    (void)_vel;
@@ -209,20 +216,15 @@ static void ST_PLUGIN_API loc_set_mod_value(st_plugin_voice_t *_voice,
    voice->mods[_modIdx] = _value;
 }
 
-static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
-                                            unsigned int       _numFrames,
-                                            float              _freqHz,
-                                            float              _note,
-                                            float              _vol,
-                                            float              _pan
-                                            ) {
-   ST_PLUGIN_VOICE_CAST(valley_plateau_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(valley_plateau_shared_t);
-   (void)_freqHz;
-   (void)_note;
-   (void)_vol;
-   (void)_pan;
-
+// Update reverb parameters (shared params + voice mods). Returns dry / wet amounts.
+static void loc_update_reverb(Dattorro    *_reverb,
+                              const float *_params,
+                              const float *_mods,
+                              bool        *_frozen,
+                              bool        *_cleared,
+                              float       *_retDry,
+                              float       *_retWet
+                              ) {
    // CV scaling
    // const float preDelayNormSens = 0.1f;
    // const float preDelayLowSens = 0.05f;
@@ -234,47 +236,47 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
    const float modShapeMin = 0.001f;
    const float modShapeMax = 0.999f;
 
-   float modDry = shared->params[PARAM_DRY] + voice->mods[MOD_DRY];
-   modDry = Dstplugin_clamp(modDry, 0.0f, 1.0f);
+   float modDry = _params[PARAM_DRY] + _mods[MOD_DRY];
+   *_retDry = Dstplugin_clamp(modDry, 0.0f, 1.0f);
 
-   float modWet = shared->params[PARAM_WET] + voice->mods[MOD_WET];
-   modWet = Dstplugin_clamp(modWet, 0.0f, 1.0f);
+   float modWet = _params[PARAM_WET] + _mods[MOD_WET];
+   *_retWet = Dstplugin_clamp(modWet, 0.0f, 1.0f);
 
-   float modFreeze = shared->params[PARAM_FREEZE_SW] + voice->mods[MOD_FREEZE_SW];
+   float modFreeze = _params[PARAM_FREEZE_SW] + _mods[MOD_FREEZE_SW];
    bool freeze = (modFreeze >= 0.5f);
-   if(freeze && !voice->frozen)
+   if(freeze && !*_frozen)
    {
-      voice->frozen = true;
-      voice->reverb.freeze();
+      *_frozen = true;
+      _reverb->freeze();
    }
-   else if(!freeze && voice->frozen)
+   else if(!freeze && *_frozen)
    {
-      voice->frozen = false;
-      voice->reverb.unFreeze();
+      *_frozen = false;
+      _reverb->unFreeze();
    }
 
-   float modClear = shared->params[PARAM_CLEAR_SW] + voice->mods[MOD_CLEAR_SW];
+   float modClear = _params[PARAM_CLEAR_SW] + _mods[MOD_CLEAR_SW];
    bool clear = (modClear >= 0.5f);
-   if(clear && !voice->cleared)
+   if(clear && !*_cleared)
    {
-      voice->cleared = true;
-      voice->reverb.clear();
+      *_cleared = true;
+      _reverb->clear();
    }
-   else if(!clear && voice->cleared)
+   else if(!clear && *_cleared)
    {
-      voice->cleared = false;
+      *_cleared = false;
    }
 
-   float modTuned = shared->params[PARAM_TUNED_SW] + voice->mods[MOD_TUNED_SW];
+   float modTuned = _params[PARAM_TUNED_SW] + _mods[MOD_TUNED_SW];
    bool tuned = (modTuned >= 0.5f);
 
-   float modPreDelay = shared->params[PARAM_PRE_DELAY] + voice->mods[MOD_PRE_DELAY];
+   float modPreDelay = _params[PARAM_PRE_DELAY] + _mods[MOD_PRE_DELAY];
    modPreDelay = Dstplugin_clamp(modPreDelay, 0.0f, 1.0f);
    float preDelay;
    preDelay = modPreDelay;
-   voice->reverb.setPreDelay(Dstplugin_clamp(preDelay, 0.f, 1.f));
+   _reverb->setPreDelay(Dstplugin_clamp(preDelay, 0.f, 1.f));
 
-   float modSize = shared->params[PARAM_SIZE] + voice->mods[MOD_SIZE];
+   float modSize = _params[PARAM_SIZE] + _mods[MOD_SIZE];
    modSize = Dstplugin_clamp(modSize, 0.0f, 1.0f);
    float size = modSize;
    if(tuned)
@@ -288,62 +290,84 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
       size = Dstplugin_scale(size, 0.01f, sizeMax);
       size = Dstplugin_clamp(size, 0.01f, sizeMax);
    }
-   voice->reverb.setTimeScale(size);
+   _reverb->setTimeScale(size);
 
-   float modDiffusion = shared->params[PARAM_DIFFUSION] + voice->mods[MOD_DIFFUSION];
+   float modDiffusion = _params[PARAM_DIFFUSION] + _mods[MOD_DIFFUSION];
    modDiffusion = Dstplugin_clamp(modDiffusion, 0.0f, 1.0f);
    float diffusion = modDiffusion;
-   voice->reverb.plateDiffusion1 = diffusion * 0.7f;
-   voice->reverb.plateDiffusion2 = diffusion * 0.5f;
+   _reverb->plateDiffusion1 = diffusion * 0.7f;
+   _reverb->plateDiffusion2 = diffusion * 0.5f;
 
    // (note) Plateau originally used a switch (0/1) for this
-   float modDiffuse = shared->params[PARAM_DIFFUSION_AMT] + voice->mods[MOD_DIFFUSION_AMT];
+   float modDiffuse = _params[PARAM_DIFFUSION_AMT] + _mods[MOD_DIFFUSION_AMT];
    // // bool diffuseInput = (modDiffuse >= 0.5f);
-   voice->reverb.diffuseInput = (double)modDiffuse;
+   _reverb->diffuseInput = (double)modDiffuse;
 
-   float modDecay = shared->params[PARAM_DECAY] + voice->mods[MOD_DECAY];
+   float modDecay = _params[PARAM_DECAY] + _mods[MOD_DECAY];
    modDecay = Dstplugin_clamp(modDecay, 0.0f, 1.0f);
    float decay = Dstplugin_scale(modDecay, decayMin, decayMax);
    decay = 1.f - decay;
    decay = 1.f - decay * decay;
-   voice->reverb.decay = decay;
+   _reverb->decay = decay;
 
-   float modReverbHighDamp = shared->params[PARAM_REVERB_HIGH_DAMP] + voice->mods[MOD_REVERB_HIGH_DAMP];
+   float modReverbHighDamp = _params[PARAM_REVERB_HIGH_DAMP] + _mods[MOD_REVERB_HIGH_DAMP];
    modReverbHighDamp = Dstplugin_clamp(modReverbHighDamp, 0.0f, 1.0f);
    float reverbDampHigh = 10.0f - modReverbHighDamp * 10.0f;
-   voice->reverb.reverbHighCut = 440.f * powf(2.f, reverbDampHigh - 5.f);
+   _reverb->reverbHighCut = 440.f * powf(2.f, reverbDampHigh - 5.f);
 
-   float modReverbLowDamp = shared->params[PARAM_REVERB_LOW_DAMP] + voice->mods[MOD_REVERB_LOW_DAMP];
+   float modReverbLowDamp = _params[PARAM_REVERB_LOW_DAMP] + _mods[MOD_REVERB_LOW_DAMP];
    modReverbLowDamp = Dstplugin_clamp(modReverbLowDamp, 0.0f, 1.0f);
    float reverbDampLow = 10.0f - modReverbLowDamp * 10.0f;
-   voice->reverb.reverbLowCut = 440.f * powf(2.f, reverbDampLow - 5.f);
+   _reverb->reverbLowCut = 440.f * powf(2.f, reverbDampLow - 5.f);
 
-   float modInputLowDamp = shared->params[PARAM_INPUT_LOW_DAMP] + voice->mods[MOD_INPUT_LOW_DAMP];
+   float modInputLowDamp = _params[PARAM_INPUT_LOW_DAMP] + _mods[MOD_INPUT_LOW_DAMP];
    modInputLowDamp = Dstplugin_clamp(modInputLowDamp, 0.0f, 1.0f);
    float inputDampLow = 10.0f - modInputLowDamp * 10.0f;
-   voice->reverb.inputLowCut = 440.f * powf(2.f, inputDampLow - 5.f);
+   _reverb->inputLowCut = 440.f * powf(2.f, inputDampLow - 5.f);
 
-   float modInputHighDamp = shared->params[PARAM_INPUT_HIGH_DAMP] + voice->mods[MOD_INPUT_HIGH_DAMP];
+   float modInputHighDamp = _params[PARAM_INPUT_HIGH_DAMP] + _mods[MOD_INPUT_HIGH_DAMP];
    modInputHighDamp = Dstplugin_clamp(modInputHighDamp, 0.0f, 1.0f);
    float inputDampHigh = 10.0f - modInputHighDamp * 10.0f;
-   voice->reverb.inputHighCut = 440.f * powf(2.f, inputDampHigh - 5.f);
+   _reverb->inputHighCut = 440.f * powf(2.f, inputDampHigh - 5.f);
 
-   float modModSpeed = shared->params[PARAM_MOD_SPEED] + voice->mods[MOD_MOD_SPEED];
+   float modModSpeed = _params[PARAM_MOD_SPEED] + _mods[MOD_MOD_SPEED];
    modModSpeed = Dstplugin_clamp(modModSpeed, 0.0f, 1.0f);
    float modSpeed = modModSpeed * modModSpeed;
    modSpeed = modSpeed * 99.f + 1.f;
-   voice->reverb.modSpeed = modSpeed;
+   _reverb->modSpeed = modSpeed;
 
-   float modModShape = shared->params[PARAM_MOD_SHAPE] + voice->mods[MOD_MOD_SHAPE];
+   float modModShape = _params[PARAM_MOD_SHAPE] + _mods[MOD_MOD_SHAPE];
    modModShape = Dstplugin_clamp(modModShape, 0.0f, 1.0f);
    float modShape = modModShape * modModShape;
    modShape = Dstplugin_scale(modShape, modShapeMin, modShapeMax);
-   voice->reverb.setModShape(modShape);
+   _reverb->setModShape(modShape);
 
-   float modModDepth = shared->params[PARAM_MOD_DEPTH] + voice->mods[MOD_MOD_DEPTH];
+   float modModDepth = _params[PARAM_MOD_DEPTH] + _mods[MOD_MOD_DEPTH];
    modModDepth = Dstplugin_clamp(modModDepth, 0.0f, 1.0f);
    float modDepth = modModDepth * modDepthMax;
-   voice->reverb.modDepth = modDepth;
+   _reverb->modDepth = modDepth;
+}
+
+static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
+                                            unsigned int       _numFrames,
+                                            float              _freqHz,
+                                            float              _note,
+                                            float              _vol,
+                                            float              _pan
+                                            ) {
+   ST_PLUGIN_VOICE_CAST(valley_plateau_voice_t);
+   ST_PLUGIN_VOICE_SHARED_CAST(valley_plateau_shared_t);
+   (void)_freqHz;
+   (void)_note;
+   (void)_vol;
+   (void)_pan;
+
+   float modDry;
+   float modWet;
+   loc_update_reverb(&voice->reverb, shared->params, voice->mods,
+                     &voice->frozen, &voice->cleared,
+                     &modDry, &modWet
+                     );
 
    if(_numFrames > 0u)
    {
@@ -363,15 +387,16 @@ static void ST_PLUGIN_API loc_prepare_block(st_plugin_voice_t *_voice,
 
 }
 
-static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
-                                              int                 _bMonoIn,
-                                              const float        *_samplesIn,
-                                              float              *_samplesOut,
-                                              unsigned int        _numFrames
-                                              ) {
-   ST_PLUGIN_VOICE_CAST(valley_plateau_voice_t);
-   ST_PLUGIN_VOICE_SHARED_CAST(valley_plateau_shared_t);
-
+static inline void loc_process(Dattorro     *_reverb,
+                               const float  *_samplesIn,
+                               float        *_samplesOut,
+                               unsigned int  _numFrames,
+                               float        &_dryCur,
+                               const float   _dryInc,
+                               float        &_wetCur,
+                               const float   _wetInc,
+                               float        &_peakWet
+                               ) {
    unsigned int k = 0u;
 
    // Stereo input, stereo output
@@ -380,27 +405,57 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
       float l = _samplesIn[k];
       float r = _samplesIn[k + 1u];
 
-      voice->reverb.process(l, r);
+      _reverb->process(l, r);
+      Dstplugin_peak(_peakWet, (float)_reverb->leftOut);
+      Dstplugin_peak(_peakWet, (float)_reverb->rightOut);
 
-      l *= voice->mod_dry_cur;
-      r *= voice->mod_dry_cur;
+      l *= _dryCur;
+      r *= _dryCur;
 
-      l += voice->reverb.leftOut  * voice->mod_wet_cur;
-      r += voice->reverb.rightOut * voice->mod_wet_cur;
+      l += _reverb->leftOut  * _wetCur;
+      r += _reverb->rightOut * _wetCur;
 
       _samplesOut[k]      = l;
       _samplesOut[k + 1u] = r;
 
       // Next frame
       k += 2u;
-      voice->mod_dry_cur += voice->mod_dry_inc;
-      voice->mod_wet_cur += voice->mod_wet_inc;
+      _dryCur += _dryInc;
+      _wetCur += _wetInc;
    }
+}
+
+static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
+                                              int                 _bMonoIn,
+                                              const float        *_samplesIn,
+                                              float              *_samplesOut,
+                                              unsigned int        _numFrames
+                                              ) {
+   ST_PLUGIN_VOICE_CAST(valley_plateau_voice_t);
+   (void)_bMonoIn;
+
+   float peakIn = 0.0f;
+   Dstplugin_peak_buf(peakIn, _samplesIn, _numFrames * 2u);
+   float peakWet = 0.0f;
 
+   loc_process(&voice->reverb, _samplesIn, _samplesOut, _numFrames,
+               voice->mod_dry_cur, voice->mod_dry_inc,
+               voice->mod_wet_cur, voice->mod_wet_inc,
+               peakWet
+               );
+
+   Dstplugin_tail_update(voice->tail, peakIn, peakWet, _numFrames);
+}
+
+static unsigned int ST_PLUGIN_API loc_query_tail_state(st_plugin_voice_t *_voice) {
+   ST_PLUGIN_VOICE_CAST(valley_plateau_voice_t);
+   if(voice->frozen)
+      return ST_PLUGIN_TAIL_ACTIVE;  // infinite decay
+   return Dstplugin_tail_state(voice->tail);
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   valley_plateau_shared_t *ret = (valley_plateau_shared_t *)malloc(sizeof(valley_plateau_shared_t));
+   valley_plateau_shared_t *ret = (valley_plateau_shared_t *)Dstplugin_alloc(_info, sizeof(valley_plateau_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -411,17 +466,18 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   valley_plateau_voice_t *ret = (valley_plateau_voice_t *)malloc(sizeof(valley_plateau_voice_t));
+   valley_plateau_voice_t *ret = (valley_plateau_voice_t *)Dstplugin_alloc(_info, sizeof(valley_plateau_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
       ret->base.info = _info;
       new(&ret->reverb)Dattorro();
+      ret->tail.num_tail_frames = (unsigned int)(44100.0f * TAIL_SEC);  // updated in set_sample_rate()
    }
    return &ret->base;
 }
@@ -429,7 +485,171 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
    ST_PLUGIN_VOICE_CAST(valley_plateau_voice_t);
    voice->reverb.~Dattorro();
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
+}
+
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(valley_plateau_voice_t);
+   (void)_voiceIdx;
+   // (note) keeps the reverb's delay line allocations
+   Dstplugin_voice_clear_to(voice, reverb);
+   voice->reverb.reset();
+   Dstplugin_voice_clear_from(voice, tail);
+   voice->tail.num_tail_frames = (unsigned int)(44100.0f * TAIL_SEC);  // updated in set_sample_rate()
+}
+
+
+// "bus" variant: a single reverb in the shared instance, processed once per block on the summed voice bus
+//  (no per-voice modulation)
+//  - hosts without ST_PLUGIN_FLAG_SHARED_BUS support: the first voice (voice_new() index 0) processes the reverb,
+//     all other voices pass their input through (dry)
+typedef struct valley_plateau_bus_shared_s {
+   valley_plateau_shared_t base;  // params
+   float    sample_rate;
+   float    dry_cur;
+   float    wet_cur;
+   bool     frozen;
+   bool     cleared;
+   stplugin_tail_t tail;
+   Dattorro reverb;
+} valley_plateau_bus_shared_t;
+
+typedef struct valley_plateau_bus_voice_s {
+   st_plugin_voice_t base;
+   unsigned int    voice_idx;  // see voice_new(). 0=processes the shared reverb (in process_replace())
+   stplugin_tail_t tail;       // dry pass-through voices (voice_idx != 0)
+} valley_plateau_bus_voice_t;
+
+static const float loc_bus_mods[NUM_MODS] = { 0.0f };
+
+static void ST_PLUGIN_API loc_bus_set_sample_rate(st_plugin_voice_t *_voice,
+                                                  float              _sampleRate
+                                                  ) {
+   ST_PLUGIN_VOICE_SHARED_CAST(valley_plateau_bus_shared_t);
+   if(shared->sample_rate != _sampleRate)
+   {
+      shared->sample_rate = _sampleRate;
+      shared->reverb.setSampleRate(_sampleRate);
+      shared->tail.num_tail_frames = (unsigned int)(_sampleRate * TAIL_SEC);
+   }
+}
+
+static void ST_PLUGIN_API loc_bus_process_shared(st_plugin_shared_t *_shared,
+                                                 int                 _bMonoIn,
+                                                 const float        *_samplesIn,
+                                                 float              *_samplesOut,
+                                                 unsigned int        _numFrames
+                                                 ) {
+   ST_PLUGIN_SHARED_CAST(valley_plateau_bus_shared_t);
+   (void)_bMonoIn;
+
+   float dry;
+   float wet;
+   loc_update_reverb(&shared->reverb, shared->base.params, loc_bus_mods,
+                     &shared->frozen, &shared->cleared,
+                     &dry, &wet
+                     );
+
+   if(_numFrames > 0u)
+   {
+      // lerp (fades in from 0 after shared_new())
+      float recBlockSize = (1.0f / _numFrames);
+      float dryInc = (dry - shared->dry_cur) * recBlockSize;
+      float wetInc = (wet - shared->wet_cur) * recBlockSize;
+      float peakIn = 0.0f;
+      Dstplugin_peak_buf(peakIn, _samplesIn, _numFrames * 2u);
+      float peakWet = 0.0f;
+      loc_process(&shared->reverb, _samplesIn, _samplesOut, _numFrames,
+                  shared->dry_cur, dryInc,
+                  shared->wet_cur, wetInc,
+                  peakWet
+                  );
+      Dstplugin_tail_update(shared->tail, peakIn, peakWet, _numFrames);
+   }
+}
+
+static void ST_PLUGIN_API loc_bus_process_replace(st_plugin_voice_t  *_voice,
+                                                  int                 _bMonoIn,
+                                                  const float        *_samplesIn,
+                                                  float              *_samplesOut,
+                                                  unsigned int        _numFrames
+                                                  ) {
+   // Host does not support ST_PLUGIN_FLAG_SHARED_BUS
+   ST_PLUGIN_VOICE_CAST(valley_plateau_bus_voice_t);
+   ST_PLUGIN_VOICE_SHARED_CAST(valley_plateau_bus_shared_t);
+
+   if(0u == voice->voice_idx)
+   {
+      // First voice steps the shared reverb
+      loc_bus_process_shared(_voice->shared, _bMonoIn, _samplesIn, _samplesOut, _numFrames);
+   }
+   else
+   {
+      // Other voices: dry pass-through
+      const float dry = Dstplugin_clamp(shared->base.params[PARAM_DRY], 0.0f, 1.0f);
+      float peakIn = 0.0f;
+      unsigned int k = 0u;
+      for(unsigned int i = 0u; i < _numFrames; i++)
+      {
+         Dstplugin_peak(peakIn, _samplesIn[k]);
+         Dstplugin_peak(peakIn, _samplesIn[k + 1u]);
+         _samplesOut[k]      = _samplesIn[k]      * dry;
+         _samplesOut[k + 1u] = _samplesIn[k + 1u] * dry;
+         k += 2u;
+      }
+      Dstplugin_tail_update(voice->tail, peakIn, 0.0f, _numFrames);
+   }
+}
+
+static unsigned int ST_PLUGIN_API loc_bus_query_tail_state(st_plugin_voice_t *_voice) {
+   ST_PLUGIN_VOICE_CAST(valley_plateau_bus_voice_t);
+   ST_PLUGIN_VOICE_SHARED_CAST(valley_plateau_bus_shared_t);
+   if(0u != voice->voice_idx)
+      return Dstplugin_tail_state(voice->tail);  // dry pass-through (no tail)
+   if(shared->frozen)
+      return ST_PLUGIN_TAIL_ACTIVE;  // infinite decay
+   return Dstplugin_tail_state(shared->tail);
+}
+
+static st_plugin_shared_t *ST_PLUGIN_API loc_bus_shared_new(st_plugin_info_t *_info) {
+   valley_plateau_bus_shared_t *ret = (valley_plateau_bus_shared_t *)Dstplugin_alloc(_info, sizeof(valley_plateau_bus_shared_t));
+   if(NULL != ret)
+   {
+      memset((void*)ret, 0, sizeof(*ret));
+      ret->base.base.info  = _info;
+      memcpy((void*)ret->base.params, (void*)loc_param_resets, NUM_PARAMS * sizeof(float));
+      new(&ret->reverb)Dattorro();
+      ret->sample_rate = 44100.0f;  // updated in set_sample_rate()
+      ret->tail.num_tail_frames = (unsigned int)(44100.0f * TAIL_SEC);  // updated in set_sample_rate()
+   }
+   return &ret->base.base;
+}
+
+static void ST_PLUGIN_API loc_bus_shared_delete(st_plugin_shared_t *_shared) {
+   ST_PLUGIN_SHARED_CAST(valley_plateau_bus_shared_t);
+   shared->reverb.~Dattorro();
+   Dstplugin_free(_shared->info, _shared);
+}
+
+static st_plugin_voice_t *ST_PLUGIN_API loc_bus_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
+   valley_plateau_bus_voice_t *ret = (valley_plateau_bus_voice_t *)Dstplugin_alloc(_info, sizeof(valley_plateau_bus_voice_t));
+   if(NULL != ret)
+   {
+      memset((void*)ret, 0, sizeof(*ret));
+      ret->base.info = _info;
+      ret->voice_idx = _voiceIdx;
+   }
+   return &ret->base;
+}
+
+static void ST_PLUGIN_API loc_bus_voice_delete(st_plugin_voice_t *_voice) {
+   Dstplugin_free(_voice->info, _voice);
+}
+
+static void ST_PLUGIN_API loc_bus_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(valley_plateau_bus_voice_t);
+   Dstplugin_voice_clear(voice);
+   voice->voice_idx = _voiceIdx;
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -460,6 +680,7 @@ st_plugin_info_t *valley_plateau_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -470,6 +691,45 @@ st_plugin_info_t *valley_plateau_init(void) {
       ret->base.set_mod_value    = &loc_set_mod_value;
       ret->base.prepare_block    = &loc_prepare_block;
       ret->base.process_replace  = &loc_process_replace;
+      ret->base.query_tail_state = &loc_query_tail_state;
+      ret->base.plugin_exit      = &loc_plugin_exit;
+   }
+
+   return &ret->base;
+}
+
+st_plugin_info_t *valley_plateau_bus_init(void) {
+   valley_plateau_info_t *ret = NULL;
+
+   ret = (valley_plateau_info_t *)malloc(sizeof(valley_plateau_info_t));
+
+   if(NULL != ret)
+   {
+      memset((void*)ret, 0, sizeof(*ret));
+
+      ret->base.api_version = ST_PLUGIN_API_VERSION;
+      ret->base.id          = "valley plateau bus";  // unique id. don't change this in future builds.
+      ret->base.author      = "Valley & bsp";
+      ret->base.name        = "Valley Plateau Bus";
+      ret->base.short_name  = "Plateau Bus";
+      ret->base.flags       = ST_PLUGIN_FLAG_FX | ST_PLUGIN_FLAG_TRUE_STEREO_OUT | ST_PLUGIN_FLAG_SHARED_BUS;
+      ret->base.category    = ST_PLUGIN_CAT_REVERB;
+      ret->base.num_params  = NUM_PARAMS;
+      ret->base.num_mods    = 0u;
+
+      ret->base.shared_new       = &loc_bus_shared_new;
+      ret->base.shared_delete    = &loc_bus_shared_delete;
+      ret->base.voice_new        = &loc_bus_voice_new;
+      ret->base.voice_delete     = &loc_bus_voice_delete;
+      ret->base.voice_reset      = &loc_bus_voice_reset;
+      ret->base.get_param_name   = &loc_get_param_name;
+      ret->base.get_param_reset  = &loc_get_param_reset;
+      ret->base.get_param_value  = &loc_get_param_value;
+      ret->base.set_param_value  = &loc_set_param_value;
+      ret->base.set_sample_rate  = &loc_bus_set_sample_rate;
+      ret->base.process_replace  = &loc_bus_process_replace;
+      ret->base.query_tail_state = &loc_bus_query_tail_state;
+      ret->base.process_shared   = &loc_bus_process_shared;
       ret->base.plugin_exit      = &loc_plugin_exit;
    }
 
@@ -477,9 +737,13 @@ st_plugin_info_t *valley_plateau_init(void) {
 }
 
 ST_PLUGIN_APICALL st_plugin_info_t *ST_PLUGIN_API st_plugin_init(unsigned int _pluginIdx) {
-   if(0u == _pluginIdx)
+   switch(_pluginIdx)
    {
-      return valley_plateau_init();
+      case 0u:
+         return valley_plateau_init();
+
+      case 1u:
+         return valley_plateau_bus_init();  // shared reverb, processed on the summed voice bus
    }
    return NULL;
 }
@@ -23,7 +23,7 @@
 // ----           (adapted from https://github.com/hemmer/Befaco for 'stfx' plugin API by bsp)
 // ----
 // ---- created: 05Dec2021
-// ---- changed: 21Jan2024
+// ---- changed: 21Jan2024, 16Oct2026
 // ----
 // ----
 // ----
@@ -253,7 +253,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   noiseplethora_ab_shared_t *ret = (noiseplethora_ab_shared_t *)malloc(sizeof(noiseplethora_ab_shared_t));
+   noiseplethora_ab_shared_t *ret = (noiseplethora_ab_shared_t *)Dstplugin_alloc(_info, sizeof(noiseplethora_ab_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -264,12 +264,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   noiseplethora_ab_voice_t *ret = (noiseplethora_ab_voice_t *)malloc(sizeof(noiseplethora_ab_voice_t));
+   noiseplethora_ab_voice_t *ret = (noiseplethora_ab_voice_t *)Dstplugin_alloc(_info, sizeof(noiseplethora_ab_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -309,7 +309,7 @@ static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
       }
    }   
 
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
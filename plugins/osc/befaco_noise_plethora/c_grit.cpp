@@ -23,7 +23,7 @@
 // ----           (adapted from https://github.com/hemmer/Befaco for 'stfx' plugin API by bsp)
 // ----
 // ---- created: 05Dec2021
-// ---- changed: 21Jan2024
+// ---- changed: 21Jan2024, 16Oct2026
 // ----
 // ----
 // ----
@@ -276,7 +276,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   noiseplethora_cgrit_shared_t *ret = (noiseplethora_cgrit_shared_t *)malloc(sizeof(noiseplethora_cgrit_shared_t));
+   noiseplethora_cgrit_shared_t *ret = (noiseplethora_cgrit_shared_t *)Dstplugin_alloc(_info, sizeof(noiseplethora_cgrit_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -287,12 +287,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   noiseplethora_cgrit_voice_t *ret = (noiseplethora_cgrit_voice_t *)malloc(sizeof(noiseplethora_cgrit_voice_t));
+   noiseplethora_cgrit_voice_t *ret = (noiseplethora_cgrit_voice_t *)Dstplugin_alloc(_info, sizeof(noiseplethora_cgrit_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -305,6 +305,25 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+template <typename T> static void loc_reconstruct(T *_obj) {
+   // Re-construct heap object in place (see loc_voice_reset())
+   if(NULL != _obj)
+   {
+      _obj->~T();
+      new(_obj) T();
+   }
+}
+
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(noiseplethora_cgrit_voice_t);
+   (void)_voiceIdx;
+   // (note) keeps the heap-allocated noise generator / filter objects
+   Dstplugin_voice_clear_to(voice, grit_noise);
+   loc_reconstruct(voice->grit_noise);
+   loc_reconstruct(voice->svf_1a);
+   loc_reconstruct(voice->svf_1b);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
    ST_PLUGIN_VOICE_CAST(noiseplethora_cgrit_voice_t);
 
@@ -317,7 +336,7 @@ static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
    delete voice->svf_1b;
    voice->svf_1b = NULL;
 
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -347,6 +366,7 @@ st_plugin_info_t *noiseplethora_cgrit_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
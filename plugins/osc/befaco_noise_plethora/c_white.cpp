@@ -23,7 +23,7 @@
 // ----           (adapted from https://github.com/hemmer/Befaco for 'stfx' plugin API by bsp)
 // ----
 // ---- created: 05Dec2021
-// ---- changed: 21Jan2024
+// ---- changed: 21Jan2024, 16Oct2026
 // ----
 // ----
 // ----
@@ -317,7 +317,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   noiseplethora_cwhite_shared_t *ret = (noiseplethora_cwhite_shared_t *)malloc(sizeof(noiseplethora_cwhite_shared_t));
+   noiseplethora_cwhite_shared_t *ret = (noiseplethora_cwhite_shared_t *)Dstplugin_alloc(_info, sizeof(noiseplethora_cwhite_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -328,12 +328,12 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
    (void)_voiceIdx;
-   noiseplethora_cwhite_voice_t *ret = (noiseplethora_cwhite_voice_t *)malloc(sizeof(noiseplethora_cwhite_voice_t));
+   noiseplethora_cwhite_voice_t *ret = (noiseplethora_cwhite_voice_t *)Dstplugin_alloc(_info, sizeof(noiseplethora_cwhite_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -348,6 +348,27 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+template <typename T> static void loc_reconstruct(T *_obj) {
+   // Re-construct heap object in place (see loc_voice_reset())
+   if(NULL != _obj)
+   {
+      _obj->~T();
+      new(_obj) T();
+   }
+}
+
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(noiseplethora_cwhite_voice_t);
+   (void)_voiceIdx;
+   // (note) keeps the heap-allocated noise generator / filter objects
+   Dstplugin_voice_clear_to(voice, white_noise);
+   loc_reconstruct(voice->white_noise);
+   loc_reconstruct(voice->svf_1a);
+   loc_reconstruct(voice->svf_1b);
+   loc_reconstruct(voice->svf_2a);
+   loc_reconstruct(voice->svf_2b);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
    ST_PLUGIN_VOICE_CAST(noiseplethora_cwhite_voice_t);
 
@@ -366,7 +387,7 @@ static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
    delete voice->svf_2b;
    voice->svf_2b = NULL;
 
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -396,6 +417,7 @@ st_plugin_info_t *noiseplethora_cwhite_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -11,7 +11,7 @@
 // ---- changed: 22Aug2023, 23Aug2023, 24Aug2023, 25Aug2023, 26Aug2023, 01Sep2023, 03Sep2023
 // ----          06Sep2023, 07Sep2023, 08Sep2023, 09Sep2023, 10Sep2023, 11Sep2023, 12Sep2023
 // ----          13Sep2023, 16Sep2023, 19Sep2023, 20Sep2023, 21Sep2023, 11Nov2023, 30Nov2023
-// ----          15Dec2023, 11Jan2024, 21Jan2024, 07Feb2024, 28Apr2024, 14Oct2024
+// ----          15Dec2023, 11Jan2024, 21Jan2024, 07Feb2024, 28Apr2024, 14Oct2024, 16Oct2026, 17Oct2026
 // ----
 // ----
 // ----
@@ -2444,6 +2444,11 @@ typedef struct FMSTACK_VOICE_S {
    StBiquad hpf;  // DC offset removal
 #endif // FMSTACK_HPF
 
+#ifndef LOGMUL
+   // (note) LOGMUL variants settle at their level floor (LOGMUL_MIN) and never decay to silence => no tail reporting
+   stplugin_tail_t tail;  // see loc_query_tail_state()
+#endif // LOGMUL
+
    float getVarParam(const FMSTACK_SHARED_T *_shared, const sUI _paramIdx) const {
       if(_paramIdx >= PARAM_VAR_BASE)
       {
@@ -4159,6 +4164,9 @@ static void ST_PLUGIN_API loc_set_sample_rate(st_plugin_voice_t *_voice,
                                               ) {
    ST_PLUGIN_VOICE_CAST(FMSTACK_VOICE_T);
    voice->sample_rate = _sampleRate;
+#ifndef LOGMUL
+   voice->tail.num_tail_frames = sUI(_sampleRate * 0.01f);  // 10ms (DC filter / op feedback ring-out)
+#endif // LOGMUL
 }
 
 static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
@@ -4171,6 +4179,10 @@ static void ST_PLUGIN_API loc_note_on(st_plugin_voice_t  *_voice,
    voice->b_glide = _bGlide;
    (void)_note;
 
+#ifndef LOGMUL
+   Dstplugin_tail_reset(voice->tail);
+#endif // LOGMUL
+
    if(_bGlide < 1)
    {
       // No gliding (bGlide=0) or glide with 'smp' reset (bGlide=-1)
@@ -4275,6 +4287,9 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
    // Mono output (replicate left to right channel)
    sUI k = 0u;
+#ifndef LOGMUL
+   float peakOut = 0.0f;
+#endif // LOGMUL
    for(sUI i = 0u; i < _numFrames; i++)
    {
       // Calc Op outputs
@@ -4319,14 +4334,51 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 
       _samplesOut[k]      = out;
       _samplesOut[k + 1u] = out;
+#ifndef LOGMUL
+      Dstplugin_peak(peakOut, out);
+#endif // LOGMUL
 
       // Next frame
       k += 2u;
    } /* loop numFrames */
+
+#ifndef LOGMUL
+   // Tail has ended when all (active) amp envelopes have ended and the output has decayed to silence
+   sBool bEnvEnd = 1;
+   for(sUI opIdx = 0u; opIdx < (NUM_OPS + 1u); opIdx++)
+   {
+      const FMSTACK_VOICE_OP_T *op = &voice->ops[opIdx];
+      if(op->b_active && (env_t::SEG_END != op->aenv.seg_idx))
+      {
+         bEnvEnd = 0;
+         break;
+      }
+   }
+
+   if(bEnvEnd)
+   {
+      // (note) Op 5 processes the input signal
+      float peakIn = 0.0f;
+      if(voice->ops[4].b_active)
+         Dstplugin_peak_buf(peakIn, _samplesIn, _numFrames * 2u);
+      Dstplugin_tail_update(voice->tail, peakIn, peakOut, _numFrames);
+   }
+   else
+   {
+      Dstplugin_tail_reset(voice->tail);
+   }
+#endif // LOGMUL
 }
 
+#ifndef LOGMUL
+static unsigned int ST_PLUGIN_API loc_query_tail_state(st_plugin_voice_t *_voice) {
+   ST_PLUGIN_VOICE_CAST(FMSTACK_VOICE_T);
+   return Dstplugin_tail_state(voice->tail);
+}
+#endif // LOGMUL
+
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   FMSTACK_SHARED_T *ret = (FMSTACK_SHARED_T *)malloc(sizeof(FMSTACK_SHARED_T));
+   FMSTACK_SHARED_T *ret = (FMSTACK_SHARED_T *)Dstplugin_alloc(_info, sizeof(FMSTACK_SHARED_T));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -4337,15 +4389,18 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
-   FMSTACK_VOICE_T *voice = (FMSTACK_VOICE_T *)malloc(sizeof(FMSTACK_VOICE_T));
+   FMSTACK_VOICE_T *voice = (FMSTACK_VOICE_T *)Dstplugin_alloc(_info, sizeof(FMSTACK_VOICE_T));
    if(NULL != voice)
    {
       memset((void*)voice, 0, sizeof(*voice));
       voice->base.info = _info;
+#ifndef LOGMUL
+      voice->tail.num_tail_frames = 480u;  // updated in set_sample_rate()
+#endif // LOGMUL
 
       for(sUI opIdx = 0u; opIdx < NUM_OPS; opIdx++)
       {
@@ -4366,10 +4421,34 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &voice->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(FMSTACK_VOICE_T);
+   Dstplugin_voice_clear(voice);
+#ifndef LOGMUL
+   voice->tail.num_tail_frames = 480u;  // updated in set_sample_rate()
+#endif // LOGMUL
+
+   for(sUI opIdx = 0u; opIdx < NUM_OPS; opIdx++)
+   {
+      FMSTACK_VOICE_OP_T *op = &voice->ops[opIdx];
+      sUI t = sUI(size_t(op)) * (_voiceIdx + 1u);
+      op->pha_lfsr_state = (unsigned short)((t >> 4) ^ (t >> 16));
+   }
+
+#ifdef FMSTACK_HPF
+   voice->hpf.reset();
+   voice->hpf.calcParamsNoStep(StBiquad::HPF,
+                               0.0f/*gainDB*/,
+                               0.001f/*freq*/,
+                               0.05f/*q*/
+                               );
+#endif // FMSTACK_HPF
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
    ST_PLUGIN_VOICE_CAST(FMSTACK_VOICE_T);
 
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -4430,6 +4509,7 @@ st_plugin_info_t *FMSTACK_INIT(void) {
       ret->base.shared_delete                     = &loc_shared_delete;
       ret->base.voice_new                         = &loc_voice_new;
       ret->base.voice_delete                      = &loc_voice_delete;
+      ret->base.voice_reset                       = &loc_voice_reset;
       ret->base.get_param_name                    = &loc_get_param_name;
       ret->base.query_dynamic_param_name          = &loc_query_dynamic_param_name;
       ret->base.query_dynamic_param_preset_values = &loc_query_dynamic_param_preset_values;
@@ -4445,6 +4525,9 @@ st_plugin_info_t *FMSTACK_INIT(void) {
       ret->base.set_mod_value                     = &loc_set_mod_value;
       ret->base.prepare_block                     = &loc_prepare_block;
       ret->base.process_replace                   = &loc_process_replace;
+#ifndef LOGMUL
+      ret->base.query_tail_state                  = &loc_query_tail_state;
+#endif // LOGMUL
       ret->base.plugin_exit                       = &loc_plugin_exit;
 
       loc_calc_sine_tbl();
@@ -20,7 +20,7 @@
 // ----
 // ---- info   : GM's RNG convolver (see https://gearspace.com/board/attachments/electronic-music-instruments-and-electronic-music-production/1014442d1650910676-novel-old-1970s-style-anolge-physical-modeling-efficient-real-time-pulse-convolution-synthesis.pdf)
 // ---- created: 26Apr2022
-// ---- changed: 27Apr2022, 21Jan2024
+// ---- changed: 27Apr2022, 21Jan2024, 16Oct2026
 // ----
 // ----
 // ----
@@ -376,7 +376,7 @@ static void ST_PLUGIN_API loc_process_replace(st_plugin_voice_t  *_voice,
 }
 
 static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info) {
-   gm_rng_convolve_shared_t *ret = (gm_rng_convolve_shared_t *)malloc(sizeof(gm_rng_convolve_shared_t));
+   gm_rng_convolve_shared_t *ret = (gm_rng_convolve_shared_t *)Dstplugin_alloc(_info, sizeof(gm_rng_convolve_shared_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -387,11 +387,11 @@ static st_plugin_shared_t *ST_PLUGIN_API loc_shared_new(st_plugin_info_t *_info)
 }
 
 static void ST_PLUGIN_API loc_shared_delete(st_plugin_shared_t *_shared) {
-   free((void*)_shared);
+   Dstplugin_free(_shared->info, _shared);
 }
 
 static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, unsigned int _voiceIdx) {
-   gm_rng_convolve_voice_t *ret = (gm_rng_convolve_voice_t *)malloc(sizeof(gm_rng_convolve_voice_t));
+   gm_rng_convolve_voice_t *ret = (gm_rng_convolve_voice_t *)Dstplugin_alloc(_info, sizeof(gm_rng_convolve_voice_t));
    if(NULL != ret)
    {
       memset((void*)ret, 0, sizeof(*ret));
@@ -400,10 +400,16 @@ static st_plugin_voice_t *ST_PLUGIN_API loc_voice_new(st_plugin_info_t *_info, u
    return &ret->base;
 }
 
+static void ST_PLUGIN_API loc_voice_reset(st_plugin_voice_t *_voice, unsigned int _voiceIdx) {
+   ST_PLUGIN_VOICE_CAST(gm_rng_convolve_voice_t);
+   (void)_voiceIdx;
+   Dstplugin_voice_clear(voice);
+}
+
 static void ST_PLUGIN_API loc_voice_delete(st_plugin_voice_t *_voice) {
    ST_PLUGIN_VOICE_CAST(gm_rng_convolve_voice_t);
 
-   free((void*)_voice);
+   Dstplugin_free(_voice->info, _voice);
 }
 
 static void ST_PLUGIN_API loc_plugin_exit(st_plugin_info_t *_info) {
@@ -432,6 +438,7 @@ st_plugin_info_t *gm_rng_convolve_init(void) {
       ret->base.shared_delete    = &loc_shared_delete;
       ret->base.voice_new        = &loc_voice_new;
       ret->base.voice_delete     = &loc_voice_delete;
+      ret->base.voice_reset      = &loc_voice_reset;
       ret->base.get_param_name   = &loc_get_param_name;
       ret->base.get_param_reset  = &loc_get_param_reset;
       ret->base.get_param_value  = &loc_get_param_value;
@@ -0,0 +1,48 @@
+#!/bin/sh
+#
+# Record / verify golden reference renders for all plugin libraries in this repository
+#
+#  usage: ./golden.sh record|verify [<refdir>] [stfx_golden options]
+#
+#  (note) build the plugins (make -f makefile.linux bin in plugins/) and stfx_golden / stfx_biquad_coeff first
+#  (note) record references with a known-good build, then verify after changing the plugin sources
+#
+
+MODE=$1
+if [ "$MODE" != "record" ] && [ "$MODE" != "verify" ]; then
+   echo "usage: $0 record|verify [<refdir>] [stfx_golden options]"
+   exit 10
+fi
+shift
+
+REFDIR=golden_ref
+if [ $# -gt 0 ] && [ "${1#-}" = "$1" ]; then
+   REFDIR=$1
+   shift
+fi
+
+BASEDIR=`dirname "$0"`
+PLUGINDIR="$BASEDIR/../../plugins"
+
+LIBS=""
+for f in \
+   "$PLUGINDIR"/fx/*/*.so \
+   "$PLUGINDIR"/osc/*/*.so \
+   "$PLUGINDIR"/cycle/*.so
+do
+   if [ -f "$f" ]; then
+      LIBS="$LIBS $f"
+   fi
+done
+
+if [ -z "$LIBS" ]; then
+   echo "$0: no plugin libraries found in \"$PLUGINDIR\""
+   exit 10
+fi
+
+# Table-driven biquad coefficient design vs. closed form (plugins/fx/fx_example/biquad.cpp)
+if [ "$MODE" = "verify" ]; then
+   "$BASEDIR/stfx_biquad_coeff" || exit $?
+fi
+
+exec "$BASEDIR/stfx_golden" $MODE -t "$BASEDIR/golden_tolerances.txt" -c "$BASEDIR/golden_cases.txt" "$@" "$REFDIR" $LIBS
@@ -0,0 +1,536 @@
+// ----
+// ---- file   : stfx_bench.cpp
+// ---- legal  : Distributed under terms of the MIT license (https://opensource.org/licenses/MIT)
+// ----          Copyright 2020-2026 by bsp
+// ----
+// ----          Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// ----          associated documentation files (the "Software"), to deal in the Software without restriction, including
+// ----          without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// ----          copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+// ----          the following conditions:
+// ----
+// ----          The above copyright notice and this permission notice shall be included in all copies or substantial
+// ----          portions of the Software.
+// ----
+// ----          THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+// ----          NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// ----          IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// ----          WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// ----          SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ----
+// ----
+// ---- info   : standalone plugin benchmark. loads one or many plugin libraries, enumerates all plugins
+// ----           and measures init / voice_new cost and per-frame / per-voice-block processing cost.
+// ----
+// ---- created: 16Oct2026
+// ---- changed:
+// ----
+// ----
+// ----
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "stfx_host.h"
+
+// input signal buffer length (frames). blocks cycle through this buffer.
+#define INPUT_NUM_FRAMES  (65536u)
+
+// Extra floats per buffer (ST_PLUGIN_PLANAR_ALIGN address alignment)
+#define ALIGN_PAD_FLOATS  (ST_PLUGIN_PLANAR_ALIGN / sizeof(float))
+
+// Deterministic stereo noise input
+typedef struct bench_input_s {
+   float *interleaved;   // 2 * INPUT_NUM_FRAMES
+   float *l;             // INPUT_NUM_FRAMES (aligned to ST_PLUGIN_PLANAR_ALIGN)
+   float *r;
+} bench_input_t;
+
+typedef struct bench_options_s {
+   stfx_host_config_t host;
+   float        num_seconds;     // measured duration (audio time)
+   float        warmup_seconds;  // not measured
+   const char  *filter;          // plugin id / name substring (or NULL)
+   int          plugin_idx;      // -1=all
+   int          b_csv;
+   float        burst_on_seconds;   // >0: alternate between noise input ..
+   float        burst_off_seconds;  //  .. and silence (note on / note off for oscillator plugins)
+   int          b_steal;         // 1=recycle all voices at the start of each burst (see stfx_host_instance_steal_voices())
+   int          b_mix;           // 1=mix all voices into one output buffer (see stfx_host_instance_process_voices_add())
+   stfx_host_arena_t *arena;     // shared / voice instance arena (or NULL)
+} bench_options_t;
+
+typedef struct bench_result_s {
+   double t_init;         // st_plugin_init()
+   double t_shared_new;
+   double t_voice_new;    // per voice
+   double ns_per_frame;   // per voice
+   double ns_per_block;   // per voice
+   double cpu_percent;    // per voice, relative to realtime
+   float  peak;
+   int    b_nan;
+   int    b_batched;      // 1=process_replace_voices() was used
+   int    b_planar;       // 1=process_replace_planar() was used
+   int    b_mix;          // 1=voices were mixed into one output buffer
+   int    b_add;          // 1=process_add() was used (0: process_replace() + host mix pass)
+   int    b_bus;          // 1=voices were summed into a bus and rendered via process_shared()
+   double skipped_percent;  // voice blocks skipped by the host (see query_tail_state())
+   double t_voice_steal;  // per voice steal (0: no voices were stolen)
+   int    b_reset;        // 1=voice_reset() was used (0: voice_delete() + voice_new())
+} bench_result_t;
+
+
+static void loc_usage(void) {
+   printf(
+      "Usage: stfx_bench [options] <plugin.so> [<plugin.so> ..]\n"
+      "\n"
+      "  -r <rate>     sample rate (default: 44100)\n"
+      "  -s <sec>      measured duration in (audio) seconds (default: 2)\n"
+      "  -w <sec>      warmup duration (default: 0.25)\n"
+      "  -v <num>      number of voices (default: 1)\n"
+      "  -n <note>     MIDI note (default: 60)\n"
+      "  -m            mono input (sets bMonoIn)\n"
+      "  -M            sweep mod slots (per-block set_mod_value() ramps)\n"
+      "  -S            single voice calls (don't use process_replace_voices())\n"
+      "  -P            use process_replace_planar() (non-interleaved buffers) when available\n"
+      "  -A            mix all voices into one buffer, use process_add() when available\n"
+      "  -X            mix all voices into one buffer, use process_replace() + host mix pass\n"
+      "  -U            sum all voices into a bus and call process_shared() once per block (ST_PLUGIN_FLAG_SHARED_BUS)\n"
+      "  -a <MB>       allocate shared / voice instances from a pre-faulted <MB> megabytes arena (host allocator)\n"
+      "  -T            skip voices whose tail has ended while the input is silent (query_tail_state())\n"
+      "  -B <on>,<off> burst input: alternate between <on> seconds of noise and <off> seconds of silence\n"
+      "                 (oscillator plugins: note on / note off)\n"
+      "  -R            steal (recycle) all voices at the start of each burst, use voice_reset() when available\n"
+      "  -f <str>      only benchmark plugins whose id or name contains <str>\n"
+      "  -i <idx>      only benchmark plugin <idx>\n"
+      "  -c            CSV output\n"
+           );
+}
+
+static int loc_match_filter(const st_plugin_info_t *_info, const bench_options_t *_opt) {
+   if(NULL == _opt->filter)
+      return 1;
+   if(NULL != _info->id && NULL != strstr(_info->id, _opt->filter))
+      return 1;
+   if(NULL != _info->name && NULL != strstr(_info->name, _opt->filter))
+      return 1;
+   return 0;
+}
+
+static float *loc_align_buf(float *_buf) {
+   return (float*)Dstplugin_align((size_t)_buf, (size_t)ST_PLUGIN_PLANAR_ALIGN);
+}
+
+static void loc_scan_output(const float *_buf, unsigned int _num, float *_peak, int *_bNaN) {
+   for(unsigned int i = 0u; i < _num; i++)
+   {
+      float f = _buf[i];
+      if(f != f)
+         *_bNaN = 1;
+      else
+      {
+         f = Dstplugin_abs(f);
+         if(f > *_peak)
+            *_peak = f;
+      }
+   }
+}
+
+static int loc_bench_plugin(st_plugin_info_t      *_info,
+                            const bench_options_t *_opt,
+                            const bench_input_t   *_input,
+                            bench_result_t        *_ret
+                            ) {
+   stfx_host_instance_t inst;
+   if(!stfx_host_instance_init(&inst, _info, &_opt->host))
+   {
+      stfx_host_instance_exit(&inst);
+      return 0;
+   }
+
+   _ret->t_shared_new = inst.t_shared_new;
+   _ret->t_voice_new  = inst.t_voice_new / inst.num_voices;
+
+   const int bBus = stfx_host_instance_use_shared_bus(&inst);
+   const int bMix = !bBus && _opt->b_mix;
+   int bPlanar = !bBus && !bMix && stfx_host_instance_use_planar(&inst);
+
+   // per-voice output buffers (interleaved, or planar l/r)
+   static float outBufMem[STFX_HOST_MAX_VOICES][2u * (STFX_HOST_MAX_BLOCK_FRAMES + ALIGN_PAD_FLOATS)];
+   float *outBufs [STFX_HOST_MAX_VOICES];
+   float *outBufsL[STFX_HOST_MAX_VOICES];
+   float *outBufsR[STFX_HOST_MAX_VOICES];
+   for(unsigned int voiceIdx = 0u; voiceIdx < inst.num_voices; voiceIdx++)
+   {
+      outBufs [voiceIdx] = outBufMem[voiceIdx];
+      outBufsL[voiceIdx] = loc_align_buf(outBufMem[voiceIdx]);
+      outBufsR[voiceIdx] = loc_align_buf(outBufMem[voiceIdx] + STFX_HOST_MAX_BLOCK_FRAMES + ALIGN_PAD_FLOATS);
+   }
+   const unsigned int lastVoiceIdx = inst.num_voices - 1u;
+
+   // silent input (burst off phase)
+   static float zeroBufMem[4u * (STFX_HOST_MAX_BLOCK_FRAMES + ALIGN_PAD_FLOATS)];
+   const float *zeroBuf = loc_align_buf(zeroBufMem);
+   const unsigned int burstOnBlocks  = (unsigned int)(_opt->burst_on_seconds  * STFX_HOST_BLOCK_RATE);
+   const unsigned int burstOffBlocks = (unsigned int)(_opt->burst_off_seconds * STFX_HOST_BLOCK_RATE);
+   const int bBurst = (burstOnBlocks > 0u) && (burstOffBlocks > 0u);
+   unsigned int burstBlockIdx = 0u;
+   int bBurstRetrigger = 0;  // 1=note on (after note off)
+
+   unsigned int inputOff = 0u;
+   float peak = 0.0f;
+   int bNaN = 0;
+
+   // Warmup + measurement
+   for(int pass = 0; pass < 2; pass++)
+   {
+      float numSec = (0 == pass) ? _opt->warmup_seconds : _opt->num_seconds;
+      unsigned int numBlocks = (unsigned int)(numSec * STFX_HOST_BLOCK_RATE);
+      unsigned int numFramesTotal = 0u;
+      double t = stfx_host_time_ns();
+
+      for(unsigned int blockIdx = 0u; blockIdx < numBlocks; blockIdx++)
+      {
+         unsigned int numFrames = stfx_host_instance_next_block_size(&inst);
+         if(bPlanar)
+            inputOff = Dstplugin_align(inputOff, (unsigned int)ALIGN_PAD_FLOATS);
+         if(inputOff + numFrames > INPUT_NUM_FRAMES)
+            inputOff = 0u;
+         const float *samplesIn = _input->interleaved + (inputOff * 2u);
+         const float *samplesInL = _input->l + inputOff;
+         const float *samplesInR = _input->r + inputOff;
+
+         if(bBurst)
+         {
+            if(bBurstRetrigger && _opt->b_steal)
+            {
+               if(!stfx_host_instance_steal_voices(&inst))
+               {
+                  stfx_host_instance_exit(&inst);
+                  return 0;
+               }
+            }
+            else if(_info->flags & ST_PLUGIN_FLAG_OSC)
+            {
+               if(burstOnBlocks == burstBlockIdx)
+                  stfx_host_instance_note_off(&inst);
+               else if(bBurstRetrigger)
+                  stfx_host_instance_note_on(&inst);
+            }
+            bBurstRetrigger = 0;
+
+            if(burstBlockIdx >= burstOnBlocks)
+            {
+               samplesIn  = zeroBuf;
+               samplesInL = zeroBuf;
+               samplesInR = zeroBuf;
+            }
+
+            if(++burstBlockIdx == (burstOnBlocks + burstOffBlocks))
+            {
+               burstBlockIdx = 0u;
+               bBurstRetrigger = 1;
+            }
+         }
+
+         if(_info->flags & ST_PLUGIN_FLAG_XMOD)
+            stfx_host_instance_set_voice_bus(&inst, samplesIn, numFrames);
+
+         // (note) only looks at the last voice's output (or the voice mix / bus)
+         if(bBus)
+         {
+            stfx_host_instance_process_shared(&inst, samplesIn, outBufs[0], numFrames, 1.0f / inst.num_voices);
+            loc_scan_output(outBufs[0], numFrames * 2u, &peak, &bNaN);
+         }
+         else if(bMix)
+         {
+            // (note) a mixing host has to clear its mix buffer once per block, either way
+            memset((void*)outBufs[0], 0, sizeof(float) * 2u * numFrames);
+            stfx_host_instance_process_voices_add(&inst, samplesIn, outBufs[0], numFrames, 1.0f / inst.num_voices);
+            loc_scan_output(outBufs[0], numFrames * 2u, &peak, &bNaN);
+         }
+         else if(bPlanar)
+         {
+            stfx_host_instance_process_voices_planar(&inst, samplesInL, samplesInR, outBufsL, outBufsR, numFrames);
+            loc_scan_output(outBufsL[lastVoiceIdx], numFrames, &peak, &bNaN);
+            loc_scan_output(outBufsR[lastVoiceIdx], numFrames, &peak, &bNaN);
+         }
+         else
+         {
+            stfx_host_instance_process_voices(&inst, samplesIn, outBufs, numFrames);
+            loc_scan_output(outBufs[lastVoiceIdx], numFrames * 2u, &peak, &bNaN);
+         }
+
+         stfx_host_instance_end_block(&inst);
+
+         inputOff += numFrames;
+         numFramesTotal += numFrames;
+      }
+
+      t = stfx_host_time_ns() - t;
+
+      if(1 == pass && numBlocks > 0u)
+      {
+         // (note) includes the time spent in the peak / NaN check above (negligible)
+         double numVoiceFrames = (double)numFramesTotal * inst.num_voices;
+         _ret->ns_per_frame = t / numVoiceFrames;
+         _ret->ns_per_block = t / ((double)numBlocks * inst.num_voices);
+         _ret->cpu_percent  = 100.0 * (t / (double)inst.num_voices) / ((double)numFramesTotal * (1000000000.0 / _opt->host.sample_rate));
+      }
+   }
+
+   if(inst.num_voice_blocks > 0u)
+      _ret->skipped_percent = (100.0 * inst.num_voice_blocks_skipped) / inst.num_voice_blocks;
+
+   _ret->peak  = peak;
+   _ret->b_nan = bNaN;
+   _ret->b_planar  = bPlanar;
+   _ret->b_batched = !bBus && !bMix && !bPlanar && _opt->host.b_batched && (NULL != _info->process_replace_voices);
+   _ret->b_mix     = bMix;
+   _ret->b_add     = bMix && stfx_host_instance_use_add(&inst);
+   _ret->b_bus     = bBus;
+   if(inst.num_voice_steals > 0u)
+      _ret->t_voice_steal = inst.t_voice_steal / inst.num_voice_steals;
+   _ret->b_reset   = (NULL != _info->voice_reset);
+
+   stfx_host_instance_exit(&inst);
+   return 1;
+}
+
+static void loc_print_header(const bench_options_t *_opt) {
+   if(_opt->b_csv)
+   {
+      printf("lib,idx,id,init_us,shared_new_us,voice_new_us,ns_per_frame,ns_per_voice_block,cpu_percent,peak,nan,batched,planar,mix,add,skipped_percent,voice_steal_us,voice_reset,bus\n");
+   }
+   else
+   {
+      printf("[...] rate=%g voices=%u note=%u mono=%d modramps=%d batched=%d planar=%d mix=%d add=%d bus=%d skipsilent=%d arena=%d burst=%g,%g steal=%d sec=%g\n",
+             _opt->host.sample_rate, _opt->host.num_voices, _opt->host.note,
+             _opt->host.b_mono_in, _opt->host.b_mod_ramps, _opt->host.b_batched, _opt->host.b_planar,
+             _opt->b_mix, _opt->host.b_add, _opt->host.b_shared_bus, _opt->host.b_skip_silent, (NULL != _opt->arena), _opt->burst_on_seconds, _opt->burst_off_seconds, _opt->b_steal, _opt->num_seconds
+             );
+      printf("%4s %-40s %9s %9s %9s %10s %12s %8s %8s\n",
+             "idx", "id", "init_us", "shrd_us", "voice_us", "ns/frame", "ns/vblock", "cpu%", "peak"
+             );
+   }
+}
+
+static void loc_print_result(const char            *_libName,
+                             unsigned int           _pluginIdx,
+                             const st_plugin_info_t*_info,
+                             const bench_result_t  *_r,
+                             const bench_options_t *_opt
+                             ) {
+   if(_opt->b_csv)
+   {
+      printf("\"%s\",%u,\"%s\",%.3f,%.3f,%.3f,%.3f,%.3f,%.4f,%.6f,%d,%d,%d,%d,%d,%.2f,%.3f,%d,%d\n",
+             _libName, _pluginIdx, _info->id,
+             _r->t_init * 0.001, _r->t_shared_new * 0.001, _r->t_voice_new * 0.001,
+             _r->ns_per_frame, _r->ns_per_block, _r->cpu_percent, _r->peak, _r->b_nan, _r->b_batched, _r->b_planar,
+             _r->b_mix, _r->b_add, _r->skipped_percent, _r->t_voice_steal * 0.001, _r->b_reset, _r->b_bus
+             );
+   }
+   else
+   {
+      char skipBuf[32];
+      skipBuf[0] = 0;
+      if(_r->skipped_percent > 0.0)
+         snprintf(skipBuf, sizeof(skipBuf), " [skip %.1f%%]", _r->skipped_percent);
+      char stealBuf[48];
+      stealBuf[0] = 0;
+      if(_r->t_voice_steal > 0.0)
+         snprintf(stealBuf, sizeof(stealBuf), " [steal %.2fus %s]", _r->t_voice_steal * 0.001, _r->b_reset ? "reset" : "new");
+      printf("%4u %-40.40s %9.2f %9.2f %9.2f %10.2f %12.1f %8.4f %8.4f%s%s%s%s%s%s%s\n",
+             _pluginIdx, _info->id,
+             _r->t_init * 0.001, _r->t_shared_new * 0.001, _r->t_voice_new * 0.001,
+             _r->ns_per_frame, _r->ns_per_block, _r->cpu_percent, _r->peak,
+             _r->b_batched ? " [batched]" : "",
+             _r->b_planar  ? " [planar]"  : "",
+             _r->b_mix ? (_r->b_add ? " [add]" : " [mix]") : "",
+             _r->b_bus ? " [bus]" : "",
+             skipBuf,
+             stealBuf,
+             _r->b_nan ? " NaN!" : ""
+             );
+   }
+   fflush(stdout);
+}
+
+static void loc_bench_lib(const char *_pathName, const bench_options_t *_opt, const bench_input_t *_input) {
+   stfx_host_lib_t lib;
+   if(!stfx_host_lib_open(&lib, _pathName))
+      return;
+
+   if(!_opt->b_csv)
+      printf("[...] lib \"%s\"\n", _pathName);
+
+   for(unsigned int pluginIdx = 0u; pluginIdx < ST_PLUGIN_MAX; pluginIdx++)
+   {
+      bench_result_t r;
+      memset((void*)&r, 0, sizeof(r));
+
+      double t = stfx_host_time_ns();
+      st_plugin_info_t *info = lib.init_fxn(pluginIdx);
+      r.t_init = stfx_host_time_ns() - t;
+
+      if(NULL == info)
+         break;
+
+      if( (_opt->plugin_idx < 0 || (unsigned int)_opt->plugin_idx == pluginIdx) &&
+          loc_match_filter(info, _opt)
+          )
+      {
+         if(loc_bench_plugin(info, _opt, _input, &r))
+            loc_print_result(_pathName, pluginIdx, info, &r, _opt);
+         else
+            printf("[---] plugin %u (\"%s\"): failed to create instance\n", pluginIdx, info->id);
+
+         if(NULL != _opt->arena)
+            stfx_host_arena_reset(_opt->arena);
+      }
+
+      if(NULL != info->plugin_exit)
+         info->plugin_exit(info);
+   }
+
+   stfx_host_lib_close(&lib);
+}
+
+int main(int argc, char **argv) {
+   bench_options_t opt;
+   memset((void*)&opt, 0, sizeof(opt));
+   opt.host.sample_rate = 44100.0f;
+   opt.host.bpm         = 125.0f;
+   opt.host.num_voices  = 1u;
+   opt.host.note        = 60u;
+   opt.host.vel         = 1.0f;
+   opt.host.b_batched   = 1;
+   opt.num_seconds      = 2.0f;
+   opt.warmup_seconds   = 0.25f;
+   opt.plugin_idx       = -1;
+
+   unsigned int arenaMB = 0u;
+
+   int argIdx = 1;
+   for(; argIdx < argc; argIdx++)
+   {
+      const char *a = argv[argIdx];
+      if('-' != a[0])
+         break;
+      int bHasArg = (argIdx + 1) < argc;
+      if(!strcmp(a, "-r") && bHasArg)
+         opt.host.sample_rate = (float)atof(argv[++argIdx]);
+      else if(!strcmp(a, "-s") && bHasArg)
+         opt.num_seconds = (float)atof(argv[++argIdx]);
+      else if(!strcmp(a, "-w") && bHasArg)
+         opt.warmup_seconds = (float)atof(argv[++argIdx]);
+      else if(!strcmp(a, "-v") && bHasArg)
+         opt.host.num_voices = (unsigned int)atoi(argv[++argIdx]);
+      else if(!strcmp(a, "-n") && bHasArg)
+         opt.host.note = (unsigned int)atoi(argv[++argIdx]);
+      else if(!strcmp(a, "-m"))
+         opt.host.b_mono_in = 1;
+      else if(!strcmp(a, "-M"))
+         opt.host.b_mod_ramps = 1;
+      else if(!strcmp(a, "-S"))
+         opt.host.b_batched = 0;
+      else if(!strcmp(a, "-P"))
+         opt.host.b_planar = 1;
+      else if(!strcmp(a, "-A"))
+      {
+         opt.b_mix = 1;
+         opt.host.b_add = 1;
+      }
+      else if(!strcmp(a, "-X"))
+      {
+         opt.b_mix = 1;
+         opt.host.b_add = 0;
+      }
+      else if(!strcmp(a, "-a") && bHasArg)
+         arenaMB = (unsigned int)atoi(argv[++argIdx]);
+      else if(!strcmp(a, "-T"))
+         opt.host.b_skip_silent = 1;
+      else if(!strcmp(a, "-B") && bHasArg)
+      {
+         if(2 != sscanf(argv[++argIdx], "%f,%f", &opt.burst_on_seconds, &opt.burst_off_seconds))
+         {
+            loc_usage();
+            return 10;
+         }
+      }
+      else if(!strcmp(a, "-U"))
+      {
+         opt.host.b_shared_bus = 1;
+      }
+      else if(!strcmp(a, "-R"))
+      {
+         opt.b_steal = 1;
+      }
+      else if(!strcmp(a, "-f") && bHasArg)
+         opt.filter = argv[++argIdx];
+      else if(!strcmp(a, "-i") && bHasArg)
+         opt.plugin_idx = atoi(argv[++argIdx]);
+      else if(!strcmp(a, "-c"))
+         opt.b_csv = 1;
+      else
+      {
+         loc_usage();
+         return 10;
+      }
+   }
+
+   if(argIdx >= argc)
+   {
+      loc_usage();
+      return 10;
+   }
+
+   opt.host.sample_rate = Dstplugin_clamp(opt.host.sample_rate, 8000.0f, (float)(STFX_HOST_MAX_BLOCK_FRAMES * STFX_HOST_BLOCK_RATE));
+   opt.host.num_voices  = Dstplugin_clamp(opt.host.num_voices, 1u, STFX_HOST_MAX_VOICES);
+   opt.host.note        = Dstplugin_clamp(opt.host.note, 0u, 127u);
+
+   // Deterministic stereo noise input (-6dB), interleaved + planar copy
+   float *inputBuf = (float*)malloc(sizeof(float) * 4u * (INPUT_NUM_FRAMES + ALIGN_PAD_FLOATS));
+   if(NULL == inputBuf)
+      return 20;
+   bench_input_t input;
+   input.interleaved = inputBuf;
+   input.l = loc_align_buf(inputBuf + (2u * INPUT_NUM_FRAMES));
+   input.r = loc_align_buf(input.l + INPUT_NUM_FRAMES + ALIGN_PAD_FLOATS);
+   unsigned int seed = 0x5EEDu;
+   for(unsigned int i = 0u; i < INPUT_NUM_FRAMES; i++)
+   {
+      float l = stfx_host_noise(&seed) * 0.5f;
+      float r = opt.host.b_mono_in ? l : (stfx_host_noise(&seed) * 0.5f);
+      inputBuf[i * 2u + 0u] = l;
+      inputBuf[i * 2u + 1u] = r;
+      input.l[i] = l;
+      input.r[i] = r;
+   }
+
+   static stfx_host_arena_t arena;
+   if(arenaMB > 0u)
+   {
+      if(!stfx_host_arena_init(&arena, (size_t)arenaMB * 1024u * 1024u))
+      {
+         printf("[---] stfx_bench: failed to allocate %u MB arena\n", arenaMB);
+         free((void*)inputBuf);
+         return 20;
+      }
+      opt.arena          = &arena;
+      opt.host.allocator = &arena.base;
+   }
+
+   loc_print_header(&opt);
+
+   for(; argIdx < argc; argIdx++)
+      loc_bench_lib(argv[argIdx], &opt, &input);
+
+   if(NULL != opt.arena)
+      stfx_host_arena_exit(opt.arena);
+
+   free((void*)inputBuf);
+   return 0;
+}
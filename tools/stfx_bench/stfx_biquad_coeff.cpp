@@ -0,0 +1,171 @@
+// ----
+// ---- file   : stfx_biquad_coeff.cpp
+// ---- legal  : Distributed under terms of the MIT license (https://opensource.org/licenses/MIT)
+// ----          Copyright 2020-2026 by bsp
+// ----
+// ----          Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// ----          associated documentation files (the "Software"), to deal in the Software without restriction, including
+// ----          without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// ----          copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+// ----          the following conditions:
+// ----
+// ----          The above copyright notice and this permission notice shall be included in all copies or substantial
+// ----          portions of the Software.
+// ----
+// ----          THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+// ----          NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// ----          IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// ----          WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// ----          SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ----
+// ----
+// ---- info   : table-driven biquad coefficient design check.
+// ----           compares StBiquadCoeff::calcParams() against the closed form (calcParamsExact())
+// ----           over a freq / res / gain grid, for all filter types (see plugins/fx/fx_example/biquad.cpp).
+// ----
+// ---- created: 17Oct2026
+// ---- changed:
+// ----
+// ----
+// ----
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "../../plugin.h"
+#include "../../plugins/fx/fx_example/biquad.h"
+
+// documented max. coefficient error (see biquad.h), relative to the largest coefficient magnitude
+#define DEFAULT_MAX_ERR  (2e-7)
+
+#define NUM_FREQ_STEPS  (2048u)  // 0..1
+#define NUM_RES_STEPS   (8u)     // 0..1
+#define GAIN_MIN_DB     (-96.0f)
+#define GAIN_MAX_DB     ( 96.0f)
+#define GAIN_STEP_DB    (0.375f)
+
+static const char *loc_type_names[StBiquad::HSH + 1] = {
+   "-",
+   "lpf",
+   "hpf",
+   "bpf",
+   "brf",
+   "peq",
+   "lsh",
+   "hsh"
+};
+
+typedef struct coeff_err_s {
+   double max_err;
+   float  freq;
+   float  res;
+   float  db_gain;
+   unsigned int num_evals;
+} coeff_err_t;
+
+static void loc_usage(void) {
+   printf("Usage: stfx_biquad_coeff [options]\n"
+          "\n"
+          "  -e <err>      max. coefficient error (relative to the largest coefficient magnitude, default: %g)\n"
+          "  -V            verbose (print worst case freq / res / gain per filter type)\n"
+          "\n"
+          "  returns exit code 1 when the error of a filter type exceeds the limit\n",
+          DEFAULT_MAX_ERR
+          );
+}
+
+static double loc_coeff_err(const StBiquadCoeff &_a, const StBiquadCoeff &_e) {
+   double mag = fabs(_e.a0);
+   mag = Dstplugin_max(mag, fabs(_e.a1));
+   mag = Dstplugin_max(mag, fabs(_e.a2));
+   mag = Dstplugin_max(mag, fabs(_e.b1));
+   mag = Dstplugin_max(mag, fabs(_e.b2));
+   if(mag <= 0.0)
+      return 0.0;
+
+   double err = fabs(_a.a0 - _e.a0);
+   err = Dstplugin_max(err, fabs(_a.a1 - _e.a1));
+   err = Dstplugin_max(err, fabs(_a.a2 - _e.a2));
+   err = Dstplugin_max(err, fabs(_a.b1 - _e.b1));
+   err = Dstplugin_max(err, fabs(_a.b2 - _e.b2));
+   return err / mag;
+}
+
+static void loc_check_type(int _type, coeff_err_t *_ret) {
+   memset((void*)_ret, 0, sizeof(*_ret));
+   const int bGain = (_type >= StBiquad::PEQ);
+   const unsigned int numGainSteps = bGain ? (unsigned int)((GAIN_MAX_DB - GAIN_MIN_DB) / GAIN_STEP_DB) : 0u;
+
+   for(unsigned int resIdx = 0u; resIdx <= NUM_RES_STEPS; resIdx++)
+   {
+      float res = float(resIdx) / NUM_RES_STEPS;
+      for(unsigned int freqIdx = 0u; freqIdx <= NUM_FREQ_STEPS; freqIdx++)
+      {
+         float freq = float(freqIdx) / NUM_FREQ_STEPS;
+         for(unsigned int gainIdx = 0u; gainIdx <= numGainSteps; gainIdx++)
+         {
+            float dbGain = bGain ? (GAIN_MIN_DB + gainIdx * GAIN_STEP_DB) : 0.0f;
+            StBiquadCoeff a;
+            StBiquadCoeff e;
+            a.calcParams     (_type, dbGain, freq, res);
+            e.calcParamsExact(_type, dbGain, freq, res);
+            double err = loc_coeff_err(a, e);
+            if(err > _ret->max_err)
+            {
+               _ret->max_err = err;
+               _ret->freq    = freq;
+               _ret->res     = res;
+               _ret->db_gain = dbGain;
+            }
+            _ret->num_evals++;
+         }
+      }
+   }
+}
+
+int main(int argc, char **argv) {
+   double maxErr = DEFAULT_MAX_ERR;
+   int bVerbose = 0;
+
+   for(int argIdx = 1; argIdx < argc; argIdx++)
+   {
+      const char *a = argv[argIdx];
+      int bHasArg = (argIdx + 1) < argc;
+      if(!strcmp(a, "-e") && bHasArg)
+         maxErr = atof(argv[++argIdx]);
+      else if(!strcmp(a, "-V"))
+         bVerbose = 1;
+      else
+      {
+         loc_usage();
+         return 10;
+      }
+   }
+
+   unsigned int numFailed = 0u;
+   for(int type = StBiquad::LPF; type <= StBiquad::HSH; type++)
+   {
+      coeff_err_t r;
+      loc_check_type(type, &r);
+      int bPass = (r.max_err <= maxErr);
+      if(!bPass)
+         numFailed++;
+      if(!bPass || bVerbose)
+         printf("[%s] %s %s: max_err=%g (limit=%g) @freq=%g res=%g gain=%gdB (%u evals)\n",
+                bPass ? "..." : "---",
+                bPass ? "pass" : "FAIL",
+                loc_type_names[type],
+                r.max_err,
+                maxErr,
+                r.freq,
+                r.res,
+                r.db_gain,
+                r.num_evals
+                );
+   }
+
+   printf("[...] stfx_biquad_coeff: %u filter type(s) failed\n", numFailed);
+   return (numFailed > 0u) ? 1 : 0;
+}
@@ -0,0 +1,802 @@
+// ----
+// ---- file   : stfx_golden.cpp
+// ---- legal  : Distributed under terms of the MIT license (https://opensource.org/licenses/MIT)
+// ----          Copyright 2020-2026 by bsp
+// ----
+// ----          Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// ----          associated documentation files (the "Software"), to deal in the Software without restriction, including
+// ----          without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// ----          copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+// ----          the following conditions:
+// ----
+// ----          The above copyright notice and this permission notice shall be included in all copies or substantial
+// ----          portions of the Software.
+// ----
+// ----          THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+// ----          NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// ----          IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// ----          WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// ----          SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ----
+// ----
+// ---- info   : offline golden-output renderer / comparator.
+// ----           renders deterministic stimuli (impulse, sweep, noise) with fixed params and mod ramps through
+// ----           all plugins of one or many plugin libraries, and either records reference renders or
+// ----           compares the output against previously recorded ones (with per-plugin tolerances).
+// ----           optional test cases render the same stimuli again with non-default parameter values.
+// ----
+// ---- created: 16Oct2026
+// ---- changed: 17Oct2026
+// ----
+// ----
+// ----
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef _MSC_VER
+#include <direct.h>
+#define loc_mkdir(a) _mkdir(a)
+#else
+#include <sys/stat.h>
+#define loc_mkdir(a) mkdir(a, 0755)
+#endif
+
+#include "stfx_host.h"
+
+#define GOLDEN_MAGIC    "STFXGOLD"
+#define GOLDEN_VERSION  (1u)
+
+#define STIM_IMPULSE    0
+#define STIM_SWEEP      1
+#define STIM_NOISE      2
+#define STIM_NOISE_MONO 3
+#define NUM_STIMULI     4
+static const char *loc_stim_names[NUM_STIMULI] = {
+   "impulse",
+   "sweep",
+   "noise",
+   "noise_mono",
+};
+
+#define MAX_TOLERANCES   (1024u)
+#define MAX_CASES        (256u)
+#define MAX_CASE_PARAMS  (32u)
+#define MAX_PATH_LEN     (1024u)
+
+typedef struct golden_tolerance_s {
+   char  id[128];       // exact plugin id (or "<id>__<case name>"), or prefix when 'b_prefix' is set ("id*"), or "*"
+   int   b_prefix;
+   float max_abs_err;   // pass when max. abs. error <= max_abs_err
+   float min_snr_db;    //  .. or when signal-to-error ratio >= min_snr_db (0=disabled)
+   int   b_skip;        // "skip": render is not compared (e.g. diverges with the default params)
+} golden_tolerance_t;
+
+typedef struct golden_case_s {
+   char         id[128];       // exact plugin id
+   char         name[64];      // appended to the reference file name ("<id>__<name>.gold")
+   unsigned int num_params;
+   unsigned int param_idx[MAX_CASE_PARAMS];
+   float        param_val[MAX_CASE_PARAMS];
+} golden_case_t;
+
+typedef struct golden_options_s {
+   int          b_record;
+   const char  *ref_dir;
+   const char  *tolerance_file;
+   const char  *case_file;
+   const char  *filter;
+   float        sample_rate;
+   float        num_seconds;   // per stimulus
+   int          b_verbose;
+   int          b_batched;
+   int          b_planar;
+   int          b_add;
+
+   golden_tolerance_t tolerances[MAX_TOLERANCES];
+   unsigned int       num_tolerances;
+
+   golden_case_t      cases[MAX_CASES];
+   unsigned int       num_cases;
+} golden_options_t;
+
+typedef struct golden_stats_s {
+   unsigned int num_passed;
+   unsigned int num_failed;
+   unsigned int num_missing;
+   unsigned int num_skipped;
+   unsigned int num_recorded;
+} golden_stats_t;
+
+
+static void loc_usage(void) {
+   printf(
+      "Usage: stfx_golden record|verify [options] <refdir> <plugin.so> [<plugin.so> ..]\n"
+      "\n"
+      "  -t <file>     tolerance file (default: none => bit-exact)\n"
+      "  -c <file>     test case file (additional renders with non-default param values)\n"
+      "  -f <str>      only process plugins whose id or name contains <str>\n"
+      "  -r <rate>     sample rate (default: 44100)\n"
+      "  -s <sec>      duration per stimulus (default: 0.25)\n"
+      "  -S            single voice calls (don't use process_replace_voices())\n"
+      "  -P            use process_replace_planar() (non-interleaved buffers) when available\n"
+      "  -A            use process_add() (accumulate into cleared output buffer) when available\n"
+      "  -V            verbose (print stats for passed plugins, too)\n"
+           );
+}
+
+// Parse (optionally quoted) id and advance '*_s' to the first char after the id. Returns 0 when the id is invalid.
+static int loc_parse_id(char **_s, char *_ret, size_t _retSize) {
+   char *s = *_s;
+   char *idEnd;
+   if('"' == *s)
+   {
+      s++;
+      idEnd = strchr(s, '"');
+   }
+   else
+   {
+      idEnd = s;
+      while(0 != *idEnd && ' ' != *idEnd && '\t' != *idEnd)
+         idEnd++;
+   }
+   if(NULL == idEnd || (size_t)(idEnd - s) >= _retSize)
+      return 0;
+
+   size_t idLen = (size_t)(idEnd - s);
+   memcpy((void*)_ret, (const void*)s, idLen);
+   _ret[idLen] = 0;
+
+   *_s = idEnd + (('"' == *idEnd) ? 1 : 0);
+   return 1;
+}
+
+static int loc_load_tolerances(golden_options_t *_opt) {
+   FILE *fh = fopen(_opt->tolerance_file, "rb");
+   if(NULL == fh)
+   {
+      printf("[---] stfx_golden: failed to open tolerance file \"%s\"\n", _opt->tolerance_file);
+      return 0;
+   }
+
+   // <id> <max_abs_err> [<min_snr_db>]   (id may be quoted; '#' starts comment)
+   // <id> skip
+   char line[512];
+   while(NULL != fgets(line, sizeof(line), fh))
+   {
+      char *s = line;
+      while(' ' == *s || '\t' == *s)
+         s++;
+      if('#' == *s || '\n' == *s || '\r' == *s || 0 == *s)
+         continue;
+
+      if(_opt->num_tolerances >= MAX_TOLERANCES)
+         break;
+      golden_tolerance_t *tol = &_opt->tolerances[_opt->num_tolerances];
+      memset((void*)tol, 0, sizeof(*tol));
+
+      if(!loc_parse_id(&s, tol->id, sizeof(tol->id)))
+         continue;
+
+      size_t idLen = strlen(tol->id);
+      if(idLen > 0u && '*' == tol->id[idLen - 1u])
+      {
+         tol->id[idLen - 1u] = 0;
+         tol->b_prefix = 1;
+      }
+
+      tol->max_abs_err = 0.0f;
+      tol->min_snr_db  = 0.0f;
+      char keyword[8];
+      if(1 == sscanf(s, " %7s", keyword) && !strcmp(keyword, "skip"))
+         tol->b_skip = 1;
+      else if(sscanf(s, "%f %f", &tol->max_abs_err, &tol->min_snr_db) < 1)
+         continue;
+
+      _opt->num_tolerances++;
+   }
+
+   fclose(fh);
+   return 1;
+}
+
+static int loc_load_cases(golden_options_t *_opt) {
+   FILE *fh = fopen(_opt->case_file, "rb");
+   if(NULL == fh)
+   {
+      printf("[---] stfx_golden: failed to open test case file \"%s\"\n", _opt->case_file);
+      return 0;
+   }
+
+   // <id> <case name> <param idx>=<value> [<param idx>=<value> ..]   (id may be quoted; '#' starts comment)
+   char line[1024];
+   while(NULL != fgets(line, sizeof(line), fh))
+   {
+      char *s = line;
+      while(' ' == *s || '\t' == *s)
+         s++;
+      if('#' == *s || '\n' == *s || '\r' == *s || 0 == *s)
+         continue;
+
+      if(_opt->num_cases >= MAX_CASES)
+         break;
+      golden_case_t *gc = &_opt->cases[_opt->num_cases];
+      memset((void*)gc, 0, sizeof(*gc));
+
+      if(!loc_parse_id(&s, gc->id, sizeof(gc->id)))
+         continue;
+
+      int off;
+      if(1 != sscanf(s, " %63s%n", gc->name, &off))
+         continue;
+      s += off;
+
+      unsigned int paramIdx;
+      float paramVal;
+      while(gc->num_params < MAX_CASE_PARAMS && 2 == sscanf(s, " %u=%f%n", &paramIdx, &paramVal, &off))
+      {
+         gc->param_idx[gc->num_params] = paramIdx;
+         gc->param_val[gc->num_params] = paramVal;
+         gc->num_params++;
+         s += off;
+      }
+
+      _opt->num_cases++;
+   }
+
+   fclose(fh);
+   return 1;
+}
+
+static int loc_find_tolerance(const golden_options_t *_opt, const char *_id, int _bExactOnly, golden_tolerance_t *_ret) {
+   // last matching entry wins. returns 0 when no entry matches (_ret = bit-exact)
+   int bFound = 0;
+   memset((void*)_ret, 0, sizeof(*_ret));
+   for(unsigned int i = 0u; i < _opt->num_tolerances; i++)
+   {
+      const golden_tolerance_t *tol = &_opt->tolerances[i];
+      int bMatch;
+      if(tol->b_prefix)
+         bMatch = !_bExactOnly && !strncmp(_id, tol->id, strlen(tol->id));
+      else
+         bMatch = !strcmp(_id, tol->id);
+      if(bMatch)
+      {
+         *_ret = *tol;
+         bFound = 1;
+      }
+   }
+   return bFound;
+}
+
+static void loc_gen_stimulus(unsigned int _stimIdx, float *_buf, unsigned int _numFrames, float _sampleRate) {
+   unsigned int seed = 0x5EEDu + _stimIdx;
+   switch(_stimIdx)
+   {
+      default:
+      case STIM_IMPULSE:
+         // unit impulse at frame 0 (+ half-level impulse in the middle to excite tails with changed mod state)
+         memset((void*)_buf, 0, sizeof(float) * 2u * _numFrames);
+         _buf[0] = _buf[1] = 1.0f;
+         _buf[(_numFrames / 2u) * 2u + 0u] = 0.5f;
+         _buf[(_numFrames / 2u) * 2u + 1u] = 0.5f;
+         break;
+
+      case STIM_SWEEP:
+      {
+         // exponential sine sweep 20Hz..20kHz (-6dB), right channel phase-shifted by 90 degrees
+         double phase = 0.0;
+         double f0 = 20.0;
+         double f1 = Dstplugin_min(20000.0, _sampleRate * 0.45);
+         double k = log(f1 / f0) / (double)_numFrames;
+         for(unsigned int i = 0u; i < _numFrames; i++)
+         {
+            double f = f0 * exp(k * (double)i);
+            _buf[i * 2u + 0u] = (float)(0.5 * sin(phase));
+            _buf[i * 2u + 1u] = (float)(0.5 * cos(phase));
+            phase += ST_PLUGIN_2PI * f / _sampleRate;
+            if(phase >= ST_PLUGIN_2PI)
+               phase -= ST_PLUGIN_2PI;
+         }
+      }
+      break;
+
+      case STIM_NOISE:
+         for(unsigned int i = 0u; i < _numFrames; i++)
+         {
+            _buf[i * 2u + 0u] = stfx_host_noise(&seed) * 0.5f;
+            _buf[i * 2u + 1u] = stfx_host_noise(&seed) * 0.5f;
+         }
+         break;
+
+      case STIM_NOISE_MONO:
+         for(unsigned int i = 0u; i < _numFrames; i++)
+         {
+            float f = stfx_host_noise(&seed) * 0.5f;
+            _buf[i * 2u + 0u] = f;
+            _buf[i * 2u + 1u] = f;
+         }
+         break;
+   }
+}
+
+// Render all stimuli (fresh shared + voice instance per stimulus)
+//  - 'ret' receives (NUM_STIMULI * 2 * numFrames) floats
+static void loc_process_planar(stfx_host_instance_t *_inst,
+                               const float          *_samplesIn,
+                               float                *_samplesOut,
+                               unsigned int          _numFrames
+                               ) {
+   // De-interleave into aligned scratch buffers, process, re-interleave (1 voice)
+   static float planarMem[4u * (STFX_HOST_MAX_BLOCK_FRAMES + 4u)];
+   float *inL  = (float*)Dstplugin_align((size_t)planarMem, (size_t)ST_PLUGIN_PLANAR_ALIGN);
+   float *inR  = inL + Dstplugin_align(STFX_HOST_MAX_BLOCK_FRAMES, ST_PLUGIN_PLANAR_ALIGN / sizeof(float));
+   float *outL = inR + Dstplugin_align(STFX_HOST_MAX_BLOCK_FRAMES, ST_PLUGIN_PLANAR_ALIGN / sizeof(float));
+   float *outR = outL + Dstplugin_align(STFX_HOST_MAX_BLOCK_FRAMES, ST_PLUGIN_PLANAR_ALIGN / sizeof(float));
+
+   for(unsigned int i = 0u; i < _numFrames; i++)
+   {
+      inL[i] = _samplesIn[i * 2u + 0u];
+      inR[i] = _samplesIn[i * 2u + 1u];
+   }
+
+   stfx_host_instance_process_voices_planar(_inst, inL, inR, &outL, &outR, _numFrames);
+
+   for(unsigned int i = 0u; i < _numFrames; i++)
+   {
+      _samplesOut[i * 2u + 0u] = outL[i];
+      _samplesOut[i * 2u + 1u] = outR[i];
+   }
+}
+
+static int loc_render_plugin(st_plugin_info_t       *_info,
+                             const golden_options_t *_opt,
+                             const golden_case_t    *_case,  // NULL=default params
+                             unsigned int            _numFrames,
+                             float                  *_stimBuf,
+                             float                  *_ret
+                             ) {
+   for(unsigned int stimIdx = 0u; stimIdx < NUM_STIMULI; stimIdx++)
+   {
+      loc_gen_stimulus(stimIdx, _stimBuf, _numFrames, _opt->sample_rate);
+
+      stfx_host_config_t config;
+      memset((void*)&config, 0, sizeof(config));
+      config.sample_rate = _opt->sample_rate;
+      config.bpm         = 125.0f;
+      config.num_voices  = 1u;
+      config.note        = 60u;
+      config.vel         = 1.0f;
+      config.b_mono_in   = (STIM_NOISE_MONO == stimIdx);
+      config.b_mod_ramps = 1;
+      config.b_batched   = _opt->b_batched;
+      config.b_planar    = _opt->b_planar;
+      config.b_add       = _opt->b_add;
+
+      stfx_host_instance_t inst;
+      if(!stfx_host_instance_init(&inst, _info, &config))
+      {
+         stfx_host_instance_exit(&inst);
+         return 0;
+      }
+
+      if(NULL != _case)
+      {
+         for(unsigned int i = 0u; i < _case->num_params; i++)
+         {
+            if(_case->param_idx[i] < _info->num_params)
+               _info->set_param_value(inst.shared, _case->param_idx[i], _case->param_val[i]);
+         }
+      }
+
+      float *out = _ret + (stimIdx * 2u * _numFrames);
+      unsigned int frameOff = 0u;
+      while(frameOff < _numFrames)
+      {
+         unsigned int numFrames = stfx_host_instance_next_block_size(&inst);
+         if(frameOff + numFrames > _numFrames)
+            numFrames = _numFrames - frameOff;
+
+         const float *samplesIn = _stimBuf + (frameOff * 2u);
+
+         if(_info->flags & ST_PLUGIN_FLAG_XMOD)
+            stfx_host_instance_set_voice_bus(&inst, samplesIn, numFrames);
+
+         float *samplesOut = out + (frameOff * 2u);
+         if(_opt->b_add)
+         {
+            memset((void*)samplesOut, 0, sizeof(float) * 2u * numFrames);
+            stfx_host_instance_process_voices_add(&inst, samplesIn, samplesOut, numFrames, 1.0f/*gain*/);
+         }
+         else if(stfx_host_instance_use_planar(&inst))
+            loc_process_planar(&inst, samplesIn, samplesOut, numFrames);
+         else
+            stfx_host_instance_process_voices(&inst, samplesIn, &samplesOut, numFrames);
+         stfx_host_instance_end_block(&inst);
+
+         frameOff += numFrames;
+      }
+
+      stfx_host_instance_exit(&inst);
+   }
+   return 1;
+}
+
+static int loc_append_sanitized(char *_buf, int _off, const char *_s) {
+   // (note) reserves space for ".gold" suffix
+   for(const char *s = _s; 0 != *s && _off < (int)MAX_PATH_LEN - 6; s++)
+   {
+      char c = *s;
+      int bValid = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || '-' == c;
+      _buf[_off++] = bValid ? c : '_';
+   }
+   return _off;
+}
+
+static void loc_make_ref_path(char *_buf, const golden_options_t *_opt, const char *_libPathName, const char *_id, const golden_case_t *_case) {
+   // <refdir>/<lib basename>/<sanitized id>[__<sanitized case name>].gold
+   const char *libName = _libPathName;
+   for(const char *s = _libPathName; 0 != *s; s++)
+   {
+      if('/' == *s || '\\' == *s)
+         libName = s + 1;
+   }
+
+   int off = snprintf(_buf, MAX_PATH_LEN, "%s/", _opt->ref_dir);
+   for(const char *s = libName; 0 != *s && '.' != *s && off < (int)MAX_PATH_LEN - 1; s++)
+      _buf[off++] = *s;
+   _buf[off] = 0;
+   if(_opt->b_record)
+      loc_mkdir(_buf);
+
+   if(off < (int)MAX_PATH_LEN - 1)
+      _buf[off++] = '/';
+   off = loc_append_sanitized(_buf, off, _id);
+   if(NULL != _case)
+   {
+      off = loc_append_sanitized(_buf, off, "__");
+      off = loc_append_sanitized(_buf, off, _case->name);
+   }
+   memcpy((void*)(_buf + off), (const void*)".gold", 6);
+}
+
+static int loc_write_ref(const char *_pathName, const golden_options_t *_opt, unsigned int _numFrames, const float *_data) {
+   FILE *fh = fopen(_pathName, "wb");
+   if(NULL == fh)
+      return 0;
+   unsigned int hdr[4] = { GOLDEN_VERSION, (unsigned int)_opt->sample_rate, _numFrames, NUM_STIMULI };
+   int bOk = (8u == fwrite(GOLDEN_MAGIC, 1u, 8u, fh));
+   bOk = bOk && (4u == fwrite((const void*)hdr, sizeof(unsigned int), 4u, fh));
+   bOk = bOk && ((NUM_STIMULI * 2u * _numFrames) == fwrite((const void*)_data, sizeof(float), NUM_STIMULI * 2u * _numFrames, fh));
+   fclose(fh);
+   return bOk;
+}
+
+static int loc_read_ref(const char *_pathName, const golden_options_t *_opt, unsigned int _numFrames, float *_ret) {
+   FILE *fh = fopen(_pathName, "rb");
+   if(NULL == fh)
+      return 0;
+   char magic[8];
+   unsigned int hdr[4];
+   int bOk = (8u == fread((void*)magic, 1u, 8u, fh)) && !memcmp(magic, GOLDEN_MAGIC, 8u);
+   bOk = bOk && (4u == fread((void*)hdr, sizeof(unsigned int), 4u, fh));
+   bOk = bOk && (GOLDEN_VERSION == hdr[0]) && ((unsigned int)_opt->sample_rate == hdr[1]);
+   bOk = bOk && (_numFrames == hdr[2]) && (NUM_STIMULI == hdr[3]);
+   bOk = bOk && ((NUM_STIMULI * 2u * _numFrames) == fread((void*)_ret, sizeof(float), NUM_STIMULI * 2u * _numFrames, fh));
+   fclose(fh);
+   if(!bOk)
+      printf("[---] stfx_golden: reference file \"%s\" is invalid or was recorded with different settings\n", _pathName);
+   return bOk;
+}
+
+// Compare one stimulus render. Returns 1 when within tolerance.
+static int loc_compare(const float              *_ref,
+                       const float              *_out,
+                       unsigned int              _numSamples,
+                       const golden_tolerance_t *_tol,
+                       float                    *_retMaxAbsErr,
+                       float                    *_retSnrDb,
+                       unsigned int             *_retFirstErrIdx
+                       ) {
+   double sumSig = 0.0;
+   double sumErr = 0.0;
+   float maxAbsErr = 0.0f;
+   unsigned int firstErrIdx = ~0u;
+   int bNaNMismatch = 0;
+
+   for(unsigned int i = 0u; i < _numSamples; i++)
+   {
+      float r = _ref[i];
+      float o = _out[i];
+      int bRefNaN = (r != r);
+      int bOutNaN = (o != o);
+      if(bRefNaN || bOutNaN)
+      {
+         if(bRefNaN != bOutNaN)
+         {
+            bNaNMismatch = 1;
+            if(~0u == firstErrIdx)
+               firstErrIdx = i;
+         }
+         continue;
+      }
+      if(r == o)
+      {
+         // (note) also matches +-inf
+         if((r - r) == 0.0f)
+            sumSig += (double)r * r;
+         continue;
+      }
+      float d = o - r;
+      float ad = Dstplugin_abs(d);
+      if(ad > 0.0f && ~0u == firstErrIdx)
+         firstErrIdx = i;
+      if(ad > maxAbsErr || ad != ad/*inf-inf*/)
+         maxAbsErr = ad;
+      if((r - r) == 0.0f)
+         sumSig += (double)r * r;
+      sumErr += (double)d * d;
+   }
+
+   float snrDb;
+   if(sumErr <= 0.0)
+      snrDb = 999.0f;
+   else if(sumSig <= 0.0)
+      snrDb = -999.0f;
+   else
+      snrDb = (float)(10.0 * log10(sumSig / sumErr));
+
+   *_retMaxAbsErr = maxAbsErr;
+   *_retSnrDb = snrDb;
+   *_retFirstErrIdx = firstErrIdx;
+
+   if(bNaNMismatch)
+      return 0;
+   if(maxAbsErr <= _tol->max_abs_err)
+      return 1;
+   if(_tol->min_snr_db > 0.0f && snrDb >= _tol->min_snr_db)
+      return 1;
+   return 0;
+}
+
+// Render, then record or verify one plugin (default params or test case)
+static void loc_process_plugin(const char             *_pathName,
+                               const golden_options_t *_opt,
+                               st_plugin_info_t       *_info,
+                               unsigned int            _pluginIdx,
+                               const golden_case_t    *_case,
+                               unsigned int            _numFrames,
+                               float                  *_stimBuf,
+                               float                  *_outBuf,
+                               float                  *_refBuf,
+                               golden_stats_t         *_stats
+                               ) {
+   char refPath[MAX_PATH_LEN];
+   loc_make_ref_path(refPath, _opt, _pathName, _info->id, _case);
+
+   const char *caseName = (NULL != _case) ? _case->name : "";
+   const char *caseSep  = (NULL != _case) ? " " : "";
+
+   golden_tolerance_t tol;
+   loc_find_tolerance(_opt, _info->id, 0/*bExactOnly*/, &tol);
+   if(NULL != _case)
+   {
+      // test case specific tolerance ("<id>__<case name>", exact match only) overrides the plugin tolerance
+      char caseId[sizeof(_case->id) + 2u + sizeof(_case->name)];
+      snprintf(caseId, sizeof(caseId), "%s__%s", _info->id, _case->name);
+      golden_tolerance_t caseTol;
+      if(loc_find_tolerance(_opt, caseId, 1/*bExactOnly*/, &caseTol))
+         tol = caseTol;
+   }
+
+   if(!loc_render_plugin(_info, _opt, _case, _numFrames, _stimBuf, _outBuf))
+   {
+      printf("[---] FAIL %3u \"%s\"%s%s: failed to create instance\n", _pluginIdx, _info->id, caseSep, caseName);
+      _stats->num_failed++;
+   }
+   else if(_opt->b_record)
+   {
+      if(loc_write_ref(refPath, _opt, _numFrames, _outBuf))
+      {
+         if(_opt->b_verbose)
+            printf("[...] rec  %3u \"%s\"%s%s => \"%s\"\n", _pluginIdx, _info->id, caseSep, caseName, refPath);
+         _stats->num_recorded++;
+      }
+      else
+      {
+         printf("[---] FAIL %3u \"%s\"%s%s: failed to write \"%s\"\n", _pluginIdx, _info->id, caseSep, caseName, refPath);
+         _stats->num_failed++;
+      }
+   }
+   else if(tol.b_skip)
+   {
+      if(_opt->b_verbose)
+         printf("[...] skip %3u \"%s\"%s%s\n", _pluginIdx, _info->id, caseSep, caseName);
+      _stats->num_skipped++;
+   }
+   else if(!loc_read_ref(refPath, _opt, _numFrames, _refBuf))
+   {
+      printf("[~~~] MISS %3u \"%s\"%s%s: no reference (\"%s\")\n", _pluginIdx, _info->id, caseSep, caseName, refPath);
+      _stats->num_missing++;
+   }
+   else
+   {
+      int bPass = 1;
+      for(unsigned int stimIdx = 0u; stimIdx < NUM_STIMULI; stimIdx++)
+      {
+         float maxAbsErr;
+         float snrDb;
+         unsigned int firstErrIdx;
+         unsigned int off = stimIdx * 2u * _numFrames;
+         int bStimPass = loc_compare(_refBuf + off, _outBuf + off, 2u * _numFrames, &tol,
+                                     &maxAbsErr, &snrDb, &firstErrIdx
+                                     );
+         if(!bStimPass || _opt->b_verbose)
+         {
+            printf("[%s] %s %3u \"%s\"%s%s %-10s: maxAbsErr=%g snr=%.1fdB (tol=%g / %.1fdB)",
+                   bStimPass ? "..." : "---",
+                   bStimPass ? "pass" : "FAIL",
+                   _pluginIdx, _info->id, caseSep, caseName, loc_stim_names[stimIdx],
+                   maxAbsErr, snrDb, tol.max_abs_err, tol.min_snr_db
+                   );
+            if(~0u != firstErrIdx)
+               printf(" firstErr@frame %u", firstErrIdx / 2u);
+            printf("\n");
+         }
+         bPass = bPass && bStimPass;
+      }
+
+      if(bPass)
+         _stats->num_passed++;
+      else
+         _stats->num_failed++;
+   }
+   fflush(stdout);
+}
+
+static void loc_process_lib(const char *_pathName, const golden_options_t *_opt, golden_stats_t *_stats) {
+   stfx_host_lib_t lib;
+   if(!stfx_host_lib_open(&lib, _pathName))
+   {
+      _stats->num_failed++;
+      return;
+   }
+
+   unsigned int numFrames = (unsigned int)(_opt->num_seconds * _opt->sample_rate);
+   float *stimBuf = (float*)malloc(sizeof(float) * 2u * numFrames);
+   float *outBuf  = (float*)malloc(sizeof(float) * 2u * numFrames * NUM_STIMULI);
+   float *refBuf  = (float*)malloc(sizeof(float) * 2u * numFrames * NUM_STIMULI);
+
+   if(NULL != stimBuf && NULL != outBuf && NULL != refBuf)
+   {
+      for(unsigned int pluginIdx = 0u; pluginIdx < ST_PLUGIN_MAX; pluginIdx++)
+      {
+         st_plugin_info_t *info = lib.init_fxn(pluginIdx);
+         if(NULL == info)
+            break;
+
+         int bMatch = (NULL == _opt->filter) ||
+            (NULL != strstr(info->id, _opt->filter)) ||
+            (NULL != info->name && NULL != strstr(info->name, _opt->filter));
+
+         if(bMatch)
+         {
+            loc_process_plugin(_pathName, _opt, info, pluginIdx, NULL/*case*/, numFrames, stimBuf, outBuf, refBuf, _stats);
+
+            for(unsigned int caseIdx = 0u; caseIdx < _opt->num_cases; caseIdx++)
+            {
+               const golden_case_t *gc = &_opt->cases[caseIdx];
+               if(!strcmp(gc->id, info->id))
+                  loc_process_plugin(_pathName, _opt, info, pluginIdx, gc, numFrames, stimBuf, outBuf, refBuf, _stats);
+            }
+         }
+
+         if(NULL != info->plugin_exit)
+            info->plugin_exit(info);
+      }
+   }
+   else
+   {
+      _stats->num_failed++;
+   }
+
+   free((void*)refBuf);
+   free((void*)outBuf);
+   free((void*)stimBuf);
+
+   stfx_host_lib_close(&lib);
+}
+
+int main(int argc, char **argv) {
+   static golden_options_t opt;
+   memset((void*)&opt, 0, sizeof(opt));
+   opt.sample_rate = 44100.0f;
+   opt.num_seconds = 0.25f;
+   opt.b_batched   = 1;
+
+   if(argc < 2)
+   {
+      loc_usage();
+      return 10;
+   }
+
+   if(!strcmp(argv[1], "record"))
+      opt.b_record = 1;
+   else if(strcmp(argv[1], "verify"))
+   {
+      loc_usage();
+      return 10;
+   }
+
+   int argIdx = 2;
+   for(; argIdx < argc; argIdx++)
+   {
+      const char *a = argv[argIdx];
+      if('-' != a[0])
+         break;
+      int bHasArg = (argIdx + 1) < argc;
+      if(!strcmp(a, "-t") && bHasArg)
+         opt.tolerance_file = argv[++argIdx];
+      else if(!strcmp(a, "-c") && bHasArg)
+         opt.case_file = argv[++argIdx];
+      else if(!strcmp(a, "-f") && bHasArg)
+         opt.filter = argv[++argIdx];
+      else if(!strcmp(a, "-r") && bHasArg)
+         opt.sample_rate = (float)atof(argv[++argIdx]);
+      else if(!strcmp(a, "-s") && bHasArg)
+         opt.num_seconds = (float)atof(argv[++argIdx]);
+      else if(!strcmp(a, "-S"))
+         opt.b_batched = 0;
+      else if(!strcmp(a, "-P"))
+         opt.b_planar = 1;
+      else if(!strcmp(a, "-A"))
+         opt.b_add = 1;
+      else if(!strcmp(a, "-V"))
+         opt.b_verbose = 1;
+      else
+      {
+         loc_usage();
+         return 10;
+      }
+   }
+
+   if(argIdx + 2 > argc)
+   {
+      loc_usage();
+      return 10;
+   }
+
+   opt.sample_rate = Dstplugin_clamp(opt.sample_rate, 8000.0f, (float)(STFX_HOST_MAX_BLOCK_FRAMES * STFX_HOST_BLOCK_RATE));
+   opt.num_seconds = Dstplugin_clamp(opt.num_seconds, 0.01f, 60.0f);
+
+   if(NULL != opt.tolerance_file)
+   {
+      if(!loc_load_tolerances(&opt))
+         return 10;
+   }
+
+   if(NULL != opt.case_file)
+   {
+      if(!loc_load_cases(&opt))
+         return 10;
+   }
+
+   opt.ref_dir = argv[argIdx++];
+   if(opt.b_record)
+      loc_mkdir(opt.ref_dir);
+
+   golden_stats_t stats;
+   memset((void*)&stats, 0, sizeof(stats));
+
+   for(; argIdx < argc; argIdx++)
+      loc_process_lib(argv[argIdx], &opt, &stats);
+
+   if(opt.b_record)
+      printf("[...] stfx_golden: recorded %u reference(s), %u failure(s)\n", stats.num_recorded, stats.num_failed);
+   else
+      printf("[...] stfx_golden: %u passed, %u failed, %u missing, %u skipped\n", stats.num_passed, stats.num_failed, stats.num_missing, stats.num_skipped);
+
+   return (stats.num_failed > 0u) ? 1 : 0;
+}
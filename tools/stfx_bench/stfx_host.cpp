@@ -0,0 +1,583 @@
+// ----
+// ---- file   : stfx_host.cpp
+// ---- legal  : Distributed under terms of the MIT license (https://opensource.org/licenses/MIT)
+// ----          Copyright 2020-2026 by bsp
+// ----
+// ----          Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// ----          associated documentation files (the "Software"), to deal in the Software without restriction, including
+// ----          without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// ----          copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+// ----          the following conditions:
+// ----
+// ----          The above copyright notice and this permission notice shall be included in all copies or substantial
+// ----          portions of the Software.
+// ----
+// ----          THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+// ----          NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// ----          IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// ----          WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// ----          SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ----
+// ----
+// ---- info   : minimal reference host for stfx plugin libraries (used by stfx_bench)
+// ----
+// ---- created: 16Oct2026
+// ---- changed:
+// ----
+// ----
+// ----
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef _MSC_VER
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#include <time.h>
+#endif
+
+#include "stfx_host.h"
+
+
+double stfx_host_time_ns(void) {
+#ifdef _MSC_VER
+   static LARGE_INTEGER freq = { 0 };
+   LARGE_INTEGER t;
+   if(0 == freq.QuadPart)
+      QueryPerformanceFrequency(&freq);
+   QueryPerformanceCounter(&t);
+   return (double)t.QuadPart * (1000000000.0 / (double)freq.QuadPart);
+#else
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (double)ts.tv_sec * 1000000000.0 + (double)ts.tv_nsec;
+#endif
+}
+
+int stfx_host_lib_open(stfx_host_lib_t *_lib, const char *_pathName) {
+   memset((void*)_lib, 0, sizeof(*_lib));
+   _lib->path_name = _pathName;
+
+#ifdef _MSC_VER
+   HINSTANCE dllHandle = LoadLibrary(_pathName);
+   if(NULL == dllHandle)
+   {
+      printf("[---] stfx_host: failed to load \"%s\"\n", _pathName);
+      return 0;
+   }
+   _lib->dll_handle = (void*)dllHandle;
+   _lib->init_fxn = (st_plugin_init_fxn_t)GetProcAddress(dllHandle, "st_plugin_init");
+#else
+   _lib->dll_handle = dlopen(_pathName, RTLD_NOW | RTLD_LOCAL);
+   if(NULL == _lib->dll_handle)
+   {
+      printf("[---] stfx_host: failed to load \"%s\" (%s)\n", _pathName, dlerror());
+      return 0;
+   }
+   _lib->init_fxn = (st_plugin_init_fxn_t)dlsym(_lib->dll_handle, "st_plugin_init");
+#endif
+
+   if(NULL == _lib->init_fxn)
+   {
+      printf("[---] stfx_host: \"%s\" does not export st_plugin_init()\n", _pathName);
+      stfx_host_lib_close(_lib);
+      return 0;
+   }
+
+   return 1;
+}
+
+void stfx_host_lib_close(stfx_host_lib_t *_lib) {
+   if(NULL != _lib->dll_handle)
+   {
+#ifdef _MSC_VER
+      FreeLibrary((HINSTANCE)_lib->dll_handle);
+#else
+      dlclose(_lib->dll_handle);
+#endif
+      _lib->dll_handle = NULL;
+   }
+   _lib->init_fxn = NULL;
+}
+
+float stfx_host_noise(unsigned int *_seed) {
+   // LCG (same sequence on all platforms)
+   *_seed = (*_seed * 1664525u) + 1013904223u;
+   return ((float)(*_seed >> 8) * (2.0f / 16777216.0f)) - 1.0f;
+}
+
+static void *ST_PLUGIN_API loc_arena_alloc(st_plugin_allocator_t *_allocator, size_t _size, size_t _align) {
+   stfx_host_arena_t *arena = (stfx_host_arena_t*)_allocator;
+   size_t off = Dstplugin_align(arena->used, _align);
+   if(off + _size > arena->size)
+      return NULL;
+   arena->used = off + _size;
+   if(arena->used > arena->peak_used)
+      arena->peak_used = arena->used;
+   return (void*)(arena->mem + off);
+}
+
+static void ST_PLUGIN_API loc_arena_free(st_plugin_allocator_t *_allocator, void *_ptr) {
+   // (note) memory is released in stfx_host_arena_reset()
+   (void)_allocator;
+   (void)_ptr;
+}
+
+int stfx_host_arena_init(stfx_host_arena_t *_arena, size_t _size) {
+   memset((void*)_arena, 0, sizeof(*_arena));
+   _arena->mem_raw = (unsigned char*)malloc(_size + ST_PLUGIN_ALLOC_ALIGN);
+   if(NULL == _arena->mem_raw)
+      return 0;
+   _arena->mem  = (unsigned char*)Dstplugin_align((size_t)_arena->mem_raw, (size_t)ST_PLUGIN_ALLOC_ALIGN);
+   _arena->size = _size;
+
+   // Pre-fault pages
+   memset((void*)_arena->mem, 0, _size);
+
+   _arena->base.mem_alloc = &loc_arena_alloc;
+   _arena->base.mem_free  = &loc_arena_free;
+   _arena->base.user_data = NULL;
+   return 1;
+}
+
+void stfx_host_arena_exit(stfx_host_arena_t *_arena) {
+   free((void*)_arena->mem_raw);
+   memset((void*)_arena, 0, sizeof(*_arena));
+}
+
+void stfx_host_arena_reset(stfx_host_arena_t *_arena) {
+   _arena->used = 0u;
+}
+
+// Initialize host-managed voice fields, set sample rate / bpm, trigger note on and prepare first block
+static void loc_start_voice(stfx_host_instance_t *_inst, unsigned int _voiceIdx) {
+   st_plugin_info_t *info = _inst->info;
+   const stfx_host_config_t *config = _inst->config;
+   st_plugin_voice_t *voice = _inst->voices[_voiceIdx];
+
+   voice->shared            = _inst->shared;
+   voice->voice_bus_buffers = _inst->voice_bus_buffers;
+   voice->voice_bus_read_offset = 0u;
+   voice->layer_idx         = 0u;
+   voice->voice_idx         = _voiceIdx;
+   voice->active_note_idx   = 0u;
+   voice->note_hz           = 440.0f * powf(2.0f, ((float)config->note - 69.0f) / 12.0f);
+
+   if(NULL != info->set_sample_rate)
+      info->set_sample_rate(voice, config->sample_rate);
+
+   if(NULL != info->set_bpm)
+      info->set_bpm(voice, config->bpm);
+
+   if(NULL != info->note_on)
+      info->note_on(voice, 0/*bGlide*/, (unsigned char)config->note, config->vel);
+
+   if(NULL != info->prepare_block)
+      info->prepare_block(voice, 0u/*numFrames*/, voice->note_hz, (float)config->note, 1.0f/*vol*/, 0.0f/*pan*/);
+}
+
+int stfx_host_instance_init(stfx_host_instance_t     *_inst,
+                            st_plugin_info_t         *_info,
+                            const stfx_host_config_t *_config
+                            ) {
+   memset((void*)_inst, 0, sizeof(*_inst));
+   _inst->config = _config;
+   _inst->info   = _info;
+
+   if(NULL == _info->shared_new || NULL == _info->voice_new || NULL == _info->process_replace)
+      return 0;
+
+   _info->allocator = _config->allocator;
+
+   // Voice buses (silence until stfx_host_instance_set_voice_bus() is called)
+   _inst->voice_bus_mem = (float*)malloc(sizeof(float) * 2u * STFX_HOST_MAX_BLOCK_FRAMES * ST_PLUGIN_MAX_LAYERS);
+   if(NULL == _inst->voice_bus_mem)
+      return 0;
+   memset((void*)_inst->voice_bus_mem, 0, sizeof(float) * 2u * STFX_HOST_MAX_BLOCK_FRAMES * ST_PLUGIN_MAX_LAYERS);
+   for(unsigned int busIdx = 0u; busIdx < ST_PLUGIN_MAX_LAYERS; busIdx++)
+      _inst->voice_bus_buffers[busIdx] = _inst->voice_bus_mem + (2u * STFX_HOST_MAX_BLOCK_FRAMES * busIdx);
+
+   double t = stfx_host_time_ns();
+   _inst->shared = _info->shared_new(_info);
+   _inst->t_shared_new = stfx_host_time_ns() - t;
+   if(NULL == _inst->shared)
+      return 0;
+
+   // Largest block returned by stfx_host_instance_next_block_size()
+   _inst->max_block_frames = (unsigned int)ceil((double)_config->sample_rate / (double)STFX_HOST_BLOCK_RATE);
+   if(_inst->max_block_frames > STFX_HOST_MAX_BLOCK_FRAMES)
+      _inst->max_block_frames = STFX_HOST_MAX_BLOCK_FRAMES;
+   if(NULL != _info->set_max_block_size)
+      _info->set_max_block_size(_inst->shared, _inst->max_block_frames);
+
+   if(NULL != _info->set_param_value)
+   {
+      for(unsigned int paramIdx = 0u; paramIdx < _info->num_params; paramIdx++)
+      {
+         float v = (NULL != _info->get_param_reset) ? _info->get_param_reset(_info, paramIdx) : 0.0f;
+         _info->set_param_value(_inst->shared, paramIdx, v);
+      }
+   }
+
+   unsigned int numVoices = Dstplugin_clamp(_config->num_voices, 1u, STFX_HOST_MAX_VOICES);
+   for(unsigned int voiceIdx = 0u; voiceIdx < numVoices; voiceIdx++)
+   {
+      t = stfx_host_time_ns();
+      st_plugin_voice_t *voice = _info->voice_new(_info, voiceIdx);
+      _inst->t_voice_new += stfx_host_time_ns() - t;
+      if(NULL == voice)
+         return 0;
+      _inst->voices[voiceIdx] = voice;
+      _inst->num_voices = voiceIdx + 1u;
+
+      loc_start_voice(_inst, voiceIdx);
+   }
+
+   return 1;
+}
+
+int stfx_host_instance_steal_voices(stfx_host_instance_t *_inst) {
+   st_plugin_info_t *info = _inst->info;
+   for(unsigned int voiceIdx = 0u; voiceIdx < _inst->num_voices; voiceIdx++)
+   {
+      double t = stfx_host_time_ns();
+      if(NULL != info->voice_reset)
+      {
+         info->voice_reset(_inst->voices[voiceIdx], voiceIdx);
+      }
+      else
+      {
+         info->voice_delete(_inst->voices[voiceIdx]);
+         _inst->voices[voiceIdx] = info->voice_new(info, voiceIdx);
+      }
+      _inst->t_voice_steal += stfx_host_time_ns() - t;
+      _inst->num_voice_steals++;
+
+      if(NULL == _inst->voices[voiceIdx])
+         return 0;  // (note) stfx_host_instance_exit() skips NULL voices
+
+      loc_start_voice(_inst, voiceIdx);
+      _inst->voice_silent[voiceIdx] = 0;
+   }
+   return 1;
+}
+
+void stfx_host_instance_exit(stfx_host_instance_t *_inst) {
+   if(NULL != _inst->info)
+   {
+      for(unsigned int voiceIdx = 0u; voiceIdx < _inst->num_voices; voiceIdx++)
+      {
+         if(NULL != _inst->voices[voiceIdx])
+         {
+            _inst->info->voice_delete(_inst->voices[voiceIdx]);
+            _inst->voices[voiceIdx] = NULL;
+         }
+      }
+      _inst->num_voices = 0u;
+
+      if(NULL != _inst->shared)
+      {
+         _inst->info->shared_delete(_inst->shared);
+         _inst->shared = NULL;
+      }
+   }
+
+   free((void*)_inst->voice_bus_mem);
+   _inst->voice_bus_mem = NULL;
+}
+
+unsigned int stfx_host_instance_next_block_size(stfx_host_instance_t *_inst) {
+   double framesPerBlock = (double)_inst->config->sample_rate / (double)STFX_HOST_BLOCK_RATE;
+   double accNext = _inst->block_frames_acc + framesPerBlock;
+   unsigned int numFrames = (unsigned int)accNext - (unsigned int)_inst->block_frames_acc;
+   _inst->block_frames_acc = accNext - (double)((unsigned int)accNext);
+   if(numFrames > STFX_HOST_MAX_BLOCK_FRAMES)
+      numFrames = STFX_HOST_MAX_BLOCK_FRAMES;
+   return numFrames;
+}
+
+void stfx_host_instance_set_voice_bus(stfx_host_instance_t *_inst,
+                                      const float          *_samples,
+                                      unsigned int          _numFrames
+                                      ) {
+   if(_numFrames > STFX_HOST_MAX_BLOCK_FRAMES)
+      _numFrames = STFX_HOST_MAX_BLOCK_FRAMES;
+   for(unsigned int busIdx = 0u; busIdx < ST_PLUGIN_MAX_LAYERS; busIdx++)
+      memcpy((void*)_inst->voice_bus_buffers[busIdx], (const void*)_samples, sizeof(float) * 2u * _numFrames);
+}
+
+static void loc_update_mods(stfx_host_instance_t *_inst, unsigned int _voiceIdx) {
+   st_plugin_info_t  *info  = _inst->info;
+   st_plugin_voice_t *voice = _inst->voices[_voiceIdx];
+
+   if(_inst->config->b_mod_ramps && NULL != info->set_mod_value)
+   {
+      // Deterministic triangle ramps (-0.25..0.25), different period per mod slot
+      for(unsigned int modIdx = 0u; modIdx < info->num_mods; modIdx++)
+      {
+         unsigned int period = 64u + (modIdx * 24u);
+         unsigned int ph = (_inst->block_idx + (_voiceIdx * 7u)) % period;
+         float t = (float)ph / (float)period;
+         float v = (t < 0.5f) ? (t * 4.0f - 1.0f) : (3.0f - t * 4.0f);
+         info->set_mod_value(voice, modIdx, v * 0.25f, 0u/*frameOff*/);
+      }
+   }
+
+   voice->voice_bus_read_offset = 0u;
+}
+
+static int loc_is_silent(const float *_samples, unsigned int _num) {
+   float peak = 0.0f;
+   Dstplugin_peak_buf(peak, _samples, _num);
+   return (peak < ST_PLUGIN_SILENCE_THRESHOLD);
+}
+
+// Returns 1 when the voice can be skipped (tail has ended and input is silent)
+static int loc_skip_voice(stfx_host_instance_t *_inst, unsigned int _voiceIdx, int _bInputSilent) {
+   _inst->num_voice_blocks++;
+   if(_inst->voice_silent[_voiceIdx] && _bInputSilent)
+   {
+      _inst->num_voice_blocks_skipped++;
+      return 1;
+   }
+   return 0;
+}
+
+static void loc_query_tail_state(stfx_host_instance_t *_inst, unsigned int _voiceIdx) {
+   st_plugin_info_t *info = _inst->info;
+   if(_inst->config->b_skip_silent && NULL != info->query_tail_state)
+      _inst->voice_silent[_voiceIdx] = (ST_PLUGIN_TAIL_SILENT == info->query_tail_state(_inst->voices[_voiceIdx]));
+}
+
+static void loc_process_voice(stfx_host_instance_t *_inst,
+                              unsigned int          _voiceIdx,
+                              const float          *_samplesIn,
+                              float                *_samplesOut,
+                              unsigned int          _numFrames
+                              ) {
+   st_plugin_info_t  *info  = _inst->info;
+   st_plugin_voice_t *voice = _inst->voices[_voiceIdx];
+   const stfx_host_config_t *config = _inst->config;
+
+   loc_update_mods(_inst, _voiceIdx);
+
+   if(NULL != info->prepare_block)
+      info->prepare_block(voice, _numFrames, voice->note_hz, (float)config->note, 1.0f/*vol*/, 0.0f/*pan*/);
+
+   info->process_replace(voice, config->b_mono_in, _samplesIn, _samplesOut, _numFrames);
+
+   loc_query_tail_state(_inst, _voiceIdx);
+}
+
+void stfx_host_instance_process_voice(stfx_host_instance_t *_inst,
+                                      unsigned int          _voiceIdx,
+                                      const float          *_samplesIn,
+                                      float                *_samplesOut,
+                                      unsigned int          _numFrames
+                                      ) {
+   if(_inst->config->b_skip_silent && loc_skip_voice(_inst, _voiceIdx, loc_is_silent(_samplesIn, _numFrames * 2u)))
+      memset((void*)_samplesOut, 0, sizeof(float) * 2u * _numFrames);
+   else
+      loc_process_voice(_inst, _voiceIdx, _samplesIn, _samplesOut, _numFrames);
+}
+
+void stfx_host_instance_process_voices(stfx_host_instance_t *_inst,
+                                       const float          *_samplesIn,
+                                       float               **_samplesOut,
+                                       unsigned int          _numFrames
+                                       ) {
+   st_plugin_info_t *info = _inst->info;
+   const stfx_host_config_t *config = _inst->config;
+
+   // (note) input is shared by all voices
+   int bInputSilent = config->b_skip_silent && loc_is_silent(_samplesIn, _numFrames * 2u);
+
+   if(config->b_batched && NULL != info->process_replace_voices)
+   {
+      unsigned int numBlocks = 0u;
+      for(unsigned int voiceIdx = 0u; voiceIdx < _inst->num_voices; voiceIdx++)
+      {
+         if(config->b_skip_silent && loc_skip_voice(_inst, voiceIdx, bInputSilent))
+         {
+            memset((void*)_samplesOut[voiceIdx], 0, sizeof(float) * 2u * _numFrames);
+            continue;
+         }
+
+         st_plugin_voice_t *voice = _inst->voices[voiceIdx];
+         loc_update_mods(_inst, voiceIdx);
+
+         st_plugin_voice_block_t *block = &_inst->blocks[numBlocks++];
+         block->voice       = voice;
+         block->freq_hz     = voice->note_hz;
+         block->note        = (float)config->note;
+         block->vol         = 1.0f;
+         block->pan         = 0.0f;
+         block->b_mono_in   = config->b_mono_in;
+         block->samples_in  = _samplesIn;
+         block->samples_out = _samplesOut[voiceIdx];
+      }
+
+      if(numBlocks > 0u)
+      {
+         info->process_replace_voices(_inst->blocks, numBlocks, _numFrames);
+
+         for(unsigned int blockIdx = 0u; blockIdx < numBlocks; blockIdx++)
+            loc_query_tail_state(_inst, _inst->blocks[blockIdx].voice->voice_idx);
+      }
+   }
+   else
+   {
+      // Fallback: per-voice calls
+      for(unsigned int voiceIdx = 0u; voiceIdx < _inst->num_voices; voiceIdx++)
+      {
+         if(config->b_skip_silent && loc_skip_voice(_inst, voiceIdx, bInputSilent))
+            memset((void*)_samplesOut[voiceIdx], 0, sizeof(float) * 2u * _numFrames);
+         else
+            loc_process_voice(_inst, voiceIdx, _samplesIn, _samplesOut[voiceIdx], _numFrames);
+      }
+   }
+}
+
+int stfx_host_instance_use_add(const stfx_host_instance_t *_inst) {
+   return _inst->config->b_add && (NULL != _inst->info->process_add);
+}
+
+void stfx_host_instance_process_voices_add(stfx_host_instance_t *_inst,
+                                           const float          *_samplesIn,
+                                           float                *_samplesMix,
+                                           unsigned int          _numFrames,
+                                           float                 _gain
+                                           ) {
+   st_plugin_info_t *info = _inst->info;
+   const stfx_host_config_t *config = _inst->config;
+   int bAdd = stfx_host_instance_use_add(_inst);
+   unsigned int numSamples = _numFrames * 2u;
+
+   int bInputSilent = config->b_skip_silent && loc_is_silent(_samplesIn, numSamples);
+
+   for(unsigned int voiceIdx = 0u; voiceIdx < _inst->num_voices; voiceIdx++)
+   {
+      if(config->b_skip_silent && loc_skip_voice(_inst, voiceIdx, bInputSilent))
+         continue;  // silent voice does not contribute to the mix
+
+      st_plugin_voice_t *voice = _inst->voices[voiceIdx];
+
+      loc_update_mods(_inst, voiceIdx);
+
+      if(NULL != info->prepare_block)
+         info->prepare_block(voice, _numFrames, voice->note_hz, (float)config->note, 1.0f/*vol*/, 0.0f/*pan*/);
+
+      if(bAdd)
+      {
+         info->process_add(voice, config->b_mono_in, _samplesIn, _samplesMix, _numFrames, _gain);
+      }
+      else
+      {
+         // Fallback: render to temporary buffer, then mix
+         info->process_replace(voice, config->b_mono_in, _samplesIn, _inst->mix_tmp, _numFrames);
+         for(unsigned int i = 0u; i < numSamples; i++)
+            _samplesMix[i] += _inst->mix_tmp[i] * _gain;
+      }
+
+      loc_query_tail_state(_inst, voiceIdx);
+   }
+}
+
+int stfx_host_instance_use_shared_bus(const stfx_host_instance_t *_inst) {
+   const st_plugin_info_t *info = _inst->info;
+   return
+      _inst->config->b_shared_bus                 &&
+      (info->flags & ST_PLUGIN_FLAG_SHARED_BUS)   &&
+      (NULL != info->process_shared)              ;
+}
+
+void stfx_host_instance_process_shared(stfx_host_instance_t *_inst,
+                                       const float          *_samplesIn,
+                                       float                *_samplesOut,
+                                       unsigned int          _numFrames,
+                                       float                 _gain
+                                       ) {
+   unsigned int numSamples = _numFrames * 2u;
+
+   // Sum voices (a real host would add each voice's individual input here)
+   memset((void*)_inst->mix_tmp, 0, sizeof(float) * numSamples);
+   for(unsigned int voiceIdx = 0u; voiceIdx < _inst->num_voices; voiceIdx++)
+   {
+      for(unsigned int i = 0u; i < numSamples; i++)
+         _inst->mix_tmp[i] += _samplesIn[i] * _gain;
+   }
+
+   _inst->info->process_shared(_inst->shared, _inst->config->b_mono_in, _inst->mix_tmp, _samplesOut, _numFrames);
+}
+
+int stfx_host_instance_use_planar(const stfx_host_instance_t *_inst) {
+   const st_plugin_info_t *info = _inst->info;
+   return
+      _inst->config->b_planar                  &&
+      (info->flags & ST_PLUGIN_FLAG_PLANAR)    &&
+      (NULL != info->process_replace_planar)   ;
+}
+
+void stfx_host_instance_process_voices_planar(stfx_host_instance_t *_inst,
+                                              const float          *_samplesInL,
+                                              const float          *_samplesInR,
+                                              float               **_samplesOutL,
+                                              float               **_samplesOutR,
+                                              unsigned int          _numFrames
+                                              ) {
+   st_plugin_info_t *info = _inst->info;
+   const stfx_host_config_t *config = _inst->config;
+
+   int bInputSilent = config->b_skip_silent && loc_is_silent(_samplesInL, _numFrames) && loc_is_silent(_samplesInR, _numFrames);
+
+   for(unsigned int voiceIdx = 0u; voiceIdx < _inst->num_voices; voiceIdx++)
+   {
+      if(config->b_skip_silent && loc_skip_voice(_inst, voiceIdx, bInputSilent))
+      {
+         memset((void*)_samplesOutL[voiceIdx], 0, sizeof(float) * _numFrames);
+         memset((void*)_samplesOutR[voiceIdx], 0, sizeof(float) * _numFrames);
+         continue;
+      }
+
+      st_plugin_voice_t *voice = _inst->voices[voiceIdx];
+
+      loc_update_mods(_inst, voiceIdx);
+
+      if(NULL != info->prepare_block)
+         info->prepare_block(voice, _numFrames, voice->note_hz, (float)config->note, 1.0f/*vol*/, 0.0f/*pan*/);
+
+      info->process_replace_planar(voice, config->b_mono_in,
+                                   _samplesInL, _samplesInR,
+                                   _samplesOutL[voiceIdx], _samplesOutR[voiceIdx],
+                                   _numFrames
+                                   );
+
+      loc_query_tail_state(_inst, voiceIdx);
+   }
+}
+
+void stfx_host_instance_note_on(stfx_host_instance_t *_inst) {
+   st_plugin_info_t *info = _inst->info;
+   for(unsigned int voiceIdx = 0u; voiceIdx < _inst->num_voices; voiceIdx++)
+   {
+      if(NULL != info->note_on)
+         info->note_on(_inst->voices[voiceIdx], 0/*bGlide*/, (unsigned char)_inst->config->note, _inst->config->vel);
+      _inst->voice_silent[voiceIdx] = 0;
+   }
+}
+
+void stfx_host_instance_note_off(stfx_host_instance_t *_inst) {
+   st_plugin_info_t *info = _inst->info;
+   if(NULL != info->note_off)
+   {
+      for(unsigned int voiceIdx = 0u; voiceIdx < _inst->num_voices; voiceIdx++)
+         info->note_off(_inst->voices[voiceIdx], (unsigned char)_inst->config->note, 0.0f/*vel*/);
+   }
+}
+
+void stfx_host_instance_end_block(stfx_host_instance_t *_inst) {
+   _inst->block_idx++;
+}
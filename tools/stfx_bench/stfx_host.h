@@ -0,0 +1,233 @@
+// ----
+// ---- file   : stfx_host.h
+// ---- legal  : Distributed under terms of the MIT license (https://opensource.org/licenses/MIT)
+// ----          Copyright 2020-2026 by bsp
+// ----
+// ----          Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+// ----          associated documentation files (the "Software"), to deal in the Software without restriction, including
+// ----          without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// ----          copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to
+// ----          the following conditions:
+// ----
+// ----          The above copyright notice and this permission notice shall be included in all copies or substantial
+// ----          portions of the Software.
+// ----
+// ----          THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+// ----          NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// ----          IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+// ----          WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// ----          SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// ----
+// ----
+// ---- info   : minimal reference host for stfx plugin libraries (used by stfx_bench)
+// ----
+// ---- created: 16Oct2026
+// ---- changed:
+// ----
+// ----
+// ----
+
+#ifndef STFX_HOST_H__
+#define STFX_HOST_H__
+
+#include "../../plugin.h"
+
+// Block rate of the (Eureka) plugin host model (see plugin.h prepare_block())
+#define STFX_HOST_BLOCK_RATE  (1000u)
+
+// Maximum number of sample frames per block (>= sampleRate / STFX_HOST_BLOCK_RATE)
+#define STFX_HOST_MAX_BLOCK_FRAMES  (1024u)
+
+// Maximum number of voices per plugin instance
+#define STFX_HOST_MAX_VOICES  (256u)
+
+// Plugin library (DLL / SO)
+typedef struct stfx_host_lib_s {
+   void                 *dll_handle;
+   st_plugin_init_fxn_t  init_fxn;
+   const char           *path_name;
+} stfx_host_lib_t;
+
+// Host configuration
+typedef struct stfx_host_config_s {
+   float        sample_rate;  // e.g. 44100
+   float        bpm;          // e.g. 125
+   unsigned int num_voices;   // 1..STFX_HOST_MAX_VOICES
+   unsigned int note;         // MIDI note passed to note_on() / prepare_block()
+   float        vel;          // 0..1
+   int          b_mono_in;    // 1=pass mono input (l=r) and set bMonoIn hint
+   int          b_mod_ramps;  // 1=sweep all mod slots with deterministic per-block ramps
+   int          b_batched;    // 1=use process_replace_voices() (when available)
+   int          b_planar;     // 1=use process_replace_planar() (when available, see stfx_host_instance_process_voices_planar())
+   int          b_skip_silent; // 1=skip voices whose tail has ended while the input is silent (see query_tail_state())
+   int          b_add;        // 1=use process_add() (when available, see stfx_host_instance_process_voices_add())
+   int          b_shared_bus; // 1=sum voices into a bus and call process_shared() (when available, see stfx_host_instance_process_shared())
+   st_plugin_allocator_t *allocator;  // shared / voice instance allocator (NULL=plugin uses malloc() / free())
+} stfx_host_config_t;
+
+// Bump allocator arena for shared / voice instances (see st_plugin_allocator_t)
+//  - memory is allocated and pre-faulted once, mem_free() is a no-op
+//  - mem_alloc() returns NULL when the arena is exhausted
+typedef struct stfx_host_arena_s {
+   st_plugin_allocator_t base;
+   unsigned char *mem_raw;
+   unsigned char *mem;        // aligned to ST_PLUGIN_ALLOC_ALIGN
+   size_t         size;
+   size_t         used;
+   size_t         peak_used;
+} stfx_host_arena_t;
+
+// Plugin instance (shared + voices) driven by the host
+typedef struct stfx_host_instance_s {
+   const stfx_host_config_t *config;
+   st_plugin_info_t   *info;
+   st_plugin_shared_t *shared;
+   st_plugin_voice_t  *voices[STFX_HOST_MAX_VOICES];
+   unsigned int        num_voices;
+
+   // voice buses (always valid, see x_* plugins)
+   float  *voice_bus_mem;
+   float  *voice_bus_buffers[ST_PLUGIN_MAX_LAYERS];
+
+   // see set_max_block_size()
+   unsigned int max_block_frames;
+
+   // fractional 1000Hz block size accumulator
+   double       block_frames_acc;
+   unsigned int block_idx;
+
+   // process_replace_voices() arguments
+   st_plugin_voice_block_t blocks[STFX_HOST_MAX_VOICES];
+
+   // process_replace() output before host mix pass (see stfx_host_instance_process_voices_add())
+   float mix_tmp[2u * STFX_HOST_MAX_BLOCK_FRAMES];
+
+   // query_tail_state() results (1=tail has ended)
+   int          voice_silent[STFX_HOST_MAX_VOICES];
+   unsigned int num_voice_blocks;          // total number of voice blocks
+   unsigned int num_voice_blocks_skipped;  // number of skipped (silent) voice blocks
+
+   // timing (nanoseconds)
+   double t_shared_new;
+   double t_voice_new;    // sum of all voice_new() calls
+   double t_voice_steal;  // sum of all voice_reset() (or voice_delete() + voice_new()) calls
+   unsigned int num_voice_steals;
+} stfx_host_instance_t;
+
+
+// Monotonic time in nanoseconds
+extern double stfx_host_time_ns (void);
+
+// Open plugin library and resolve st_plugin_init()
+//  - returns 1 on success, 0 on failure
+extern int stfx_host_lib_open (stfx_host_lib_t *_lib, const char *_pathName);
+extern void stfx_host_lib_close (stfx_host_lib_t *_lib);
+
+// Allocate and pre-fault arena memory ('size' bytes)
+//  - returns 1 on success, 0 on failure
+extern int stfx_host_arena_init (stfx_host_arena_t *_arena, size_t _size);
+extern void stfx_host_arena_exit (stfx_host_arena_t *_arena);
+
+// Release all allocations (call after all shared / voice instances have been deleted)
+extern void stfx_host_arena_reset (stfx_host_arena_t *_arena);
+
+// Create shared instance and voices, declare max. block size, set sample rate / bpm, reset params and trigger note on
+//  (note) calls prepare_block() with numFrames=0 (initial state)
+//  - returns 1 on success, 0 on failure
+extern int stfx_host_instance_init (stfx_host_instance_t     *_inst,
+                                    st_plugin_info_t         *_info,
+                                    const stfx_host_config_t *_config
+                                    );
+
+// Delete voices and shared instance (does not call plugin_exit())
+extern void stfx_host_instance_exit (stfx_host_instance_t *_inst);
+
+// Calc size of next block (sampleRate / STFX_HOST_BLOCK_RATE, fractional remainder is carried to next block)
+extern unsigned int stfx_host_instance_next_block_size (stfx_host_instance_t *_inst);
+
+// Update voice buses (interleaved stereo, must provide at least 'numFrames' frames)
+extern void stfx_host_instance_set_voice_bus (stfx_host_instance_t *_inst,
+                                              const float          *_samples,
+                                              unsigned int          _numFrames
+                                              );
+
+// Render one block for voice 'voiceIdx' (set_mod_value(), prepare_block(), process_replace())
+//  - 'samplesIn' / 'samplesOut' are interleaved stereo buffers (2 * numFrames floats)
+//  - when 'b_skip_silent' is set and the voice's tail has ended, silent input blocks are skipped (output is cleared)
+extern void stfx_host_instance_process_voice (stfx_host_instance_t *_inst,
+                                              unsigned int          _voiceIdx,
+                                              const float          *_samplesIn,
+                                              float                *_samplesOut,
+                                              unsigned int          _numFrames
+                                              );
+
+// Render one block for all voices
+//  - calls process_replace_voices() when the plugin implements it and 'b_batched' is set,
+//     or falls back to per-voice prepare_block() + process_replace() calls
+//  - 'samplesIn' is shared by all voices, 'samplesOut' is an array of per-voice output buffers
+extern void stfx_host_instance_process_voices (stfx_host_instance_t *_inst,
+                                               const float          *_samplesIn,
+                                               float               **_samplesOut,
+                                               unsigned int          _numFrames
+                                               );
+
+// Render one block for all voices (non-interleaved buffers)
+//  - calls prepare_block() + process_replace_planar() for each voice
+//  - plugin must set ST_PLUGIN_FLAG_PLANAR (see stfx_host_instance_use_planar())
+//  - all buffer addresses must be aligned to ST_PLUGIN_PLANAR_ALIGN
+extern void stfx_host_instance_process_voices_planar (stfx_host_instance_t *_inst,
+                                                      const float          *_samplesInL,
+                                                      const float          *_samplesInR,
+                                                      float               **_samplesOutL,
+                                                      float               **_samplesOutR,
+                                                      unsigned int          _numFrames
+                                                      );
+
+// Render one block for all voices and mix them into 'samplesMix' ('samplesMix += voiceOut * gain')
+//  - calls process_add() when the plugin implements it and 'b_add' is set,
+//     or falls back to process_replace() + host mix pass
+//  - 'samplesIn' is shared by all voices and must not overlap 'samplesMix'
+extern void stfx_host_instance_process_voices_add (stfx_host_instance_t *_inst,
+                                                   const float          *_samplesIn,
+                                                   float                *_samplesMix,
+                                                   unsigned int          _numFrames,
+                                                   float                 _gain
+                                                   );
+
+// Sum the input of all voices into a bus ('samplesIn * gain' per voice) and render it once via process_shared()
+//  - plugin must set ST_PLUGIN_FLAG_SHARED_BUS (see stfx_host_instance_use_shared_bus())
+//  - 'samplesIn' is shared by all voices
+extern void stfx_host_instance_process_shared (stfx_host_instance_t *_inst,
+                                               const float          *_samplesIn,
+                                               float                *_samplesOut,
+                                               unsigned int          _numFrames,
+                                               float                 _gain
+                                               );
+
+// Returns 1 when 'b_shared_bus' is set and the plugin implements process_shared()
+extern int stfx_host_instance_use_shared_bus (const stfx_host_instance_t *_inst);
+
+// Returns 1 when 'b_add' is set and the plugin implements process_add()
+extern int stfx_host_instance_use_add (const stfx_host_instance_t *_inst);
+
+// Returns 1 when 'b_planar' is set and the plugin implements process_replace_planar()
+extern int stfx_host_instance_use_planar (const stfx_host_instance_t *_inst);
+
+// Send note_on() / note_off() to all voices (e.g. to re-trigger oscillator plugins)
+//  - note_on() resets the voices' query_tail_state() result
+extern void stfx_host_instance_note_on (stfx_host_instance_t *_inst);
+extern void stfx_host_instance_note_off (stfx_host_instance_t *_inst);
+
+// Recycle all voices (voice stealing), then set sample rate / bpm and trigger note on
+//  - calls voice_reset() when the plugin implements it, or falls back to voice_delete() + voice_new()
+//  - returns 1 on success, 0 on failure (voice_new() returned NULL)
+extern int stfx_host_instance_steal_voices (stfx_host_instance_t *_inst);
+
+// Advance block counter (call after all voices have been processed)
+extern void stfx_host_instance_end_block (stfx_host_instance_t *_inst);
+
+// Deterministic white noise (-1..1)
+extern float stfx_host_noise (unsigned int *_seed);
+
+
+#endif // STFX_HOST_H__